@@ -0,0 +1,194 @@
+#include "Atom.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+class AtomTable
+{
+private:
+	struct Slot
+	{
+		size_t        hash;
+		const String* string;
+	};
+
+	std::shared_mutex m_mutex;
+
+	Slot*  m_slots;
+	size_t m_capacity;
+	size_t m_count;
+
+	size_t              m_storedBytes;
+	std::atomic<size_t> m_requestedBytes;
+
+	static size_t GetByteCount(const String& string) { return string.Length().ToRawValue() * sizeof(Character); }
+
+	static size_t Hash(const String& string) { return string.GetHashCode().GetValue(); }
+
+	const String* Find(const String& string, size_t hash) const
+	{
+		if(m_capacity == 0U)
+			return nullptr;
+
+		size_t mask = m_capacity - 1U;
+		for(size_t i = hash & mask; m_slots[i].string; i = (i + 1U) & mask)
+		{
+			if(m_slots[i].hash == hash && *m_slots[i].string == string)
+				return m_slots[i].string;
+		}
+
+		return nullptr;
+	}
+
+	void Grow(size_t capacity)
+	{
+		Slot* slots = (Slot*)calloc(capacity, sizeof(Slot));
+
+		size_t mask = capacity - 1U;
+		for(size_t i = 0U; i < m_capacity; i++)
+		{
+			if(!m_slots[i].string)
+				continue;
+
+			size_t j = m_slots[i].hash & mask;
+			while(slots[j].string)
+				j = (j + 1U) & mask;
+
+			slots[j] = m_slots[i];
+		}
+
+		free(m_slots);
+		m_slots    = slots;
+		m_capacity = capacity;
+	}
+
+	void EnsureCapacity(size_t count)
+	{
+		size_t capacity = m_capacity == 0U ? 64U : m_capacity;
+		while(count * 4U > capacity * 3U)
+			capacity *= 2U;
+
+		if(capacity > m_capacity)
+			Grow(capacity);
+	}
+
+	const String* Insert(const String& string, size_t hash)
+	{
+		EnsureCapacity(m_count + 1U);
+
+		// The characters are copied into storage that is never freed and handed to String as static, so copies of an
+		// atom's string, made by any thread, never touch a shared reference count.
+		size_t     length = string.Length().ToRawValue();
+		Character* chars  = (Character*)malloc(length * sizeof(Character));
+		memcpy(chars, string.AsView().ToUnsafePointer(), length * sizeof(Character));
+
+		const String* result = new String(SharedArraySpan<Character>(SharedArrayRef<Character>::FromStatic(chars, length)));
+
+		size_t mask = m_capacity - 1U;
+		size_t i = hash & mask;
+		while(m_slots[i].string)
+			i = (i + 1U) & mask;
+
+		m_slots[i] = { hash, result };
+		m_count++;
+		m_storedBytes += GetByteCount(string);
+
+		return result;
+	}
+
+	const String* FindOrInsert(const String& string, size_t hash)
+	{
+		if(const String* existing = Find(string, hash))
+			return existing;
+
+		return Insert(string, hash);
+	}
+public:
+	AtomTable() : m_slots(nullptr), m_capacity(0U), m_count(0U), m_storedBytes(0U), m_requestedBytes(0U) {}
+
+	static AtomTable& GetInstance()
+	{
+		static AtomTable s_instance;
+		return s_instance;
+	}
+
+	const String* Intern(const String& string)
+	{
+		size_t hash = Hash(string);
+		m_requestedBytes += GetByteCount(string);
+
+		{
+			std::shared_lock lock(m_mutex);
+			if(const String* existing = Find(string, hash))
+				return existing;
+		}
+
+		std::unique_lock lock(m_mutex);
+		return FindOrInsert(string, hash);
+	}
+
+	const String* TryFind(const String& string)
+	{
+		size_t hash = Hash(string);
+
+		std::shared_lock lock(m_mutex);
+		return Find(string, hash);
+	}
+
+	void Reserve(size_t count)
+	{
+		std::unique_lock lock(m_mutex);
+		EnsureCapacity(count);
+	}
+
+	void InternAll(const ArraySpan<String>& strings)
+	{
+		std::unique_lock lock(m_mutex);
+		EnsureCapacity(m_count + strings.Count().ToRawValue());
+
+		for(Size i = 0U; i < strings.Count(); i++)
+		{
+			const String& string = strings[i];
+			if(string.Length() == 0U)
+				continue;
+
+			m_requestedBytes += GetByteCount(string);
+			FindOrInsert(string, Hash(string));
+		}
+	}
+
+	AtomStatistics GetStatistics()
+	{
+		std::shared_lock lock(m_mutex);
+		return AtomStatistics(m_count, m_storedBytes, m_requestedBytes.load());
+	}
+};
+
+Atom::Atom(const String& string) : m_string(string.Length() == 0U ? nullptr : AtomTable::GetInstance().Intern(string)) {}
+
+Boolean Atom::TryFind(const String& string, Atom& result)
+{
+	if(string.Length() == 0U)
+	{
+		result = Atom();
+		return true;
+	}
+
+	const String* existing = AtomTable::GetInstance().TryFind(string);
+	if(!existing)
+		return false;
+
+	result = Atom(existing);
+	return true;
+}
+
+void Atom::Reserve(Size count) { AtomTable::GetInstance().Reserve(count.ToRawValue()); }
+
+void Atom::InternAll(const ArraySpan<String>& strings) { AtomTable::GetInstance().InternAll(strings); }
+
+AtomStatistics Atom::GetStatistics() { return AtomTable::GetInstance().GetStatistics(); }
+
+Size Atom::Length() const { return m_string ? m_string->Length() : Size(0U); }
+
+String Atom::ToString() const { return m_string ? *m_string : String(); }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "String.hpp"
+
+class AtomStatistics
+{
+private:
+	Size m_atomCount;
+	Size m_storedBytes;
+	Size m_requestedBytes;
+public:
+	AtomStatistics(Size atomCount, Size storedBytes, Size requestedBytes) :
+		m_atomCount(atomCount), m_storedBytes(storedBytes), m_requestedBytes(requestedBytes) {}
+
+	Size GetAtomCount()      const { return m_atomCount;      }
+	Size GetStoredBytes()    const { return m_storedBytes;    }
+	Size GetRequestedBytes() const { return m_requestedBytes; }
+
+	Size GetMemorySaved() const { return m_requestedBytes - m_storedBytes; }
+};
+
+// An interned string. Every Atom created from equal strings points at the same entry of a process-wide table,
+// so equality and hashing only look at that pointer. Entries are never freed.
+class Atom
+{
+private:
+	const String* m_string;
+
+	explicit Atom(const String* string) : m_string(string) {}
+public:
+	Atom() : m_string(nullptr) {}
+
+	explicit Atom(const String& string);
+
+	Atom(const Atom& other) : m_string(other.m_string) {}
+
+	Atom& operator=(const Atom& other)
+	{
+		m_string = other.m_string;
+		return *this;
+	}
+
+	static Boolean TryFind(const String& string, Atom& result);
+
+	static void Reserve(Size count);
+
+	static void InternAll(const ArraySpan<String>& strings);
+
+	static AtomStatistics GetStatistics();
+
+	Size Length() const;
+
+	friend Boolean operator==(Atom left, Atom right) { return left.m_string == right.m_string; }
+	friend Boolean operator!=(Atom left, Atom right) { return left.m_string != right.m_string; }
+
+	HashCode GetHashCode() const { return HashCode(size_t(m_string) >> 4U); }
+
+	String ToString() const;
+
+	friend class AtomTable;
+};
\ No newline at end of file
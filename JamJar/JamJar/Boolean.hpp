@@ -12,9 +12,9 @@ private:
 	bool m_value;
 public:
 	template<std::same_as<bool> T>
-	Boolean(T value = false) : m_value(value) {}
+	constexpr Boolean(T value = false) noexcept : m_value(value) {}
 
-	operator bool() const { return m_value; }
+	constexpr operator bool() const noexcept { return m_value; }
 
 	HashCode GetHashCode() const;
 
@@ -28,6 +28,9 @@ concept MoveConstructible = std::is_move_constructible_v<T>;
 template<typename T, typename... Args>
 concept ConstructibleFrom = std::is_constructible_v<T, Args...>;
 
+template<typename T>
+concept TriviallyCopyable = std::is_trivially_copyable_v<T>;
+
 template<typename T>
 concept Destructible = std::is_destructible_v<T>;
 
@@ -146,12 +149,17 @@ template<typename T>
 concept Pointer = std::is_pointer_v<T>;
 
 template<typename T>
-concept Number = Addable<T> && Subtractable<T> && Multiplicable<T> && Divisible<T> && Modable<T> && Incrementable<T> && Decrementable<T> && Comparable<T> && 
-requires
+concept Bounded = requires
 {
 	{ T::Minimum };
 	{ T::Maximum };
+};
 
+// Not necessarily Bounded, so arbitrary precision types count too.
+template<typename T>
+concept Number = Addable<T> && Subtractable<T> && Multiplicable<T> && Divisible<T> && Modable<T> && Incrementable<T> && Decrementable<T> && Comparable<T> && 
+requires
+{
 	{ T::Zero };
 	{ T::One  };
 } && 
@@ -1,19 +1,342 @@
 #include "Console.hpp"
+#include "Encoding.hpp"
 
-void Console::Print(const String& value) 
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+static const size_t BufferCapacity   = 64U * 1024U;
+static const size_t WriteChunkLength = 256U;
+
+static const std::chrono::milliseconds FlushInterval(100);
+
+static void WriteToOutput(const char* data, size_t count)
 {
-	wchar_t* chars = new wchar_t[value.Length().ToRawValue() + 1U];
-	value.CopyTo(chars);
-	std::wcout << chars;
-	delete[] chars;
+#if defined(_WIN32)
+	static const Boolean initialized = SetConsoleOutputCP(CP_UTF8) != 0;
+
+	HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+	while(count > 0U)
+	{
+		DWORD written;
+		if(!WriteFile(output, data, DWORD(count), &written, nullptr))
+			return;
+
+		data  += written;
+		count -= written;
+	}
+#else
+	while(count > 0U)
+	{
+		ssize_t written = write(STDOUT_FILENO, data, count);
+		if(written < 0)
+		{
+			if(errno == EINTR)
+				continue;
+
+			return;
+		}
+
+		data  += written;
+		count -= size_t(written);
+	}
+#endif
 }
 
-void Console::PrintLine(const String& value) 
+class ConsoleBuffer;
+
+// Every thread's buffer, so that text left in one is written out by a background thread while its owner is busy or
+// blocked, and so that all of them are written out at exit. The registry is never destroyed: both of those can run
+// while static objects are being torn down.
+struct ConsoleRegistry
+{
+	std::mutex              mutex;
+	std::condition_variable wake;
+	ConsoleBuffer*          first   = nullptr;
+	Boolean                 pending = false;
+	Boolean                 started = false;
+};
+
+static ConsoleRegistry& GetRegistry()
 {
-	wchar_t* chars = new wchar_t[value.Length().ToRawValue() + 1U];
-	value.CopyTo(chars);
-	std::wcout << chars << std::endl;
-	delete[] chars;
+	static ConsoleRegistry* s_registry = new ConsoleRegistry();
+	return *s_registry;
 }
 
+class ConsoleBuffer
+{
+private:
+	std::mutex m_mutex;
+	char*      m_data;
+	size_t     m_count;
+
+	std::chrono::steady_clock::time_point m_lastFlush;
+
+	ConsoleBuffer* m_previous;
+	ConsoleBuffer* m_next;
+
+	static void RunFlusher();
+	static void FlushAll();
+public:
+	ConsoleBuffer();
+
+	ConsoleBuffer(const ConsoleBuffer& other) = delete;
+
+	~ConsoleBuffer();
+
+	std::mutex& GetMutex() { return m_mutex; }
+
+	Boolean IsEmpty() const { return m_count == 0U; }
+
+	char* Reserve(size_t count)
+	{
+		if(m_count + count > BufferCapacity)
+			Flush();
+
+		return m_data + m_count;
+	}
+
+	void Commit(size_t count) { m_count += count; }
+
+	void Flush()
+	{
+		WriteToOutput(m_data, m_count);
+		m_count     = 0U;
+		m_lastFlush = std::chrono::steady_clock::now();
+	}
+
+	// Writes out the complete lines and keeps the rest, or writes out everything if there is no complete line.
+	void FlushLines()
+	{
+		size_t end = m_count;
+		while(end > 0U && m_data[end - 1U] != '\n')
+			end--;
+
+		if(end == 0U || end == m_count)
+		{
+			Flush();
+			return;
+		}
+
+		WriteToOutput(m_data, end);
+		memmove(m_data, m_data + end, m_count - end);
+		m_count    -= end;
+		m_lastFlush = std::chrono::steady_clock::now();
+	}
+
+	void FlushIfDue()
+	{
+		if(std::chrono::steady_clock::now() - m_lastFlush > FlushInterval)
+			Flush();
+	}
+
+	// Wakes the background thread, which writes the buffer out within FlushInterval unless its owner does first.
+	static void NotifyPending()
+	{
+		ConsoleRegistry& registry = GetRegistry();
+		{
+			std::lock_guard lock(registry.mutex);
+			registry.pending = true;
+		}
+		registry.wake.notify_one();
+	}
+};
+
+ConsoleBuffer::ConsoleBuffer() : m_data((char*)malloc(BufferCapacity)), m_count(0U), m_lastFlush(std::chrono::steady_clock::now()), m_previous(nullptr), m_next(nullptr)
+{
+	ConsoleRegistry& registry = GetRegistry();
+	std::lock_guard lock(registry.mutex);
+
+	m_next = registry.first;
+	if(m_next)
+		m_next->m_previous = this;
+
+	registry.first = this;
+
+	if(!registry.started)
+	{
+		registry.started = true;
+		std::thread(&ConsoleBuffer::RunFlusher).detach();
+		std::atexit(&ConsoleBuffer::FlushAll);
+	}
+}
+
+ConsoleBuffer::~ConsoleBuffer()
+{
+	ConsoleRegistry& registry = GetRegistry();
+	{
+		std::lock_guard lock(registry.mutex);
+		if(m_previous)
+			m_previous->m_next = m_next;
+		else
+			registry.first = m_next;
+
+		if(m_next)
+			m_next->m_previous = m_previous;
+	}
+
+	Flush();
+	free(m_data);
+}
+
+// Sleeps until some buffer stops being empty, gives its owner FlushInterval to write it out, then writes out whatever
+// is still waiting, up to the last complete line. A buffer its owner is using at that moment, or the unfinished line
+// after the last one, is left for the next round.
+void ConsoleBuffer::RunFlusher()
+{
+	ConsoleRegistry& registry = GetRegistry();
+	std::unique_lock lock(registry.mutex);
+
+	for(;;)
+	{
+		registry.wake.wait(lock, [&registry]() { return registry.pending; });
+
+		// Other buffers becoming pending wake it too, which must not cut the interval short.
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + FlushInterval;
+		while(registry.wake.wait_until(lock, deadline) != std::cv_status::timeout) {}
+
+		Boolean waiting = false;
+		for(ConsoleBuffer* buffer = registry.first; buffer; buffer = buffer->m_next)
+		{
+			std::unique_lock bufferLock(buffer->m_mutex, std::try_to_lock);
+			if(!bufferLock.owns_lock())
+				waiting = true;
+			else if(!buffer->IsEmpty())
+			{
+				buffer->FlushLines();
+				waiting = waiting || !buffer->IsEmpty();
+			}
+		}
+
+		registry.pending = waiting;
+	}
+}
+
+// At exit the other threads' buffers are never destroyed, so they are written out here.
+void ConsoleBuffer::FlushAll()
+{
+	ConsoleRegistry& registry = GetRegistry();
+	std::lock_guard lock(registry.mutex);
+
+	for(ConsoleBuffer* buffer = registry.first; buffer; buffer = buffer->m_next)
+	{
+		std::lock_guard bufferLock(buffer->m_mutex);
+		buffer->Flush();
+	}
+}
+
+static thread_local ConsoleBuffer s_buffer;
+
+// Runs operation on this thread's buffer under its lock, so the background thread never sees a half-written
+// character, and wakes that thread if the buffer had been empty. The registry is locked only after the buffer is
+// released, so the two locks are never taken in the opposite order.
+template<typename Operation>
+static void WithBuffer(Operation operation)
+{
+	Boolean wasEmpty = false;
+	Boolean isEmpty  = false;
+	{
+		std::lock_guard lock(s_buffer.GetMutex());
+		wasEmpty = s_buffer.IsEmpty();
+		operation(s_buffer);
+		isEmpty = s_buffer.IsEmpty();
+	}
+
+	if(wasEmpty && !isEmpty)
+		ConsoleBuffer::NotifyPending();
+}
+
+// Ends the line, then writes the buffer out if the last write-out was more than FlushInterval ago.
+static void EndLine(ConsoleBuffer& buffer)
+{
+	*buffer.Reserve(1U) = '\n';
+	buffer.Commit(1U);
+	buffer.FlushIfDue();
+}
+
+static void Write(const String& value, Boolean endLine)
+{
+	WithBuffer([&value, endLine](ConsoleBuffer& buffer)
+	{
+		const wchar_t* source    = (const wchar_t*)value.AsView().ToUnsafePointer();
+		size_t         remaining = value.Length().ToRawValue();
+
+		while(remaining > 0U)
+		{
+			size_t count = remaining < WriteChunkLength ? remaining : WriteChunkLength;
+
+			// Keep surrogate pairs within one chunk.
+			if(sizeof(wchar_t) == 2U && count < remaining && source[count - 1U] >= 0xD800U && source[count - 1U] <= 0xDBFFU)
+				count--;
+
+			char* dest = buffer.Reserve(count * 4U);
+
+			EncodingResult result = Encoding::WideToUTF8(source, count, dest);
+			buffer.Commit(result.GetCount().ToRawValue());
+
+			if(!result.IsValid())
+			{
+				memcpy(buffer.Reserve(3U), "\xEF\xBF\xBD", 3U);
+				buffer.Commit(3U);
+
+				count = result.GetPosition().ToRawValue() + 1U;
+			}
+
+			source    += count;
+			remaining -= count;
+		}
+
+		if(endLine)
+			EndLine(buffer);
+	});
+}
+
+static void WriteWide(const wchar_t* characters, size_t count, Boolean endLine)
+{
+	WithBuffer([characters, count, endLine](ConsoleBuffer& buffer)
+	{
+		char* dest = buffer.Reserve(count);
+		for(size_t i = 0U; i < count; i++)
+			dest[i] = char(characters[i]);
+
+		buffer.Commit(count);
+
+		if(endLine)
+			EndLine(buffer);
+	});
+}
+
+void Console::WriteUnsigned(uint64_t value, Boolean endLine)
+{
+	wchar_t digits[NumberFormat::MaximumIntegerLength];
+	WriteWide(digits, NumberFormat::Format(value, digits), endLine);
+}
+
+void Console::WriteSigned(int64_t value, Boolean endLine)
+{
+	wchar_t digits[NumberFormat::MaximumIntegerLength + 1U];
+	WriteWide(digits, NumberFormat::Format(value, digits), endLine);
+}
+
+void Console::WriteFloat(double value, Boolean singlePrecision, Boolean endLine)
+{
+	wchar_t digits[NumberFormat::MaximumFloatLength];
+	WriteWide(digits, singlePrecision ? NumberFormat::Format(float(value), digits) : NumberFormat::Format(value, digits), endLine);
+}
+
+void Console::Flush() { WithBuffer([](ConsoleBuffer& buffer) { buffer.Flush(); }); }
+
+void Console::Print(const String& value) { Write(value, false); }
 
+void Console::PrintLine(const String& value) { Write(value, true); }
\ No newline at end of file
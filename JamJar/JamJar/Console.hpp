@@ -1,12 +1,22 @@
 #pragma once
 
-#include <iostream>
-
 #include "String.hpp"
+#include "StringBuilder.hpp"
 
+// Output goes through a per-thread UTF-8 buffer. It is written out when it fills up, when a line completes more than
+// 100 ms after the previous write-out, when the thread exits, or on Flush. A background thread writes out anything
+// left waiting for 100 ms, so nothing is held back while the program is blocked, and every thread's buffer is written
+// out at program exit.
 class Console
 {
+private:
+	// Each writes its value and, if asked, the end of the line in one go, so a line is never split between batches.
+	static void WriteUnsigned(uint64_t value, Boolean endLine);
+	static void WriteSigned(int64_t value, Boolean endLine);
+	static void WriteFloat(double value, Boolean singlePrecision, Boolean endLine);
 public:
+	static void Flush();
+
 	template<Printable T>
 	static void Print(const T& value);
 	static void Print(const String& value);
@@ -43,13 +53,13 @@ public:
 
 
 template<std::unsigned_integral T>
-void Console::Print(T value) { std::cout << value; }
+void Console::Print(T value) { WriteUnsigned(value, false); }
 
 template<std::signed_integral T>
-void Console::Print(T value) { std::cout << value; }
+void Console::Print(T value) { WriteSigned(value, false); }
 
 template<std::floating_point T>
-void Console::Print(T value) { std::cout << value; }
+void Console::Print(T value) { WriteFloat(value, sizeof(T) == sizeof(float), false); }
 
 template<Printable T>
 void Console::Print(const T& value) { Print(value.ToString()); }
@@ -57,23 +67,24 @@ void Console::Print(const T& value) { Print(value.ToString()); }
 template<Iterable T>
 void Console::Print(const T& iterable)
 {
-	MutableString message = "{ ";
+	StringBuilder message;
+	message.Append("{ ");
 	for(auto it = iterable.begin(); it != iterable.end(); ++it)
 		message.Append(*it).Append(", ");
 
 	message.Append("}");
 
-	Console::Print(message);
+	Console::Print(message.ToString());
 }
 
 template<std::unsigned_integral T>
-void Console::PrintLine(T value) { std::cout << value << std::endl; }
+void Console::PrintLine(T value) { WriteUnsigned(value, true); }
 
 template<std::signed_integral T>
-void Console::PrintLine(T value) { std::cout << value << std::endl; }
+void Console::PrintLine(T value) { WriteSigned(value, true); }
 
 template<std::floating_point T>
-void Console::PrintLine(T value) { std::cout << value << std::endl; }
+void Console::PrintLine(T value) { WriteFloat(value, sizeof(T) == sizeof(float), true); }
 
 template<Printable T>
 void Console::PrintLine(const T& value) { PrintLine(value.ToString()); }
@@ -81,12 +92,12 @@ void Console::PrintLine(const T& value) { PrintLine(value.ToString()); }
 template<Iterable T>
 void Console::PrintLine(const T& iterable)
 {
-	MutableString message = "{ ";
+	StringBuilder message;
+	message.Append("{ ");
 	for(auto it = iterable.begin(); it != iterable.end(); ++it)
-		message.Append(it->ToString()).Append(", ");
+		message.Append(*it).Append(", ");
 
-	
 	message.Append("}");
 
-	Console::PrintLine(message);
+	Console::PrintLine(message.ToString());
 }
\ No newline at end of file
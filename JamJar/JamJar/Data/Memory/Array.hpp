@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iterator>
+#include <utility>
 
 template<typename T>
 class HeapArray;
@@ -17,6 +18,16 @@ class SharedArrayRef;
 template<typename T>
 class SharedArraySpan;
 
+// Shared by every reference to a heap array. The hash slot is filled on demand by whoever owns the meaning of the
+// contents (see String::GetHashCode); zero means it has not been computed yet.
+struct ArrayControlBlock
+{
+	Size   refCount;
+	size_t hash;
+
+	ArrayControlBlock() : refCount(1U), hash(0U) {}
+};
+
 template<typename T, size_t C>
 class StackArray
 {
@@ -88,15 +99,18 @@ template<typename T>
 class HeapArray
 {
 private:
-	T*    m_address;
-	Size* m_refCount;
-	Size  m_count;
+	T*                 m_address;
+	ArrayControlBlock* m_control;
+	Size               m_count;
 
-	void AddRef() { ++(*m_refCount); }
+	void AddRef() { ++m_control->refCount; }
 
 	void RemRef()
 	{
-		Size& refCount = *m_refCount;
+		if(!m_control)
+			return;
+
+		Size& refCount = m_control->refCount;
 		--refCount;
 
 		if(refCount == 0U)
@@ -105,45 +119,57 @@ private:
 				(m_address + i.ToRawValue())->~T();
 
 			free(m_address);
-			delete m_refCount;
+			delete m_control;
 		}
 	}
 public:
 	static const HeapArray<T> Empty;
 
 	template<SameAs<T>... Args>
-	HeapArray(Args&&... args) : m_address(new T[] { (T)args... }), m_refCount(new Size(1U)), m_count(sizeof...(args)) {}
+	HeapArray(Args&&... args) : m_address((T*)malloc(sizeof(T) * sizeof...(args))), m_control(new ArrayControlBlock()), m_count(sizeof...(args))
+	{
+		T* element = m_address;
+		((new(element++) T(std::forward<Args>(args))), ...);
+	}
 
-	HeapArray(Size count) requires DefaultConstructible<T> : m_address((T*)malloc(sizeof(T)* count.ToRawValue())), m_refCount(new Size(1U)), m_count(count)
+	HeapArray(Size count) requires DefaultConstructible<T> : m_address((T*)malloc(sizeof(T)* count.ToRawValue())), m_control(new ArrayControlBlock()), m_count(count)
 	{
 		for(Size i = 0U; i < m_count; i++)
 			new(m_address + i.ToRawValue()) T();
 	}
 
 	HeapArray(Size count, const T& item) requires CopyConstructible<T> : 
-		m_address((T*)malloc(sizeof(T)* count.ToRawValue())), m_refCount(new Size(1U)), m_count(count)
+		m_address((T*)malloc(sizeof(T)* count.ToRawValue())), m_control(new ArrayControlBlock()), m_count(count)
 	{
 		for(Size i = 0U; i < m_count; i++)
 			new(m_address + i.ToRawValue()) T(item);
 	}
 
 	HeapArray(const HeapArray<T>& other) requires CopyConstructible<T> : 
-		m_address((T*)malloc(sizeof(T)* other.m_count.ToRawValue())), m_refCount(new Size(1U)), m_count(other.m_count)
+		m_address((T*)malloc(sizeof(T)* other.m_count.ToRawValue())), m_control(new ArrayControlBlock()), m_count(other.m_count)
 	{
 		for(Size i = 0U; i < m_count; i++)
 			new(m_address + i.ToRawValue()) T(other[i]);
 	}
 
+	// Takes the elements over and leaves the other array empty.
+	HeapArray(HeapArray<T>&& other) noexcept : m_address(other.m_address), m_control(other.m_control), m_count(other.m_count)
+	{
+		other.m_address = nullptr;
+		other.m_control = nullptr;
+		other.m_count   = 0U;
+	}
+
 	template<size_t C>
 	HeapArray(const StackArray<T, C>& other) :
-		m_address((T*)malloc(sizeof(T) * C)), m_refCount(new Size(1U)), m_count(C)
+		m_address((T*)malloc(sizeof(T) * C)), m_control(new ArrayControlBlock()), m_count(C)
 	{
 		for(Size i = 0U; i < m_count; i++)
 			new(m_address + i.ToRawValue()) T(other[i]);
 	}
 
 	HeapArray(const ArrayRef<T>& other) :
-		m_address((T*)malloc(sizeof(T) * other.m_count.ToRawValue())), m_refCount(new Size(1U)), m_count(other.m_count)
+		m_address((T*)malloc(sizeof(T) * other.m_count.ToRawValue())), m_control(new ArrayControlBlock()), m_count(other.m_count)
 	{
 		for(Size i = 0U; i < m_count; i++)
 			new(m_address + i.ToRawValue()) T(other[i]);
@@ -151,6 +177,41 @@ public:
 
 	~HeapArray() { RemRef(); }
 
+	// Copies the elements, as the copy constructor does; declaring the move constructor took the implicit one away.
+	HeapArray<T>& operator=(const HeapArray<T>& other) requires CopyConstructible<T>
+	{
+		if(this == &other)
+			return *this;
+
+		T* address = (T*)malloc(sizeof(T) * other.m_count.ToRawValue());
+		for(Size i = 0U; i < other.m_count; i++)
+			new(address + i.ToRawValue()) T(other[i]);
+
+		RemRef();
+		m_address = address;
+		m_control = new ArrayControlBlock();
+		m_count   = other.m_count;
+
+		return *this;
+	}
+
+	HeapArray<T>& operator=(HeapArray<T>&& other) noexcept
+	{
+		if(this == &other)
+			return *this;
+
+		RemRef();
+		m_address = other.m_address;
+		m_control = other.m_control;
+		m_count   = other.m_count;
+
+		other.m_address = nullptr;
+		other.m_control = nullptr;
+		other.m_count   = 0U;
+
+		return *this;
+	}
+
 	Size Count() const { return m_count; }
 
     	  T& operator[](Size index)       { return m_address[index.ToRawValue()]; }
@@ -182,8 +243,13 @@ public:
 
 	ArrayRef(const SharedArrayRef<T>& other) : m_address(other.m_address), m_count(other.m_count) {}
 
+	// Refers to elements owned elsewhere, which must outlive the reference.
+	ArrayRef(T* address, Size count) : m_address(address), m_count(count) {}
+
 	Size Count() const { return m_count; }
 
+	T* ToUnsafePointer() const { return m_address; }
+
 		  T& operator[](Size index)       { return m_address[index.ToRawValue()]; }
 	const T& operator[](Size index) const { return m_address[index.ToRawValue()]; }
 
@@ -212,6 +278,8 @@ public:
 
 	Size Count() const { return m_count; }
 
+	T* ToUnsafePointer() const { return m_array.ToUnsafePointer() + m_index.ToRawValue(); }
+
 		  T& operator[](Size index)       { return m_array[m_index + index]; }
 	const T& operator[](Size index) const { return m_array[m_index + index]; }
 
@@ -262,29 +330,44 @@ template<typename T>
 class SharedArrayRef
 {
 private:
-	T*    m_address;
-	Size* m_refCount;
-	Size  m_count;
+	T*                 m_address;
+	ArrayControlBlock* m_control;
+	Size               m_count;
 
-	void AddRef() { ++(*m_refCount); }
+	void AddRef()
+	{
+		if(m_control)
+			++m_control->refCount;
+	}
 
 	void RemRef()
 	{
-		Size& refCount = *m_refCount;
+		if(!m_control)
+			return;
+
+		Size& refCount = m_control->refCount;
 		--refCount;
 
 		if(refCount == 0U)
 		{
-			delete[] m_address;
-			delete m_refCount;
+			for(Size i = 0U; i < m_count; i++)
+				(m_address + i.ToRawValue())->~T();
+
+			free(m_address);
+			delete m_control;
 		}
 	}
 
-	SharedArrayRef(T* address, Size count) : m_address(address), m_refCount(new Size(1U)), m_count(count) {}
+	SharedArrayRef(T* address, Size count) : m_address(address), m_control(new ArrayControlBlock()), m_count(count) {}
+
+	SharedArrayRef(T* address, ArrayControlBlock* control, Size count) : m_address(address), m_control(control), m_count(count) {}
 public:
-	SharedArrayRef(const HeapArray<T>& array) : m_address(array.m_address), m_refCount(array.m_refCount), m_count(array.m_count) { AddRef(); }
+	// Refers to storage that lives for the whole program (e.g. a literal). It is never reference counted or freed.
+	static SharedArrayRef<T> FromStatic(const T* address, Size count) { return SharedArrayRef<T>((T*)address, nullptr, count); }
+
+	SharedArrayRef(const HeapArray<T>& array) : m_address(array.m_address), m_control(array.m_control), m_count(array.m_count) { AddRef(); }
 
-	SharedArrayRef(const SharedArrayRef<T>& other) : m_address(other.m_address), m_refCount(other.m_refCount), m_count(other.m_count) { AddRef(); }
+	SharedArrayRef(const SharedArrayRef<T>& other) : m_address(other.m_address), m_control(other.m_control), m_count(other.m_count) { AddRef(); }
 
 	~SharedArrayRef() { RemRef(); }
 
@@ -292,7 +375,7 @@ public:
 	{
 		RemRef();
 		m_address  = other.m_address;
-		m_refCount = other.m_refCount;
+		m_control  = other.m_control;
 		m_count    = other.m_count;
 		AddRef();
 
@@ -301,6 +384,21 @@ public:
 
 	Size Count() const { return m_count; }
 
+	// Gives up the elements from count on, for an array that was measured generously and has just been filled in. No
+	// other reference may have been made to it yet.
+	void Shrink(Size count)
+	{
+		for(Size i = count; i < m_count; i++)
+			(m_address + i.ToRawValue())->~T();
+
+		m_count = count;
+	}
+
+	T* ToUnsafePointer() const { return m_address; }
+
+	// The hash slot of the control block, or null for static storage.
+	size_t* GetHashSlot() const { return m_control ? &m_control->hash : nullptr; }
+
 	virtual       T& operator[](Size index)       { return m_address[index.ToRawValue()]; }
 	virtual const T& operator[](Size index) const { return m_address[index.ToRawValue()]; }
 
@@ -329,6 +427,11 @@ public:
 	Size Index() const { return m_index; }
 	Size Count() const { return m_count; }
 
+	T* ToUnsafePointer() const { return m_array.m_address + m_index.ToRawValue(); }
+
+	// Only a span over the whole array may use the array's hash slot.
+	size_t* GetHashSlot() const { return m_index == 0U && m_count == m_array.m_count ? m_array.GetHashSlot() : nullptr; }
+
 	      T& operator[](Size index)       { return m_array[index + m_index]; }
 	const T& operator[](Size index) const { return m_array[index + m_index]; }
 
@@ -336,7 +439,7 @@ public:
 
 	SharedArrayRef<T> ToArray() const requires CopyConstructible<T>
 	{
-		T* array = (T*)malloc(m_array.Count().ToRawValue() * sizeof(T));
+		T* array = (T*)malloc(m_count.ToRawValue() * sizeof(T));
 
 		for(Size i = 0U; i < m_count; i++)
 			new(array + i.ToRawValue()) T(m_array[i + m_index]);
@@ -5,6 +5,10 @@
 #include "../Reflection.hpp"
 
 class DynamicBufferRef;
+class DynamicBufferSpan;
+
+template<typename T>
+class Buffer;
 
 class DynamicBuffer
 {
@@ -90,7 +94,7 @@ private:
 
 		if(refCount == 0U)
 		{
-			delete[] m_address;
+			free(m_address);
 			delete   m_refCount;
 		}
 	}
@@ -104,11 +108,11 @@ public:
 
 	Size Count() const { return m_count; }
 
-	      DynamicBufferSpan AsSpan()       { return *this; }
-	const DynamicBufferSpan AsSpan() const { return *this; }
+	      DynamicBufferSpan AsSpan();
+	const DynamicBufferSpan AsSpan() const;
 
-		  DynamicBufferSpan AsSpan(Size index, Size count)       { return DynamicBufferSpan(*this, index, count); }
-	const DynamicBufferSpan AsSpan(Size index, Size count) const { return DynamicBufferSpan(*this, index, count); }
+		  DynamicBufferSpan AsSpan(Size index, Size count);
+	const DynamicBufferSpan AsSpan(Size index, Size count) const;
 
 	friend class DynamicBufferSpan;
 };
@@ -130,7 +134,7 @@ private:
 
 		if(refCount == 0U)
 		{
-			delete[] m_address;
+			free(m_address);
 			delete   m_refCount;
 		}
 	}
@@ -180,6 +184,12 @@ public:
 
 	DynamicBufferSpan Slice(Size index, Size count) const { return DynamicBufferSpan(m_buffer, index + m_index, count); }
 
+	const TypeInfo& GetElementType() const { return m_buffer.GetElementType(); }
+
+	Size GetByteCount() const { return m_count * m_buffer.GetElementType().GetSize(); }
+
+	void* ToUnsafePointer() const { return (UInt8*)m_buffer.m_address + (m_index * m_buffer.GetElementType().GetSize()).ToRawValue(); }
+
 	void CopyTo(DynamicBufferSpan destination) const 
 	{ 
 		Size typeSize = m_buffer.GetElementType().GetSize();
@@ -196,6 +206,12 @@ public:
 	}
 };
 
+inline       DynamicBufferSpan DynamicBufferRef::AsSpan()       { return *this; }
+inline const DynamicBufferSpan DynamicBufferRef::AsSpan() const { return *this; }
+
+inline       DynamicBufferSpan DynamicBufferRef::AsSpan(Size index, Size count)       { return DynamicBufferSpan(*this, index, count); }
+inline const DynamicBufferSpan DynamicBufferRef::AsSpan(Size index, Size count) const { return DynamicBufferSpan(*this, index, count); }
+
 template<typename T>
 class BufferSpan
 {
@@ -213,7 +229,9 @@ public:
 
 	BufferSpan<T> Slice(Size index, Size count) const { return BufferSpan<T>(m_buffer, index + m_index, count); }
 
-	void Fill(UInt8 value) requires SameAs<T, UInt8> { memset(m_buffer.m_address, value.ToRawValue(), m_count.ToRawValue()) }
+	T* ToUnsafePointer() const { return m_buffer.m_address + m_index.ToRawValue(); }
+
+	void Fill(UInt8 value) requires SameAs<T, UInt8> { memset(m_buffer.m_address, value.ToRawValue(), m_count.ToRawValue()); }
 
 	void Fill(const T& value)
 	{
@@ -1,3 +1,93 @@
 #include "Reflection.hpp"
 
-Size TypeInfo::s_lastID(0U);
\ No newline at end of file
+#include <mutex>
+
+Size TypeInfo::s_lastID(0U);
+
+struct RegisteredType
+{
+	const TypeInfo* type;
+	String          name;
+	RegisteredType* next;
+};
+
+// Never destroyed, so streams can still be read and written while the program exits.
+class TypeRegistry
+{
+public:
+	std::mutex      mutex;
+	RegisteredType* first;
+
+	TypeRegistry() : first(nullptr)
+	{
+		Add(Reflect::GetType<UInt8>(),     "UInt8"_s);
+		Add(Reflect::GetType<UInt16>(),    "UInt16"_s);
+		Add(Reflect::GetType<UInt32>(),    "UInt32"_s);
+		Add(Reflect::GetType<UInt64>(),    "UInt64"_s);
+		Add(Reflect::GetType<SInt8>(),     "SInt8"_s);
+		Add(Reflect::GetType<SInt16>(),    "SInt16"_s);
+		Add(Reflect::GetType<SInt32>(),    "SInt32"_s);
+		Add(Reflect::GetType<SInt64>(),    "SInt64"_s);
+		Add(Reflect::GetType<Float32>(),   "Float32"_s);
+		Add(Reflect::GetType<Float64>(),   "Float64"_s);
+		Add(Reflect::GetType<Boolean>(),   "Boolean"_s);
+		Add(Reflect::GetType<Character>(), "Character"_s);
+		Add(Reflect::GetType<String>(),    "String"_s);
+	}
+
+	void Add(const TypeInfo& type, const String& name) { first = new RegisteredType { &type, name, first }; }
+};
+
+static TypeRegistry& GetRegistry()
+{
+	static TypeRegistry* registry = new TypeRegistry();
+	return *registry;
+}
+
+void Reflect::Register(const TypeInfo& type, const String& name)
+{
+	TypeRegistry& registry = GetRegistry();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+
+	for(RegisteredType* entry = registry.first; entry; entry = entry->next)
+	{
+		if(entry->type == &type && entry->name == name)
+			return;
+
+		if(entry->type == &type)
+			Exception(Format("Type {} is already registered as {}.", type, entry->name)).Throw();
+
+		if(entry->name == name)
+			Exception(Format("The name {} is already registered for type {}.", name, *entry->type)).Throw();
+	}
+
+	registry.Add(type, name);
+}
+
+const TypeInfo* Reflect::FindType(StringView name)
+{
+	TypeRegistry& registry = GetRegistry();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+
+	for(RegisteredType* entry = registry.first; entry; entry = entry->next)
+	{
+		if(entry->name == name)
+			return entry->type;
+	}
+
+	return nullptr;
+}
+
+const String* Reflect::FindName(const TypeInfo& type)
+{
+	TypeRegistry& registry = GetRegistry();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+
+	for(RegisteredType* entry = registry.first; entry; entry = entry->next)
+	{
+		if(entry->type == &type)
+			return &entry->name;
+	}
+
+	return nullptr;
+}
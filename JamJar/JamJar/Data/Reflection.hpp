@@ -2,6 +2,7 @@
 
 #include "../Exception.hpp"
 #include "../Delegate.hpp"
+#include "Serialization.hpp"
 
 #include <typeinfo>
 
@@ -18,6 +19,9 @@ using Comparer = Function<Boolean, const void*, const void*>;
 
 using Hasher = Function<HashCode, const void*>;
 
+using Serializer   = Function<void, const void*, BinaryWriter&>;
+using Deserializer = Function<void, BinaryReader&, void*>;
+
 class TypeInfo
 {
 private:
@@ -25,8 +29,10 @@ private:
 
 	Size m_ID;
 
-	String m_name;
-	Size   m_size;
+	String  m_name;
+	Size    m_size;
+	Size    m_alignment;
+	Boolean m_blockSerializable;
 
 	DefaultConstructor m_defaultConstructor;
 	CopyConstructor    m_copyConstructor;
@@ -51,6 +57,9 @@ private:
 
 	Hasher m_hasher;
 
+	Serializer   m_serializer;
+	Deserializer m_deserializer;
+
 	template<typename T>
 	class TypeStore
 	{
@@ -63,13 +72,13 @@ private:
 		static void Initialize(void* dest) { new(dest) T(); }
 
 		template<typename T>
-		static void Initialize(void* dest) { Exception("Type " + s_type + " is not default constructible.").Throw(); }
+		static void Initialize(void* dest) { Exception(Format("Type {} is not default constructible.", s_type)).Throw(); }
 
 		template<CopyConstructible T>
 		static void Copy(const void* source, void* dest) { new(dest) T(*(const T*)source); }
 
 		template<typename T>
-		static void Copy(const void* source, void* dest) { Exception("Type " + s_type + " is not copy constructible.").Throw(); }
+		static void Copy(const void* source, void* dest) { Exception(Format("Type {} is not copy constructible.", s_type)).Throw(); }
 
 		template<MoveConstructible T>
 		static void Move(const void* source, void* dest) { new(dest) T(std::move(*(const T*)source)); }
@@ -91,7 +100,7 @@ private:
 		}
 
 		template<typename T>
-		static void CopyAssign(const void* source, void* dest) { Exception("Type " + s_type + " is not copy assignable.").Throw(); }
+		static void CopyAssign(const void* source, void* dest) { Exception(Format("Type {} is not copy assignable.", s_type)).Throw(); }
 
 		template<MoveAssignable T>
 		static void MoveAssign(const void* source, void* dest)
@@ -149,19 +158,19 @@ private:
 		}
 
 		template<typename T>
-		static void Add(void* dest, const void* left, const void* right)      { Exception("Type " + s_type + " is not addable.").Throw(); }
+		static void Add(void* dest, const void* left, const void* right)      { Exception(Format("Type {} is not addable.", s_type)).Throw(); }
 
 		template<typename T>
-		static void Subtract(void* dest, const void* left, const void* right) { Exception("Type " + s_type + " is not subtractable.").Throw(); }
+		static void Subtract(void* dest, const void* left, const void* right) { Exception(Format("Type {} is not subtractable.", s_type)).Throw(); }
 
 		template<typename T>
-		static void Multiply(void* dest, const void* left, const void* right) { Exception("Type " + s_type + " is not multiplicable.").Throw(); }
+		static void Multiply(void* dest, const void* left, const void* right) { Exception(Format("Type {} is not multiplicable.", s_type)).Throw(); }
 
 		template<typename T>
-		static void Divide(void* dest, const void* left, const void* right)   { Exception("Type " + s_type + " is not divisible.").Throw(); }
+		static void Divide(void* dest, const void* left, const void* right)   { Exception(Format("Type {} is not divisible.", s_type)).Throw(); }
 
 		template<typename T>
-		static void Modulate(void* dest, const void* left, const void* right) { Exception("Type " + s_type + " is not modable.").Throw(); }
+		static void Modulate(void* dest, const void* left, const void* right) { Exception(Format("Type {} is not modable.", s_type)).Throw(); }
 
 		template<Comparable T>
 		static Boolean Smaller(const void* left, const void* right)
@@ -218,34 +227,48 @@ private:
 		}
 
 		template<typename T>
-		static Boolean Smaller(const void* left, const void* right) { Exception("Type " + s_type + " is not comparable.").Throw(); return false; }
+		static Boolean Smaller(const void* left, const void* right) { Exception(Format("Type {} is not comparable.", s_type)).Throw(); return false; }
 
 		template<typename T>
-		static Boolean SmallerOrEqual(const void* left, const void* right) { Exception("Type " + s_type + " is not comparable.").Throw(); return false; }
+		static Boolean SmallerOrEqual(const void* left, const void* right) { Exception(Format("Type {} is not comparable.", s_type)).Throw(); return false; }
 
 		template<typename T>
-		static Boolean Greater(const void* left, const void* right) { Exception("Type " + s_type + " is not comparable.").Throw(); return false; }
+		static Boolean Greater(const void* left, const void* right) { Exception(Format("Type {} is not comparable.", s_type)).Throw(); return false; }
 
 		template<typename T>
-		static Boolean GreaterOrEqual(const void* left, const void* right) { Exception("Type " + s_type + " is not comparable.").Throw(); return false; }
+		static Boolean GreaterOrEqual(const void* left, const void* right) { Exception(Format("Type {} is not comparable.", s_type)).Throw(); return false; }
 
 		template<typename T>
-		static Boolean Equal(const void* left, const void* right) { Exception("Type " + s_type + " is not equatable.").Throw(); return false; }
+		static Boolean Equal(const void* left, const void* right) { Exception(Format("Type {} is not equatable.", s_type)).Throw(); return false; }
 
 		template<typename T>
-		static Boolean NotEqual(const void* left, const void* right) { Exception("Type " + s_type + " is not equatable.").Throw(); return false; }
+		static Boolean NotEqual(const void* left, const void* right) { Exception(Format("Type {} is not equatable.", s_type)).Throw(); return false; }
 
 		template<Hashable T>
 		static HashCode GetHashCode(const void* value) { return ((T*)value)->GetHashCode(); }
 
 		template<typename T>
-		static HashCode GetHashCode(const void* value) { Exception("Type " + s_type + " is not hashable.").Throw(); return HashCode(); }
+		static HashCode GetHashCode(const void* value) { Exception(Format("Type {} is not hashable.", s_type)).Throw(); return HashCode(); }
+
+		template<Serializable T>
+		static void Serialize(const void* value, BinaryWriter& writer) { Serialization<T>::Write(writer, *(const T*)value); }
+
+		template<typename T>
+		static void Serialize(const void*, BinaryWriter&) { Exception(Format("Type {} is not serializable.", s_type)).Throw(); }
+
+		template<Serializable T>
+		static void Deserialize(BinaryReader& reader, void* dest) { new(dest) T(Serialization<T>::Read(reader)); }
+
+		template<typename T>
+		static void Deserialize(BinaryReader&, void*) { Exception(Format("Type {} is not serializable.", s_type)).Throw(); }
 	};
 public:
 	TypeInfo(
 		Size ID,
 		const String& name,
 		Size size,
+		Size alignment,
+		Boolean blockSerializable,
 		DefaultConstructor defaultConstructor,
 		CopyConstructor copyConstructor,
 		CopyConstructor moveConstructor,
@@ -263,11 +286,15 @@ public:
 		Comparer greaterOrEqual,
 		Comparer equator,
 		Comparer notEquator,
-		Hasher hasher) :
+		Hasher hasher,
+		Serializer serializer,
+		Deserializer deserializer) :
 
 		m_ID(ID),
 		m_name(name),
 		m_size(size),
+		m_alignment(alignment),
+		m_blockSerializable(blockSerializable),
 		m_defaultConstructor(defaultConstructor),
 		m_copyConstructor(copyConstructor),
 		m_moveConstructor(moveConstructor),
@@ -285,10 +312,16 @@ public:
 		m_greaterOrEqual(greaterOrEqual),
 		m_equator(equator),
 		m_notEquator(notEquator),
-		m_hasher(hasher) {}
+		m_hasher(hasher),
+		m_serializer(serializer),
+		m_deserializer(deserializer) {}
 
-	const String& GetName() const { return m_name; }
-	      Size    GetSize() const { return m_size; }
+	const String& GetName()      const { return m_name;      }
+	      Size    GetSize()      const { return m_size;      }
+	      Size    GetAlignment() const { return m_alignment; }
+
+	// Whether arrays of the type are serialized as raw blocks (see BlockSerializable).
+	Boolean IsBlockSerializable() const { return m_blockSerializable; }
 
 	DefaultConstructor GetDefaultConstructor() const { return m_defaultConstructor; }
 	CopyConstructor    GetCopyConstructor()    const { return m_copyConstructor;    }
@@ -313,6 +346,9 @@ public:
 
 	Hasher GetHasher() const { return m_hasher; }
 
+	Serializer   GetSerializer()   const { return m_serializer;   }
+	Deserializer GetDeserializer() const { return m_deserializer; }
+
 	friend Boolean operator==(const TypeInfo& left, const TypeInfo& right) { return left.m_ID == right.m_ID; }
 	friend Boolean operator!=(const TypeInfo& left, const TypeInfo& right) { return left.m_ID != right.m_ID; }
 
@@ -324,7 +360,7 @@ public:
 };
 
 template<typename T>
-TypeInfo TypeInfo::TypeStore<T>::s_type(s_lastID++, typeid(T).name(), sizeof(T),
+TypeInfo TypeInfo::TypeStore<T>::s_type(s_lastID++, typeid(T).name(), sizeof(T), alignof(T), BlockSerializable<T>,
 	Initialize<T>,
 	Copy<T>,
 	Move<T>,
@@ -342,7 +378,9 @@ TypeInfo TypeInfo::TypeStore<T>::s_type(s_lastID++, typeid(T).name(), sizeof(T),
 	GreaterOrEqual<T>,
 	Equal<T>, 
 	NotEqual<T>,
-	GetHashCode<T>);
+	GetHashCode<T>,
+	Serialize<T>,
+	Deserialize<T>);
 
 
 class Reflect
@@ -350,11 +388,25 @@ class Reflect
 public:
 	template<typename T>
 	static const TypeInfo& GetType() { return TypeInfo::TypeStore<T>::s_type; }
+
+	// Names a type in serialized streams, which is how a Dynamic or DynamicArray records its type. The name must be unique
+	// and stay the same from build to build, and the reading program must register it too. The numeric wrappers,
+	// Boolean, Character and String are registered under their own names.
+	template<typename T>
+	static void Register(const String& name) { Register(GetType<T>(), name); }
+
+	static void Register(const TypeInfo& type, const String& name);
+
+	// The type registered under name, or null.
+	static const TypeInfo* FindType(StringView name);
+
+	// The name type was registered under, or null.
+	static const String* FindName(const TypeInfo& type);
 };
 
 class InvalidCastException : public Exception
 {
 public:
 	InvalidCastException(const TypeInfo& sourceType, const TypeInfo& targetType) : 
-		Exception("Cannot cast from type: '" + sourceType.GetName() + "' to type '" + targetType.GetName() + "'.") {}
+		Exception(Format("Cannot cast from type: '{}' to type '{}'.", sourceType.GetName(), targetType.GetName())) {}
 };
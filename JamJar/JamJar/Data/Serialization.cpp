@@ -0,0 +1,222 @@
+#include "Serialization.hpp"
+#include "Reflection.hpp"
+#include "Memory/Buffer.hpp"
+#include "../Encoding.hpp"
+
+static const size_t InitialCapacity  = 256U;
+static const size_t MaximumVarLength = 10U;
+
+// Encodes UTF-16/32 to UTF-8, replacing unpaired surrogates with U+FFFD. A null destination only measures.
+static size_t EncodeUTF8(const wchar_t* source, size_t length, char* destination)
+{
+	size_t count = 0U;
+	while(length > 0U)
+	{
+		EncodingResult result = Encoding::WideToUTF8(source, length, destination ? destination + count : nullptr);
+		count += result.GetCount().ToRawValue();
+
+		if(result.IsValid())
+			break;
+
+		if(destination)
+			memcpy(destination + count, "\xEF\xBF\xBD", 3U);
+
+		count += 3U;
+
+		size_t consumed = result.GetPosition().ToRawValue() + 1U;
+		source += consumed;
+		length -= consumed;
+	}
+
+	return count;
+}
+
+BinaryWriter::BinaryWriter() : m_data((unsigned char*)malloc(InitialCapacity)), m_count(0U), m_capacity(InitialCapacity), m_types(nullptr), m_typeCount(0U) {}
+
+BinaryWriter::~BinaryWriter()
+{
+	free(m_data);
+	free(m_types);
+}
+
+SharedBufferRef<UInt8> BinaryWriter::ToBuffer() const
+{
+	Buffer<UInt8> buffer((Size(m_count)));
+
+	SharedBufferRef<UInt8> result(buffer);
+	memcpy(result.AsSpan().ToUnsafePointer(), m_data, m_count);
+	return result;
+}
+
+void BinaryWriter::Clear()
+{
+	m_count     = 0U;
+	m_typeCount = 0U;
+}
+
+unsigned char* BinaryWriter::Extend(Size count)
+{
+	size_t required = m_count + count.ToRawValue();
+	if(required > m_capacity)
+	{
+		m_capacity = m_capacity * 2U > required ? m_capacity * 2U : required;
+		m_data     = (unsigned char*)realloc(m_data, m_capacity);
+	}
+
+	unsigned char* result = m_data + m_count;
+	m_count = required;
+	return result;
+}
+
+void BinaryWriter::WriteVarUInt(UInt64 value)
+{
+	uint64_t       raw  = value.ToRawValue();
+	unsigned char* dest = Extend(MaximumVarLength);
+
+	size_t count = 0U;
+	while(raw >= 0x80U)
+	{
+		dest[count++] = (unsigned char)(raw | 0x80U);
+		raw >>= 7U;
+	}
+
+	dest[count++] = (unsigned char)raw;
+	m_count -= MaximumVarLength - count;
+}
+
+void BinaryWriter::WriteVarSInt(SInt64 value)
+{
+	int64_t raw = value.ToRawValue();
+	WriteVarUInt((uint64_t(raw) << 1U) ^ uint64_t(raw >> 63));
+}
+
+void BinaryWriter::Align(Size alignment)
+{
+	size_t padding = (0U - m_count) & (alignment.ToRawValue() - 1U);
+	if(padding > 0U)
+		memset(Extend(padding), 0, padding);
+}
+
+void BinaryWriter::WriteType(const TypeInfo& type)
+{
+	for(size_t i = 0U; i < m_typeCount; i++)
+	{
+		if(m_types[i] == &type)
+		{
+			WriteVarUInt(i + 1U);
+			return;
+		}
+	}
+
+	const String* name = Reflect::FindName(type);
+	if(!name)
+		Exception(Format("Type {} has no serialized name; give it one with Reflect::Register.", type)).Throw();
+
+	m_types = (const TypeInfo**)realloc(m_types, (m_typeCount + 1U) * sizeof(const TypeInfo*));
+	m_types[m_typeCount++] = &type;
+
+	WriteVarUInt(0U);
+	Serialization<String>::Write(*this, *name);
+}
+
+BinaryReader::BinaryReader(const void* data, Size count) :
+	m_data((const unsigned char*)data), m_count(count.ToRawValue()), m_position(0U), m_types(nullptr), m_typeCount(0U) {}
+
+BinaryReader::BinaryReader(const BufferSpan<UInt8>& data) : BinaryReader(data.ToUnsafePointer(), data.Count()) {}
+
+BinaryReader::~BinaryReader() { free(m_types); }
+
+void BinaryReader::ThrowMalformed() { SerializationException().Throw(); }
+
+void BinaryReader::ThrowMisaligned() { Exception("The serialized data is not aligned for reading in place."_s).Throw(); }
+
+UInt64 BinaryReader::ReadLongVarUInt()
+{
+	const unsigned char* source    = m_data + m_position;
+	size_t               available = m_count - m_position;
+	size_t               limit     = available < MaximumVarLength ? available : MaximumVarLength;
+
+	uint64_t result = 0U;
+	for(size_t i = 0U; i < limit; i++)
+	{
+		unsigned char byte = source[i];
+
+		// The tenth byte only has room for the top bit.
+		if(i == MaximumVarLength - 1U && byte > 1U)
+			break;
+
+		result |= uint64_t(byte & 0x7FU) << (7U * i);
+		if(byte < 0x80U)
+		{
+			m_position += i + 1U;
+			return result;
+		}
+	}
+
+	ThrowMalformed();
+	return 0U;
+}
+
+void BinaryReader::Align(Size alignment)
+{
+	size_t padding = (0U - m_position) & (alignment.ToRawValue() - 1U);
+	ReadBytes(padding);
+}
+
+const TypeInfo& BinaryReader::ReadType()
+{
+	size_t index = ReadVarUInt().ToRawValue();
+	if(index > 0U)
+	{
+		if(index > m_typeCount)
+			ThrowMalformed();
+
+		return *m_types[index - 1U];
+	}
+
+	String name = Serialization<String>::Read(*this);
+
+	const TypeInfo* type = Reflect::FindType(name);
+	if(!type)
+		Exception(Format("The serialized type {} is not registered in this program.", name)).Throw();
+
+	m_types = (const TypeInfo**)realloc(m_types, (m_typeCount + 1U) * sizeof(const TypeInfo*));
+	m_types[m_typeCount++] = type;
+	return *type;
+}
+
+Character Serialization<Character>::Read(BinaryReader& reader)
+{
+	uint64_t value = reader.ReadVarUInt().ToRawValue();
+	if(value > uint64_t(std::numeric_limits<wchar_t>::max()))
+		BinaryReader::ThrowMalformed();
+
+	return wchar_t(value);
+}
+
+void Serialization<String>::Write(BinaryWriter& writer, const String& value)
+{
+	const wchar_t* source = (const wchar_t*)value.AsView().ToUnsafePointer();
+	size_t         length = value.Length().ToRawValue();
+
+	size_t count = EncodeUTF8(source, length, nullptr);
+	writer.WriteVarUInt(count);
+	EncodeUTF8(source, length, (char*)writer.Extend(count));
+}
+
+String Serialization<String>::Read(BinaryReader& reader)
+{
+	Size length = reader.ReadVarUInt();
+	if(length == 0U)
+		return String();
+
+	const char* bytes = (const char*)reader.ReadBytes(length);
+
+	EncodingResult measured = Encoding::UTF8ToWide(bytes, length.ToRawValue(), nullptr);
+	if(!measured.IsValid())
+		BinaryReader::ThrowMalformed();
+
+	SharedArrayRef<Character> chars = HeapArray<Character>(measured.GetCount());
+	Encoding::UTF8ToWide(bytes, length.ToRawValue(), (wchar_t*)chars.ToUnsafePointer());
+	return String(chars.AsSpan());
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "../String.hpp"
+
+// Arrays of numbers are written and read as raw blocks, which relies on the wrappers staying trivially copyable.
+static_assert(TriviallyCopyable<UInt64> && TriviallyCopyable<SInt64> && TriviallyCopyable<Float64>);
+
+class TypeInfo;
+
+template<typename T>
+class BufferSpan;
+
+template<typename T>
+class SharedBufferRef;
+
+class BinaryWriter;
+class BinaryReader;
+
+// How a type is written and read. Specializations provide
+//     static void Write(BinaryWriter& writer, const T& value);
+//     static T    Read (BinaryReader& reader);
+// and must be declared before the type is first passed to Reflect::GetType, which records whether it is serializable.
+template<typename T>
+struct Serialization;
+
+template<typename T>
+concept Serializable = requires(BinaryWriter& writer, BinaryReader& reader, const T& value)
+{
+	Serialization<T>::Write(writer, value);
+	{ Serialization<T>::Read(reader) } -> SameAs<T>;
+};
+
+// Arrays of these are written as one raw block, which can be read in place. A specialization opts in with
+//     static constexpr bool Block = true;
+// when a value's bytes are all there is to it and mean the same on every target, as for the numeric wrappers.
+template<typename T>
+concept BlockSerializable = Serializable<T> && TriviallyCopyable<T> && requires { requires Serialization<T>::Block; };
+
+// Builds a compact binary stream. Integers are written as variable-length (LEB128) values, signed ones zig-zag encoded
+// first; arrays of BlockSerializable elements are written as one aligned block, so they can be read back in place.
+// Floating point values and blocks use the byte order of the machine, which is little-endian on every target.
+class BinaryWriter
+{
+private:
+	unsigned char* m_data;
+	size_t         m_count;
+	size_t         m_capacity;
+
+	const TypeInfo** m_types;
+	size_t           m_typeCount;
+public:
+	BinaryWriter();
+
+	BinaryWriter(const BinaryWriter& other) = delete;
+
+	~BinaryWriter();
+
+	Size Count() const { return m_count; }
+
+	const void* ToUnsafePointer() const { return m_data; }
+
+	SharedBufferRef<UInt8> ToBuffer() const;
+
+	void Clear();
+
+	// Returns space for count more bytes, which the caller must fill.
+	unsigned char* Extend(Size count);
+
+	void WriteVarUInt(UInt64 value);
+	void WriteVarSInt(SInt64 value);
+
+	void WriteBytes(const void* data, Size count)
+	{
+		if(count > 0U)
+			memcpy(Extend(count), data, count.ToRawValue());
+	}
+
+	// Pads with zeros up to a multiple of alignment (a power of two) from the start of the stream.
+	void Align(Size alignment);
+
+	// A type is written by its registered name the first time and by index afterwards (see Reflect::Register).
+	void WriteType(const TypeInfo& type);
+
+	template<Serializable T>
+	void Write(const T& value) { Serialization<T>::Write(*this, value); }
+
+	template<Serializable T>
+	void WriteArray(const T* values, Size count)
+	{
+		WriteVarUInt(count);
+
+		if constexpr(BlockSerializable<T>)
+		{
+			Align(alignof(T));
+			WriteBytes(values, count * sizeof(T));
+		}
+		else
+		{
+			for(Size i = 0U; i < count; i++)
+				Serialization<T>::Write(*this, values[i.ToRawValue()]);
+		}
+	}
+};
+
+// Reads a stream made by BinaryWriter straight from memory, such as a mapped file. Blocks are not copied: ReadBytes and
+// ReadView point into the source, which must outlive them and be aligned to at least 16 bytes. Malformed input throws
+// a SerializationException.
+class BinaryReader
+{
+private:
+	const unsigned char* m_data;
+	size_t               m_count;
+	size_t               m_position;
+
+	const TypeInfo** m_types;
+	size_t           m_typeCount;
+
+	UInt64 ReadLongVarUInt();
+public:
+	BinaryReader(const void* data, Size count);
+	BinaryReader(const BufferSpan<UInt8>& data);
+
+	BinaryReader(const BinaryReader& other) = delete;
+
+	~BinaryReader();
+
+	Size GetPosition()  const { return m_position; }
+	Size GetRemaining() const { return m_count - m_position; }
+
+	Boolean IsAtEnd() const { return m_position == m_count; }
+
+	// Defined here, as is the one-byte case of ReadVarUInt, because a record of small fields reads each one separately.
+	const void* ReadBytes(Size count)
+	{
+		if(count > m_count - m_position)
+		{
+			ThrowMalformed();
+			return nullptr;
+		}
+
+		const void* result = m_data + m_position;
+		m_position += count.ToRawValue();
+		return result;
+	}
+
+	UInt64 ReadVarUInt()
+	{
+		if(m_position < m_count && m_data[m_position] < 0x80U)
+			return m_data[m_position++];
+
+		return ReadLongVarUInt();
+	}
+
+	SInt64 ReadVarSInt()
+	{
+		uint64_t raw = ReadVarUInt().ToRawValue();
+		return int64_t((raw >> 1U) ^ (0U - (raw & 1U)));
+	}
+
+	void Align(Size alignment);
+
+	const TypeInfo& ReadType();
+
+	template<Serializable T>
+	T Read() { return Serialization<T>::Read(*this); }
+
+	// Reads an array written by WriteArray without copying it.
+	template<BlockSerializable T>
+	const ArrayRef<T> ReadView()
+	{
+		Size count = ReadVarUInt();
+		if(count > GetRemaining() / sizeof(T))
+			ThrowMalformed();
+
+		Align(alignof(T));
+
+		const void* data = ReadBytes(count * sizeof(T));
+		if((uintptr_t)data % alignof(T) != 0U)
+			ThrowMisaligned();
+
+		return ArrayRef<T>((T*)data, count);
+	}
+
+	static void ThrowMalformed();
+	static void ThrowMisaligned();
+};
+
+template<std::unsigned_integral T>
+struct Serialization<UnsignedInteger<T>>
+{
+	static constexpr bool Block = true;
+
+	static void Write(BinaryWriter& writer, const UnsignedInteger<T>& value)
+	{
+		if constexpr(sizeof(T) == 1U)
+			*writer.Extend(1U) = value.ToRawValue();
+		else
+			writer.WriteVarUInt(value);
+	}
+
+	static UnsignedInteger<T> Read(BinaryReader& reader)
+	{
+		if constexpr(sizeof(T) == 1U)
+			return *(const unsigned char*)reader.ReadBytes(1U);
+		else
+		{
+			uint64_t value = reader.ReadVarUInt().ToRawValue();
+			if(value > std::numeric_limits<T>::max())
+				BinaryReader::ThrowMalformed();
+
+			return UnsignedInteger<T>(T(value));
+		}
+	}
+};
+
+template<std::signed_integral T>
+struct Serialization<SignedInteger<T>>
+{
+	static constexpr bool Block = true;
+
+	static void Write(BinaryWriter& writer, const SignedInteger<T>& value)
+	{
+		if constexpr(sizeof(T) == 1U)
+			*writer.Extend(1U) = (unsigned char)value.ToRawValue();
+		else
+			writer.WriteVarSInt(value);
+	}
+
+	static SignedInteger<T> Read(BinaryReader& reader)
+	{
+		if constexpr(sizeof(T) == 1U)
+			return SignedInteger<T>(T(*(const signed char*)reader.ReadBytes(1U)));
+		else
+		{
+			int64_t value = reader.ReadVarSInt().ToRawValue();
+			if(value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max())
+				BinaryReader::ThrowMalformed();
+
+			return SignedInteger<T>(T(value));
+		}
+	}
+};
+
+template<std::floating_point T>
+struct Serialization<Float<T>>
+{
+	static constexpr bool Block = true;
+
+	static void Write(BinaryWriter& writer, const Float<T>& value)
+	{
+		T raw = value.ToRawValue();
+		writer.WriteBytes(&raw, sizeof(T));
+	}
+
+	static Float<T> Read(BinaryReader& reader)
+	{
+		T raw;
+		memcpy(&raw, reader.ReadBytes(sizeof(T)), sizeof(T));
+		return raw;
+	}
+};
+
+template<>
+struct Serialization<Boolean>
+{
+	static void Write(BinaryWriter& writer, const Boolean& value) { *writer.Extend(1U) = value ? 1U : 0U; }
+
+	static Boolean Read(BinaryReader& reader)
+	{
+		unsigned char value = *(const unsigned char*)reader.ReadBytes(1U);
+		if(value > 1U)
+			BinaryReader::ThrowMalformed();
+
+		return value == 1U;
+	}
+};
+
+template<>
+struct Serialization<Character>
+{
+	static void Write(BinaryWriter& writer, const Character& value) { writer.WriteVarUInt(uint64_t(value.ToRawValue())); }
+	static Character Read(BinaryReader& reader);
+};
+
+// Strings are stored as UTF-8, so they are portable between 16 and 32-bit wchar_t and usually half the size.
+template<>
+struct Serialization<String>
+{
+	static void   Write(BinaryWriter& writer, const String& value);
+	static String Read(BinaryReader& reader);
+};
+
+template<Serializable T>
+struct Serialization<HeapArray<T>>
+{
+	static void Write(BinaryWriter& writer, const HeapArray<T>& value)
+	{
+		writer.WriteArray(value.Count() > 0U ? &value[0U] : (const T*)nullptr, value.Count());
+	}
+
+	static HeapArray<T> Read(BinaryReader& reader) requires DefaultConstructible<T> && CopyAssignable<T>
+	{
+		// Every element takes at least one byte, which bounds the allocation by the size of the input.
+		Size count = reader.ReadVarUInt();
+		if(count > reader.GetRemaining() / (BlockSerializable<T> ? sizeof(T) : 1U))
+			BinaryReader::ThrowMalformed();
+
+		HeapArray<T> result(count);
+
+		if constexpr(BlockSerializable<T>)
+		{
+			reader.Align(alignof(T));
+			if(count > 0U)
+				memcpy(&result[0U], reader.ReadBytes(count * sizeof(T)), (count * sizeof(T)).ToRawValue());
+		}
+		else
+		{
+			for(Size i = 0U; i < count; i++)
+				result[i] = Serialization<T>::Read(reader);
+		}
+
+		return result;
+	}
+};
@@ -1,5 +1,46 @@
 #include "Dynamic.hpp"
 
+// Storage for elements a deserializer is building. Until it is released, a throw frees it after destroying the elements
+// that were finished.
+class PendingElements
+{
+private:
+	const TypeInfo& m_type;
+	void*           m_address;
+	Size            m_count;
+public:
+	PendingElements(const TypeInfo& type, Size capacity) : m_type(type), m_address(malloc((type.GetSize() * capacity).ToRawValue())), m_count(0U) {}
+
+	PendingElements(const PendingElements& other) = delete;
+
+	~PendingElements()
+	{
+		if(!m_address)
+			return;
+
+		for(Size i = 0U; i < m_count; i++)
+			m_type.GetDestructor()(GetAddress(i));
+
+		free(m_address);
+	}
+
+	void* GetAddress(Size index) const { return (UInt8*)m_address + (m_type.GetSize() * index).ToRawValue(); }
+
+	// Reads the next element in place.
+	void Read(BinaryReader& reader)
+	{
+		m_type.GetDeserializer()(reader, GetAddress(m_count));
+		m_count++;
+	}
+
+	void* Release()
+	{
+		void* address = m_address;
+		m_address = nullptr;
+		return address;
+	}
+};
+
 Dynamic::Dynamic(const Dynamic& other) : m_address(malloc(other.m_type.GetSize().ToRawValue())), m_type(other.m_type)
 {
 	m_type.GetCopyConstructor()(other.m_address, m_address);
@@ -15,3 +56,65 @@ Dynamic::~Dynamic()
 	m_type.GetDestructor()(m_address);
 	free(m_address);
 }
+
+void Serialization<Dynamic>::Write(BinaryWriter& writer, const Dynamic& value)
+{
+	writer.WriteType(value.m_type);
+	value.m_type.GetSerializer()(value.m_address, writer);
+}
+
+Dynamic Serialization<Dynamic>::Read(BinaryReader& reader)
+{
+	const TypeInfo& type = reader.ReadType();
+
+	PendingElements value(type, 1U);
+	value.Read(reader);
+	return Dynamic(value.Release(), type);
+}
+
+void Serialization<DynamicArray>::Write(BinaryWriter& writer, const DynamicArray& value)
+{
+	const TypeInfo& type = value.m_elementType;
+
+	writer.WriteType(type);
+	writer.WriteVarUInt(value.m_count);
+
+	if(type.IsBlockSerializable())
+	{
+		writer.Align(type.GetAlignment());
+		writer.WriteBytes(value.m_address, type.GetSize() * value.m_count);
+		return;
+	}
+
+	for(Size i = 0U; i < value.m_count; i++)
+		type.GetSerializer()(value.GetAddress(i), writer);
+}
+
+DynamicArray Serialization<DynamicArray>::Read(BinaryReader& reader)
+{
+	const TypeInfo& type = reader.ReadType();
+
+	// Every element takes at least one byte, which bounds the allocation by the size of the input.
+	Size count = reader.ReadVarUInt();
+	if(count > reader.GetRemaining() / (type.IsBlockSerializable() ? type.GetSize() : Size(1U)))
+		BinaryReader::ThrowMalformed();
+
+	PendingElements elements(type, count);
+
+	if(type.IsBlockSerializable())
+	{
+		reader.Align(type.GetAlignment());
+		if(count > 0U)
+		{
+			Size size = type.GetSize() * count;
+			memcpy(elements.GetAddress(0U), reader.ReadBytes(size), size.ToRawValue());
+		}
+	}
+	else
+	{
+		for(Size i = 0U; i < count; i++)
+			elements.Read(reader);
+	}
+
+	return DynamicArray(elements.Release(), count, type);
+}
@@ -2,6 +2,15 @@
 
 #include "Data/Reflection.hpp"
 
+class Dynamic;
+class DynamicArray;
+
+template<>
+struct Serialization<Dynamic>;
+
+template<>
+struct Serialization<DynamicArray>;
+
 class NullType
 {
 
@@ -67,7 +76,7 @@ public:
 	{
 		if(left.m_type != right.m_type)
 		{
-			Exception("Addition can only be done between dynamics of the same type.").Throw();
+			Exception("Addition can only be done between dynamics of the same type."_s).Throw();
 			return NullType();
 		}
 
@@ -81,7 +90,7 @@ public:
 	{
 		if(left.m_type != right.m_type)
 		{
-			Exception("Subtraction can only be done between dynamics of the same type.").Throw();
+			Exception("Subtraction can only be done between dynamics of the same type."_s).Throw();
 			return NullType();
 		}
 
@@ -95,7 +104,7 @@ public:
 	{
 		if(left.m_type != right.m_type)
 		{
-			Exception("Multiplication can only be done between dynamics of the same type.").Throw();
+			Exception("Multiplication can only be done between dynamics of the same type."_s).Throw();
 			return NullType();
 		}
 
@@ -109,7 +118,7 @@ public:
 	{
 		if(left.m_type != right.m_type)
 		{
-			Exception("Division can only be done between dynamics of the same type.").Throw();
+			Exception("Division can only be done between dynamics of the same type."_s).Throw();
 			return NullType();
 		}
 
@@ -123,7 +132,7 @@ public:
 	{
 		if(left.m_type != right.m_type)
 		{
-			Exception("Modulus can only be done between dynamics of the same type").Throw();
+			Exception("Modulus can only be done between dynamics of the same type"_s).Throw();
 			return NullType();
 		}
 
@@ -137,7 +146,7 @@ public:
 	{
 		if(left.m_type != right.m_type)
 		{
-			Exception("Comparisons can only be done between dynamics of the same type").Throw();
+			Exception("Comparisons can only be done between dynamics of the same type"_s).Throw();
 			return false;
 		}
 
@@ -149,7 +158,7 @@ public:
 	{
 		if(left.m_type != right.m_type)
 		{
-			Exception("Comparisons can only be done between dynamics of the same type").Throw();
+			Exception("Comparisons can only be done between dynamics of the same type"_s).Throw();
 			return false;
 		}
 
@@ -161,7 +170,7 @@ public:
 	{
 		if (left.m_type != right.m_type)
 		{
-			Exception("Comparisons can only be done between dynamics of the same type").Throw();
+			Exception("Comparisons can only be done between dynamics of the same type"_s).Throw();
 			return false;
 		}
 
@@ -173,7 +182,7 @@ public:
 	{
 		if (left.m_type != right.m_type)
 		{
-			Exception("Comparisons can only be done between dynamics of the same type").Throw();
+			Exception("Comparisons can only be done between dynamics of the same type"_s).Throw();
 			return false;
 		}
 
@@ -202,6 +211,8 @@ public:
 	}
 
 	HashCode GetHashCode() const { return m_type.GetHasher()(m_address); }
+
+	friend struct Serialization<Dynamic>;
 };
 
 class SharedDynamicRef
@@ -334,6 +345,10 @@ private:
 	{
 		return (UInt8*)m_address + (m_elementType.GetSize() * index.ToRawValue()).ToRawValue();
 	}
+
+	// Takes ownership of count constructed elements.
+	DynamicArray(void* address, Size count, const TypeInfo& elementType) :
+		m_address(address), m_refCount(new Size(1U)), m_count(count), m_elementType(elementType) {}
 public:
 	DynamicArray(Size count, const TypeInfo& elementType) :
 		m_address(malloc((elementType.GetSize() * count).ToRawValue())), m_refCount(new Size(1U)), m_count(count), m_elementType(elementType)
@@ -386,6 +401,10 @@ public:
 
 	      DynamicRef operator[](Size index)       { return DynamicRef(GetAddress(index), m_elementType); }
 	const DynamicRef operator[](Size index) const { return DynamicRef(GetAddress(index), m_elementType); }
+
+	const TypeInfo& GetElementType() const { return m_elementType; }
+
+	friend struct Serialization<DynamicArray>;
 };
 
 template<typename T>
@@ -400,4 +419,19 @@ DynamicArray::DynamicArray(const ArrayRef<T>& other) :
 		T* dest = (T*)m_address + i.ToRawValue();
 		new(dest) T(other[i]);
 	}
-}
\ No newline at end of file
+}
+
+// A dynamic value is written as its type followed by the value, so the reader needs no prior knowledge of it.
+template<>
+struct Serialization<Dynamic>
+{
+	static void    Write(BinaryWriter& writer, const Dynamic& value);
+	static Dynamic Read(BinaryReader& reader);
+};
+
+template<>
+struct Serialization<DynamicArray>
+{
+	static void         Write(BinaryWriter& writer, const DynamicArray& value);
+	static DynamicArray Read(BinaryReader& reader);
+};
@@ -0,0 +1,291 @@
+#include "Encoding.hpp"
+
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENCODING_VECTORIZED
+#include <emmintrin.h>
+#endif
+
+using WideUnit = std::conditional_t<sizeof(wchar_t) == 2U, char16_t, char32_t>;
+
+static Boolean IsScalarValue(char32_t codePoint) { return codePoint < 0xD800U || (codePoint > 0xDFFFU && codePoint <= 0x10FFFFU); }
+
+// Each Decode reads one code point and returns the number of units it used, or 0 if the sequence is invalid.
+static size_t Decode(const char* source, size_t remaining, char32_t& codePoint)
+{
+	const unsigned char* bytes = (const unsigned char*)source;
+
+	unsigned char lead = bytes[0];
+	if(lead < 0x80U)
+	{
+		codePoint = lead;
+		return 1U;
+	}
+
+	size_t   count;
+	char32_t minimum;
+	if((lead & 0xE0U) == 0xC0U)
+	{
+		count     = 2U;
+		minimum   = 0x80U;
+		codePoint = lead & 0x1FU;
+	}
+	else if((lead & 0xF0U) == 0xE0U)
+	{
+		count     = 3U;
+		minimum   = 0x800U;
+		codePoint = lead & 0x0FU;
+	}
+	else if((lead & 0xF8U) == 0xF0U)
+	{
+		count     = 4U;
+		minimum   = 0x10000U;
+		codePoint = lead & 0x07U;
+	}
+	else
+		return 0U;
+
+	if(count > remaining)
+		return 0U;
+
+	for(size_t i = 1U; i < count; i++)
+	{
+		if((bytes[i] & 0xC0U) != 0x80U)
+			return 0U;
+
+		codePoint = (codePoint << 6U) | (bytes[i] & 0x3FU);
+	}
+
+	if(codePoint < minimum || !IsScalarValue(codePoint))
+		return 0U;
+
+	return count;
+}
+
+static size_t Decode(const char16_t* source, size_t remaining, char32_t& codePoint)
+{
+	char16_t first = source[0];
+	if(first < 0xD800U || first > 0xDFFFU)
+	{
+		codePoint = first;
+		return 1U;
+	}
+
+	if(first > 0xDBFFU || remaining < 2U || source[1] < 0xDC00U || source[1] > 0xDFFFU)
+		return 0U;
+
+	codePoint = 0x10000U + ((char32_t(first) - 0xD800U) << 10U) + (char32_t(source[1]) - 0xDC00U);
+	return 2U;
+}
+
+static size_t Decode(const char32_t* source, size_t, char32_t& codePoint)
+{
+	codePoint = source[0];
+	return IsScalarValue(codePoint) ? 1U : 0U;
+}
+
+// Each Encode writes one code point (if destination is not null) and returns the number of units it needs.
+static size_t Encode(char32_t codePoint, char* destination)
+{
+	if(codePoint < 0x80U)
+	{
+		if(destination)
+			destination[0] = char(codePoint);
+
+		return 1U;
+	}
+
+	if(codePoint < 0x800U)
+	{
+		if(destination)
+		{
+			destination[0] = char(0xC0U | (codePoint >> 6U));
+			destination[1] = char(0x80U | (codePoint & 0x3FU));
+		}
+
+		return 2U;
+	}
+
+	if(codePoint < 0x10000U)
+	{
+		if(destination)
+		{
+			destination[0] = char(0xE0U |  (codePoint >> 12U));
+			destination[1] = char(0x80U | ((codePoint >>  6U) & 0x3FU));
+			destination[2] = char(0x80U |  (codePoint         & 0x3FU));
+		}
+
+		return 3U;
+	}
+
+	if(destination)
+	{
+		destination[0] = char(0xF0U |  (codePoint >> 18U));
+		destination[1] = char(0x80U | ((codePoint >> 12U) & 0x3FU));
+		destination[2] = char(0x80U | ((codePoint >>  6U) & 0x3FU));
+		destination[3] = char(0x80U |  (codePoint         & 0x3FU));
+	}
+
+	return 4U;
+}
+
+static size_t Encode(char32_t codePoint, char16_t* destination)
+{
+	if(codePoint < 0x10000U)
+	{
+		if(destination)
+			destination[0] = char16_t(codePoint);
+
+		return 1U;
+	}
+
+	if(destination)
+	{
+		codePoint -= 0x10000U;
+		destination[0] = char16_t(0xD800U + (codePoint >> 10U));
+		destination[1] = char16_t(0xDC00U + (codePoint & 0x3FFU));
+	}
+
+	return 2U;
+}
+
+static size_t Encode(char32_t codePoint, char32_t* destination)
+{
+	if(destination)
+		destination[0] = codePoint;
+
+	return 1U;
+}
+
+// Copies the leading run of ASCII units and returns its length. Only whole vectors of ASCII are written at once, so
+// nothing past the run is ever stored.
+template<typename Source, typename Dest>
+static size_t CopyASCII(const Source* source, size_t length, Dest* destination)
+{
+	size_t i = 0U;
+
+#if defined(ENCODING_VECTORIZED)
+	if constexpr(sizeof(Source) == 1U)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		for(; i + 16U <= length; i += 16U)
+		{
+			__m128i block = _mm_loadu_si128((const __m128i*)(source + i));
+			if(_mm_movemask_epi8(block) != 0)
+				break;
+
+			if constexpr(sizeof(Dest) == 2U)
+			{
+				if(destination)
+				{
+					_mm_storeu_si128((__m128i*)(destination + i),       _mm_unpacklo_epi8(block, zero));
+					_mm_storeu_si128((__m128i*)(destination + i + 8U),  _mm_unpackhi_epi8(block, zero));
+				}
+			}
+			else if constexpr(sizeof(Dest) == 4U)
+			{
+				if(destination)
+				{
+					__m128i low  = _mm_unpacklo_epi8(block, zero);
+					__m128i high = _mm_unpackhi_epi8(block, zero);
+
+					_mm_storeu_si128((__m128i*)(destination + i),       _mm_unpacklo_epi16(low,  zero));
+					_mm_storeu_si128((__m128i*)(destination + i + 4U),  _mm_unpackhi_epi16(low,  zero));
+					_mm_storeu_si128((__m128i*)(destination + i + 8U),  _mm_unpacklo_epi16(high, zero));
+					_mm_storeu_si128((__m128i*)(destination + i + 12U), _mm_unpackhi_epi16(high, zero));
+				}
+			}
+		}
+	}
+	else if constexpr(sizeof(Dest) == 1U && sizeof(Source) == 2U)
+	{
+		const __m128i nonASCII = _mm_set1_epi16((short)0xFF80);
+		for(; i + 8U <= length; i += 8U)
+		{
+			__m128i block = _mm_loadu_si128((const __m128i*)(source + i));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, nonASCII), _mm_setzero_si128())) != 0xFFFF)
+				break;
+
+			if(destination)
+				_mm_storel_epi64((__m128i*)(destination + i), _mm_packus_epi16(block, block));
+		}
+	}
+	else if constexpr(sizeof(Dest) == 1U && sizeof(Source) == 4U)
+	{
+		const __m128i nonASCII = _mm_set1_epi32((int)0xFFFFFF80);
+		for(; i + 8U <= length; i += 8U)
+		{
+			__m128i low  = _mm_loadu_si128((const __m128i*)(source + i));
+			__m128i high = _mm_loadu_si128((const __m128i*)(source + i + 4U));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(low, high), nonASCII), _mm_setzero_si128())) != 0xFFFF)
+				break;
+
+			if(destination)
+			{
+				__m128i words = _mm_packs_epi32(low, high);
+				_mm_storel_epi64((__m128i*)(destination + i), _mm_packus_epi16(words, words));
+			}
+		}
+	}
+#endif
+
+	for(; i < length; i++)
+	{
+		if(uint32_t(source[i]) >= 0x80U)
+			break;
+
+		if(destination)
+			destination[i] = Dest(source[i]);
+	}
+
+	return i;
+}
+
+template<typename Source, typename Dest>
+static EncodingResult Transcode(const Source* source, size_t length, Dest* destination)
+{
+	size_t position = 0U;
+	size_t count    = 0U;
+
+	while(position < length)
+	{
+		size_t ascii = CopyASCII(source + position, length - position, destination ? destination + count : nullptr);
+		position += ascii;
+		count    += ascii;
+
+		if(position == length)
+			break;
+
+		char32_t codePoint;
+		size_t used = Decode(source + position, length - position, codePoint);
+		if(used == 0U)
+			return EncodingResult::Error(count, position);
+
+		count    += Encode(codePoint, destination ? destination + count : nullptr);
+		position += used;
+	}
+
+	return EncodingResult::Success(count, position);
+}
+
+EncodingResult Encoding::ValidateUTF8(const char* source, size_t length) { return Transcode(source, length, (char32_t*)nullptr); }
+
+EncodingResult Encoding::UTF8ToUTF16(const char* source, size_t length, char16_t* destination) { return Transcode(source, length, destination); }
+EncodingResult Encoding::UTF8ToUTF32(const char* source, size_t length, char32_t* destination) { return Transcode(source, length, destination); }
+
+EncodingResult Encoding::UTF16ToUTF8 (const char16_t* source, size_t length, char*     destination) { return Transcode(source, length, destination); }
+EncodingResult Encoding::UTF16ToUTF32(const char16_t* source, size_t length, char32_t* destination) { return Transcode(source, length, destination); }
+
+EncodingResult Encoding::UTF32ToUTF8 (const char32_t* source, size_t length, char*     destination) { return Transcode(source, length, destination); }
+EncodingResult Encoding::UTF32ToUTF16(const char32_t* source, size_t length, char16_t* destination) { return Transcode(source, length, destination); }
+
+EncodingResult Encoding::UTF8ToWide(const char* source, size_t length, wchar_t* destination) { return Transcode(source, length, (WideUnit*)destination); }
+
+EncodingResult Encoding::WideToUTF8(const wchar_t* source, size_t length, char* destination) { return Transcode((const WideUnit*)source, length, destination); }
+
+size_t Encoding::NarrowToWideAtRuntime(const char* source, size_t length, wchar_t* destination)
+{
+	EncodingResult result = UTF8ToWide(source, length, destination);
+	return result.IsValid() ? result.GetCount().ToRawValue() : WidenLatin1(source, length, destination);
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Numerics.hpp"
+
+#include <type_traits>
+
+class EncodingResult
+{
+private:
+	size_t  m_count;
+	size_t  m_position;
+	Boolean m_valid;
+
+	EncodingResult(size_t count, size_t position, Boolean valid) : m_count(count), m_position(position), m_valid(valid) {}
+public:
+	static EncodingResult Success(size_t count, size_t position) { return EncodingResult(count, position, true);  }
+	static EncodingResult Error  (size_t count, size_t position) { return EncodingResult(count, position, false); }
+
+	Boolean IsValid() const { return m_valid; }
+
+	// Number of code units written (or measured) to the destination.
+	Size GetCount() const { return m_count; }
+
+	// Number of source code units consumed. On failure this is the position of the first invalid unit.
+	Size GetPosition() const { return m_position; }
+};
+
+// Validates and converts between UTF-8, UTF-16 and UTF-32 into caller-provided buffers. Runs of ASCII are handled a
+// vector at a time. Passing a null destination only measures the output, which lets a caller size its buffer exactly.
+// Conversion stops at the first invalid sequence.
+class Encoding
+{
+private:
+	// UTF8ToWide for constant evaluation, one code point at a time. Returns SIZE_MAX if the bytes are not valid UTF-8.
+	static constexpr size_t DecodeUTF8Constant(const char* source, size_t length, wchar_t* destination)
+	{
+		size_t count = 0U;
+		for(size_t i = 0U; i < length;)
+		{
+			unsigned char lead  = (unsigned char)source[i];
+			size_t        units = lead < 0x80U ? 1U : (lead & 0xE0U) == 0xC0U ? 2U : (lead & 0xF0U) == 0xE0U ? 3U : (lead & 0xF8U) == 0xF0U ? 4U : 0U;
+			if(units == 0U || units > length - i)
+				return SIZE_MAX;
+
+			char32_t codePoint = units == 1U ? lead : lead & (0x7FU >> units);
+			for(size_t j = 1U; j < units; j++)
+			{
+				unsigned char next = (unsigned char)source[i + j];
+				if((next & 0xC0U) != 0x80U)
+					return SIZE_MAX;
+
+				codePoint = (codePoint << 6U) | (next & 0x3FU);
+			}
+
+			char32_t minimum = units == 2U ? 0x80U : units == 3U ? 0x800U : units == 4U ? 0x10000U : 0U;
+			if(codePoint < minimum || codePoint > 0x10FFFFU || (codePoint >= 0xD800U && codePoint <= 0xDFFFU))
+				return SIZE_MAX;
+
+			if(sizeof(wchar_t) == 2U && codePoint >= 0x10000U)
+			{
+				if(destination)
+				{
+					destination[count]      = wchar_t(0xD800U + ((codePoint - 0x10000U) >> 10U));
+					destination[count + 1U] = wchar_t(0xDC00U + ((codePoint - 0x10000U) & 0x3FFU));
+				}
+				count += 2U;
+			}
+			else
+			{
+				if(destination)
+					destination[count] = wchar_t(codePoint);
+				count++;
+			}
+
+			i += units;
+		}
+
+		return count;
+	}
+
+	static constexpr size_t WidenLatin1(const char* source, size_t length, wchar_t* destination)
+	{
+		if(destination)
+		{
+			for(size_t i = 0U; i < length; i++)
+				destination[i] = wchar_t((unsigned char)source[i]);
+		}
+
+		return length;
+	}
+
+	static size_t NarrowToWideAtRuntime(const char* source, size_t length, wchar_t* destination);
+public:
+	static EncodingResult ValidateUTF8(const char* source, size_t length);
+
+	static EncodingResult UTF8ToUTF16(const char* source, size_t length, char16_t* destination);
+	static EncodingResult UTF8ToUTF32(const char* source, size_t length, char32_t* destination);
+
+	static EncodingResult UTF16ToUTF8 (const char16_t* source, size_t length, char*     destination);
+	static EncodingResult UTF16ToUTF32(const char16_t* source, size_t length, char32_t* destination);
+
+	static EncodingResult UTF32ToUTF8 (const char32_t* source, size_t length, char*     destination);
+	static EncodingResult UTF32ToUTF16(const char32_t* source, size_t length, char16_t* destination);
+
+	// wchar_t is UTF-16 on Windows and UTF-32 elsewhere.
+	static EncodingResult UTF8ToWide(const char*    source, size_t length, wchar_t* destination);
+	static EncodingResult WideToUTF8(const wchar_t* source, size_t length, char*    destination);
+
+	// Narrow text as the library reads it everywhere, from String(const char*) to "..."_s, Format, StringBuilder and
+	// the logger: UTF-8 if all of it is valid, otherwise Latin-1, one character per byte. Returns the number of wide
+	// units, never more than length. Works at compile time too.
+	static constexpr size_t NarrowToWide(const char* source, size_t length, wchar_t* destination)
+	{
+		if(!std::is_constant_evaluated())
+			return NarrowToWideAtRuntime(source, length, destination);
+
+		size_t count = DecodeUTF8Constant(source, length, destination);
+		return count != SIZE_MAX ? count : WidenLatin1(source, length, destination);
+	}
+};
\ No newline at end of file
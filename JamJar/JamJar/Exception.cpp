@@ -5,5 +5,6 @@
 void Exception::Throw() const 
 {
 	Console::PrintLine(m_message);
+	Console::Flush();
 	std::exit(1);
 }
\ No newline at end of file
@@ -16,7 +16,25 @@ public:
 class NullReferenceException : public Exception
 {
 public:
-	NullReferenceException() : Exception("Cannot dereference a null reference.") {}
+	NullReferenceException() : Exception("Cannot dereference a null reference."_s) {}
+};
+
+class FormatException : public Exception
+{
+public:
+	FormatException(const String& string) : Exception(Format("The input \"{}\" is not in a valid format.", string)) {}
+};
+
+class SerializationException : public Exception
+{
+public:
+	SerializationException() : Exception("The serialized data is truncated or malformed."_s) {}
+};
+
+class IOException : public Exception
+{
+public:
+	IOException(const char* operation, const String& path) : Exception(Format("Could not {} the file \"{}\".", operation, path)) {}
 };
 
 template<typename T>
@@ -44,4 +62,44 @@ T* const NullableRef<T>::operator->() const
 		NullReferenceException().Throw();
 
 	return m_address;
-}
\ No newline at end of file
+}
+
+template<std::unsigned_integral T>
+UnsignedInteger<T> UnsignedInteger<T>::Parse(const String& string)
+{
+	UnsignedInteger<T> result;
+	if(!TryParse(string, result))
+		FormatException(string).Throw();
+
+	return result;
+}
+
+template<std::signed_integral T>
+SignedInteger<T> SignedInteger<T>::Parse(const String& string)
+{
+	SignedInteger<T> result;
+	if(!TryParse(string, result))
+		FormatException(string).Throw();
+
+	return result;
+}
+
+template<std::floating_point T>
+Float<T> Float<T>::Parse(const String& string)
+{
+	Float<T> result;
+	if(!TryParse(string, result))
+		FormatException(string).Throw();
+
+	return result;
+}
+
+template<size_t ExponentBits>
+HalfFloat<ExponentBits> HalfFloat<ExponentBits>::Parse(const String& string)
+{
+	HalfFloat<ExponentBits> result;
+	if(!TryParse(string, result))
+		FormatException(string).Throw();
+
+	return result;
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+#include "String.hpp"
+
+#include <type_traits>
+#include <utility>
+
+// Describes how a value is written by Format. Measure returns an upper bound of the number of characters the value
+// needs, and Write returns the number of characters it actually wrote.
+template<typename T>
+struct FormatArgument;
+
+template<>
+struct FormatArgument<String>
+{
+	static size_t Measure(const String& value) { return value.Length().ToRawValue(); }
+
+	static size_t Write(const String& value, wchar_t* destination)
+	{
+		memcpy(destination, value.AsSpan().ToUnsafePointer(), value.Length().ToRawValue() * sizeof(wchar_t));
+		return value.Length().ToRawValue();
+	}
+};
+
+template<>
+struct FormatArgument<const char*>
+{
+	static size_t Measure(const char* value) { return strlen(value); }
+
+	static size_t Write(const char* value, wchar_t* destination) { return Encoding::NarrowToWide(value, strlen(value), destination); }
+};
+
+template<size_t N>
+struct FormatArgument<char[N]> : FormatArgument<const char*> {};
+
+template<>
+struct FormatArgument<const wchar_t*>
+{
+	static size_t Measure(const wchar_t* value) { return wcslen(value); }
+
+	static size_t Write(const wchar_t* value, wchar_t* destination)
+	{
+		size_t count = wcslen(value);
+		memcpy(destination, value, count * sizeof(wchar_t));
+		return count;
+	}
+};
+
+template<size_t N>
+struct FormatArgument<wchar_t[N]> : FormatArgument<const wchar_t*> {};
+
+template<>
+struct FormatArgument<Character>
+{
+	static size_t Measure(Character) { return 1U; }
+
+	static size_t Write(Character value, wchar_t* destination)
+	{
+		*destination = *(const wchar_t*)&value;
+		return 1U;
+	}
+};
+
+template<>
+struct FormatArgument<Boolean>
+{
+	static size_t Measure(Boolean value) { return value ? 4U : 5U; }
+
+	static size_t Write(Boolean value, wchar_t* destination) { return FormatArgument<const char*>::Write(value ? "True" : "False", destination); }
+};
+
+template<std::unsigned_integral T>
+struct FormatArgument<UnsignedInteger<T>>
+{
+	static size_t Measure(UnsignedInteger<T> value) { return NumberFormat::GetLength(uint64_t(value.ToRawValue())); }
+
+	static size_t Write(UnsignedInteger<T> value, wchar_t* destination) { return NumberFormat::Format(uint64_t(value.ToRawValue()), destination); }
+};
+
+template<std::signed_integral T>
+struct FormatArgument<SignedInteger<T>>
+{
+	static size_t Measure(SignedInteger<T> value) { return NumberFormat::GetLength(int64_t(value.ToRawValue())); }
+
+	static size_t Write(SignedInteger<T> value, wchar_t* destination) { return NumberFormat::Format(int64_t(value.ToRawValue()), destination); }
+};
+
+template<std::floating_point T>
+struct FormatArgument<Float<T>>
+{
+	static size_t Measure(Float<T>) { return NumberFormat::MaximumFloatLength; }
+
+	static size_t Write(Float<T> value, wchar_t* destination) { return NumberFormat::Format(value.ToRawValue(), destination); }
+};
+
+template<typename T>
+concept Formattable = requires(const T& value, wchar_t* destination)
+{
+	{ FormatArgument<T>::Measure(value) } -> std::same_as<size_t>;
+	{ FormatArgument<T>::Write(value, destination) } -> std::same_as<size_t>;
+};
+
+// Arguments without a FormatArgument are converted with ToString once, before measuring.
+template<typename T>
+decltype(auto) PrepareFormatArgument(const T& value)
+{
+	if constexpr(Formattable<T>)
+		return (value);
+	else
+		return value.ToString();
+}
+
+void FormatStringError(const char* message);
+
+// A format string whose placeholders are checked against the argument count at compile time. "{}" is replaced by
+// the next argument, "{{" and "}}" produce literal braces.
+template<typename... Args>
+class FormatString
+{
+private:
+	const char* m_string;
+	size_t      m_length;
+	size_t      m_literalLength;
+public:
+	template<size_t N>
+	consteval FormatString(const char (&string)[N]) : m_string(string), m_length(N - 1U), m_literalLength(0U)
+	{
+		size_t placeholders = 0U;
+		for(size_t i = 0U; i < m_length; i++)
+		{
+			if(string[i] == '{')
+			{
+				if(i + 1U < m_length && string[i + 1U] == '{')
+					i++;
+				else if(i + 1U < m_length && string[i + 1U] == '}')
+				{
+					placeholders++;
+					i++;
+					continue;
+				}
+				else
+					FormatStringError("Unmatched '{' in format string.");
+			}
+			else if(string[i] == '}')
+			{
+				if(i + 1U < m_length && string[i + 1U] == '}')
+					i++;
+				else
+					FormatStringError("Unmatched '}' in format string.");
+			}
+
+			m_literalLength++;
+		}
+
+		if(placeholders != sizeof...(Args))
+			FormatStringError("The number of placeholders does not match the number of arguments.");
+	}
+
+	const char* GetString() const { return m_string; }
+
+	// Copies literal text starting at offset up to the next placeholder (or the end), and moves offset past it. The runs
+	// between braces are decoded like String(const char*).
+	size_t WriteLiteral(size_t& offset, wchar_t* destination) const
+	{
+		size_t count = 0U;
+		while(offset < m_length)
+		{
+			char current = m_string[offset];
+			if(current == '{' && m_string[offset + 1U] == '}')
+			{
+				offset += 2U;
+				break;
+			}
+
+			if(current == '{' || current == '}')
+			{
+				destination[count++] = wchar_t(current);
+				offset += 2U;
+				continue;
+			}
+
+			size_t run = 1U;
+			while(offset + run < m_length && m_string[offset + run] != '{' && m_string[offset + run] != '}')
+				run++;
+
+			count  += Encoding::NarrowToWide(m_string + offset, run, destination + count);
+			offset += run;
+		}
+
+		return count;
+	}
+
+	template<typename... Values>
+	String Apply(const Values&... values) const
+	{
+		size_t length = m_literalLength;
+		((length += FormatArgument<Values>::Measure(values)), ...);
+
+		SharedArrayRef<Character> chars = HeapArray<Character>(length);
+		wchar_t* destination = (wchar_t*)chars.ToUnsafePointer();
+
+		size_t offset = 0U;
+		size_t count  = 0U;
+		((count += WriteLiteral(offset, destination + count), count += FormatArgument<Values>::Write(values, destination + count)), ...);
+		count += WriteLiteral(offset, destination + count);
+
+		// Measure is an upper bound; a span over less than the whole array could not cache its hash.
+		chars.Shrink(count);
+		return String(SharedArraySpan<Character>(chars));
+	}
+};
+
+template<typename... Args>
+String Format(FormatString<std::type_identity_t<Args>...> format, const Args&... args) requires ((Formattable<Args> || Printable<Args>) && ...)
+{
+	return format.Apply(PrepareFormatArgument(args)...);
+}
+
+template<typename Left, typename Right>
+class StringConcat;
+
+template<typename T>
+struct IsStringConcat : std::false_type {};
+
+template<typename Left, typename Right>
+struct IsStringConcat<StringConcat<Left, Right>> : std::true_type {};
+
+// A pending concatenation built by operator+. Nothing is allocated until the node is converted to a String, which
+// measures the total and writes every operand once. Operands are held by value, C strings copied into a String (use
+// "..."_s for literals that should not be copied), so a node can be kept, copied or converted later; the node below is
+// moved in when it is a temporary, which costs a reference count per leaf, not a copy of the text.
+template<typename Left, typename Right>
+class StringConcat
+{
+private:
+	Left  m_left;
+	Right m_right;
+public:
+	StringConcat(Left left, Right right) : m_left(std::move(left)), m_right(std::move(right)) {}
+
+	size_t Measure() const { return FormatArgument<Left>::Measure(m_left) + FormatArgument<Right>::Measure(m_right); }
+
+	size_t Write(wchar_t* destination) const
+	{
+		size_t count = FormatArgument<Left>::Write(m_left, destination);
+		return count + FormatArgument<Right>::Write(m_right, destination + count);
+	}
+
+	String ToString() const
+	{
+		SharedArrayRef<Character> chars = HeapArray<Character>(Measure());
+		chars.Shrink(Write((wchar_t*)chars.ToUnsafePointer()));
+		return String(SharedArraySpan<Character>(chars));
+	}
+
+	operator String() const { return ToString(); }
+};
+
+template<typename Left, typename Right>
+struct FormatArgument<StringConcat<Left, Right>>
+{
+	static size_t Measure(const StringConcat<Left, Right>& value) { return value.Measure(); }
+
+	static size_t Write(const StringConcat<Left, Right>& value, wchar_t* destination) { return value.Write(destination); }
+};
+
+template<typename T>
+concept StringOperand = SameAs<T, String> || SameAs<T, MutableString> || IsStringConcat<T>::value;
+
+template<typename T>
+concept ConcatOperand = Formattable<T> || Printable<T>;
+
+template<typename T>
+concept CStringOperand = std::is_pointer_v<std::decay_t<T>> &&
+	(SameAs<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>, char> || SameAs<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>, wchar_t>);
+
+template<typename T>
+using ConcatLeaf = std::conditional_t<CStringOperand<T>, String, std::decay_t<decltype(PrepareFormatArgument(std::declval<const T&>()))>>;
+
+// A concat operand as its node will hold it: a node below is passed on as it came, so a temporary can be moved.
+template<typename T>
+decltype(auto) PrepareConcatOperand(T&& value)
+{
+	if constexpr(IsStringConcat<std::remove_cvref_t<T>>::value)
+		return std::forward<T>(value);
+	else
+		return PrepareFormatArgument(value);
+}
+
+template<typename Left, typename Right>
+StringConcat<ConcatLeaf<std::remove_cvref_t<Left>>, ConcatLeaf<std::remove_cvref_t<Right>>> operator+(Left&& left, Right&& right)
+	requires ConcatOperand<std::remove_cvref_t<Left>> && ConcatOperand<std::remove_cvref_t<Right>> &&
+		(StringOperand<std::remove_cvref_t<Left>> || StringOperand<std::remove_cvref_t<Right>>)
+{
+	return StringConcat<ConcatLeaf<std::remove_cvref_t<Left>>, ConcatLeaf<std::remove_cvref_t<Right>>>(
+		PrepareConcatOperand(std::forward<Left>(left)), PrepareConcatOperand(std::forward<Right>(right)));
+}
+
+template<typename T>
+String SharedRef<T>::ToString() const requires Printable<T>
+{
+	return Format("Reference -> {{ {} }}", *m_address);
+}
+
+template<typename T>
+String NullableRef<T>::ToString() const requires Printable<T>
+{
+	if(m_address)
+		return Format("Reference -> {{ {} }}", *m_address);
+
+	return "<Null Reference>"_s;
+}
+
+template<typename T>
+String WeakRef<T>::ToString() const requires Printable<T>
+{
+	if(m_refCount->m_useCount == 0U)
+		return "Reference -> Deleted"_s;
+
+	return Format("Reference -> {{ {} }}", *m_address);
+}
+
+template<typename T>
+String NullableWeakRef<T>::ToString() const requires Printable<T>
+{
+	if(!m_address)
+		return "<Null Reference>"_s;
+
+	if(m_refCount->m_useCount == 0U)
+		return "Reference -> Deleted"_s;
+
+	return Format("Reference -> {{ {} }}", *m_address);
+}
\ No newline at end of file
@@ -1,3 +1,41 @@
 #include "HashCode.hpp"
 
-HashCode Boolean::GetHashCode() const { return m_value ? 1U : 0U; }
\ No newline at end of file
+#include <cstring>
+
+HashCode Boolean::GetHashCode() const { return m_value ? 1U : 0U; }
+
+static uint64_t ReadWord(const unsigned char* bytes)
+{
+	uint64_t word;
+	memcpy(&word, bytes, sizeof(word));
+	return word;
+}
+
+static uint64_t RotateLeft(uint64_t value, unsigned count) { return (value << count) | (value >> (64U - count)); }
+
+HashCode HashCode::FromBytes(const void* data, size_t length)
+{
+	const uint64_t Multiplier0 = 0x9E3779B97F4A7C15ULL;
+	const uint64_t Multiplier1 = 0xC2B2AE3D27D4EB4FULL;
+
+	const unsigned char* bytes = (const unsigned char*)data;
+
+	uint64_t hash = 0x27D4EB2F165667C5ULL ^ (uint64_t(length) * Multiplier0);
+	for(; length >= 8U; length -= 8U, bytes += 8U)
+		hash = RotateLeft(hash ^ (ReadWord(bytes) * Multiplier1), 31U) * Multiplier0;
+
+	if(length > 0U)
+	{
+		uint64_t tail = 0U;
+		memcpy(&tail, bytes, length);
+		hash = RotateLeft(hash ^ (tail * Multiplier1), 31U) * Multiplier0;
+	}
+
+	hash ^= hash >> 33U;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33U;
+	hash *= 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 33U;
+
+	return HashCode(hash != 0U ? size_t(hash) : size_t(1U));
+}
\ No newline at end of file
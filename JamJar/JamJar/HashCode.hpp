@@ -14,6 +14,9 @@ public:
 
 	HashCode(UnsignedInteger<size_t> value);
 
+	// Hashes raw memory eight bytes at a time. Never returns zero.
+	static HashCode FromBytes(const void* data, size_t length);
+
 	size_t GetValue() const { return m_value; }
 
 	friend HashCode operator&(const HashCode& left, const HashCode& right)
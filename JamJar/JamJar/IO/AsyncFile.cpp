@@ -0,0 +1,687 @@
+#include "AsyncFile.hpp"
+#include "../Exception.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(JAMJAR_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+static const size_t   MaximumWorkers    = 16U;
+static const size_t   MaximumRegistered = 64U;
+static const unsigned RingEntries       = 256U;
+
+#if defined(_WIN32)
+// Each worker waits for its own requests on its own event.
+class WorkerEvent
+{
+public:
+	HANDLE handle;
+
+	WorkerEvent() : handle(CreateEventW(nullptr, TRUE, FALSE, nullptr)) {}
+
+	WorkerEvent(const WorkerEvent& other) = delete;
+
+	~WorkerEvent() { CloseHandle(handle); }
+};
+
+static thread_local WorkerEvent s_workerEvent;
+#endif
+
+class AsyncEngine
+{
+protected:
+	static intptr_t       GetHandle(const AsyncRequest& request) { return request.m_file->m_handle; }
+	static unsigned char* GetData  (const AsyncRequest& request) { return request.m_data; }
+	static size_t         GetCount (const AsyncRequest& request) { return request.m_count; }
+	static uint64_t       GetOffset(const AsyncRequest& request) { return request.m_offset; }
+	static Boolean        IsWrite  (const AsyncRequest& request) { return request.m_write; }
+
+	static AsyncRequest*& GetNext(AsyncRequest& request) { return request.m_next; }
+
+	// While a request is pending its result holds the bytes transferred so far.
+	static int64_t& GetTransferred(AsyncRequest& request) { return request.m_result; }
+
+	static void Complete(AsyncRequest& request, int64_t result)
+	{
+		request.m_result = result;
+		if(request.m_callback)
+			request.m_callback(request);
+
+		request.m_state.store(AsyncRequest::State::Completed, std::memory_order_release);
+		request.m_state.notify_all();
+	}
+public:
+	virtual ~AsyncEngine() {}
+
+	virtual AsyncBackend GetBackend() const = 0;
+
+	virtual void Enqueue(AsyncRequest& request) = 0;
+	virtual void Submit() = 0;
+
+	virtual Boolean RegisterBuffers(const ArraySpan<BufferSpan<UInt8>>&) { return false; }
+};
+
+// Performs requests with blocking positional reads and writes on a few worker threads. On Windows the file is opened
+// for overlapped I/O, so the workers' requests on one handle run side by side instead of queueing on the file object.
+class ThreadPoolEngine : public AsyncEngine
+{
+private:
+	std::mutex              m_mutex;
+	std::condition_variable m_ready;
+
+	AsyncRequest* m_queuedHead;
+	AsyncRequest* m_queuedTail;
+	AsyncRequest* m_readyHead;
+	AsyncRequest* m_readyTail;
+
+	std::thread m_threads[MaximumWorkers];
+	size_t      m_threadCount;
+	bool        m_stopping;
+
+	static int64_t Perform(AsyncRequest& request)
+	{
+		unsigned char* data   = GetData(request);
+		size_t         count  = GetCount(request);
+		uint64_t       offset = GetOffset(request);
+		size_t         total  = 0U;
+
+		while(total < count)
+		{
+			size_t remaining = count - total;
+
+#if defined(_WIN32)
+			HANDLE handle = (HANDLE)GetHandle(request);
+
+			OVERLAPPED overlapped = {};
+			overlapped.Offset     = DWORD(offset + total);
+			overlapped.OffsetHigh = DWORD((offset + total) >> 32U);
+			overlapped.hEvent     = s_workerEvent.handle;
+
+			DWORD length      = DWORD(remaining < 0x40000000U ? remaining : 0x40000000U);
+			DWORD transferred = 0U;
+
+			BOOL started = IsWrite(request) ?
+				WriteFile(handle, data + total, length, nullptr, &overlapped) :
+				ReadFile (handle, data + total, length, nullptr, &overlapped);
+
+			BOOL succeeded = (started || GetLastError() == ERROR_IO_PENDING) && GetOverlappedResult(handle, &overlapped, &transferred, TRUE);
+			if(!succeeded)
+			{
+				DWORD error = GetLastError();
+				if(error == ERROR_HANDLE_EOF)
+					break;
+
+				return -int64_t(error);
+			}
+#else
+			ssize_t transferred = IsWrite(request) ?
+				pwrite(int(GetHandle(request)), data + total, remaining, off_t(offset + total)) :
+				pread (int(GetHandle(request)), data + total, remaining, off_t(offset + total));
+
+			if(transferred < 0)
+			{
+				if(errno == EINTR)
+					continue;
+
+				return -int64_t(errno);
+			}
+#endif
+
+			if(transferred == 0)
+				break;
+
+			total += size_t(transferred);
+		}
+
+		return int64_t(total);
+	}
+
+	void Run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while(true)
+		{
+			m_ready.wait(lock, [this]() { return m_readyHead || m_stopping; });
+			if(!m_readyHead)
+				break;
+
+			AsyncRequest& request = *m_readyHead;
+			m_readyHead = GetNext(request);
+			if(!m_readyHead)
+				m_readyTail = nullptr;
+
+			lock.unlock();
+			Complete(request, Perform(request));
+			lock.lock();
+		}
+	}
+public:
+	ThreadPoolEngine() : m_queuedHead(nullptr), m_queuedTail(nullptr), m_readyHead(nullptr), m_readyTail(nullptr), m_stopping(false)
+	{
+		size_t concurrency = std::thread::hardware_concurrency();
+		m_threadCount = concurrency < 4U ? 4U : concurrency > MaximumWorkers ? MaximumWorkers : concurrency;
+
+		for(size_t i = 0U; i < m_threadCount; i++)
+			m_threads[i] = std::thread([this]() { Run(); });
+	}
+
+	~ThreadPoolEngine()
+	{
+		Submit();
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+
+		m_ready.notify_all();
+		for(size_t i = 0U; i < m_threadCount; i++)
+			m_threads[i].join();
+	}
+
+	virtual AsyncBackend GetBackend() const override { return AsyncBackend::ThreadPool; }
+
+	virtual void Enqueue(AsyncRequest& request) override
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		GetNext(request) = nullptr;
+		if(m_queuedTail)
+			GetNext(*m_queuedTail) = &request;
+		else
+			m_queuedHead = &request;
+
+		m_queuedTail = &request;
+	}
+
+	virtual void Submit() override
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if(!m_queuedHead)
+				return;
+
+			if(m_readyTail)
+				GetNext(*m_readyTail) = m_queuedHead;
+			else
+				m_readyHead = m_queuedHead;
+
+			m_readyTail  = m_queuedTail;
+			m_queuedHead = nullptr;
+			m_queuedTail = nullptr;
+		}
+
+		m_ready.notify_all();
+	}
+};
+
+#if defined(JAMJAR_IO_URING)
+static int SetupRing(unsigned entries, io_uring_params& parameters) { return int(syscall(__NR_io_uring_setup, entries, &parameters)); }
+
+static int EnterRing(int ring, unsigned submit, unsigned minimumComplete, unsigned flags)
+{
+	return int(syscall(__NR_io_uring_enter, ring, submit, minimumComplete, flags, nullptr, 0));
+}
+
+static int RegisterRing(int ring, unsigned opcode, const void* arguments, unsigned count)
+{
+	return int(syscall(__NR_io_uring_register, ring, opcode, arguments, count));
+}
+
+// Talks to the kernel through the raw system calls. Submissions from any thread are written to the shared queue under
+// a lock; a single completion thread blocks in the kernel and finishes requests as they arrive. A request the kernel
+// transfers only part of is resubmitted for the rest, as the thread pool loops, until it is done or reaches the end.
+class IOUringEngine : public AsyncEngine
+{
+private:
+	// Linux moves at most this much in one read or write; the entry's length is 32 bits anyway.
+	static const size_t MaximumTransfer = 0x7FFFF000U;
+
+	struct RegisteredBuffer
+	{
+		unsigned char* data;
+		size_t         count;
+	};
+
+	int m_ring;
+
+	void*  m_queueMemory;
+	size_t m_queueMemorySize;
+
+	io_uring_sqe* m_entries;
+	size_t        m_entriesSize;
+
+	unsigned* m_submitHead;
+	unsigned* m_submitTail;
+	unsigned* m_submitArray;
+	unsigned  m_submitMask;
+	unsigned  m_submitCount;
+
+	unsigned*     m_completeHead;
+	unsigned*     m_completeTail;
+	io_uring_cqe* m_completions;
+	unsigned      m_completeMask;
+
+	std::mutex m_mutex;
+	unsigned   m_queued;
+
+	RegisteredBuffer m_registered[MaximumRegistered];
+	size_t           m_registeredCount;
+
+	std::atomic<size_t> m_outstanding;
+	std::atomic<bool>   m_stopping;
+	std::thread         m_thread;
+
+	IOUringEngine(int ring, const io_uring_params& parameters) :
+		m_ring(ring), m_queued(0U), m_registeredCount(0U), m_outstanding(0U), m_stopping(false)
+	{
+		size_t submitSize   = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+		size_t completeSize = parameters.cq_off.cqes  + parameters.cq_entries * sizeof(io_uring_cqe);
+
+		// With IORING_FEAT_SINGLE_MMAP both rings share one mapping.
+		m_queueMemorySize = submitSize > completeSize ? submitSize : completeSize;
+		m_queueMemory     = mmap(nullptr, m_queueMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+
+		m_entriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+		m_entries     = (io_uring_sqe*)mmap(nullptr, m_entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+
+		unsigned char* memory = (unsigned char*)m_queueMemory;
+
+		m_submitHead  = (unsigned*)(memory + parameters.sq_off.head);
+		m_submitTail  = (unsigned*)(memory + parameters.sq_off.tail);
+		m_submitArray = (unsigned*)(memory + parameters.sq_off.array);
+		m_submitMask  = *(unsigned*)(memory + parameters.sq_off.ring_mask);
+		m_submitCount = parameters.sq_entries;
+
+		m_completeHead = (unsigned*)(memory + parameters.cq_off.head);
+		m_completeTail = (unsigned*)(memory + parameters.cq_off.tail);
+		m_completions  = (io_uring_cqe*)(memory + parameters.cq_off.cqes);
+		m_completeMask = *(unsigned*)(memory + parameters.cq_off.ring_mask);
+	}
+
+	Boolean IsMapped() const { return m_queueMemory != MAP_FAILED && m_entries != MAP_FAILED; }
+
+	void SubmitLocked()
+	{
+		while(m_queued > 0U)
+		{
+			int submitted = EnterRing(m_ring, m_queued, 0U, 0U);
+			if(submitted < 0)
+			{
+				// EBUSY means completions are backed up; the completion thread is already draining them.
+				if(errno == EINTR || errno == EAGAIN || errno == EBUSY)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				Exception("The I/O ring rejected a submission."_s).Throw();
+			}
+
+			m_queued -= unsigned(submitted);
+		}
+	}
+
+	io_uring_sqe& AcquireEntry()
+	{
+		unsigned tail = *m_submitTail;
+		if(tail - std::atomic_ref<unsigned>(*m_submitHead).load(std::memory_order_acquire) == m_submitCount)
+			SubmitLocked();
+
+		unsigned index = tail & m_submitMask;
+		m_submitArray[index] = index;
+
+		io_uring_sqe& entry = m_entries[index];
+		memset(&entry, 0, sizeof(io_uring_sqe));
+		return entry;
+	}
+
+	void PublishEntry()
+	{
+		std::atomic_ref<unsigned>(*m_submitTail).fetch_add(1U, std::memory_order_release);
+		m_queued++;
+	}
+
+	// Queues the part of the request that has not been transferred yet.
+	void QueueLocked(AsyncRequest& request)
+	{
+		size_t transferred = size_t(GetTransferred(request));
+		size_t remaining   = GetCount(request) - transferred;
+
+		unsigned char* data  = GetData(request) + transferred;
+		size_t         count = remaining < MaximumTransfer ? remaining : MaximumTransfer;
+
+		io_uring_sqe& entry = AcquireEntry();
+		entry.opcode    = IsWrite(request) ? IORING_OP_WRITE : IORING_OP_READ;
+		entry.fd        = int(GetHandle(request));
+		entry.off       = GetOffset(request) + transferred;
+		entry.addr      = uint64_t(data);
+		entry.len       = unsigned(count);
+		entry.user_data = uint64_t(&request);
+
+		for(size_t i = 0U; i < m_registeredCount; i++)
+		{
+			if(data >= m_registered[i].data && data + count <= m_registered[i].data + m_registered[i].count)
+			{
+				entry.opcode    = IsWrite(request) ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+				entry.buf_index = uint16_t(i);
+				break;
+			}
+		}
+
+		PublishEntry();
+	}
+
+	void Run()
+	{
+		while(true)
+		{
+			unsigned head = *m_completeHead;
+			unsigned tail = std::atomic_ref<unsigned>(*m_completeTail).load(std::memory_order_acquire);
+			if(head == tail)
+			{
+				if(m_stopping.load(std::memory_order_acquire) && m_outstanding.load(std::memory_order_acquire) == 0U)
+					break;
+
+				EnterRing(m_ring, 0U, 1U, IORING_ENTER_GETEVENTS);
+				continue;
+			}
+
+			AsyncRequest* unfinished = nullptr;
+			for(; head != tail; head++)
+			{
+				const io_uring_cqe& completion = m_completions[head & m_completeMask];
+				if(completion.user_data == 0U)
+					continue;
+
+				AsyncRequest& request = *(AsyncRequest*)completion.user_data;
+				if(completion.res > 0)
+				{
+					GetTransferred(request) += completion.res;
+					if(size_t(GetTransferred(request)) < GetCount(request))
+					{
+						GetNext(request) = unfinished;
+						unfinished       = &request;
+						continue;
+					}
+				}
+
+				Complete(request, completion.res < 0 ? int64_t(completion.res) : GetTransferred(request));
+				m_outstanding.fetch_sub(1U, std::memory_order_release);
+			}
+
+			// The completions are released first: a submitter holding the lock may be waiting for room to post them.
+			std::atomic_ref<unsigned>(*m_completeHead).store(head, std::memory_order_release);
+
+			if(unfinished)
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				for(AsyncRequest* request = unfinished; request;)
+				{
+					AsyncRequest* next = GetNext(*request);
+					QueueLocked(*request);
+					request = next;
+				}
+
+				SubmitLocked();
+			}
+		}
+	}
+public:
+	// Returns null if the kernel lacks io_uring or the features relied on here (5.7 or later).
+	static IOUringEngine* TryCreate()
+	{
+		io_uring_params parameters = {};
+
+		int ring = SetupRing(RingEntries, parameters);
+		if(ring < 0)
+			return nullptr;
+
+		unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+		if((parameters.features & required) != required)
+		{
+			close(ring);
+			return nullptr;
+		}
+
+		IOUringEngine* engine = new IOUringEngine(ring, parameters);
+		if(!engine->IsMapped())
+		{
+			delete engine;
+			return nullptr;
+		}
+
+		engine->m_thread = std::thread([engine]() { engine->Run(); });
+		return engine;
+	}
+
+	~IOUringEngine()
+	{
+		if(m_thread.joinable())
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_stopping.store(true, std::memory_order_release);
+
+			// Wakes the completion thread, which leaves once every request has finished.
+			io_uring_sqe& entry = AcquireEntry();
+			entry.opcode = IORING_OP_NOP;
+			PublishEntry();
+			SubmitLocked();
+		}
+
+		if(m_thread.joinable())
+			m_thread.join();
+
+		if(m_entries != MAP_FAILED)
+			munmap(m_entries, m_entriesSize);
+
+		if(m_queueMemory != MAP_FAILED)
+			munmap(m_queueMemory, m_queueMemorySize);
+
+		close(m_ring);
+	}
+
+	virtual AsyncBackend GetBackend() const override { return AsyncBackend::IOUring; }
+
+	virtual void Enqueue(AsyncRequest& request) override
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		m_outstanding.fetch_add(1U, std::memory_order_relaxed);
+		QueueLocked(request);
+	}
+
+	virtual void Submit() override
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		SubmitLocked();
+	}
+
+	virtual Boolean RegisterBuffers(const ArraySpan<BufferSpan<UInt8>>& buffers) override
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		if(m_registeredCount > 0U)
+		{
+			RegisterRing(m_ring, IORING_UNREGISTER_BUFFERS, nullptr, 0U);
+			m_registeredCount = 0U;
+		}
+
+		size_t count = buffers.Count().ToRawValue();
+		if(count == 0U)
+			return true;
+
+		if(count > MaximumRegistered)
+			return false;
+
+		struct iovec vectors[MaximumRegistered];
+		for(size_t i = 0U; i < count; i++)
+		{
+			vectors[i].iov_base = buffers[i].ToUnsafePointer();
+			vectors[i].iov_len  = buffers[i].Count().ToRawValue();
+		}
+
+		if(RegisterRing(m_ring, IORING_REGISTER_BUFFERS, vectors, unsigned(count)) < 0)
+			return false;
+
+		for(size_t i = 0U; i < count; i++)
+			m_registered[i] = { (unsigned char*)vectors[i].iov_base, vectors[i].iov_len };
+
+		m_registeredCount = count;
+		return true;
+	}
+};
+#endif
+
+class AsyncEngineOwner
+{
+public:
+	AsyncEngine* engine;
+
+	AsyncEngineOwner() : engine(nullptr)
+	{
+#if defined(JAMJAR_IO_URING)
+		engine = IOUringEngine::TryCreate();
+#endif
+
+		if(!engine)
+			engine = new ThreadPoolEngine();
+	}
+
+	AsyncEngineOwner(const AsyncEngineOwner& other) = delete;
+
+	~AsyncEngineOwner() { delete engine; }
+};
+
+static AsyncEngine& GetEngine()
+{
+	static AsyncEngineOwner owner;
+	return *owner.engine;
+}
+
+AsyncRequest::~AsyncRequest() { WaitForCompletion(); }
+
+void AsyncRequest::WaitForCompletion()
+{
+	if(m_state.load(std::memory_order_acquire) != State::Pending)
+		return;
+
+	GetEngine().Submit();
+
+	while(m_state.load(std::memory_order_acquire) == State::Pending)
+		m_state.wait(State::Pending, std::memory_order_acquire);
+}
+
+Size AsyncRequest::Wait()
+{
+	if(m_state.load(std::memory_order_acquire) == State::Idle)
+		return 0U;
+
+	WaitForCompletion();
+	if(m_result < 0)
+		IOException(m_write ? "write" : "read", m_file->m_path).Throw();
+
+	return size_t(m_result);
+}
+
+AsyncFile::AsyncFile(const String& path, AsyncFileMode mode) : m_path(path), m_handle(-1)
+{
+#if defined(_WIN32)
+	wchar_t* nativePath = (wchar_t*)malloc((path.Length().ToRawValue() + 1U) * sizeof(wchar_t));
+	path.CopyTo(nativePath);
+
+	DWORD access      = mode == AsyncFileMode::Read ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+	DWORD disposition = mode == AsyncFileMode::Create ? CREATE_ALWAYS : OPEN_EXISTING;
+
+	HANDLE handle = CreateFileW(nativePath, access, FILE_SHARE_READ, nullptr, disposition, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS | FILE_FLAG_OVERLAPPED, nullptr);
+	free(nativePath);
+
+	if(handle == INVALID_HANDLE_VALUE)
+		IOException("open", path).Throw();
+
+	m_handle = (intptr_t)handle;
+#else
+	char* nativePath = (char*)malloc(path.GetUTF8Length().ToRawValue() + 1U);
+	path.CopyTo(nativePath);
+
+	int flags = O_CLOEXEC;
+	if(mode == AsyncFileMode::Read)
+		flags |= O_RDONLY;
+	else if(mode == AsyncFileMode::Create)
+		flags |= O_RDWR | O_CREAT | O_TRUNC;
+	else
+		flags |= O_RDWR;
+
+	int descriptor = open(nativePath, flags, 0644);
+	free(nativePath);
+
+	if(descriptor < 0)
+		IOException("open", path).Throw();
+
+	m_handle = descriptor;
+#endif
+}
+
+AsyncFile::~AsyncFile()
+{
+#if defined(_WIN32)
+	CloseHandle((HANDLE)m_handle);
+#else
+	close(int(m_handle));
+#endif
+}
+
+UInt64 AsyncFile::GetLength() const
+{
+#if defined(_WIN32)
+	LARGE_INTEGER length;
+	if(!GetFileSizeEx((HANDLE)m_handle, &length))
+		IOException("query", m_path).Throw();
+
+	return uint64_t(length.QuadPart);
+#else
+	struct stat status;
+	if(fstat(int(m_handle), &status) != 0)
+		IOException("query", m_path).Throw();
+
+	return uint64_t(status.st_size);
+#endif
+}
+
+void AsyncFile::Enqueue(UInt64 offset, unsigned char* data, Size count, Boolean write, AsyncRequest& request) const
+{
+	if(request.m_state.load(std::memory_order_acquire) == AsyncRequest::State::Pending)
+		Exception("The request is still pending."_s).Throw();
+
+	request.m_file   = this;
+	request.m_data   = data;
+	request.m_count  = count.ToRawValue();
+	request.m_offset = offset.ToRawValue();
+	request.m_result = 0;
+	request.m_write  = write;
+	request.m_state.store(AsyncRequest::State::Pending, std::memory_order_relaxed);
+
+	GetEngine().Enqueue(request);
+}
+
+void AsyncFile::Submit() { GetEngine().Submit(); }
+
+Boolean AsyncFile::RegisterBuffers(const ArraySpan<BufferSpan<UInt8>>& buffers) { return GetEngine().RegisterBuffers(buffers); }
+
+AsyncBackend AsyncFile::GetBackend() { return GetEngine().GetBackend(); }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../String.hpp"
+#include "../Delegate.hpp"
+#include "../Data/Memory/Array.hpp"
+#include "../Data/Memory/Buffer.hpp"
+
+#include <atomic>
+
+// Set to use the portable thread pool even where io_uring is available.
+#if !defined(JAMJAR_NO_IO_URING) && defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define JAMJAR_IO_URING
+#endif
+
+enum class AsyncFileMode : uint8_t
+{
+	Read,
+	Create,
+	Update,
+};
+
+enum class AsyncBackend : uint8_t
+{
+	IOUring,
+	ThreadPool,
+};
+
+class AsyncFile;
+class AsyncEngine;
+class AsyncRequest;
+
+// Called on an I/O thread once the request has finished, just before it is marked complete. The request must not be
+// waited on or resubmitted from the callback.
+using AsyncCallback = Function<void, AsyncRequest&>;
+
+// One read or write. The caller owns the request and its buffer and must keep both alive until the request has
+// completed; a request can be reused once it has. Destroying a pending request waits for it.
+class AsyncRequest
+{
+private:
+	enum class State : uint32_t
+	{
+		Idle,
+		Pending,
+		Completed,
+	};
+
+	const AsyncFile*   m_file;
+	unsigned char*     m_data;
+	size_t             m_count;
+	uint64_t           m_offset;
+	int64_t            m_result;
+	Boolean            m_write;
+	AsyncCallback      m_callback;
+	void*              m_context;
+	AsyncRequest*      m_next;
+	std::atomic<State> m_state;
+
+	void WaitForCompletion();
+public:
+	AsyncRequest(AsyncCallback callback = nullptr, void* context = nullptr) :
+		m_file(nullptr), m_data(nullptr), m_count(0U), m_offset(0U), m_result(0), m_write(false), m_callback(callback), m_context(context), m_next(nullptr), m_state(State::Idle) {}
+
+	AsyncRequest(const AsyncRequest& other) = delete;
+
+	~AsyncRequest();
+
+	void* GetContext() const { return m_context; }
+
+	Boolean IsCompleted() const { return m_state.load(std::memory_order_acquire) == State::Completed; }
+
+	// Submits the request if it is still queued, blocks until it has finished and returns the number of bytes
+	// transferred. A short count means the end of the file was reached.
+	Size Wait();
+
+	// The number of bytes transferred, or a negative error code. Valid in the callback and after Wait.
+	SInt64 GetResult() const { return m_result; }
+
+	friend class AsyncFile;
+	friend class AsyncEngine;
+};
+
+// A file for many outstanding reads and writes without a thread per request. On Linux the requests go through an
+// io_uring; elsewhere, or when the kernel does not support it, a small pool of threads performs them.
+//
+// Read and Write only queue a request. Queued requests are handed to the kernel together by Submit, so a batch costs
+// one system call; Wait submits on its own, and a full queue is submitted automatically.
+class AsyncFile
+{
+private:
+	String   m_path;
+	intptr_t m_handle;
+
+	void Enqueue(UInt64 offset, unsigned char* data, Size count, Boolean write, AsyncRequest& request) const;
+public:
+	AsyncFile(const String& path, AsyncFileMode mode = AsyncFileMode::Read);
+
+	AsyncFile(const AsyncFile& other) = delete;
+
+	// Every request on the file must have completed.
+	~AsyncFile();
+
+	UInt64 GetLength() const;
+
+	void Read (UInt64 offset, BufferSpan<UInt8> destination, AsyncRequest& request) const { Enqueue(offset, (unsigned char*)destination.ToUnsafePointer(), destination.Count(), false, request); }
+	void Write(UInt64 offset, BufferSpan<UInt8> source,      AsyncRequest& request) const { Enqueue(offset, (unsigned char*)source.ToUnsafePointer(),      source.Count(),      true,  request); }
+
+	static void Submit();
+
+	// Pins the buffers with the kernel so requests inside them skip the per-request page mapping. Replaces any earlier
+	// set and must be called while no requests are pending. Returns false if the backend does not support it.
+	static Boolean RegisterBuffers(const ArraySpan<BufferSpan<UInt8>>& buffers);
+
+	static AsyncBackend GetBackend();
+
+	friend class AsyncRequest;
+	friend class AsyncEngine;
+};
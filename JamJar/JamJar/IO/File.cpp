@@ -0,0 +1,566 @@
+#include "File.hpp"
+#include "../Encoding.hpp"
+#include "../Exception.hpp"
+
+#include <new>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+static const size_t WriteChunkLength = 256U;
+
+// Room for one chunk of text at the worst UTF-8 expansion plus a replacement character.
+static const size_t MinimumWriteBuffer = WriteChunkLength * 4U + 3U;
+
+static size_t AlignBufferSize(Size size) { return (size.ToRawValue() + FileReader::Alignment - 1U) & ~(FileReader::Alignment - 1U); }
+
+static size_t WriteBufferSize(Size size) { return AlignBufferSize(size.ToRawValue() < MinimumWriteBuffer ? Size(MinimumWriteBuffer) : size); }
+
+static unsigned char* AllocateBuffer(size_t capacity) { return (unsigned char*)::operator new(capacity, std::align_val_t(FileReader::Alignment)); }
+
+static void FreeBuffer(unsigned char* buffer) { ::operator delete(buffer, std::align_val_t(FileReader::Alignment)); }
+
+// A null-terminated copy of a path in the form the operating system expects.
+class NativePath
+{
+private:
+#if defined(_WIN32)
+	wchar_t* m_path;
+public:
+	NativePath(const String& path) : m_path((wchar_t*)malloc((path.Length().ToRawValue() + 1U) * sizeof(wchar_t))) { path.CopyTo(m_path); }
+
+	const wchar_t* Get() const { return m_path; }
+#else
+	char* m_path;
+public:
+	NativePath(const String& path) : m_path((char*)malloc(path.GetUTF8Length().ToRawValue() + 1U)) { path.CopyTo(m_path); }
+
+	const char* Get() const { return m_path; }
+#endif
+
+	NativePath(const NativePath& other) = delete;
+
+	~NativePath() { free(m_path); }
+};
+
+#if defined(_WIN32)
+static OVERLAPPED GetOverlapped(uint64_t offset)
+{
+	OVERLAPPED overlapped = {};
+	overlapped.Offset     = DWORD(offset);
+	overlapped.OffsetHigh = DWORD(offset >> 32U);
+	return overlapped;
+}
+
+// The offset that makes WriteFile write at the end of the file.
+static const uint64_t AppendOffset = ~uint64_t(0U);
+
+static Boolean WriteToHandle(HANDLE handle, uint64_t offset, const void* data, size_t count)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	while(count > 0U)
+	{
+		OVERLAPPED overlapped = GetOverlapped(offset);
+
+		DWORD written;
+		if(!WriteFile(handle, bytes, DWORD(count < 0x40000000U ? count : 0x40000000U), &written, &overlapped))
+			return false;
+
+		bytes += written;
+		count -= written;
+
+		if(offset != AppendOffset)
+			offset += written;
+	}
+
+	return true;
+}
+#endif
+
+FileReader::FileReader(const String& path, FileAccess access, Boolean direct, Size bufferSize) :
+	m_path(path), m_handle(-1), m_buffer(nullptr), m_capacity(AlignBufferSize(bufferSize)), m_bufferOffset(0U), m_bufferStart(0U), m_bufferEnd(0U), m_direct(direct)
+{
+	NativePath nativePath(path);
+
+#if defined(_WIN32)
+	DWORD flags = FILE_ATTRIBUTE_NORMAL | (access == FileAccess::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN);
+	if(direct)
+		flags |= FILE_FLAG_NO_BUFFERING;
+
+	HANDLE handle = CreateFileW(nativePath.Get(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, flags, nullptr);
+	if(handle == INVALID_HANDLE_VALUE)
+		IOException("open", path).Throw();
+
+	m_handle = (intptr_t)handle;
+#else
+	int flags = O_RDONLY | O_CLOEXEC;
+#if defined(O_DIRECT)
+	if(direct)
+		flags |= O_DIRECT;
+#endif
+
+	int descriptor = open(nativePath.Get(), flags);
+	if(descriptor < 0)
+		IOException("open", path).Throw();
+
+#if !defined(O_DIRECT) && defined(F_NOCACHE)
+	if(direct)
+		fcntl(descriptor, F_NOCACHE, 1);
+#endif
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+	posix_fadvise(descriptor, 0, 0, access == FileAccess::Random ? POSIX_FADV_RANDOM : POSIX_FADV_SEQUENTIAL);
+#endif
+
+	m_handle = descriptor;
+#endif
+
+	m_buffer = AllocateBuffer(m_capacity);
+}
+
+FileReader::~FileReader()
+{
+#if defined(_WIN32)
+	CloseHandle((HANDLE)m_handle);
+#else
+	close(int(m_handle));
+#endif
+
+	FreeBuffer(m_buffer);
+}
+
+size_t FileReader::ReadFromHandle(uint64_t offset, void* destination, size_t count)
+{
+	unsigned char* bytes = (unsigned char*)destination;
+	size_t         total = 0U;
+
+	while(total < count)
+	{
+		size_t remaining = count - total;
+
+#if defined(_WIN32)
+		OVERLAPPED overlapped = GetOverlapped(offset + total);
+
+		DWORD read;
+		if(!ReadFile((HANDLE)m_handle, bytes + total, DWORD(remaining < 0x40000000U ? remaining : 0x40000000U), &read, &overlapped))
+		{
+			if(GetLastError() == ERROR_HANDLE_EOF)
+				break;
+
+			IOException("read", m_path).Throw();
+		}
+#else
+		ssize_t read = pread(int(m_handle), bytes + total, remaining, off_t(offset + total));
+		if(read < 0)
+		{
+			if(errno == EINTR)
+				continue;
+
+			IOException("read", m_path).Throw();
+		}
+#endif
+
+		if(read == 0)
+			break;
+
+		total += size_t(read);
+
+		// A short direct read means the end of the file, and the next offset would not be aligned anyway.
+		if(m_direct)
+			break;
+	}
+
+	return total;
+}
+
+Boolean FileReader::Fill()
+{
+	uint64_t position = GetPosition().ToRawValue();
+	uint64_t aligned  = position & ~uint64_t(Alignment - 1U);
+
+	m_bufferOffset = aligned;
+	m_bufferStart  = size_t(position - aligned);
+	m_bufferEnd    = ReadFromHandle(aligned, m_buffer, m_capacity);
+
+	// Seeking past the end leaves nothing to read, but the position must be kept.
+	if(m_bufferEnd < m_bufferStart)
+		m_bufferEnd = m_bufferStart;
+
+	return m_bufferEnd > m_bufferStart;
+}
+
+UInt64 FileReader::GetLength() const
+{
+#if defined(_WIN32)
+	LARGE_INTEGER length;
+	if(!GetFileSizeEx((HANDLE)m_handle, &length))
+		IOException("query", m_path).Throw();
+
+	return uint64_t(length.QuadPart);
+#else
+	struct stat status;
+	if(fstat(int(m_handle), &status) != 0)
+		IOException("query", m_path).Throw();
+
+	return uint64_t(status.st_size);
+#endif
+}
+
+void FileReader::Seek(UInt64 position)
+{
+	uint64_t target = position.ToRawValue();
+	if(target >= m_bufferOffset && target <= m_bufferOffset + m_bufferEnd)
+	{
+		m_bufferStart = size_t(target - m_bufferOffset);
+		return;
+	}
+
+	m_bufferOffset = target;
+	m_bufferStart  = 0U;
+	m_bufferEnd    = 0U;
+}
+
+Size FileReader::Read(void* destination, Size count)
+{
+	unsigned char* bytes     = (unsigned char*)destination;
+	size_t         remaining = count.ToRawValue();
+
+	while(remaining > 0U)
+	{
+		size_t available = m_bufferEnd - m_bufferStart;
+		if(available > 0U)
+		{
+			size_t copied = available < remaining ? available : remaining;
+			memcpy(bytes, m_buffer + m_bufferStart, copied);
+
+			m_bufferStart += copied;
+			bytes         += copied;
+			remaining     -= copied;
+			continue;
+		}
+
+		if(!m_direct && remaining >= m_capacity)
+		{
+			uint64_t position = GetPosition().ToRawValue();
+			size_t   read     = ReadFromHandle(position, bytes, remaining);
+
+			m_bufferOffset = position + read;
+			m_bufferStart  = 0U;
+			m_bufferEnd    = 0U;
+
+			remaining -= read;
+			break;
+		}
+
+		if(!Fill())
+			break;
+	}
+
+	return count - remaining;
+}
+
+Size FileReader::Read(DynamicBufferSpan destination)
+{
+	Size elementSize = destination.GetElementType().GetSize();
+	return Read(destination.ToUnsafePointer(), destination.GetByteCount()) / elementSize;
+}
+
+Size FileReader::ReadAt(UInt64 position, BufferSpan<UInt8> destination)
+{
+	if(!m_direct)
+		return ReadFromHandle(position.ToRawValue(), destination.ToUnsafePointer(), destination.Count().ToRawValue());
+
+	UInt64 previous = GetPosition();
+	Seek(position);
+
+	Size read = Read(destination);
+	Seek(previous);
+	return read;
+}
+
+FileWriter::FileWriter(const String& path, FileWriteMode mode, Size bufferSize) :
+	m_path(path), m_handle(-1), m_buffer(nullptr), m_capacity(WriteBufferSize(bufferSize)), m_count(0U), m_position(0U),
+	m_append(mode == FileWriteMode::Append)
+{
+	NativePath nativePath(path);
+
+	// In append mode the system places every write at the end of the file, so writers sharing it never overwrite each
+	// other; the position is only a count from the length the file had when it was opened.
+#if defined(_WIN32)
+	DWORD disposition = mode == FileWriteMode::Create ? CREATE_ALWAYS : OPEN_ALWAYS;
+	DWORD rights      = mode == FileWriteMode::Create ? GENERIC_WRITE : FILE_APPEND_DATA | SYNCHRONIZE;
+
+	HANDLE handle = CreateFileW(nativePath.Get(), rights, FILE_SHARE_READ, nullptr, disposition, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(handle == INVALID_HANDLE_VALUE)
+		IOException("open", path).Throw();
+
+	LARGE_INTEGER length;
+	if(mode == FileWriteMode::Append && GetFileSizeEx(handle, &length))
+		m_position = uint64_t(length.QuadPart);
+
+	m_handle = (intptr_t)handle;
+#else
+	int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (mode == FileWriteMode::Create ? O_TRUNC : O_APPEND);
+
+	int descriptor = open(nativePath.Get(), flags, 0644);
+	if(descriptor < 0)
+		IOException("open", path).Throw();
+
+	struct stat status;
+	if(mode == FileWriteMode::Append && fstat(descriptor, &status) == 0)
+		m_position = uint64_t(status.st_size);
+
+	m_handle = descriptor;
+#endif
+
+	m_buffer = AllocateBuffer(m_capacity);
+}
+
+// A destructor cannot report anything, so what is still buffered is written on a best-effort basis; call Close to find
+// out whether it arrived.
+FileWriter::~FileWriter()
+{
+	if(m_handle != -1)
+	{
+		if(m_count > 0U)
+			WriteThrough(nullptr, 0U);
+
+		CloseFile();
+	}
+
+	FreeBuffer(m_buffer);
+}
+
+void FileWriter::CloseFile()
+{
+#if defined(_WIN32)
+	CloseHandle((HANDLE)m_handle);
+#else
+	close(int(m_handle));
+#endif
+
+	m_handle = -1;
+}
+
+Boolean FileWriter::WriteThrough(const void* data, size_t count)
+{
+	size_t buffered = m_count;
+	m_count = 0U;
+
+#if defined(_WIN32)
+	uint64_t offset = m_append ? AppendOffset : m_position;
+	if(!WriteToHandle((HANDLE)m_handle, offset, m_buffer, buffered) || !WriteToHandle((HANDLE)m_handle, m_append ? offset : offset + buffered, data, count))
+		return false;
+
+	m_position += buffered + count;
+#else
+	struct iovec vectors[2] = { { m_buffer, buffered }, { (void*)data, count } };
+
+	// The descriptor's own offset starts at zero, or at the end in append mode, so no explicit offset is needed.
+	size_t index = buffered == 0U ? 1U : 0U;
+	while(index < 2U)
+	{
+		ssize_t written = writev(int(m_handle), vectors + index, int(2U - index));
+		if(written < 0)
+		{
+			if(errno == EINTR)
+				continue;
+
+			return false;
+		}
+
+		m_position += uint64_t(written);
+
+		size_t consumed = size_t(written);
+		while(index < 2U && consumed >= vectors[index].iov_len)
+		{
+			consumed -= vectors[index].iov_len;
+			index++;
+		}
+
+		if(index < 2U)
+		{
+			vectors[index].iov_base  = (unsigned char*)vectors[index].iov_base + consumed;
+			vectors[index].iov_len  -= consumed;
+		}
+	}
+#endif
+
+	return true;
+}
+
+void FileWriter::Write(const void* data, Size count)
+{
+	size_t length = count.ToRawValue();
+	if(length > m_capacity - m_count)
+	{
+		if(!WriteThrough(data, length))
+			IOException("write", m_path).Throw();
+
+		return;
+	}
+
+	memcpy(m_buffer + m_count, data, length);
+	m_count += length;
+}
+
+void FileWriter::Write(StringView text)
+{
+	const wchar_t* source    = (const wchar_t*)text.ToUnsafePointer();
+	size_t         remaining = text.Length().ToRawValue();
+
+	while(remaining > 0U)
+	{
+		size_t count = remaining < WriteChunkLength ? remaining : WriteChunkLength;
+
+		// Keep surrogate pairs within one chunk.
+		if(sizeof(wchar_t) == 2U && count < remaining && source[count - 1U] >= 0xD800U && source[count - 1U] <= 0xDBFFU)
+			count--;
+
+		if(m_capacity - m_count < count * 4U + 3U)
+			Flush();
+
+		EncodingResult result = Encoding::WideToUTF8(source, count, (char*)m_buffer + m_count);
+		m_count += result.GetCount().ToRawValue();
+
+		if(!result.IsValid())
+		{
+			memcpy(m_buffer + m_count, "\xEF\xBF\xBD", 3U);
+			m_count += 3U;
+
+			count = result.GetPosition().ToRawValue() + 1U;
+		}
+
+		source    += count;
+		remaining -= count;
+	}
+}
+
+void FileWriter::Flush()
+{
+	if(m_count > 0U && !WriteThrough(nullptr, 0U))
+		IOException("write", m_path).Throw();
+}
+
+void FileWriter::Close()
+{
+	if(m_handle == -1)
+		return;
+
+	Flush();
+	CloseFile();
+}
+
+// Returns true if the bytes are the start of a UTF-8 sequence that continues past them.
+static Boolean IsTruncatedSequence(const unsigned char* bytes, size_t count)
+{
+	size_t length;
+	if((bytes[0] & 0xE0U) == 0xC0U)
+		length = 2U;
+	else if((bytes[0] & 0xF0U) == 0xE0U)
+		length = 3U;
+	else if((bytes[0] & 0xF8U) == 0xF0U)
+		length = 4U;
+	else
+		return false;
+
+	if(count >= length)
+		return false;
+
+	for(size_t i = 1U; i < count; i++)
+	{
+		if((bytes[i] & 0xC0U) != 0x80U)
+			return false;
+	}
+
+	return true;
+}
+
+FileLineReader::FileLineReader(const String& path) : m_reader(path), m_chars(HeapArray<Character>::Empty), m_position(0U), m_count(0U) {}
+
+// Decodes the next block of the file into a new array that starts with the unfinished line of the previous one.
+Boolean FileLineReader::Decode()
+{
+	if(m_reader.m_bufferEnd - m_reader.m_bufferStart < 4U)
+		m_reader.Fill();
+
+	const unsigned char* bytes     = m_reader.m_buffer + m_reader.m_bufferStart;
+	size_t               available = m_reader.m_bufferEnd - m_reader.m_bufferStart;
+	if(available == 0U)
+		return false;
+
+	// Less than a whole sequence after a refill can only be the end of the file.
+	Boolean canDefer = available >= 4U;
+
+	// Every byte decodes to at most one unit, in both UTF-16 and UTF-32.
+	size_t carried = m_count - m_position;
+
+	SharedArrayRef<Character> chars = HeapArray<Character>(carried + available);
+	wchar_t* dest = (wchar_t*)chars.ToUnsafePointer();
+	memcpy(dest, m_chars.ToUnsafePointer() + m_position, carried * sizeof(Character));
+
+	size_t count    = carried;
+	size_t consumed = 0U;
+	while(consumed < available)
+	{
+		EncodingResult result = Encoding::UTF8ToWide((const char*)bytes + consumed, available - consumed, dest + count);
+		count    += result.GetCount().ToRawValue();
+		consumed += result.GetPosition().ToRawValue();
+
+		if(result.IsValid())
+			break;
+
+		// A sequence cut off by the end of the buffer is decoded with the next block.
+		if(canDefer && IsTruncatedSequence(bytes + consumed, available - consumed))
+			break;
+
+		dest[count++] = L'\xFFFD';
+		consumed++;
+	}
+
+	m_reader.m_bufferStart += consumed;
+
+	m_chars    = chars;
+	m_position = 0U;
+	m_count    = count;
+	return true;
+}
+
+Boolean FileLineReader::TryReadLine(String& line)
+{
+	while(true)
+	{
+		const wchar_t* chars   = (const wchar_t*)m_chars.ToUnsafePointer();
+		const wchar_t* newline = wmemchr(chars + m_position, L'\n', m_count - m_position);
+		if(newline)
+		{
+			size_t end    = size_t(newline - chars);
+			size_t length = end - m_position;
+			if(length > 0U && chars[end - 1U] == L'\r')
+				length--;
+
+			line       = String(SharedArraySpan<Character>(m_chars, m_position, length));
+			m_position = end + 1U;
+			return true;
+		}
+
+		if(!Decode())
+			break;
+	}
+
+	if(m_position == m_count)
+		return false;
+
+	line       = String(SharedArraySpan<Character>(m_chars, m_position, m_count - m_position));
+	m_position = m_count;
+	return true;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../String.hpp"
+#include "../Data/Memory/Buffer.hpp"
+
+enum class FileAccess : uint8_t
+{
+	Sequential,
+	Random,
+};
+
+enum class FileWriteMode : uint8_t
+{
+	Create,
+	Append,
+};
+
+// Reads a file through one large, page-aligned buffer using positional reads, so the reader never depends on the
+// shared file offset. Requests at least as large as the buffer are read straight into the destination.
+//
+// With direct set the operating system cache is bypassed (O_DIRECT, F_NOCACHE or FILE_FLAG_NO_BUFFERING). That only
+// pays off for large one-pass reads; all reads then go through the buffer, since they must be aligned.
+class FileReader
+{
+private:
+	String         m_path;
+	intptr_t       m_handle;
+	unsigned char* m_buffer;
+	size_t         m_capacity;
+	uint64_t       m_bufferOffset;
+	size_t         m_bufferStart;
+	size_t         m_bufferEnd;
+	Boolean        m_direct;
+
+	size_t ReadFromHandle(uint64_t offset, void* destination, size_t count);
+
+	// Refills the buffer from the current position. Returns false at the end of the file.
+	Boolean Fill();
+public:
+	static const size_t DefaultBufferSize = 1U << 20U;
+	static const size_t Alignment         = 4096U;
+
+	FileReader(const String& path, FileAccess access = FileAccess::Sequential, Boolean direct = false, Size bufferSize = DefaultBufferSize);
+
+	FileReader(const FileReader& other) = delete;
+
+	~FileReader();
+
+	UInt64 GetLength() const;
+
+	UInt64 GetPosition() const { return m_bufferOffset + m_bufferStart; }
+	void   Seek(UInt64 position);
+
+	// Each Read fills as much of the destination as the file allows and returns the number of elements (or bytes, for
+	// Read(void*, Size)) read. A short count means the end of the file was reached.
+	Size Read(void* destination, Size count);
+	Size Read(BufferSpan<UInt8> destination) { return Read(destination.ToUnsafePointer(), destination.Count()); }
+	Size Read(DynamicBufferSpan destination);
+
+	// Reads at an absolute position without moving the reader.
+	Size ReadAt(UInt64 position, BufferSpan<UInt8> destination);
+
+	friend class FileLineReader;
+};
+
+// Writes a file through one large buffer. A write that does not fit is sent together with the buffered bytes in a
+// single vectored call, so large spans are never copied.
+class FileWriter
+{
+private:
+	String         m_path;
+	intptr_t       m_handle;
+	unsigned char* m_buffer;
+	size_t         m_capacity;
+	size_t         m_count;
+	uint64_t       m_position;
+	Boolean        m_append;
+
+	// Writes the buffered bytes and then the given ones. Returns false if the system refused them.
+	Boolean WriteThrough(const void* data, size_t count);
+
+	void CloseFile();
+public:
+	static const size_t DefaultBufferSize = 1U << 20U;
+
+	FileWriter(const String& path, FileWriteMode mode = FileWriteMode::Create, Size bufferSize = DefaultBufferSize);
+
+	FileWriter(const FileWriter& other) = delete;
+
+	~FileWriter();
+
+	UInt64 GetPosition() const { return m_position + m_count; }
+
+	void Write(const void* data, Size count);
+	void Write(BufferSpan<UInt8> data) { Write(data.ToUnsafePointer(), data.Count()); }
+	void Write(DynamicBufferSpan data) { Write(data.ToUnsafePointer(), data.GetByteCount()); }
+
+	// Writes the text as UTF-8.
+	void Write(StringView text);
+
+	// Hands the buffered bytes to the operating system.
+	void Flush();
+
+	// Flushes and closes the file, reporting a failed write, which the destructor cannot. Nothing may be written after.
+	void Close();
+};
+
+// Splits a UTF-8 file into lines. Each block of the file is decoded once into a shared character array and the lines
+// are returned as slices of it, so a line costs no allocation unless it crosses a block boundary. "\n" and "\r\n" are
+// both accepted as line endings, and invalid UTF-8 is replaced with U+FFFD.
+class FileLineReader
+{
+private:
+	FileReader                m_reader;
+	SharedArrayRef<Character> m_chars;
+	size_t                    m_position;
+	size_t                    m_count;
+
+	Boolean Decode();
+public:
+	FileLineReader(const String& path);
+
+	Boolean TryReadLine(String& line);
+};
@@ -0,0 +1,263 @@
+#include "MappedFile.hpp"
+#include "../Encoding.hpp"
+#include "../Exception.hpp"
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const String& path, FileAccess access) : m_path(path), m_data(nullptr), m_count(0U)
+{
+#if defined(_WIN32)
+	wchar_t* nativePath = (wchar_t*)malloc((path.Length().ToRawValue() + 1U) * sizeof(wchar_t));
+	path.CopyTo(nativePath);
+
+	DWORD flags = access == FileAccess::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+
+	HANDLE handle = CreateFileW(nativePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+	free(nativePath);
+
+	if(handle == INVALID_HANDLE_VALUE)
+		IOException("open", path).Throw();
+
+	LARGE_INTEGER length;
+	if(!GetFileSizeEx(handle, &length) || uint64_t(length.QuadPart) > SIZE_MAX)
+	{
+		CloseHandle(handle);
+		IOException("map", path).Throw();
+	}
+
+	m_count = size_t(length.QuadPart);
+	if(m_count == 0U)
+	{
+		CloseHandle(handle);
+		return;
+	}
+
+	// The view keeps the mapping and the file open on its own.
+	HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0U, 0U, nullptr);
+	CloseHandle(handle);
+
+	if(!mapping)
+		IOException("map", path).Throw();
+
+	m_data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0U, 0U, 0U);
+	CloseHandle(mapping);
+
+	if(!m_data)
+		IOException("map", path).Throw();
+#else
+	char* nativePath = (char*)malloc(path.GetUTF8Length().ToRawValue() + 1U);
+	path.CopyTo(nativePath);
+
+	int descriptor = open(nativePath, O_RDONLY | O_CLOEXEC);
+	free(nativePath);
+
+	if(descriptor < 0)
+		IOException("open", path).Throw();
+
+	struct stat status;
+	if(fstat(descriptor, &status) != 0 || uint64_t(status.st_size) > SIZE_MAX)
+	{
+		close(descriptor);
+		IOException("map", path).Throw();
+	}
+
+	m_count = size_t(status.st_size);
+	if(m_count == 0U)
+	{
+		close(descriptor);
+		return;
+	}
+
+	void* address = mmap(nullptr, m_count, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+
+	if(address == MAP_FAILED)
+		IOException("map", path).Throw();
+
+	madvise(address, m_count, access == FileAccess::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+	m_data = (const unsigned char*)address;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	if(!m_data)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(m_data);
+#else
+	munmap((void*)m_data, m_count);
+#endif
+}
+
+String TextLine::ToString() const
+{
+	if(m_count == 0U)
+		return String();
+
+	// Every byte decodes to at most one unit, in both UTF-16 and UTF-32.
+	SharedArrayRef<Character> chars = HeapArray<Character>(m_count);
+	wchar_t* dest = (wchar_t*)chars.ToUnsafePointer();
+
+	size_t count    = 0U;
+	size_t consumed = 0U;
+	while(consumed < m_count)
+	{
+		EncodingResult result = Encoding::UTF8ToWide(m_data + consumed, m_count - consumed, dest + count);
+		count    += result.GetCount().ToRawValue();
+		consumed += result.GetPosition().ToRawValue();
+
+		if(result.IsValid())
+			break;
+
+		dest[count++] = L'\xFFFD';
+		consumed++;
+	}
+
+	return String(SharedArraySpan<Character>(chars, 0U, count));
+}
+
+Boolean TextChunk::TryReadLine(TextLine& line)
+{
+	if(m_position == m_count)
+		return false;
+
+	const char* start   = m_data + m_position;
+	const char* newline = (const char*)memchr(start, '\n', m_count - m_position);
+
+	size_t length;
+	if(newline)
+	{
+		length     = size_t(newline - start);
+		m_position += length + 1U;
+
+		if(length > 0U && start[length - 1U] == '\r')
+			length--;
+	}
+	else
+	{
+		length     = m_count - m_position;
+		m_position = m_count;
+	}
+
+	line = TextLine(start, length);
+	return true;
+}
+
+MappedTextReader::MappedTextReader(const String& path) : m_file(path), m_chunk((const char*)m_file.ToUnsafePointer(), m_file.Count()) {}
+
+Boolean MappedTextReader::TryReadLine(String& line)
+{
+	TextLine bytes;
+	if(!m_chunk.TryReadLine(bytes))
+		return false;
+
+	line = bytes.ToString();
+	return true;
+}
+
+HeapArray<TextChunk> MappedTextReader::Split(Size count) const
+{
+	const char* data   = (const char*)m_file.ToUnsafePointer();
+	size_t      length = m_file.Count().ToRawValue();
+
+	size_t chunkCount = count.ToRawValue();
+	if(chunkCount == 0U)
+		chunkCount = 1U;
+
+	HeapArray<TextChunk> result(chunkCount);
+
+	// Each chunk ends just after the first line ending at or past its share of the file, so a later chunk may end up
+	// empty when lines are long.
+	size_t start = 0U;
+	for(size_t i = 0U; i < chunkCount; i++)
+	{
+		size_t end = i + 1U == chunkCount ? length : uint64_t(length) * (i + 1U) / chunkCount;
+		if(end < start)
+			end = start;
+
+		if(end < length && end > 0U)
+		{
+			const char* newline = (const char*)memchr(data + end - 1U, '\n', length - end + 1U);
+			end = newline ? size_t(newline - data) + 1U : length;
+		}
+
+		result[i] = TextChunk(data + start, end - start);
+		start = end;
+	}
+
+	return result;
+}
+
+// Joins the threads when it goes out of scope, so none of them outlives the call that started them, even one that throws.
+class ThreadJoiner
+{
+private:
+	std::vector<std::thread>& m_threads;
+public:
+	ThreadJoiner(std::vector<std::thread>& threads) : m_threads(threads) {}
+
+	ThreadJoiner(const ThreadJoiner& other) = delete;
+
+	~ThreadJoiner()
+	{
+		for(std::thread& thread : m_threads)
+			thread.join();
+	}
+};
+
+void MappedTextReader::ReadParallel(TextChunkCallback callback, void* context, Size threadCount) const
+{
+	size_t workers = threadCount.ToRawValue();
+	if(workers == 0U)
+		workers = std::thread::hardware_concurrency();
+	if(workers == 0U)
+		workers = 1U;
+
+	HeapArray<TextChunk> chunks = Split(workers);
+
+	// A worker's exception is kept until every thread has finished and then rethrown on the calling thread.
+	std::vector<std::exception_ptr> errors(workers);
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(workers - 1U);
+
+		ThreadJoiner joiner(threads);
+		for(size_t i = 1U; i < workers; i++)
+		{
+			threads.emplace_back([&chunks, &errors, callback, context, i]()
+			{
+				try
+				{
+					callback(chunks[i], i, context);
+				}
+				catch(...)
+				{
+					errors[i] = std::current_exception();
+				}
+			});
+		}
+
+		callback(chunks[0U], 0U, context);
+	}
+
+	for(const std::exception_ptr& error : errors)
+	{
+		if(error)
+			std::rethrow_exception(error);
+	}
+}
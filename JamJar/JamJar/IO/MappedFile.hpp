@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../String.hpp"
+#include "../Delegate.hpp"
+#include "../Data/Memory/Array.hpp"
+#include "File.hpp"
+
+// Maps a whole file into memory read-only. The pages are loaded on first access, so opening even a very large file is
+// cheap; the access hint tells the operating system whether to read ahead.
+class MappedFile
+{
+private:
+	String               m_path;
+	const unsigned char* m_data;
+	size_t               m_count;
+public:
+	MappedFile(const String& path, FileAccess access = FileAccess::Sequential);
+
+	MappedFile(const MappedFile& other) = delete;
+
+	~MappedFile();
+
+	Size Count() const { return m_count; }
+
+	// Null for an empty file. Valid until the file is destroyed.
+	const void* ToUnsafePointer() const { return m_data; }
+};
+
+// One line as raw UTF-8 without its line ending. It points into the mapping, which must outlive it.
+class TextLine
+{
+private:
+	const char* m_data;
+	size_t      m_count;
+public:
+	TextLine() : m_data(nullptr), m_count(0U) {}
+
+	TextLine(const char* data, Size count) : m_data(data), m_count(count.ToRawValue()) {}
+
+	Size Count() const { return m_count; }
+
+	Boolean IsEmpty() const { return m_count == 0U; }
+
+	const char* ToUnsafePointer() const { return m_data; }
+
+	char operator[](Size index) const { return m_data[index.ToRawValue()]; }
+
+	Boolean StartsWith(const char* prefix) const
+	{
+		size_t length = strlen(prefix);
+		return length <= m_count && memcmp(m_data, prefix, length) == 0;
+	}
+
+	// Decodes the line, replacing invalid UTF-8 with U+FFFD.
+	String ToString() const;
+};
+
+// A run of whole lines. "\n" and "\r\n" are both accepted as line endings.
+class TextChunk
+{
+private:
+	const char* m_data;
+	size_t      m_count;
+	size_t      m_position;
+public:
+	TextChunk() : m_data(nullptr), m_count(0U), m_position(0U) {}
+
+	TextChunk(const char* data, Size count) : m_data(data), m_count(count.ToRawValue()), m_position(0U) {}
+
+	Size Count() const { return m_count; }
+
+	const char* ToUnsafePointer() const { return m_data; }
+
+	Boolean TryReadLine(TextLine& line);
+};
+
+class MappedTextReader;
+
+// Called once per chunk, possibly on several threads at once. The index tells chunks apart, so each can keep its own
+// results without locking.
+using TextChunkCallback = Function<void, TextChunk&, Size, void*>;
+
+// Reads a UTF-8 text file through a mapping, so lines are never copied. Line ends are found with memchr, which the C
+// library vectorizes, and TextLine::ToString decodes a line only when it is needed.
+class MappedTextReader
+{
+private:
+	MappedFile m_file;
+	TextChunk  m_chunk;
+public:
+	MappedTextReader(const String& path);
+
+	MappedTextReader(const MappedTextReader& other) = delete;
+
+	Size Count() const { return m_file.Count(); }
+
+	Boolean TryReadLine(TextLine& line) { return m_chunk.TryReadLine(line); }
+
+	Boolean TryReadLine(String& line);
+
+	// Splits the file into at most count chunks of about the same size that start and end on line boundaries.
+	HeapArray<TextChunk> Split(Size count) const;
+
+	// Splits the file into one chunk per thread and reads them in parallel, using the calling thread as one of the
+	// workers. A thread count of zero uses one thread per processor. If a callback throws, the exception reaches the
+	// caller once every thread has finished.
+	void ReadParallel(TextChunkCallback callback, void* context = nullptr, Size threadCount = 0U) const;
+};
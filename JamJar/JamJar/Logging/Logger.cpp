@@ -0,0 +1,482 @@
+#include "Logger.hpp"
+
+#include "../Console.hpp"
+
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+static const size_t MaximumSinks = 8U;
+
+// How long the writer thread keeps looking for records before it goes to sleep. Waking it costs the logging thread a
+// system call, so a steady stream of records should always find it awake.
+static const std::chrono::microseconds IdleSpin(100);
+
+struct LogRecordHeader
+{
+	LogDecoder  decoder;
+	const char* format;
+	uint64_t    timestamp;
+	uint32_t    size;
+	LogLevel    level;
+};
+
+static_assert(sizeof(LogRecordHeader) % 8U == 0U);
+
+static size_t AlignRecord(size_t size) { return (size + 7U) & ~size_t(7U); }
+
+// Single-producer, single-consumer byte ring. Records never wrap: if one does not fit before the end, the rest of the
+// ring is skipped (with a header that has no decoder, or implicitly when not even a header fits).
+class LogRing
+{
+private:
+	unsigned char* m_data;
+	size_t         m_capacity;
+
+	alignas(64) std::atomic<size_t> m_head;
+	size_t m_pendingHead;
+	size_t m_cachedTail;
+
+	alignas(64) std::atomic<size_t> m_tail;
+public:
+	std::atomic<bool> abandoned;
+	LogRing*          next;
+
+	// The capacity must be a power of two. The memory is touched here, so the page faults of a fresh allocation are
+	// taken by the thread's first record rather than spread over the calls that fill the ring.
+	explicit LogRing(size_t capacity) :
+		m_data((unsigned char*)malloc(capacity)), m_capacity(capacity), m_head(0U), m_pendingHead(0U), m_cachedTail(0U), m_tail(0U), abandoned(false), next(nullptr)
+	{
+		memset(m_data, 0, capacity);
+	}
+
+	LogRing(const LogRing& other) = delete;
+
+	~LogRing() { free(m_data); }
+
+	size_t Capacity() const { return m_capacity; }
+
+	Boolean IsEmpty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed); }
+
+	unsigned char* Begin(size_t size)
+	{
+		size_t head     = m_head.load(std::memory_order_relaxed);
+		size_t position = head & (m_capacity - 1U);
+		size_t skipped  = m_capacity - position < size ? m_capacity - position : 0U;
+
+		if(head + skipped + size - m_cachedTail > m_capacity)
+		{
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+			if(head + skipped + size - m_cachedTail > m_capacity)
+				return nullptr;
+		}
+
+		if(skipped >= sizeof(LogRecordHeader))
+		{
+			LogRecordHeader* padding = (LogRecordHeader*)(m_data + position);
+			padding->decoder = nullptr;
+			padding->size    = uint32_t(skipped);
+		}
+
+		m_pendingHead = head + skipped + size;
+		return m_data + ((head + skipped) & (m_capacity - 1U));
+	}
+
+	void Commit() { m_head.store(m_pendingHead, std::memory_order_release); }
+
+	// Formats every published record into output. Returns false if there was nothing to read.
+	Boolean Drain(StringBuilder& output);
+};
+
+class LogCore
+{
+private:
+	std::mutex              m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_flushed;
+	std::thread             m_thread;
+
+	// Set by the writer thread before it waits for records, and cleared by whoever wakes it.
+	std::atomic<bool> m_sleeping;
+
+	// Only the writer thread walks and unlinks these. New rings wait in m_newRings, under the mutex, until it takes them.
+	LogRing* m_rings;
+	LogRing* m_newRings;
+
+	// The rest is guarded by the mutex. Sinks are never removed, so the writer thread can keep pointers to them.
+	NullableRef<LogSink> m_sinks[MaximumSinks];
+	size_t               m_sinkCount;
+
+	uint64_t m_flushRequested;
+	uint64_t m_flushCompleted;
+	bool     m_running;
+
+	void Run();
+	void AdoptRings();
+	Boolean DrainAll(StringBuilder& output);
+	Boolean HasRecords();
+public:
+	const std::chrono::steady_clock::time_point start;
+
+	std::atomic<uint64_t> dropped;
+
+	LogCore();
+	~LogCore();
+
+	void Register(LogRing* ring);
+	void AddSink(const SharedRef<LogSink>& sink);
+	void Flush();
+
+	// Called after a record is committed. Costs a fence and a load unless the writer thread is asleep.
+	void Notify();
+};
+
+static LogCore& GetCore()
+{
+	static LogCore core;
+	return core;
+}
+
+class LogRingOwner
+{
+public:
+	LogRing* ring;
+
+	LogRingOwner() : ring(new LogRing(Logger::GetRingCapacity().ToRawValue())) { GetCore().Register(ring); }
+
+	~LogRingOwner() { ring->abandoned.store(true, std::memory_order_release); }
+};
+
+static thread_local LogRingOwner s_ringOwner;
+
+static const char* GetLevelName(LogLevel level)
+{
+	switch(level)
+	{
+		case LogLevel::Trace:       return "Trace";
+		case LogLevel::Debug:       return "Debug";
+		case LogLevel::Information: return "Information";
+		case LogLevel::Warning:     return "Warning";
+		case LogLevel::Error:       return "Error";
+		case LogLevel::Fatal:       return "Fatal";
+		default:                    return "None";
+	}
+}
+
+static void AppendTimestamp(uint64_t nanoseconds, StringBuilder& output)
+{
+	uint64_t microseconds = (nanoseconds / 1000U) % 1000000U;
+
+	output.Append(UInt64(nanoseconds / 1000000000U)).Append(Character(L'.'));
+	for(uint64_t divisor = 100000U; divisor > 0U; divisor /= 10U)
+		output.Append(Character(wchar_t(L'0' + (microseconds / divisor) % 10U)));
+}
+
+Boolean LogRing::Drain(StringBuilder& output)
+{
+	size_t tail = m_tail.load(std::memory_order_relaxed);
+	size_t head = m_head.load(std::memory_order_acquire);
+	if(tail == head)
+		return false;
+
+	while(tail != head)
+	{
+		size_t position  = tail & (m_capacity - 1U);
+		size_t remaining = m_capacity - position;
+		if(remaining < sizeof(LogRecordHeader))
+		{
+			tail += remaining;
+			continue;
+		}
+
+		const LogRecordHeader* header = (const LogRecordHeader*)(m_data + position);
+		if(header->decoder)
+		{
+			output.Append(Character(L'['));
+			AppendTimestamp(header->timestamp, output);
+			output.Append("] [").Append(GetLevelName(header->level)).Append("] ");
+
+			header->decoder(m_data + position + sizeof(LogRecordHeader), header->format, output);
+			output.Append(Character(L'\n'));
+		}
+
+		tail += header->size;
+	}
+
+	m_tail.store(tail, std::memory_order_release);
+	return true;
+}
+
+LogCore::LogCore() :
+	m_sleeping(false), m_rings(nullptr), m_newRings(nullptr), m_sinkCount(0U), m_flushRequested(0U), m_flushCompleted(0U), m_running(true),
+	start(std::chrono::steady_clock::now()), dropped(0U)
+{
+	m_thread = std::thread([this]() { Run(); });
+}
+
+LogCore::~LogCore()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+
+	m_wake.notify_one();
+	m_thread.join();
+
+	AdoptRings();
+	while(m_rings)
+	{
+		LogRing* next = m_rings->next;
+		delete m_rings;
+		m_rings = next;
+	}
+}
+
+void LogCore::Register(LogRing* ring)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	ring->next = m_newRings;
+	m_newRings = ring;
+}
+
+void LogCore::AddSink(const SharedRef<LogSink>& sink)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if(m_sinkCount < MaximumSinks)
+		m_sinks[m_sinkCount++] = sink;
+}
+
+void LogCore::Flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	uint64_t request = ++m_flushRequested;
+	m_wake.notify_one();
+	m_flushed.wait(lock, [&]() { return m_flushCompleted >= request || !m_running; });
+}
+
+// Pairs with the fence in Run: either the writer thread sees the record when it looks again before waiting, or this
+// sees it asleep and wakes it. Taking the mutex makes sure it is already waiting, or has yet to test its predicate.
+void LogCore::Notify()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(!m_sleeping.load(std::memory_order_relaxed) || !m_sleeping.exchange(false))
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+	}
+	m_wake.notify_one();
+}
+
+// Called with the mutex held.
+void LogCore::AdoptRings()
+{
+	while(m_newRings)
+	{
+		LogRing* ring = m_newRings;
+		m_newRings = ring->next;
+		ring->next = m_rings;
+		m_rings    = ring;
+	}
+}
+
+Boolean LogCore::HasRecords()
+{
+	for(LogRing* ring = m_rings; ring; ring = ring->next)
+	{
+		if(!ring->IsEmpty())
+			return true;
+	}
+
+	return false;
+}
+
+Boolean LogCore::DrainAll(StringBuilder& output)
+{
+	Boolean drained = false;
+
+	LogRing** link = &m_rings;
+	while(*link)
+	{
+		LogRing* ring = *link;
+
+		// Read the flag before draining, so a ring is only freed once its final records have been seen.
+		bool abandoned = ring->abandoned.load(std::memory_order_acquire);
+		if(ring->Drain(output))
+			drained = true;
+
+		if(abandoned)
+		{
+			*link = ring->next;
+			delete ring;
+		}
+		else
+			link = &ring->next;
+	}
+
+	return drained;
+}
+
+// The mutex is only held to pick up new rings, sinks and flush requests, and to go to sleep. Records are formatted and
+// written without it, so threads logging for the first time, adding sinks or flushing never wait for the sinks' I/O.
+void LogCore::Run()
+{
+	StringBuilder output;
+
+	LogSink* sinks[MaximumSinks];
+	size_t   sinkCount = 0U;
+	bool     unflushed = false;
+
+	while(true)
+	{
+		bool     running;
+		uint64_t request;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			running = m_running;
+			request = m_flushRequested;
+
+			AdoptRings();
+			for(; sinkCount < m_sinkCount; sinkCount++)
+				sinks[sinkCount] = &*m_sinks[sinkCount];
+		}
+
+		Boolean drained = DrainAll(output);
+		if(drained)
+		{
+			String text = output.ToString();
+			output.Clear();
+
+			for(size_t i = 0U; i < sinkCount; i++)
+				sinks[i]->Write(text);
+
+			unflushed = true;
+		}
+
+		// Sinks are flushed once the rings run dry, or straight away when a caller is waiting in Flush. Only this thread
+		// writes m_flushCompleted, so it can read it without the mutex.
+		if((!drained && unflushed) || request != m_flushCompleted)
+		{
+			for(size_t i = 0U; i < sinkCount; i++)
+				sinks[i]->Flush();
+
+			unflushed = false;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_flushCompleted = request;
+			}
+			m_flushed.notify_all();
+		}
+
+		if(!running)
+			break;
+
+		if(!drained)
+		{
+			std::chrono::steady_clock::time_point idle = std::chrono::steady_clock::now();
+			while(!HasRecords() && std::chrono::steady_clock::now() - idle < IdleSpin)
+				std::this_thread::yield();
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_sleeping.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			// A ring that is registered but not adopted yet may hold records too.
+			if(m_newRings || HasRecords())
+				m_sleeping.store(false, std::memory_order_relaxed);
+			else
+				m_wake.wait(lock, [this]() { return !m_sleeping.load(std::memory_order_relaxed) || m_flushRequested != m_flushCompleted || !m_running; });
+
+			m_sleeping.store(false, std::memory_order_relaxed);
+		}
+	}
+}
+
+std::atomic<LogLevel> Logger::s_level(LogLevel::Trace);
+std::atomic<size_t>   Logger::s_ringCapacity(64U * 1024U);
+
+void Logger::SetRingCapacity(Size bytes)
+{
+	size_t capacity = bytes.ToRawValue() < 4096U ? 4096U : bytes.ToRawValue();
+	s_ringCapacity.store(std::bit_ceil(capacity), std::memory_order_relaxed);
+}
+
+Size Logger::GetRingCapacity() { return s_ringCapacity.load(std::memory_order_relaxed); }
+
+unsigned char* Logger::BeginRecord(LogLevel level, LogDecoder decoder, const char* format, size_t payloadSize)
+{
+	LogRing* ring = s_ringOwner.ring;
+
+	size_t size = AlignRecord(sizeof(LogRecordHeader) + payloadSize);
+	if(size > ring->Capacity() / 2U)
+	{
+		GetCore().dropped.fetch_add(1U, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	unsigned char* record = ring->Begin(size);
+	if(!record)
+	{
+		GetCore().dropped.fetch_add(1U, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	LogRecordHeader* header = (LogRecordHeader*)record;
+	header->decoder   = decoder;
+	header->format    = format;
+	header->timestamp = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - GetCore().start).count());
+	header->size      = uint32_t(size);
+	header->level     = level;
+
+	return record + sizeof(LogRecordHeader);
+}
+
+void Logger::CommitRecord()
+{
+	s_ringOwner.ring->Commit();
+	GetCore().Notify();
+}
+
+const char* Logger::AppendLiteral(const char* format, StringBuilder& output)
+{
+	while(*format)
+	{
+		if(format[0] == '{' && format[1] == '}')
+			return format + 2;
+
+		if(*format == '{' || *format == '}')
+		{
+			// A doubled brace stands for one.
+			output.Append(Character(wchar_t(*format)));
+			format += format[1] == format[0] ? 2 : 1;
+			continue;
+		}
+
+		size_t run = 1U;
+		while(format[run] && format[run] != '{' && format[run] != '}')
+			run++;
+
+		output.Append(format, run);
+		format += run;
+	}
+
+	return format;
+}
+
+void Logger::AddSink(const SharedRef<LogSink>& sink) { GetCore().AddSink(sink); }
+
+void Logger::Flush() { GetCore().Flush(); }
+
+UInt64 Logger::GetDroppedCount() { return GetCore().dropped.load(std::memory_order_relaxed); }
+
+void ConsoleLogSink::Write(const String& text) { Console::Print(text); }
+
+void ConsoleLogSink::Flush() { Console::Flush(); }
+
+void FileLogSink::Write(const String& text) { m_file.Write(text); }
+
+void FileLogSink::Flush() { m_file.Flush(); }
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "../String.hpp"
+#include "../StringBuilder.hpp"
+#include "../Data/Memory/Refs.hpp"
+#include "../IO/File.hpp"
+
+#include <atomic>
+
+enum class LogLevel : uint8_t
+{
+	Trace,
+	Debug,
+	Information,
+	Warning,
+	Error,
+	Fatal,
+	None,
+};
+
+// Records below this level are compiled out entirely.
+#if !defined(JAMJAR_LOG_MINIMUM_LEVEL)
+#define JAMJAR_LOG_MINIMUM_LEVEL Trace
+#endif
+
+class LogSink
+{
+public:
+	virtual ~LogSink() {}
+
+	// Receives a batch of complete, newline-terminated records.
+	virtual void Write(const String& text) = 0;
+	virtual void Flush() {}
+};
+
+class ConsoleLogSink : public LogSink
+{
+public:
+	virtual void Write(const String& text) override;
+	virtual void Flush() override;
+};
+
+class FileLogSink : public LogSink
+{
+private:
+	FileWriter m_file;
+public:
+	// Records are appended to the file if it already exists.
+	FileLogSink(const String& path) : m_file(path, FileWriteMode::Append) {}
+
+	virtual void Write(const String& text) override;
+	virtual void Flush() override;
+};
+
+// How an argument is stored in a log record. Encode copies the value into the record on the logging thread, Decode
+// reads it back and appends it to the output on the background thread. Sizes are multiples of 8 bytes.
+template<typename T>
+struct LogArgument;
+
+template<typename T>
+struct LogRawArgument
+{
+	static size_t Measure(const T& value) { return (sizeof(T) + 7U) & ~size_t(7U); }
+
+	static size_t Encode(const T& value, unsigned char* destination)
+	{
+		memcpy(destination, &value, sizeof(T));
+		return Measure(value);
+	}
+};
+
+template<std::unsigned_integral T>
+struct LogArgument<UnsignedInteger<T>> : LogRawArgument<UnsignedInteger<T>>
+{
+	static size_t Decode(const unsigned char* source, StringBuilder& output)
+	{
+		T value;
+		memcpy(&value, source, sizeof(T));
+		output.Append(UnsignedInteger<T>(value));
+		return (sizeof(T) + 7U) & ~size_t(7U);
+	}
+};
+
+template<std::signed_integral T>
+struct LogArgument<SignedInteger<T>> : LogRawArgument<SignedInteger<T>>
+{
+	static size_t Decode(const unsigned char* source, StringBuilder& output)
+	{
+		T value;
+		memcpy(&value, source, sizeof(T));
+		output.Append(SignedInteger<T>(value));
+		return (sizeof(T) + 7U) & ~size_t(7U);
+	}
+};
+
+template<std::floating_point T>
+struct LogArgument<Float<T>> : LogRawArgument<Float<T>>
+{
+	static size_t Decode(const unsigned char* source, StringBuilder& output)
+	{
+		T value;
+		memcpy(&value, source, sizeof(T));
+		output.Append(Float<T>(value));
+		return (sizeof(T) + 7U) & ~size_t(7U);
+	}
+};
+
+template<>
+struct LogArgument<Boolean> : LogRawArgument<Boolean>
+{
+	static size_t Decode(const unsigned char* source, StringBuilder& output)
+	{
+		output.Append(*(const Boolean*)source);
+		return 8U;
+	}
+};
+
+template<>
+struct LogArgument<Character> : LogRawArgument<Character>
+{
+	static size_t Decode(const unsigned char* source, StringBuilder& output)
+	{
+		output.Append(*(const Character*)source);
+		return 8U;
+	}
+};
+
+template<>
+struct LogArgument<StringView>
+{
+	static size_t Measure(StringView value) { return sizeof(size_t) + ((value.Length().ToRawValue() * sizeof(Character) + 7U) & ~size_t(7U)); }
+
+	static size_t Encode(StringView value, unsigned char* destination)
+	{
+		size_t length = value.Length().ToRawValue();
+		memcpy(destination, &length, sizeof(size_t));
+		memcpy(destination + sizeof(size_t), value.ToUnsafePointer(), length * sizeof(Character));
+		return Measure(value);
+	}
+
+	static size_t Decode(const unsigned char* source, StringBuilder& output)
+	{
+		size_t length;
+		memcpy(&length, source, sizeof(size_t));
+
+		StringView value((const Character*)(source + sizeof(size_t)), length);
+		output.Append(value);
+		return Measure(value);
+	}
+};
+
+template<>
+struct LogArgument<String> : LogArgument<StringView> {};
+
+template<>
+struct LogArgument<const char*>
+{
+	static size_t Measure(const char* value) { return sizeof(size_t) + ((strlen(value) + 1U + 7U) & ~size_t(7U)); }
+
+	static size_t Encode(const char* value, unsigned char* destination)
+	{
+		size_t length = strlen(value);
+		memcpy(destination, &length, sizeof(size_t));
+		memcpy(destination + sizeof(size_t), value, length + 1U);
+		return sizeof(size_t) + ((length + 1U + 7U) & ~size_t(7U));
+	}
+
+	static size_t Decode(const unsigned char* source, StringBuilder& output)
+	{
+		size_t length;
+		memcpy(&length, source, sizeof(size_t));
+
+		output.Append((const char*)(source + sizeof(size_t)));
+		return sizeof(size_t) + ((length + 1U + 7U) & ~size_t(7U));
+	}
+};
+
+template<size_t N>
+struct LogArgument<char[N]> : LogArgument<const char*> {};
+
+template<typename T>
+concept Loggable = requires(const T& value, unsigned char* destination, const unsigned char* source, StringBuilder& output)
+{
+	{ LogArgument<T>::Measure(value) } -> std::same_as<size_t>;
+	{ LogArgument<T>::Encode(value, destination) } -> std::same_as<size_t>;
+	{ LogArgument<T>::Decode(source, output) } -> std::same_as<size_t>;
+};
+
+// Anything else that is Printable is converted with ToString on the calling thread, before the record is written, and
+// costs that thread the formatting and an allocation. A LogArgument specialization moves that to the background thread.
+template<typename T>
+decltype(auto) PrepareLogArgument(const T& value)
+{
+	if constexpr(Loggable<T>)
+		return (value);
+	else
+		return value.ToString();
+}
+
+using LogDecoder = void(*)(const unsigned char* payload, const char* format, StringBuilder& output);
+
+// Asynchronous logger. A call copies its format string pointer and raw arguments into a lock-free ring owned by the
+// calling thread; a background thread formats the records and hands the text to the sinks in batches. Arguments with a
+// LogArgument are not formatted on the calling thread; others are, see PrepareLogArgument. When a ring is
+// full the record is dropped rather than blocking the caller (see GetDroppedCount).
+class Logger
+{
+private:
+	static std::atomic<LogLevel> s_level;
+	static std::atomic<size_t>   s_ringCapacity;
+
+	static unsigned char* BeginRecord(LogLevel level, LogDecoder decoder, const char* format, size_t payloadSize);
+	static void           CommitRecord();
+
+	// Appends literal text up to the next placeholder and returns the position after it.
+	static const char* AppendLiteral(const char* format, StringBuilder& output);
+
+	template<typename... Values>
+	static void Decode(const unsigned char* payload, const char* format, StringBuilder& output)
+	{
+		((format = AppendLiteral(format, output), payload += LogArgument<Values>::Decode(payload, output)), ...);
+		AppendLiteral(format, output);
+	}
+
+	template<typename... Values>
+	static void Write(LogLevel level, const char* format, const Values&... values)
+	{
+		size_t payloadSize = (LogArgument<Values>::Measure(values) + ... + 0U);
+
+		unsigned char* payload = BeginRecord(level, &Decode<Values...>, format, payloadSize);
+		if(!payload)
+			return;
+
+		((payload += LogArgument<Values>::Encode(values, payload)), ...);
+		CommitRecord();
+	}
+public:
+	static constexpr LogLevel CompiledLevel = LogLevel::JAMJAR_LOG_MINIMUM_LEVEL;
+
+	static LogLevel GetLevel() { return s_level.load(std::memory_order_relaxed); }
+	static void     SetLevel(LogLevel level) { s_level.store(level, std::memory_order_relaxed); }
+
+	static Boolean IsEnabled(LogLevel level) { return level >= CompiledLevel && level >= GetLevel(); }
+
+	static void AddSink(const SharedRef<LogSink>& sink);
+
+	// The size of the ring a thread gets with its first record, rounded up to a power of two and at least 4 KiB. It
+	// applies to threads that have not logged yet; 64 KiB by default.
+	static void SetRingCapacity(Size bytes);
+	static Size GetRingCapacity();
+
+	// Blocks until every record logged before the call has been written and the sinks are flushed.
+	static void Flush();
+
+	static UInt64 GetDroppedCount();
+
+	template<LogLevel Level, typename... Args>
+	static void Log(FormatString<std::type_identity_t<Args>...> format, const Args&... args)
+	{
+		if constexpr(Level >= CompiledLevel && Level != LogLevel::None)
+		{
+			if(Level < GetLevel())
+				return;
+
+			Write(Level, format.GetString(), PrepareLogArgument(args)...);
+		}
+	}
+
+	template<typename... Args>
+	static void Trace(FormatString<std::type_identity_t<Args>...> format, const Args&... args) { Log<LogLevel::Trace, Args...>(format, args...); }
+
+	template<typename... Args>
+	static void Debug(FormatString<std::type_identity_t<Args>...> format, const Args&... args) { Log<LogLevel::Debug, Args...>(format, args...); }
+
+	template<typename... Args>
+	static void Information(FormatString<std::type_identity_t<Args>...> format, const Args&... args) { Log<LogLevel::Information, Args...>(format, args...); }
+
+	template<typename... Args>
+	static void Warning(FormatString<std::type_identity_t<Args>...> format, const Args&... args) { Log<LogLevel::Warning, Args...>(format, args...); }
+
+	template<typename... Args>
+	static void Error(FormatString<std::type_identity_t<Args>...> format, const Args&... args) { Log<LogLevel::Error, Args...>(format, args...); }
+
+	template<typename... Args>
+	static void Fatal(FormatString<std::type_identity_t<Args>...> format, const Args&... args) { Log<LogLevel::Fatal, Args...>(format, args...); }
+};
\ No newline at end of file
@@ -0,0 +1,975 @@
+#include "BigInteger.hpp"
+
+// Below these sizes the simpler methods win. Karatsuba and Newton are in limbs of the smaller operand and of the divisor
+// and quotient; the other two are the pieces ToString and Parse stop splitting at.
+static const size_t KaratsubaThreshold = 32U;
+static const size_t NewtonThreshold    = 2048U;
+static const size_t ToStringThreshold  = 24U;
+static const size_t ParseThreshold     = 24U;
+
+// The largest power of ten in a limb, which ToString and Parse work in.
+static const uint64_t LimbBase   = 10000000000000000000ULL;
+static const size_t   LimbDigits = 19U;
+
+// result = left + right with leftCount >= rightCount, returning the carry. The result may be left itself.
+static uint64_t AddLimbs(uint64_t* result, const uint64_t* left, size_t leftCount, const uint64_t* right, size_t rightCount)
+{
+	uint64_t carry = 0U;
+	size_t   i     = 0U;
+
+	for(; i < rightCount; i++)
+	{
+		uint64_t sum = left[i] + carry;
+		carry  = sum < carry ? 1U : 0U;
+		sum   += right[i];
+		carry += sum < right[i] ? 1U : 0U;
+		result[i] = sum;
+	}
+
+	for(; i < leftCount; i++)
+	{
+		result[i] = left[i] + carry;
+		carry     = result[i] < carry ? 1U : 0U;
+	}
+
+	return carry;
+}
+
+// result = left - right with leftCount >= rightCount, returning the borrow. The result may be left itself.
+static uint64_t SubtractLimbs(uint64_t* result, const uint64_t* left, size_t leftCount, const uint64_t* right, size_t rightCount)
+{
+	uint64_t borrow = 0U;
+	size_t   i      = 0U;
+
+	for(; i < rightCount; i++)
+	{
+		uint64_t difference = left[i] - right[i];
+		uint64_t next       = left[i] < right[i] ? 1U : 0U;
+		next      |= difference < borrow ? 1U : 0U;
+		result[i]  = difference - borrow;
+		borrow     = next;
+	}
+
+	for(; i < leftCount; i++)
+	{
+		uint64_t limb = left[i];
+		result[i] = limb - borrow;
+		borrow    = limb < borrow ? 1U : 0U;
+	}
+
+	return borrow;
+}
+
+// target += source * factor over count limbs, returning the limb carried out.
+static uint64_t MultiplyAddLimb(uint64_t* target, const uint64_t* source, size_t count, uint64_t factor)
+{
+	uint64_t carry = 0U;
+	for(size_t i = 0U; i < count; i++)
+	{
+		UInt128 product = UInt128::Multiply(source[i], factor) + UInt128(target[i]) + UInt128(carry);
+		target[i] = product.GetLow();
+		carry     = product.GetHigh();
+	}
+
+	return carry;
+}
+
+// target -= source * factor over count limbs, returning what is left to take from the next limb.
+static uint64_t MultiplySubtractLimb(uint64_t* target, const uint64_t* source, size_t count, uint64_t factor)
+{
+	uint64_t carry = 0U;
+	for(size_t i = 0U; i < count; i++)
+	{
+		UInt128  product = UInt128::Multiply(source[i], factor) + UInt128(carry);
+		uint64_t limb    = target[i];
+		target[i] = limb - product.GetLow();
+		carry     = product.GetHigh() + (limb < product.GetLow() ? 1U : 0U);
+	}
+
+	return carry;
+}
+
+// quotient = numerator / divisor, returning the remainder. The quotient may be the numerator itself.
+static uint64_t DivideLimb(uint64_t* quotient, const uint64_t* numerator, size_t count, uint64_t divisor)
+{
+	uint64_t remainder = 0U;
+	for(size_t i = count; i-- > 0U;)
+		quotient[i] = UInt128(remainder, numerator[i]).Divide(divisor, remainder).GetLow();
+
+	return remainder;
+}
+
+// Shifts by less than a limb. Left shifts return the bits shifted out and go from the top, right shifts from the
+// bottom, so either may write over its source.
+static uint64_t ShiftLimbsLeft(uint64_t* result, const uint64_t* source, size_t count, unsigned shift)
+{
+	if(shift == 0U)
+	{
+		for(size_t i = count; i-- > 0U;)
+			result[i] = source[i];
+		return 0U;
+	}
+
+	uint64_t out = source[count - 1U] >> (64U - shift);
+	for(size_t i = count - 1U; i > 0U; i--)
+		result[i] = (source[i] << shift) | (source[i - 1U] >> (64U - shift));
+	result[0] = source[0] << shift;
+
+	return out;
+}
+
+static void ShiftLimbsRight(uint64_t* result, const uint64_t* source, size_t count, unsigned shift)
+{
+	if(shift == 0U)
+	{
+		for(size_t i = 0U; i < count; i++)
+			result[i] = source[i];
+		return;
+	}
+
+	for(size_t i = 0U; i + 1U < count; i++)
+		result[i] = (source[i] >> shift) | (source[i + 1U] << (64U - shift));
+	result[count - 1U] = source[count - 1U] >> shift;
+}
+
+static void MultiplySchoolbook(uint64_t* result, const uint64_t* left, size_t leftCount, const uint64_t* right, size_t rightCount)
+{
+	for(size_t i = 0U; i < leftCount; i++)
+		result[i] = 0U;
+
+	for(size_t j = 0U; j < rightCount; j++)
+		result[leftCount + j] = MultiplyAddLimb(result + j, left, leftCount, right[j]);
+}
+
+// The scratch space MultiplyLimbs needs when the larger operand has count limbs. Each Karatsuba level keeps the two
+// half sums and their product, and the deepest recursion is on the product.
+static size_t MultiplyScratch(size_t count)
+{
+	size_t scratch = 0U;
+	while(count >= KaratsubaThreshold)
+	{
+		size_t half = (count + 1U) / 2U;
+		scratch += 4U * (half + 1U);
+		count    = half + 1U;
+	}
+
+	return scratch;
+}
+
+// result = left * right with leftCount >= rightCount, over leftCount + rightCount limbs.
+static void MultiplyLimbs(uint64_t* result, const uint64_t* left, size_t leftCount, const uint64_t* right, size_t rightCount, uint64_t* scratch)
+{
+	if(rightCount < KaratsubaThreshold)
+	{
+		MultiplySchoolbook(result, left, leftCount, right, rightCount);
+		return;
+	}
+
+	// Much longer on the left: multiply it a piece as long as the right at a time.
+	if(leftCount >= 2U * rightCount)
+	{
+		for(size_t i = 0U; i < leftCount + rightCount; i++)
+			result[i] = 0U;
+
+		uint64_t* product = scratch;
+		for(size_t i = 0U; i < leftCount; i += rightCount)
+		{
+			size_t piece = rightCount < leftCount - i ? rightCount : leftCount - i;
+			MultiplyLimbs(product, right, rightCount, left + i, piece, scratch + 2U * rightCount);
+			AddLimbs(result + i, result + i, leftCount + rightCount - i, product, rightCount + piece);
+		}
+
+		return;
+	}
+
+	// Split both at half the left, so left = a1 B + a0 and right = b1 B + b0, and the product is
+	// a1 b1 B^2 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) B + a0 b0 with three half-size products instead of four.
+	size_t half           = (leftCount + 1U) / 2U;
+	size_t leftHighCount  = leftCount  - half;
+	size_t rightHighCount = rightCount - half;
+
+	MultiplyLimbs(result, left, half, right, half, scratch);
+	if(rightHighCount == 0U)
+	{
+		for(size_t i = 2U * half; i < leftCount + rightCount; i++)
+			result[i] = 0U;
+	}
+	else
+		MultiplyLimbs(result + 2U * half, left + half, leftHighCount, right + half, rightHighCount, scratch);
+
+	uint64_t* leftSum  = scratch;
+	uint64_t* rightSum = scratch + half + 1U;
+	uint64_t* middle   = scratch + 2U * (half + 1U);
+
+	leftSum[half]  = AddLimbs(leftSum,  left,  half, left  + half, leftHighCount);
+	rightSum[half] = AddLimbs(rightSum, right, half, right + half, rightHighCount);
+
+	MultiplyLimbs(middle, leftSum, half + 1U, rightSum, half + 1U, scratch + 4U * (half + 1U));
+	SubtractLimbs(middle, middle, 2U * half + 2U, result, 2U * half);
+	SubtractLimbs(middle, middle, 2U * half + 2U, result + 2U * half, leftHighCount + rightHighCount);
+
+	// The top limbs of the middle term are zero whenever they would fall past the end of the result.
+	size_t resultCount = leftCount + rightCount - half;
+	size_t middleCount = 2U * half + 2U < resultCount ? 2U * half + 2U : resultCount;
+	AddLimbs(result + half, result + half, resultCount, middle, middleCount);
+}
+
+// Knuth's algorithm D (TAOCP 4.3.1) for a divisor of at least two limbs. The divisor is shifted so its top bit is set,
+// which makes the quotient digit estimated from the top two limbs at most two too large.
+static void DivideKnuth(uint64_t* quotient, uint64_t* remainder, const uint64_t* numerator, size_t numeratorCount, const uint64_t* divisor, size_t divisorCount)
+{
+	HeapArray<UInt64> buffer(numeratorCount + 1U + divisorCount);
+	uint64_t* shiftedNumerator = (uint64_t*)&buffer[0U];
+	uint64_t* shiftedDivisor   = shiftedNumerator + numeratorCount + 1U;
+
+	unsigned shift = unsigned(std::countl_zero(divisor[divisorCount - 1U]));
+	ShiftLimbsLeft(shiftedDivisor, divisor, divisorCount, shift);
+	shiftedNumerator[numeratorCount] = ShiftLimbsLeft(shiftedNumerator, numerator, numeratorCount, shift);
+
+	uint64_t top  = shiftedDivisor[divisorCount - 1U];
+	uint64_t next = shiftedDivisor[divisorCount - 2U];
+
+	for(size_t j = numeratorCount - divisorCount + 1U; j-- > 0U;)
+	{
+		uint64_t* window = shiftedNumerator + j;
+		uint64_t  estimate;
+		uint64_t  rest;
+		bool      restOverflow = false;
+
+		if(window[divisorCount] >= top)
+		{
+			estimate     = UINT64_MAX;
+			rest         = window[divisorCount - 1U] + top;
+			restOverflow = rest < top;
+		}
+		else
+			estimate = UInt128(window[divisorCount], window[divisorCount - 1U]).Divide(top, rest).GetLow();
+
+		while(!restOverflow && UInt128::Multiply(estimate, next) > UInt128(rest, window[divisorCount - 2U]))
+		{
+			estimate--;
+			rest        += top;
+			restOverflow = rest < top;
+		}
+
+		uint64_t borrow  = MultiplySubtractLimb(window, shiftedDivisor, divisorCount, estimate);
+		uint64_t topLimb = window[divisorCount];
+		window[divisorCount] = topLimb - borrow;
+
+		// Rarely, the estimate was still one too large.
+		if(topLimb < borrow)
+		{
+			estimate--;
+			window[divisorCount] += AddLimbs(window, window, divisorCount, shiftedDivisor, divisorCount);
+		}
+
+		quotient[j] = estimate;
+	}
+
+	ShiftLimbsRight(remainder, shiftedNumerator, divisorCount, shift);
+}
+
+// floor(2^2n / divisor) for a divisor of n bits. Newton's iteration doubles the precision of the reciprocal of the top
+// half of the divisor, and the result is corrected to the exact floor, which keeps the error of each step to a few units.
+static BigInteger Reciprocal(const BigInteger& divisor)
+{
+	size_t     bits  = divisor.BitLength().ToRawValue();
+	BigInteger power = BigInteger::One << 2U * bits;
+
+	// Small enough that the division below takes algorithm D rather than coming back here.
+	if(bits <= (NewtonThreshold - 1U) * 64U)
+		return power / divisor;
+
+	size_t     lowBits  = bits - (bits + 1U) / 2U;
+	BigInteger estimate = Reciprocal(divisor >> lowBits) << lowBits;
+
+	// With rest = 2^2n - d e, the step e + e rest / 2^2n squares the relative error. The step's remainder follows from
+	// the one before it, which saves a multiplication by the whole divisor.
+	BigInteger rest = power - divisor * estimate;
+	BigInteger step = (estimate * rest) >> 2U * bits;
+
+	estimate += step;
+	rest     -= divisor * step;
+	while(rest.IsNegative())
+	{
+		--estimate;
+		rest += divisor;
+	}
+	while(rest >= divisor)
+	{
+		++estimate;
+		rest -= divisor;
+	}
+
+	return estimate;
+}
+
+// For a dividend below the square of 2^n, where n is the bit length of the divisor, the quotient from the reciprocal is
+// never too large and at most a few too small. Only the top n + 1 bits of the dividend make a difference to it.
+static void DivideByReciprocal(const BigInteger& dividend, const BigInteger& divisor, const BigInteger& reciprocal, BigInteger& quotient, BigInteger& remainder)
+{
+	size_t bits = divisor.BitLength().ToRawValue();
+
+	quotient  = ((dividend >> (bits - 1U)) * reciprocal) >> (bits + 1U);
+	remainder = dividend - quotient * divisor;
+	while(remainder >= divisor)
+	{
+		++quotient;
+		remainder -= divisor;
+	}
+}
+
+// Long division in digits as wide as the divisor, each found from the same reciprocal.
+static void DivideNewton(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder)
+{
+	size_t     bits       = divisor.BitLength().ToRawValue();
+	size_t     digits     = (dividend.BitLength().ToRawValue() + bits - 1U) / bits;
+	BigInteger reciprocal = Reciprocal(divisor);
+
+	if(digits <= 2U)
+	{
+		DivideByReciprocal(dividend, divisor, reciprocal, quotient, remainder);
+		return;
+	}
+
+	BigInteger mask = (BigInteger::One << bits) - BigInteger::One;
+	BigInteger result;
+	BigInteger rest;
+
+	for(size_t i = digits; i-- > 0U;)
+	{
+		BigInteger digit;
+		DivideByReciprocal((rest << bits) + ((dividend >> i * bits) & mask), divisor, reciprocal, digit, rest);
+		result += digit << i * bits;
+	}
+
+	quotient  = result;
+	remainder = rest;
+}
+
+const BigInteger BigInteger::Zero;
+const BigInteger BigInteger::One(1);
+
+BigInteger::BigInteger(size_t count, bool negative) : m_inline(), m_count(0U), m_onHeap(false), m_negative(negative) { Allocate(count); }
+
+BigInteger::BigInteger(const BigInteger& other) : m_inline(), m_count(0U), m_onHeap(false), m_negative(other.m_negative)
+{
+	Allocate(other.m_count);
+	memcpy(Limbs(), other.Limbs(), m_count * sizeof(uint64_t));
+}
+
+BigInteger::BigInteger(BigInteger&& other) noexcept : m_inline(), m_count(0U), m_onHeap(false), m_negative(false) { *this = std::move(other); }
+
+BigInteger& BigInteger::operator=(const BigInteger& other)
+{
+	if(this == &other)
+		return *this;
+
+	Release();
+	Allocate(other.m_count);
+	memcpy(Limbs(), other.Limbs(), m_count * sizeof(uint64_t));
+	m_negative = other.m_negative;
+
+	return *this;
+}
+
+BigInteger& BigInteger::operator=(BigInteger&& other) noexcept
+{
+	if(this == &other)
+		return *this;
+
+	Release();
+	if(other.m_onHeap)
+	{
+		new(&m_heap) HeapArray<UInt64>(std::move(other.m_heap));
+		m_onHeap = true;
+		other.Release();
+	}
+	else
+	{
+		for(size_t i = 0U; i < InlineLimbs; i++)
+			m_inline[i] = other.m_inline[i];
+	}
+
+	m_count    = other.m_count;
+	m_negative = other.m_negative;
+
+	other.Allocate(0U);
+	other.m_negative = false;
+
+	return *this;
+}
+
+void BigInteger::Allocate(size_t count)
+{
+	if(count > InlineLimbs)
+	{
+		new(&m_heap) HeapArray<UInt64>(Size(count));
+		m_onHeap = true;
+	}
+	else
+	{
+		for(size_t i = 0U; i < InlineLimbs; i++)
+			m_inline[i] = 0U;
+		m_onHeap = false;
+	}
+
+	m_count = count;
+}
+
+void BigInteger::Release()
+{
+	if(m_onHeap)
+	{
+		m_heap.~HeapArray<UInt64>();
+		m_onHeap = false;
+	}
+}
+
+void BigInteger::Normalize()
+{
+	const uint64_t* limbs = Limbs();
+	while(m_count > 0U && limbs[m_count - 1U] == 0U)
+		m_count--;
+
+	if(m_count == 0U)
+		m_negative = false;
+}
+
+int BigInteger::CompareMagnitudes(const BigInteger& left, const BigInteger& right)
+{
+	if(left.m_count != right.m_count)
+		return left.m_count < right.m_count ? -1 : 1;
+
+	const uint64_t* leftLimbs  = left.Limbs();
+	const uint64_t* rightLimbs = right.Limbs();
+	for(size_t i = left.m_count; i-- > 0U;)
+	{
+		if(leftLimbs[i] != rightLimbs[i])
+			return leftLimbs[i] < rightLimbs[i] ? -1 : 1;
+	}
+
+	return 0;
+}
+
+BigInteger BigInteger::Add(const BigInteger& left, const BigInteger& right, bool negateRight)
+{
+	bool rightNegative = right.m_negative != negateRight;
+
+	if(left.m_negative == rightNegative)
+	{
+		const BigInteger& longer  = left.m_count >= right.m_count ? left : right;
+		const BigInteger& shorter = left.m_count >= right.m_count ? right : left;
+
+		BigInteger result(longer.m_count + 1U, left.m_negative);
+		result.Limbs()[longer.m_count] = AddLimbs(result.Limbs(), longer.Limbs(), longer.m_count, shorter.Limbs(), shorter.m_count);
+		result.Normalize();
+		return result;
+	}
+
+	int order = CompareMagnitudes(left, right);
+	if(order == 0)
+		return BigInteger();
+
+	const BigInteger& larger  = order > 0 ? left : right;
+	const BigInteger& smaller = order > 0 ? right : left;
+
+	BigInteger result(larger.m_count, order > 0 ? left.m_negative : rightNegative);
+	SubtractLimbs(result.Limbs(), larger.Limbs(), larger.m_count, smaller.Limbs(), smaller.m_count);
+	result.Normalize();
+	return result;
+}
+
+BigInteger operator*(const BigInteger& left, const BigInteger& right)
+{
+	if(left.m_count == 0U || right.m_count == 0U)
+		return BigInteger();
+
+	const BigInteger& longer  = left.m_count >= right.m_count ? left : right;
+	const BigInteger& shorter = left.m_count >= right.m_count ? right : left;
+
+	BigInteger result(left.m_count + right.m_count, left.m_negative != right.m_negative);
+
+	if(shorter.m_count < KaratsubaThreshold)
+		MultiplySchoolbook(result.Limbs(), longer.Limbs(), longer.m_count, shorter.Limbs(), shorter.m_count);
+	else
+	{
+		HeapArray<UInt64> scratch(MultiplyScratch(longer.m_count));
+		MultiplyLimbs(result.Limbs(), longer.Limbs(), longer.m_count, shorter.Limbs(), shorter.m_count, (uint64_t*)&scratch[0U]);
+	}
+
+	result.Normalize();
+	return result;
+}
+
+void BigInteger::DivideMagnitudes(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder)
+{
+	if(CompareMagnitudes(dividend, divisor) < 0)
+	{
+		remainder = dividend.Abs();
+		quotient  = BigInteger();
+		return;
+	}
+
+	if(divisor.m_count == 1U)
+	{
+		BigInteger result(dividend.m_count, false);
+		uint64_t   rest = DivideLimb(result.Limbs(), dividend.Limbs(), dividend.m_count, divisor.Limbs()[0]);
+		result.Normalize();
+
+		quotient  = std::move(result);
+		remainder = BigInteger(rest);
+		return;
+	}
+
+	if(divisor.m_count >= NewtonThreshold && dividend.m_count - divisor.m_count >= NewtonThreshold)
+	{
+		BigInteger result;
+		BigInteger rest;
+		DivideNewton(dividend.Abs(), divisor.Abs(), result, rest);
+
+		quotient  = std::move(result);
+		remainder = std::move(rest);
+		return;
+	}
+
+	BigInteger result(dividend.m_count - divisor.m_count + 1U, false);
+	BigInteger rest(divisor.m_count, false);
+	DivideKnuth(result.Limbs(), rest.Limbs(), dividend.Limbs(), dividend.m_count, divisor.Limbs(), divisor.m_count);
+	result.Normalize();
+	rest.Normalize();
+
+	quotient  = std::move(result);
+	remainder = std::move(rest);
+}
+
+BigInteger BigInteger::Divide(const BigInteger& divisor, BigInteger& remainder) const
+{
+	if(divisor.m_count == 0U)
+		Exception("Cannot divide by zero."_s).Throw();
+
+	BigInteger quotient;
+	BigInteger rest;
+	DivideMagnitudes(*this, divisor, quotient, rest);
+
+	quotient.m_negative = quotient.m_count != 0U && m_negative != divisor.m_negative;
+	rest.m_negative     = rest.m_count != 0U && m_negative;
+
+	remainder = std::move(rest);
+	return quotient;
+}
+
+BigInteger operator/(const BigInteger& left, const BigInteger& right)
+{
+	BigInteger remainder;
+	return left.Divide(right, remainder);
+}
+
+BigInteger operator%(const BigInteger& left, const BigInteger& right)
+{
+	BigInteger remainder;
+	left.Divide(right, remainder);
+	return remainder;
+}
+
+// Works on both operands in two's complement, one limb wider than the longer so the top limb is all sign, negating
+// negative values on the fly with a carry each.
+template<typename Operation>
+BigInteger BigInteger::Bitwise(const BigInteger& left, const BigInteger& right, Operation operation)
+{
+	size_t     count = (left.m_count > right.m_count ? left.m_count : right.m_count) + 1U;
+	BigInteger result(count, false);
+
+	uint64_t*       limbs      = result.Limbs();
+	const uint64_t* leftLimbs  = left.Limbs();
+	const uint64_t* rightLimbs = right.Limbs();
+
+	uint64_t leftCarry  = 1U;
+	uint64_t rightCarry = 1U;
+
+	for(size_t i = 0U; i < count; i++)
+	{
+		uint64_t leftLimb  = i < left.m_count  ? leftLimbs[i]  : 0U;
+		uint64_t rightLimb = i < right.m_count ? rightLimbs[i] : 0U;
+
+		if(left.m_negative)
+		{
+			leftLimb  = ~leftLimb + leftCarry;
+			leftCarry = leftLimb < leftCarry ? 1U : 0U;
+		}
+
+		if(right.m_negative)
+		{
+			rightLimb  = ~rightLimb + rightCarry;
+			rightCarry = rightLimb < rightCarry ? 1U : 0U;
+		}
+
+		limbs[i] = operation(leftLimb, rightLimb);
+	}
+
+	if(limbs[count - 1U] >> 63U)
+	{
+		uint64_t carry = 1U;
+		for(size_t i = 0U; i < count; i++)
+		{
+			limbs[i] = ~limbs[i] + carry;
+			carry    = limbs[i] < carry ? 1U : 0U;
+		}
+
+		result.m_negative = true;
+	}
+
+	result.Normalize();
+	return result;
+}
+
+BigInteger operator&(const BigInteger& left, const BigInteger& right) { return BigInteger::Bitwise(left, right, [](uint64_t a, uint64_t b) { return a & b; }); }
+BigInteger operator|(const BigInteger& left, const BigInteger& right) { return BigInteger::Bitwise(left, right, [](uint64_t a, uint64_t b) { return a | b; }); }
+BigInteger operator^(const BigInteger& left, const BigInteger& right) { return BigInteger::Bitwise(left, right, [](uint64_t a, uint64_t b) { return a ^ b; }); }
+
+BigInteger BigInteger::ShiftLeft(const BigInteger& value, size_t bits)
+{
+	if(value.m_count == 0U)
+		return BigInteger();
+
+	size_t limbShift = bits / 64U;
+
+	BigInteger result(value.m_count + limbShift + 1U, value.m_negative);
+	result.Limbs()[value.m_count + limbShift] = ShiftLimbsLeft(result.Limbs() + limbShift, value.Limbs(), value.m_count, unsigned(bits % 64U));
+	result.Normalize();
+	return result;
+}
+
+// Rounds toward negative infinity, as an arithmetic shift of the two's complement form would.
+BigInteger BigInteger::ShiftRight(const BigInteger& value, size_t bits)
+{
+	size_t limbShift = bits / 64U;
+	if(limbShift >= value.m_count)
+		return value.m_negative ? BigInteger(-1) : BigInteger();
+
+	const uint64_t* limbs = value.Limbs();
+	unsigned        shift = unsigned(bits % 64U);
+
+	BigInteger result(value.m_count - limbShift, value.m_negative);
+	ShiftLimbsRight(result.Limbs(), limbs + limbShift, value.m_count - limbShift, shift);
+	result.Normalize();
+
+	if(value.m_negative)
+	{
+		bool inexact = shift != 0U && (limbs[limbShift] << (64U - shift)) != 0U;
+		for(size_t i = 0U; i < limbShift && !inexact; i++)
+			inexact = limbs[i] != 0U;
+
+		if(inexact)
+			return result - One;
+		if(result.m_count == 0U)
+			return BigInteger(-1);
+	}
+
+	return result;
+}
+
+BigInteger operator<<(const BigInteger& value, const BigInteger& count)
+{
+	if(count.m_count > 1U)
+	{
+		if(!count.m_negative)
+			Exception("The shift is too large."_s).Throw();
+
+		return value.m_negative ? BigInteger(-1) : BigInteger();
+	}
+
+	size_t bits = count.m_count != 0U ? size_t(count.Limbs()[0]) : 0U;
+	return count.m_negative ? BigInteger::ShiftRight(value, bits) : BigInteger::ShiftLeft(value, bits);
+}
+
+BigInteger operator>>(const BigInteger& value, const BigInteger& count) { return value << -count; }
+
+Boolean operator==(const BigInteger& left, const BigInteger& right)
+{
+	return left.m_negative == right.m_negative && BigInteger::CompareMagnitudes(left, right) == 0;
+}
+
+Boolean operator<(const BigInteger& left, const BigInteger& right)
+{
+	if(left.m_negative != right.m_negative)
+		return left.m_negative;
+
+	int order = BigInteger::CompareMagnitudes(left, right);
+	return left.m_negative ? order > 0 : order < 0;
+}
+
+BigInteger BigInteger::operator-() const
+{
+	BigInteger result = *this;
+	result.m_negative = m_count != 0U && !m_negative;
+	return result;
+}
+
+BigInteger::operator UInt64() const
+{
+	uint64_t low = m_count != 0U ? Limbs()[0] : 0U;
+	return UInt64(m_negative ? 0U - low : low);
+}
+
+BigInteger::operator SInt64() const { return SInt64(int64_t(UInt64(*this).ToRawValue())); }
+
+// The top 64 bits with the rest folded into the lowest one, which rounds the same as the whole would.
+BigInteger::operator Float64() const
+{
+	if(m_count == 0U)
+		return Float64::Zero;
+
+	const uint64_t* limbs = Limbs();
+	size_t          bits  = BitLength().ToRawValue();
+	double          value;
+
+	if(bits <= 64U)
+		value = double(limbs[0]);
+	else
+	{
+		size_t   shift     = bits - 64U;
+		size_t   limbShift = shift / 64U;
+		unsigned bitShift  = unsigned(shift % 64U);
+
+		uint64_t top    = bitShift == 0U ? limbs[limbShift] : (limbs[limbShift] >> bitShift) | (limbs[limbShift + 1U] << (64U - bitShift));
+		bool     sticky = bitShift != 0U && (limbs[limbShift] << (64U - bitShift)) != 0U;
+		for(size_t i = 0U; i < limbShift && !sticky; i++)
+			sticky = limbs[i] != 0U;
+
+		value = ldexp(double(top | (sticky ? 1U : 0U)), int(shift < 4096U ? shift : 4096U));
+	}
+
+	return Float64(m_negative ? -value : value);
+}
+
+Size BigInteger::BitLength() const
+{
+	if(m_count == 0U)
+		return 0U;
+
+	return Size((m_count - 1U) * 64U + size_t(std::bit_width(Limbs()[m_count - 1U])));
+}
+
+BigInteger BigInteger::Abs() const
+{
+	BigInteger result = *this;
+	result.m_negative = false;
+	return result;
+}
+
+// Newton's iteration from above, which comes down to the root and then stops.
+BigInteger BigInteger::Sqrt() const
+{
+	if(m_negative || m_count == 0U)
+		return BigInteger();
+
+	if(m_count == 1U)
+		return BigInteger(IntegerMath::SquareRoot(Limbs()[0]));
+
+	BigInteger root = One << (BitLength().ToRawValue() + 1U) / 2U;
+	while(true)
+	{
+		BigInteger next = (root + *this / root) >> 1U;
+		if(next >= root)
+			return root;
+
+		root = std::move(next);
+	}
+}
+
+BigInteger BigInteger::IPow(UInt64 exponent) const
+{
+	uint64_t   remaining = exponent.ToRawValue();
+	BigInteger result    = One;
+	BigInteger base      = *this;
+
+	while(remaining != 0U)
+	{
+		if((remaining & 1U) != 0U)
+			result *= base;
+
+		remaining >>= 1U;
+		if(remaining != 0U)
+			base *= base;
+	}
+
+	return result;
+}
+
+HashCode BigInteger::GetHashCode() const
+{
+	return HashCode::FromBytes(Limbs(), m_count * sizeof(uint64_t)) & HashCode(size_t(m_negative));
+}
+
+wchar_t* BigInteger::FormatDigits(const BigInteger& value, const BigInteger* powers, const BigInteger* reciprocals, size_t level, wchar_t* end, size_t width)
+{
+	wchar_t* cursor = end;
+
+	if(value.m_count <= ToStringThreshold)
+	{
+		uint64_t limbs[ToStringThreshold];
+		size_t   count = value.m_count;
+		memcpy(limbs, value.Limbs(), count * sizeof(uint64_t));
+
+		while(count > 0U)
+		{
+			uint64_t group = DivideLimb(limbs, limbs, count, LimbBase);
+			if(limbs[count - 1U] == 0U)
+				count--;
+
+			for(size_t i = 0U; i < LimbDigits && (count > 0U || group != 0U); i++)
+			{
+				*--cursor = wchar_t(L'0' + group % 10U);
+				group /= 10U;
+			}
+		}
+
+		if(cursor == end && width == 0U)
+			*--cursor = L'0';
+		while(size_t(end - cursor) < width)
+			*--cursor = L'0';
+
+		return cursor;
+	}
+
+	// Without padding there is no need to split off a high part of zero.
+	if(width == 0U && value < powers[level])
+		return FormatDigits(value, powers, reciprocals, level - 1U, end, 0U);
+
+	BigInteger high;
+	BigInteger low;
+	if(reciprocals[level] != Zero)
+		DivideByReciprocal(value, powers[level], reciprocals[level], high, low);
+	else
+		high = value.Divide(powers[level], low);
+
+	size_t lowWidth = LimbDigits << level;
+	cursor = FormatDigits(low, powers, reciprocals, level - 1U, end, lowWidth);
+	return FormatDigits(high, powers, reciprocals, level - 1U, cursor, width != 0U ? width - lowWidth : 0U);
+}
+
+String BigInteger::ToString() const
+{
+	size_t bits   = BitLength().ToRawValue();
+	size_t length = size_t(double(bits) * 0.30103) + 2U;
+
+	// 10^19 squared over and over, up to the first power whose square is above the value.
+	BigInteger powers[64];
+	BigInteger reciprocals[64];
+	size_t     level = 0U;
+
+	if(m_count > ToStringThreshold)
+	{
+		powers[0] = BigInteger(LimbBase);
+		while(2U * powers[level].BitLength().ToRawValue() - 1U <= bits)
+		{
+			powers[level + 1U] = powers[level] * powers[level];
+			level++;
+		}
+
+		for(size_t i = 0U; i <= level; i++)
+		{
+			if(powers[i].m_count >= NewtonThreshold)
+				reciprocals[i] = Reciprocal(powers[i]);
+		}
+	}
+
+	SharedArrayRef<Character> chars = HeapArray<Character>(length);
+	wchar_t* end   = (wchar_t*)chars.ToUnsafePointer() + length;
+	wchar_t* start = FormatDigits(Abs(), powers, reciprocals, level, end, 0U);
+
+	if(m_negative)
+		*--start = L'-';
+
+	size_t index = size_t(start - (wchar_t*)chars.ToUnsafePointer());
+	return String(chars.AsSpan(index, length - index));
+}
+
+BigInteger BigInteger::ParseDigits(const wchar_t* digits, size_t count, const BigInteger* powers, size_t level)
+{
+	if(count <= ParseThreshold * LimbDigits)
+	{
+		BigInteger result(count / LimbDigits + 1U, false);
+		uint64_t*  limbs = result.Limbs();
+		size_t     used  = 0U;
+
+		size_t piece = count % LimbDigits != 0U ? count % LimbDigits : LimbDigits;
+		for(size_t i = 0U; i < count; i += piece, piece = LimbDigits)
+		{
+			uint64_t group;
+			NumberFormat::Parse(digits + i, piece, UINT64_MAX, group);
+
+			for(size_t j = 0U; j < used; j++)
+			{
+				UInt128 product = UInt128::Multiply(limbs[j], LimbBase) + UInt128(group);
+				limbs[j] = product.GetLow();
+				group    = product.GetHigh();
+			}
+
+			if(group != 0U)
+				limbs[used++] = group;
+		}
+
+		result.Normalize();
+		return result;
+	}
+
+	while(LimbDigits << level >= count)
+		level--;
+
+	size_t lowCount = LimbDigits << level;
+	return ParseDigits(digits, count - lowCount, powers, level) * powers[level] + ParseDigits(digits + count - lowCount, lowCount, powers, level);
+}
+
+Boolean BigInteger::TryParse(const String& string, BigInteger& result)
+{
+	const wchar_t* characters = (const wchar_t*)string.AsSpan().ToUnsafePointer();
+	size_t         length     = string.Length().ToRawValue();
+
+	bool negative = false;
+	if(length > 0U && (characters[0] == L'-' || characters[0] == L'+'))
+	{
+		negative = characters[0] == L'-';
+		characters++;
+		length--;
+	}
+
+	if(length == 0U)
+		return false;
+
+	for(size_t i = 0U; i < length; i++)
+	{
+		if(uint32_t(characters[i]) - uint32_t(L'0') > 9U)
+			return false;
+	}
+
+	BigInteger powers[64];
+	size_t     level = 0U;
+
+	if(length > ParseThreshold * LimbDigits)
+	{
+		powers[0] = BigInteger(LimbBase);
+		while(LimbDigits << (level + 1U) < length)
+		{
+			powers[level + 1U] = powers[level] * powers[level];
+			level++;
+		}
+	}
+
+	result = ParseDigits(characters, length, powers, level);
+	result.m_negative = negative && result.m_count != 0U;
+	return true;
+}
+
+BigInteger BigInteger::Parse(const String& string)
+{
+	BigInteger result;
+	if(!TryParse(string, result))
+		FormatException(string).Throw();
+
+	return result;
+}
+
+// An integer in every sense the generic math code asks for, just without bounds.
+static_assert(SignedIntegral<BigInteger> && !Bounded<BigInteger>);
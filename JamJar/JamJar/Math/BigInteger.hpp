@@ -0,0 +1,176 @@
+#pragma once
+
+#include "../Exception.hpp"
+#include "UInt128.hpp"
+
+// A signed integer of any size: a sign and the 64-bit limbs of the magnitude, least significant first. Values of up to
+// three limbs are kept inline and never allocate. Bitwise operators and shifts act on an infinite two's
+// complement form, so -1 >> 1 is -1 and -1 & x is x; division rounds toward zero like the built-in types.
+//
+// Multiplication is schoolbook below KaratsubaThreshold limbs and Karatsuba above it. Division is Knuth's algorithm D,
+// or a multiplication by a Newton reciprocal when both the divisor and the quotient are large. ToString and Parse split
+// the number in halves at powers of ten, so they cost a few large multiplications instead of one pass per digit.
+class BigInteger
+{
+private:
+	// As many as fit in a HeapArray on 64-bit targets. A 32-bit HeapArray holds only one, so the count is fixed instead.
+	static constexpr size_t InlineLimbs = 3U;
+
+	union
+	{
+		uint64_t          m_inline[InlineLimbs];
+		HeapArray<UInt64> m_heap;
+	};
+
+	size_t m_count;
+	bool   m_onHeap;
+	bool   m_negative;
+
+	// Room for count limbs, all zero, for the caller to fill in before calling Normalize.
+	BigInteger(size_t count, bool negative);
+
+	uint64_t*       Limbs()       { return m_onHeap ? (uint64_t*)&m_heap[0U] : m_inline; }
+	const uint64_t* Limbs() const { return m_onHeap ? (const uint64_t*)&m_heap[0U] : m_inline; }
+
+	void Allocate(size_t count);
+	void Release();
+
+	// Drops the leading zero limbs; zero is never negative.
+	void Normalize();
+
+	static int CompareMagnitudes(const BigInteger& left, const BigInteger& right);
+
+	static BigInteger Add(const BigInteger& left, const BigInteger& right, bool negateRight);
+
+	static BigInteger ShiftLeft (const BigInteger& value, size_t bits);
+	static BigInteger ShiftRight(const BigInteger& value, size_t bits);
+
+	template<typename Operation>
+	static BigInteger Bitwise(const BigInteger& left, const BigInteger& right, Operation operation);
+
+	static void DivideMagnitudes(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder);
+
+	// Writes the digits of value, below powers[level] squared, backwards from end: exactly width of them with leading
+	// zeros, or as many as it takes when width is zero. Returns where they start.
+	static wchar_t* FormatDigits(const BigInteger& value, const BigInteger* powers, const BigInteger* reciprocals, size_t level, wchar_t* end, size_t width);
+
+	// The value of count decimal digits, which must all be valid.
+	static BigInteger ParseDigits(const wchar_t* digits, size_t count, const BigInteger* powers, size_t level);
+public:
+	static const BigInteger Zero;
+	static const BigInteger One;
+
+	BigInteger() noexcept : m_inline(), m_count(0U), m_onHeap(false), m_negative(false) {}
+
+	template<std::integral T>
+	BigInteger(T value) noexcept : m_inline(), m_count(0U), m_onHeap(false), m_negative(false)
+	{
+		if constexpr(std::is_signed_v<T>)
+		{
+			m_negative  = value < 0;
+			m_inline[0] = m_negative ? 0U - uint64_t(value) : uint64_t(value);
+		}
+		else
+			m_inline[0] = uint64_t(value);
+
+		m_count = m_inline[0] != 0U ? 1U : 0U;
+	}
+
+	template<std::unsigned_integral T>
+	BigInteger(UnsignedInteger<T> value) noexcept : BigInteger(value.ToRawValue()) {}
+
+	template<std::signed_integral T>
+	BigInteger(SignedInteger<T> value) noexcept : BigInteger(value.ToRawValue()) {}
+
+	BigInteger(const BigInteger& other);
+	BigInteger(BigInteger&& other) noexcept;
+
+	~BigInteger() { Release(); }
+
+	BigInteger& operator=(const BigInteger& other);
+	BigInteger& operator=(BigInteger&& other) noexcept;
+
+	// The low 64 bits of the two's complement form, like a cast to a narrower built-in integer.
+	explicit operator UInt64() const;
+	explicit operator SInt64() const;
+
+	// Rounded to nearest, or infinity past the range of a double.
+	explicit operator Float64() const;
+
+	friend BigInteger operator+(const BigInteger& left, const BigInteger& right) { return Add(left, right, false); }
+	friend BigInteger operator-(const BigInteger& left, const BigInteger& right) { return Add(left, right, true);  }
+	friend BigInteger operator*(const BigInteger& left, const BigInteger& right);
+	friend BigInteger operator/(const BigInteger& left, const BigInteger& right);
+	friend BigInteger operator%(const BigInteger& left, const BigInteger& right);
+
+	friend BigInteger operator&(const BigInteger& left, const BigInteger& right);
+	friend BigInteger operator|(const BigInteger& left, const BigInteger& right);
+	friend BigInteger operator^(const BigInteger& left, const BigInteger& right);
+
+	// A negative count shifts the other way.
+	friend BigInteger operator<<(const BigInteger& value, const BigInteger& count);
+	friend BigInteger operator>>(const BigInteger& value, const BigInteger& count);
+
+	friend Boolean operator==(const BigInteger& left, const BigInteger& right);
+	friend Boolean operator!=(const BigInteger& left, const BigInteger& right) { return !(left == right); }
+	friend Boolean operator< (const BigInteger& left, const BigInteger& right);
+	friend Boolean operator> (const BigInteger& left, const BigInteger& right) { return right < left;    }
+	friend Boolean operator<=(const BigInteger& left, const BigInteger& right) { return !(right < left); }
+	friend Boolean operator>=(const BigInteger& left, const BigInteger& right) { return !(left < right); }
+
+	BigInteger& operator+=(const BigInteger& other) { return *this = *this + other; }
+	BigInteger& operator-=(const BigInteger& other) { return *this = *this - other; }
+	BigInteger& operator*=(const BigInteger& other) { return *this = *this * other; }
+	BigInteger& operator/=(const BigInteger& other) { return *this = *this / other; }
+	BigInteger& operator%=(const BigInteger& other) { return *this = *this % other; }
+
+	BigInteger& operator&=(const BigInteger& other) { return *this = *this & other; }
+	BigInteger& operator|=(const BigInteger& other) { return *this = *this | other; }
+	BigInteger& operator^=(const BigInteger& other) { return *this = *this ^ other; }
+
+	BigInteger& operator<<=(const BigInteger& other) { return *this = *this << other; }
+	BigInteger& operator>>=(const BigInteger& other) { return *this = *this >> other; }
+
+	BigInteger operator+() const { return *this; }
+	BigInteger operator-() const;
+	BigInteger operator~() const { return -(*this) - One; }
+
+	BigInteger& operator++() { return *this = *this + One; }
+	BigInteger& operator--() { return *this = *this - One; }
+
+	BigInteger operator++(int)
+	{
+		BigInteger result = *this;
+		++(*this);
+		return result;
+	}
+
+	BigInteger operator--(int)
+	{
+		BigInteger result = *this;
+		--(*this);
+		return result;
+	}
+
+	// The quotient rounded toward zero, and the remainder with the sign of this.
+	BigInteger Divide(const BigInteger& divisor, BigInteger& remainder) const;
+
+	Boolean IsNegative() const { return m_negative; }
+
+	// The number of bits in the magnitude, zero for zero.
+	Size BitLength() const;
+
+	BigInteger Abs() const;
+
+	// Exact, the square root rounded down; negative values give zero.
+	BigInteger Sqrt() const;
+
+	BigInteger IPow(UInt64 exponent) const;
+
+	HashCode GetHashCode() const;
+
+	String ToString() const;
+
+	static Boolean TryParse(const String& string, BigInteger& result);
+	static BigInteger Parse(const String& string);
+};
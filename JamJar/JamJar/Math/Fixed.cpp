@@ -0,0 +1,115 @@
+#include "Fixed.hpp"
+
+// atan(2^-i) in Q2.61.
+static const int64_t ArcTangents[61] =
+{
+	0x1921FB54442D1847, 0x0ED63382B0DDA7B4, 0x07D6DD7E4B203759, 0x03FAB7535585EDB9,
+	0x01FF55BB72CFDE9C, 0x00FFEAADDD4BB125, 0x007FFD556EEDCA6B, 0x003FFFAAAB77752E,
+	0x001FFFF5555BBBB7, 0x000FFFFEAAAADDDE, 0x0007FFFFD55556EF, 0x0003FFFFFAAAAAB7,
+	0x0001FFFFFF555556, 0x0000FFFFFFEAAAAB, 0x00007FFFFFFD5555, 0x00003FFFFFFFAAAB,
+	0x00001FFFFFFFF555, 0x00000FFFFFFFFEAB, 0x000007FFFFFFFFD5, 0x000003FFFFFFFFFB,
+	0x000001FFFFFFFFFF, 0x0000010000000000, 0x0000008000000000, 0x0000004000000000,
+	0x0000002000000000, 0x0000001000000000, 0x0000000800000000, 0x0000000400000000,
+	0x0000000200000000, 0x0000000100000000, 0x0000000080000000, 0x0000000040000000,
+	0x0000000020000000, 0x0000000010000000, 0x0000000008000000, 0x0000000004000000,
+	0x0000000002000000, 0x0000000001000000, 0x0000000000800000, 0x0000000000400000,
+	0x0000000000200000, 0x0000000000100000, 0x0000000000080000, 0x0000000000040000,
+	0x0000000000020000, 0x0000000000010000, 0x0000000000008000, 0x0000000000004000,
+	0x0000000000002000, 0x0000000000001000, 0x0000000000000800, 0x0000000000000400,
+	0x0000000000000200, 0x0000000000000100, 0x0000000000000080, 0x0000000000000040,
+	0x0000000000000020, 0x0000000000000010, 0x0000000000000008, 0x0000000000000004,
+	0x0000000000000002,
+};
+
+// The inverse of the CORDIC gain after i + 1 rotations in Q2.61, which the vector starts at so it ends up of length
+// one. It no longer changes in 61 bits after 31 rotations.
+static const int64_t InverseGains[32] =
+{
+	0x16A09E667F3BCC91, 0x143D136248490EDB, 0x13A261BA6D7A3698, 0x137B9141DEB3FDED,
+	0x1371DAC182EEF58D, 0x136F6CFABD961F3D, 0x136ED1869F27E8C3, 0x136EAAA970B20EF8,
+	0x136EA0F222A6D08C, 0x136E9E844EFD23E4, 0x136E9DE8DA104AE7, 0x136E9DC1FCD4EDCB,
+	0x136E9DB845861416, 0x136E9DB5D7B25D82, 0x136E9DB53C3D6FDA, 0x136E9DB515603470,
+	0x136E9DB50BA8E596, 0x136E9DB5093B11DF, 0x136E9DB5089F9CF2, 0x136E9DB50878BFB6,
+	0x136E9DB5086F0867, 0x136E9DB5086C9A94, 0x136E9DB5086BFF1F, 0x136E9DB5086BD841,
+	0x136E9DB5086BCE8A, 0x136E9DB5086BCC1C, 0x136E9DB5086BCB81, 0x136E9DB5086BCB5A,
+	0x136E9DB5086BCB50, 0x136E9DB5086BCB4E, 0x136E9DB5086BCB4D, 0x136E9DB5086BCB4D,
+};
+
+// 2/pi in Q0.64 and pi/2 in Q2.62.
+static const uint64_t TwoOverPi = 0xA2F9836E4E44152AULL;
+static const uint64_t HalfPi    = 0x6487ED5110B4611AULL;
+
+static int64_t MultiplyQ61(int64_t left, int64_t right)
+{
+	uint64_t magnitude = (UInt128::Multiply(left < 0 ? 0U - uint64_t(left) : uint64_t(left), right < 0 ? 0U - uint64_t(right) : uint64_t(right)) >> 61U).GetLow();
+	return (left < 0) != (right < 0) ? -int64_t(magnitude) : int64_t(magnitude);
+}
+
+void FixedMath::SinCos(int64_t value, size_t fractionBits, size_t rotations, int64_t& sine, int64_t& cosine)
+{
+	uint64_t magnitude = value < 0 ? 0U - uint64_t(value) : uint64_t(value);
+
+	// |x| * 2/pi is the number of quarter turns. Keep the whole ones and 62 bits of the rest.
+	UInt128  turns    = UInt128::Multiply(magnitude, TwoOverPi);
+	uint64_t quadrant = (turns >> (fractionBits + 64U)).GetLow();
+	int64_t  rest     = int64_t((turns >> (fractionBits + 2U)).GetLow() & ((uint64_t(1) << 62U) - 1U));
+
+	// Go to the nearest quarter turn instead, which leaves at most pi/4 to rotate by.
+	if(rest >= int64_t(1) << 61U)
+	{
+		quadrant++;
+		rest -= int64_t(1) << 62U;
+	}
+
+	uint64_t restMagnitude = rest < 0 ? 0U - uint64_t(rest) : uint64_t(rest);
+	int64_t  angle         = int64_t((UInt128::Multiply(restMagnitude, HalfPi) >> 63U).GetLow());
+	if(rest < 0)
+		angle = -angle;
+
+	int64_t x = InverseGains[(rotations < 32U ? rotations : 32U) - 1U];
+	int64_t y = 0;
+
+	for(size_t i = 0U; i < rotations; i++)
+	{
+		// All ones when the angle left is negative, which turns each step around without a branch.
+		int64_t direction = angle >> 63;
+
+		int64_t stepX = ((y >> i) ^ direction) - direction;
+		int64_t stepY = ((x >> i) ^ direction) - direction;
+
+		x     -= stepX;
+		y     += stepY;
+		angle -= (ArcTangents[i] ^ direction) - direction;
+	}
+
+	// The rest of the angle is small enough that its sine is itself and its cosine one.
+	int64_t stepX = MultiplyQ61(y, angle);
+	int64_t stepY = MultiplyQ61(x, angle);
+	x -= stepX;
+	y += stepY;
+
+	switch(quadrant & 3U)
+	{
+	case 0U: sine =  y; cosine =  x; break;
+	case 1U: sine =  x; cosine = -y; break;
+	case 2U: sine = -y; cosine = -x; break;
+	default: sine = -x; cosine =  y; break;
+	}
+
+	if(value < 0)
+		sine = -sine;
+}
+
+// The formats the game code uses must work with Vector and Matrix, and their arithmetic must stay exact at compile time.
+static_assert(SignedNumber<Fixed32> && SignedNumber<Fixed64> && SignedNumber<Fixed<8U, 8U, FixedMode::Wrap>>);
+static_assert(sizeof(Fixed32) == sizeof(int32_t) && sizeof(Fixed64) == sizeof(int64_t) && TriviallyCopyable<Fixed64>);
+
+static_assert(Fixed32::One.ToRawValue() == 0x10000 && Fixed64::One.ToRawValue() == int64_t(1) << 32U);
+static_assert((Fixed32(3) * Fixed32(0.5) + Fixed32::One).ToRawValue() == 0x28000);
+static_assert((Fixed64(-7) / Fixed64(2)).ToRawValue() == -(int64_t(7) << 31U) && (Fixed64(1) / Fixed64(3)).ToRawValue() == 0x55555555);
+static_assert(Fixed32(30000) + Fixed32(30000) == Fixed32::Maximum && -Fixed32::Minimum == Fixed32::Maximum);
+static_assert(Fixed<16U, 16U, FixedMode::Wrap>(30000) + Fixed<16U, 16U, FixedMode::Wrap>(30000) == Fixed<16U, 16U, FixedMode::Wrap>(60000 - 65536));
+static_assert(Fixed64(1000000) * Fixed64(1000000) == Fixed64::Maximum && Fixed32::One / Fixed32::Zero == Fixed32::Maximum);
+static_assert(Fixed32(2).Sqrt().ToRawValue() == 92682 && Fixed64(2).Sqrt().ToRawValue() == 6074001000 && Fixed64(-1).Sqrt() == Fixed64::Zero);
+static_assert(Fixed32(-2.5).Round() == Fixed32(-3) && Fixed32(-2.5).Floor() == Fixed32(-3) && Fixed32(-2.5).Truncate() == Fixed32(-2));
+static_assert(Fixed64(Fixed32(1.25)) == Fixed64(1.25) && Fixed32(Fixed64::Epsilon) == Fixed32::Zero);
@@ -0,0 +1,457 @@
+#pragma once
+
+#include "../Exception.hpp"
+#include "UInt128.hpp"
+
+enum class FixedMode : uint8_t
+{
+	Saturate,
+	Wrap,
+};
+
+// The parts of Fixed that do not depend on the format.
+class FixedMath
+{
+public:
+	// The sine and cosine of value / 2^fractionBits radians by CORDIC, in Q2.61. After n rotations the angle left is
+	// below 2^(1 - n), small enough to rotate by with one multiplication at an error of about 2^(1 - 2n).
+	static void SinCos(int64_t value, size_t fractionBits, size_t rotations, int64_t& sine, int64_t& cosine);
+};
+
+// A signed binary fixed point number with IntBits integer bits, the sign included, and FracBits fraction bits, so
+// Fixed<16, 16> is the Q16.16 format. Everything is done with integers, so results are the same bit for bit on every
+// machine and compiler, which floating point does not promise. Results out of range saturate at Minimum or Maximum, or
+// wrap around in FixedMode::Wrap; conversions from floating point always saturate, and NaN becomes zero.
+//
+// Products, quotients and square roots are rounded to nearest, halfway cases away from zero, through intermediates of
+// twice the width, which for 64-bit formats means UInt128. Dividing by zero gives Minimum or Maximum by the sign of the
+// dividend, and the remainder of a division by zero is zero.
+template<size_t IntBits, size_t FracBits, FixedMode Mode = FixedMode::Saturate>
+class Fixed
+{
+private:
+	static constexpr size_t Bits = IntBits + FracBits;
+
+	static_assert(IntBits >= 1U && (Bits == 8U || Bits == 16U || Bits == 32U || Bits == 64U), "A fixed point format needs a sign bit and 8, 16, 32 or 64 bits in all.");
+
+	using Raw = std::conditional_t<Bits == 8U, int8_t, std::conditional_t<Bits == 16U, int16_t, std::conditional_t<Bits == 32U, int32_t, int64_t>>>;
+	using Unsigned = std::make_unsigned_t<Raw>;
+
+	static constexpr Raw RawMinimum = std::numeric_limits<Raw>::min();
+	static constexpr Raw RawMaximum = std::numeric_limits<Raw>::max();
+
+	static constexpr uint64_t FractionMask = (uint64_t(1) << FracBits) - 1U;
+
+	// CORDIC rotations for a result good to an eighth of the last place; see FixedMath::SinCos.
+	static constexpr size_t Rotations = (FracBits + 5U) / 2U;
+
+	Raw m_value;
+
+	template<std::integral T>
+	static constexpr uint64_t Magnitude(T value) noexcept
+	{
+		if constexpr(std::is_signed_v<T>)
+			return value < 0 ? 0U - uint64_t(value) : uint64_t(value);
+		else
+			return uint64_t(value);
+	}
+
+	static constexpr Raw FromMagnitude(const UInt128& magnitude, bool negative) noexcept
+	{
+		if constexpr(Mode == FixedMode::Saturate)
+		{
+			if(magnitude > UInt128(uint64_t(RawMaximum) + (negative ? 1U : 0U)))
+				return negative ? RawMinimum : RawMaximum;
+		}
+
+		Unsigned low = Unsigned(magnitude.GetLow());
+		return Raw(negative ? Unsigned(0U - low) : low);
+	}
+
+	// Brings an intermediate of a format narrower than 64 bits into range.
+	static constexpr Raw Narrow(int64_t value) noexcept
+	{
+		if constexpr(Mode == FixedMode::Saturate)
+		{
+			if(value < RawMinimum)
+				return RawMinimum;
+			if(value > RawMaximum)
+				return RawMaximum;
+		}
+
+		return Raw(value);
+	}
+
+	// A value with FromFracBits fraction bits in this format.
+	template<size_t FromFracBits>
+	static constexpr Raw Rescale(uint64_t magnitude, bool negative) noexcept
+	{
+		UInt128 result(magnitude);
+		if constexpr(FracBits >= FromFracBits)
+			result = result << (FracBits - FromFracBits);
+		else
+			result = (result + UInt128(uint64_t(1) << (FromFracBits - FracBits - 1U))) >> (FromFracBits - FracBits);
+
+		return FromMagnitude(result, negative);
+	}
+
+	static constexpr Raw Add(Raw left, Raw right) noexcept
+	{
+		Raw result = Raw(Unsigned(Unsigned(left) + Unsigned(right)));
+		if constexpr(Mode == FixedMode::Saturate)
+		{
+			if(((left ^ result) & (right ^ result)) < 0)
+				return left < 0 ? RawMinimum : RawMaximum;
+		}
+
+		return result;
+	}
+
+	static constexpr Raw Subtract(Raw left, Raw right) noexcept
+	{
+		Raw result = Raw(Unsigned(Unsigned(left) - Unsigned(right)));
+		if constexpr(Mode == FixedMode::Saturate)
+		{
+			if(((left ^ right) & (left ^ result)) < 0)
+				return left < 0 ? RawMinimum : RawMaximum;
+		}
+
+		return result;
+	}
+
+	static constexpr Raw Multiply(Raw left, Raw right) noexcept
+	{
+		if constexpr(Bits < 64U)
+		{
+			int64_t product = int64_t(left) * int64_t(right);
+			if constexpr(FracBits > 0U)
+				product = (product + (int64_t(1) << (FracBits - 1U)) - (product < 0 ? 1 : 0)) >> FracBits;
+
+			return Narrow(product);
+		}
+		else
+		{
+			UInt128 product = UInt128::Multiply(Magnitude(left), Magnitude(right));
+			if constexpr(FracBits > 0U)
+				product = (product + UInt128(uint64_t(1) << (FracBits - 1U))) >> FracBits;
+
+			return FromMagnitude(product, (left < 0) != (right < 0));
+		}
+	}
+
+	static constexpr Raw Divide(Raw left, Raw right) noexcept
+	{
+		if(right == 0)
+			return left < 0 ? RawMinimum : left > 0 ? RawMaximum : Raw(0);
+
+		bool     negative = (left < 0) != (right < 0);
+		uint64_t divisor  = Magnitude(right);
+
+		if constexpr(Bits < 64U)
+		{
+			uint64_t quotient = ((Magnitude(left) << FracBits) + divisor / 2U) / divisor;
+			return Narrow(negative ? -int64_t(quotient) : int64_t(quotient));
+		}
+		else
+		{
+			uint64_t remainder;
+			UInt128 quotient = ((UInt128(Magnitude(left)) << FracBits) + UInt128(divisor / 2U)).Divide(divisor, remainder);
+			return FromMagnitude(quotient, negative);
+		}
+	}
+
+	static constexpr Raw Remainder(Raw left, Raw right) noexcept
+	{
+		// Both values have the same scale, so the integer remainder is already the right one.
+		if(right == 0 || right == -1)
+			return 0;
+
+		return Raw(left % right);
+	}
+
+	static constexpr size_t BitWidth(uint64_t value)       noexcept { return size_t(std::bit_width(value)); }
+	static constexpr size_t BitWidth(const UInt128& value) noexcept { return value.BitWidth(); }
+
+	// The square root rounded to nearest, one bit at a time from the top.
+	template<typename T>
+	static constexpr uint64_t SquareRootByBits(T value) noexcept
+	{
+		T        remainder = T(0U);
+		uint64_t root      = 0U;
+
+		for(size_t shift = (BitWidth(value) + 1U) & ~size_t(1U); shift > 0U; )
+		{
+			shift -= 2U;
+			remainder = (remainder << 2U) | ((value >> shift) & T(3U));
+
+			T trial = (T(root) << 2U) | T(1U);
+			root <<= 1U;
+			if(remainder >= trial)
+			{
+				remainder = remainder - trial;
+				root |= 1U;
+			}
+		}
+
+		// value - root^2 > root exactly when value > (root + 1/2)^2.
+		return remainder > T(root) ? root + 1U : root;
+	}
+
+	// At run time a floating point estimate is corrected with exact integer arithmetic, so the result is the same
+	// however the machine rounds. The value is below 2^62.
+	static constexpr uint64_t SquareRoot(uint64_t value) noexcept
+	{
+		if(std::is_constant_evaluated())
+			return SquareRootByBits(value);
+
+		uint64_t root = uint64_t(sqrt(double(value)));
+		while(root * root > value)
+			root--;
+		while((root + 1U) * (root + 1U) <= value)
+			root++;
+
+		return value - root * root > root ? root + 1U : root;
+	}
+
+	// The value is below 2^126, so the root and the root plus one squared fit.
+	static constexpr uint64_t SquareRoot(const UInt128& value) noexcept
+	{
+		if(std::is_constant_evaluated())
+			return SquareRootByBits(value);
+
+		// The estimate is within 2^11 of the root; a Newton step in floating point brings it within one.
+		double   estimate = sqrt(value.ToDouble());
+		uint64_t root     = uint64_t(estimate);
+
+		UInt128 square = UInt128::Multiply(root, root);
+		double  error  = square > value ? -(square - value).ToDouble() : (value - square).ToDouble();
+		if(root > 0U)
+			root = uint64_t(int64_t(root) + int64_t(error / (2.0 * estimate)));
+
+		while(UInt128::Multiply(root, root) > value)
+			root--;
+		while(UInt128::Multiply(root + 1U, root + 1U) <= value)
+			root++;
+
+		return value - UInt128::Multiply(root, root) > UInt128(root) ? root + 1U : root;
+	}
+public:
+	static const Fixed<IntBits, FracBits, Mode> Minimum;
+	static const Fixed<IntBits, FracBits, Mode> Maximum;
+
+	static const Fixed<IntBits, FracBits, Mode> Zero;
+	static const Fixed<IntBits, FracBits, Mode> One;
+
+	// The smallest positive value.
+	static const Fixed<IntBits, FracBits, Mode> Epsilon;
+
+	static const Fixed<IntBits, FracBits, Mode> PI;
+
+	constexpr Fixed()                                            noexcept : m_value(0) {}
+	constexpr Fixed(const Fixed<IntBits, FracBits, Mode>& other) noexcept = default;
+
+	template<std::integral T>
+	constexpr Fixed(T value) noexcept : m_value(Rescale<0U>(Magnitude(value), value < T(0))) {}
+
+	template<std::floating_point T>
+	explicit constexpr Fixed(T value) noexcept : m_value(0)
+	{
+		// Scaling by a power of two is exact, so the result only depends on the value and the rounding below.
+		T scaled = value * T(uint64_t(1) << FracBits);
+		T limit  = T(uint64_t(1) << (Bits - 1U));
+
+		if(scaled != scaled)
+			m_value = 0;
+		else if(scaled >= limit)
+			m_value = RawMaximum;
+		else if(scaled < -limit)
+			m_value = RawMinimum;
+		else
+		{
+			// Past the precision of T every value is a whole number already, and adding a half could round it up.
+			if(scaled < T(uint64_t(1) << (std::numeric_limits<T>::digits - 1)) && scaled > -T(uint64_t(1) << (std::numeric_limits<T>::digits - 1)))
+				scaled += scaled < T(0) ? T(-0.5) : T(0.5);
+
+			if constexpr(Bits < 64U)
+				m_value = Narrow(int64_t(scaled));
+			else
+				m_value = Raw(int64_t(scaled));
+		}
+	}
+
+	template<std::floating_point T>
+	explicit constexpr Fixed(Float<T> value) noexcept : Fixed(value.ToRawValue()) {}
+
+	// Converts between formats, rounding away fraction bits that do not fit.
+	template<size_t OtherIntBits, size_t OtherFracBits, FixedMode OtherMode>
+	explicit constexpr Fixed(const Fixed<OtherIntBits, OtherFracBits, OtherMode>& other) noexcept :
+		m_value(Rescale<OtherFracBits>(Magnitude(other.ToRawValue()), other.ToRawValue() < 0)) {}
+
+	static constexpr Fixed<IntBits, FracBits, Mode> FromRawValue(Raw value) noexcept
+	{
+		Fixed<IntBits, FracBits, Mode> result;
+		result.m_value = value;
+		return result;
+	}
+
+	constexpr Raw ToRawValue() const noexcept { return m_value; }
+
+	template<std::floating_point T>
+	explicit constexpr operator Float<T>() const noexcept { return Float<T>(T(m_value) / T(uint64_t(1) << FracBits)); }
+
+	// Drops the fraction, rounding toward zero.
+	template<std::signed_integral T>
+	explicit constexpr operator SignedInteger<T>() const noexcept { return SignedInteger<T>(T(Truncate().m_value >> FracBits)); }
+
+	friend constexpr Fixed<IntBits, FracBits, Mode> operator+(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return FromRawValue(Add      (left.m_value, right.m_value)); }
+	friend constexpr Fixed<IntBits, FracBits, Mode> operator-(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return FromRawValue(Subtract (left.m_value, right.m_value)); }
+	friend constexpr Fixed<IntBits, FracBits, Mode> operator*(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return FromRawValue(Multiply (left.m_value, right.m_value)); }
+	friend constexpr Fixed<IntBits, FracBits, Mode> operator/(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return FromRawValue(Divide   (left.m_value, right.m_value)); }
+	friend constexpr Fixed<IntBits, FracBits, Mode> operator%(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return FromRawValue(Remainder(left.m_value, right.m_value)); }
+
+	friend constexpr Boolean operator< (Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return left.m_value <  right.m_value; }
+	friend constexpr Boolean operator> (Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return left.m_value >  right.m_value; }
+	friend constexpr Boolean operator<=(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return left.m_value <= right.m_value; }
+	friend constexpr Boolean operator>=(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return left.m_value >= right.m_value; }
+	friend constexpr Boolean operator==(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return left.m_value == right.m_value; }
+	friend constexpr Boolean operator!=(Fixed<IntBits, FracBits, Mode> left, Fixed<IntBits, FracBits, Mode> right) noexcept { return left.m_value != right.m_value; }
+
+	constexpr Fixed<IntBits, FracBits, Mode>& operator+=(Fixed<IntBits, FracBits, Mode> other) noexcept { m_value = Add      (m_value, other.m_value); return *this; }
+	constexpr Fixed<IntBits, FracBits, Mode>& operator-=(Fixed<IntBits, FracBits, Mode> other) noexcept { m_value = Subtract (m_value, other.m_value); return *this; }
+	constexpr Fixed<IntBits, FracBits, Mode>& operator*=(Fixed<IntBits, FracBits, Mode> other) noexcept { m_value = Multiply (m_value, other.m_value); return *this; }
+	constexpr Fixed<IntBits, FracBits, Mode>& operator/=(Fixed<IntBits, FracBits, Mode> other) noexcept { m_value = Divide   (m_value, other.m_value); return *this; }
+	constexpr Fixed<IntBits, FracBits, Mode>& operator%=(Fixed<IntBits, FracBits, Mode> other) noexcept { m_value = Remainder(m_value, other.m_value); return *this; }
+
+	constexpr Fixed<IntBits, FracBits, Mode> operator+() const noexcept { return *this; }
+	constexpr Fixed<IntBits, FracBits, Mode> operator-() const noexcept { return FromRawValue(Subtract(0, m_value)); }
+
+	constexpr Fixed<IntBits, FracBits, Mode>& operator++() noexcept { return (*this) += One; }
+	constexpr Fixed<IntBits, FracBits, Mode>& operator--() noexcept { return (*this) -= One; }
+
+	constexpr Fixed<IntBits, FracBits, Mode> operator++(int) noexcept
+	{
+		Fixed<IntBits, FracBits, Mode> result = *this;
+		++(*this);
+		return result;
+	}
+
+	constexpr Fixed<IntBits, FracBits, Mode> operator--(int) noexcept
+	{
+		Fixed<IntBits, FracBits, Mode> result = *this;
+		--(*this);
+		return result;
+	}
+
+	constexpr Fixed<IntBits, FracBits, Mode> Min(const Fixed<IntBits, FracBits, Mode>& other) const noexcept { return m_value < other.m_value ? *this : other; }
+	constexpr Fixed<IntBits, FracBits, Mode> Max(const Fixed<IntBits, FracBits, Mode>& other) const noexcept { return m_value > other.m_value ? *this : other; }
+
+	constexpr Fixed<IntBits, FracBits, Mode> Clamp(const Fixed<IntBits, FracBits, Mode>& min, const Fixed<IntBits, FracBits, Mode>& max) const noexcept { return min.Max(this->Min(max)); }
+
+	constexpr Fixed<IntBits, FracBits, Mode> Abs() const noexcept { return m_value < 0 ? -(*this) : *this; }
+
+	constexpr Fixed<IntBits, FracBits, Mode> Floor() const noexcept { return FromRawValue(Raw(uint64_t(int64_t(m_value)) & ~FractionMask)); }
+
+	constexpr Fixed<IntBits, FracBits, Mode> Ceiling() const noexcept { return (uint64_t(int64_t(m_value)) & FractionMask) != 0U ? Floor() + One : *this; }
+
+	constexpr Fixed<IntBits, FracBits, Mode> Truncate() const noexcept { return m_value < 0 ? Ceiling() : Floor(); }
+
+	// Halfway cases round away from zero.
+	constexpr Fixed<IntBits, FracBits, Mode> Round() const noexcept
+	{
+		if constexpr(FracBits == 0U)
+			return *this;
+		else
+		{
+			Fixed<IntBits, FracBits, Mode> half = FromRawValue(Raw(uint64_t(1) << (FracBits - 1U)));
+			return m_value < 0 ? (*this - half).Ceiling() : (*this + half).Floor();
+		}
+	}
+
+	// Negative values have no square root and give zero.
+	constexpr Fixed<IntBits, FracBits, Mode> Sqrt() const noexcept
+	{
+		if(m_value <= 0)
+			return Zero;
+
+		if constexpr(Bits < 64U)
+			return FromRawValue(Narrow(int64_t(SquareRoot(uint64_t(m_value) << FracBits))));
+		else
+			return FromRawValue(FromMagnitude(UInt128(SquareRoot(UInt128(uint64_t(m_value)) << FracBits)), false));
+	}
+
+	Fixed<IntBits, FracBits, Mode> Sin() const
+	{
+		int64_t sine, cosine;
+		FixedMath::SinCos(m_value, FracBits, Rotations, sine, cosine);
+		return FromRawValue(Rescale<61U>(Magnitude(sine), sine < 0));
+	}
+
+	Fixed<IntBits, FracBits, Mode> Cos() const
+	{
+		int64_t sine, cosine;
+		FixedMath::SinCos(m_value, FracBits, Rotations, sine, cosine);
+		return FromRawValue(Rescale<61U>(Magnitude(cosine), cosine < 0));
+	}
+
+	HashCode GetHashCode() const { return HashCode(size_t(m_value)); }
+
+	// The shortest decimal that reads back as the same value.
+	String ToString() const;
+
+	static Boolean TryParse(const String& string, Fixed<IntBits, FracBits, Mode>& result);
+	static Fixed<IntBits, FracBits, Mode> Parse(const String& string);
+};
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+constexpr Fixed<IntBits, FracBits, Mode> Fixed<IntBits, FracBits, Mode>::Minimum = Fixed<IntBits, FracBits, Mode>::FromRawValue(Fixed<IntBits, FracBits, Mode>::RawMinimum);
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+constexpr Fixed<IntBits, FracBits, Mode> Fixed<IntBits, FracBits, Mode>::Maximum = Fixed<IntBits, FracBits, Mode>::FromRawValue(Fixed<IntBits, FracBits, Mode>::RawMaximum);
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+constexpr Fixed<IntBits, FracBits, Mode> Fixed<IntBits, FracBits, Mode>::Zero = Fixed<IntBits, FracBits, Mode>::FromRawValue(0);
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+constexpr Fixed<IntBits, FracBits, Mode> Fixed<IntBits, FracBits, Mode>::One(1);
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+constexpr Fixed<IntBits, FracBits, Mode> Fixed<IntBits, FracBits, Mode>::Epsilon = Fixed<IntBits, FracBits, Mode>::FromRawValue(1);
+
+// pi in Q2.61, rounded to the format.
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+constexpr Fixed<IntBits, FracBits, Mode> Fixed<IntBits, FracBits, Mode>::PI = Fixed<IntBits, FracBits, Mode>::FromRawValue(Fixed<IntBits, FracBits, Mode>::template Rescale<61U>(0x6487ED5110B4611AULL, false));
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+String Fixed<IntBits, FracBits, Mode>::ToString() const
+{
+	wchar_t buffer[NumberFormat::MaximumFixedLength];
+	size_t count = NumberFormat::FormatFixed(int64_t(m_value), FracBits, buffer);
+
+	SharedArrayRef<Character> chars = HeapArray<Character>(count);
+	memcpy(chars.ToUnsafePointer(), buffer, count * sizeof(wchar_t));
+	return String(chars);
+}
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+Boolean Fixed<IntBits, FracBits, Mode>::TryParse(const String& string, Fixed<IntBits, FracBits, Mode>& result)
+{
+	int64_t value;
+	if(!NumberFormat::ParseFixed((const wchar_t*)string.AsSpan().ToUnsafePointer(), string.Length().ToRawValue(), FracBits, RawMinimum, RawMaximum, value))
+		return false;
+
+	result = FromRawValue(Raw(value));
+	return true;
+}
+
+template<size_t IntBits, size_t FracBits, FixedMode Mode>
+Fixed<IntBits, FracBits, Mode> Fixed<IntBits, FracBits, Mode>::Parse(const String& string)
+{
+	Fixed<IntBits, FracBits, Mode> result;
+	if(!TryParse(string, result))
+		FormatException(string).Throw();
+
+	return result;
+}
+
+using Fixed32 = Fixed<16U, 16U>;
+using Fixed64 = Fixed<32U, 32U>;
@@ -0,0 +1,911 @@
+#include "Math.hpp"
+#include "../Exception.hpp"
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define MATH_AVX2
+#define MATH_VECTORIZED
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_VECTORIZED
+#include <emmintrin.h>
+#endif
+
+// F16C came with AVX, and MSVC has no macro of its own for it.
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define MATH_F16C
+#include <immintrin.h>
+#endif
+
+static void CheckCounts(Size input, Size output)
+{
+	if(input != output)
+		Exception("The output span must be as long as the input."_s).Throw();
+}
+
+#if defined(MATH_VECTORIZED)
+
+// A thin layer over the intrinsics so each kernel is written once for both instruction sets. Float and double packs
+// are told apart by overloading; integer operations name their lane width.
+#if defined(MATH_AVX2)
+using FloatPack  = __m256;
+using DoublePack = __m256d;
+using IntPack    = __m256i;
+
+static inline FloatPack  Splat(float  value) { return _mm256_set1_ps(value); }
+static inline DoublePack Splat(double value) { return _mm256_set1_pd(value); }
+
+static inline IntPack SplatInt32(int32_t value) { return _mm256_set1_epi32(value); }
+static inline IntPack SplatInt64(int64_t value) { return _mm256_set1_epi64x(value); }
+
+static inline FloatPack  Load(const float*  source) { return _mm256_loadu_ps(source); }
+static inline DoublePack Load(const double* source) { return _mm256_loadu_pd(source); }
+
+static inline void Store(float*  destination, FloatPack  value) { _mm256_storeu_ps(destination, value); }
+static inline void Store(double* destination, DoublePack value) { _mm256_storeu_pd(destination, value); }
+
+static inline FloatPack  Add(FloatPack  left, FloatPack  right) { return _mm256_add_ps(left, right); }
+static inline DoublePack Add(DoublePack left, DoublePack right) { return _mm256_add_pd(left, right); }
+static inline FloatPack  Sub(FloatPack  left, FloatPack  right) { return _mm256_sub_ps(left, right); }
+static inline DoublePack Sub(DoublePack left, DoublePack right) { return _mm256_sub_pd(left, right); }
+static inline FloatPack  Mul(FloatPack  left, FloatPack  right) { return _mm256_mul_ps(left, right); }
+static inline DoublePack Mul(DoublePack left, DoublePack right) { return _mm256_mul_pd(left, right); }
+static inline FloatPack  Div(FloatPack  left, FloatPack  right) { return _mm256_div_ps(left, right); }
+static inline DoublePack Div(DoublePack left, DoublePack right) { return _mm256_div_pd(left, right); }
+
+// a * b + c, rounded once.
+static inline FloatPack  MulAdd(FloatPack  a, FloatPack  b, FloatPack  c) { return _mm256_fmadd_ps(a, b, c); }
+static inline DoublePack MulAdd(DoublePack a, DoublePack b, DoublePack c) { return _mm256_fmadd_pd(a, b, c); }
+
+// The second operand is returned when either is NaN, so Min(limit, x) keeps a NaN x.
+static inline FloatPack  Min(FloatPack  left, FloatPack  right) { return _mm256_min_ps(left, right); }
+static inline DoublePack Min(DoublePack left, DoublePack right) { return _mm256_min_pd(left, right); }
+static inline FloatPack  Max(FloatPack  left, FloatPack  right) { return _mm256_max_ps(left, right); }
+static inline DoublePack Max(DoublePack left, DoublePack right) { return _mm256_max_pd(left, right); }
+
+static inline FloatPack  Sqrt(FloatPack  value) { return _mm256_sqrt_ps(value); }
+static inline DoublePack Sqrt(DoublePack value) { return _mm256_sqrt_pd(value); }
+
+static inline FloatPack  And   (FloatPack  left, FloatPack  right) { return _mm256_and_ps(left, right); }
+static inline DoublePack And   (DoublePack left, DoublePack right) { return _mm256_and_pd(left, right); }
+static inline FloatPack  AndNot(FloatPack  left, FloatPack  right) { return _mm256_andnot_ps(left, right); }
+static inline DoublePack AndNot(DoublePack left, DoublePack right) { return _mm256_andnot_pd(left, right); }
+static inline FloatPack  Xor   (FloatPack  left, FloatPack  right) { return _mm256_xor_ps(left, right); }
+static inline DoublePack Xor   (DoublePack left, DoublePack right) { return _mm256_xor_pd(left, right); }
+
+static inline FloatPack  Less   (FloatPack  left, FloatPack  right) { return _mm256_cmp_ps(left, right, _CMP_LT_OQ); }
+static inline DoublePack Less   (DoublePack left, DoublePack right) { return _mm256_cmp_pd(left, right, _CMP_LT_OQ); }
+static inline FloatPack  Greater(FloatPack  left, FloatPack  right) { return _mm256_cmp_ps(left, right, _CMP_GT_OQ); }
+static inline DoublePack Greater(DoublePack left, DoublePack right) { return _mm256_cmp_pd(left, right, _CMP_GT_OQ); }
+static inline FloatPack  Equal  (FloatPack  left, FloatPack  right) { return _mm256_cmp_ps(left, right, _CMP_EQ_OQ); }
+static inline DoublePack Equal  (DoublePack left, DoublePack right) { return _mm256_cmp_pd(left, right, _CMP_EQ_OQ); }
+static inline FloatPack  IsNaN  (FloatPack  value) { return _mm256_cmp_ps(value, value, _CMP_UNORD_Q); }
+static inline DoublePack IsNaN  (DoublePack value) { return _mm256_cmp_pd(value, value, _CMP_UNORD_Q); }
+
+static inline FloatPack  Select(FloatPack  mask, FloatPack  whenSet, FloatPack  otherwise) { return _mm256_blendv_ps(otherwise, whenSet, mask); }
+static inline DoublePack Select(DoublePack mask, DoublePack whenSet, DoublePack otherwise) { return _mm256_blendv_pd(otherwise, whenSet, mask); }
+
+static inline int MoveMask(FloatPack  mask) { return _mm256_movemask_ps(mask); }
+static inline int MoveMask(DoublePack mask) { return _mm256_movemask_pd(mask); }
+
+static inline IntPack    Bits(FloatPack  value) { return _mm256_castps_si256(value); }
+static inline IntPack    Bits(DoublePack value) { return _mm256_castpd_si256(value); }
+static inline FloatPack  FloatFromBits (IntPack bits) { return _mm256_castsi256_ps(bits); }
+static inline DoublePack DoubleFromBits(IntPack bits) { return _mm256_castsi256_pd(bits); }
+
+static inline IntPack AndInt(IntPack left, IntPack right) { return _mm256_and_si256(left, right); }
+static inline IntPack OrInt (IntPack left, IntPack right) { return _mm256_or_si256(left, right); }
+
+static inline IntPack AddInt32(IntPack left, IntPack right) { return _mm256_add_epi32(left, right); }
+static inline IntPack SubInt32(IntPack left, IntPack right) { return _mm256_sub_epi32(left, right); }
+static inline IntPack AddInt64(IntPack left, IntPack right) { return _mm256_add_epi64(left, right); }
+static inline IntPack SubInt64(IntPack left, IntPack right) { return _mm256_sub_epi64(left, right); }
+
+template<int C> static inline IntPack ShiftLeft32 (IntPack value) { return _mm256_slli_epi32(value, C); }
+template<int C> static inline IntPack ShiftRight32(IntPack value) { return _mm256_srli_epi32(value, C); }
+template<int C> static inline IntPack ShiftRightSigned32(IntPack value) { return _mm256_srai_epi32(value, C); }
+template<int C> static inline IntPack ShiftLeft64 (IntPack value) { return _mm256_slli_epi64(value, C); }
+template<int C> static inline IntPack ShiftRight64(IntPack value) { return _mm256_srli_epi64(value, C); }
+
+static inline FloatPack ToFloat(IntPack value) { return _mm256_cvtepi32_ps(value); }
+
+// All ones in the lanes whose integer has its lowest bit set.
+static inline FloatPack  OddMask32(IntPack value) { return FloatFromBits (_mm256_cmpeq_epi32(_mm256_and_si256(value, _mm256_set1_epi32(1)),     _mm256_set1_epi32(1))); }
+static inline DoublePack OddMask64(IntPack value) { return DoubleFromBits(_mm256_cmpeq_epi64(_mm256_and_si256(value, _mm256_set1_epi64x(1)), _mm256_set1_epi64x(1))); }
+#else
+using FloatPack  = __m128;
+using DoublePack = __m128d;
+using IntPack    = __m128i;
+
+static inline FloatPack  Splat(float  value) { return _mm_set1_ps(value); }
+static inline DoublePack Splat(double value) { return _mm_set1_pd(value); }
+
+static inline IntPack SplatInt32(int32_t value) { return _mm_set1_epi32(value); }
+static inline IntPack SplatInt64(int64_t value) { return _mm_set_epi32(int32_t(value >> 32), int32_t(value), int32_t(value >> 32), int32_t(value)); }
+
+static inline FloatPack  Load(const float*  source) { return _mm_loadu_ps(source); }
+static inline DoublePack Load(const double* source) { return _mm_loadu_pd(source); }
+
+static inline void Store(float*  destination, FloatPack  value) { _mm_storeu_ps(destination, value); }
+static inline void Store(double* destination, DoublePack value) { _mm_storeu_pd(destination, value); }
+
+static inline FloatPack  Add(FloatPack  left, FloatPack  right) { return _mm_add_ps(left, right); }
+static inline DoublePack Add(DoublePack left, DoublePack right) { return _mm_add_pd(left, right); }
+static inline FloatPack  Sub(FloatPack  left, FloatPack  right) { return _mm_sub_ps(left, right); }
+static inline DoublePack Sub(DoublePack left, DoublePack right) { return _mm_sub_pd(left, right); }
+static inline FloatPack  Mul(FloatPack  left, FloatPack  right) { return _mm_mul_ps(left, right); }
+static inline DoublePack Mul(DoublePack left, DoublePack right) { return _mm_mul_pd(left, right); }
+static inline FloatPack  Div(FloatPack  left, FloatPack  right) { return _mm_div_ps(left, right); }
+static inline DoublePack Div(DoublePack left, DoublePack right) { return _mm_div_pd(left, right); }
+
+// Without FMA the product is rounded before the addition, which the kernels allow for.
+static inline FloatPack  MulAdd(FloatPack  a, FloatPack  b, FloatPack  c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+static inline DoublePack MulAdd(DoublePack a, DoublePack b, DoublePack c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+// The second operand is returned when either is NaN, so Min(limit, x) keeps a NaN x.
+static inline FloatPack  Min(FloatPack  left, FloatPack  right) { return _mm_min_ps(left, right); }
+static inline DoublePack Min(DoublePack left, DoublePack right) { return _mm_min_pd(left, right); }
+static inline FloatPack  Max(FloatPack  left, FloatPack  right) { return _mm_max_ps(left, right); }
+static inline DoublePack Max(DoublePack left, DoublePack right) { return _mm_max_pd(left, right); }
+
+static inline FloatPack  Sqrt(FloatPack  value) { return _mm_sqrt_ps(value); }
+static inline DoublePack Sqrt(DoublePack value) { return _mm_sqrt_pd(value); }
+
+static inline FloatPack  And   (FloatPack  left, FloatPack  right) { return _mm_and_ps(left, right); }
+static inline DoublePack And   (DoublePack left, DoublePack right) { return _mm_and_pd(left, right); }
+static inline FloatPack  AndNot(FloatPack  left, FloatPack  right) { return _mm_andnot_ps(left, right); }
+static inline DoublePack AndNot(DoublePack left, DoublePack right) { return _mm_andnot_pd(left, right); }
+static inline FloatPack  Xor   (FloatPack  left, FloatPack  right) { return _mm_xor_ps(left, right); }
+static inline DoublePack Xor   (DoublePack left, DoublePack right) { return _mm_xor_pd(left, right); }
+
+static inline FloatPack  Less   (FloatPack  left, FloatPack  right) { return _mm_cmplt_ps(left, right); }
+static inline DoublePack Less   (DoublePack left, DoublePack right) { return _mm_cmplt_pd(left, right); }
+static inline FloatPack  Greater(FloatPack  left, FloatPack  right) { return _mm_cmpgt_ps(left, right); }
+static inline DoublePack Greater(DoublePack left, DoublePack right) { return _mm_cmpgt_pd(left, right); }
+static inline FloatPack  Equal  (FloatPack  left, FloatPack  right) { return _mm_cmpeq_ps(left, right); }
+static inline DoublePack Equal  (DoublePack left, DoublePack right) { return _mm_cmpeq_pd(left, right); }
+static inline FloatPack  IsNaN  (FloatPack  value) { return _mm_cmpunord_ps(value, value); }
+static inline DoublePack IsNaN  (DoublePack value) { return _mm_cmpunord_pd(value, value); }
+
+static inline FloatPack  Select(FloatPack  mask, FloatPack  whenSet, FloatPack  otherwise) { return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, otherwise)); }
+static inline DoublePack Select(DoublePack mask, DoublePack whenSet, DoublePack otherwise) { return _mm_or_pd(_mm_and_pd(mask, whenSet), _mm_andnot_pd(mask, otherwise)); }
+
+static inline int MoveMask(FloatPack  mask) { return _mm_movemask_ps(mask); }
+static inline int MoveMask(DoublePack mask) { return _mm_movemask_pd(mask); }
+
+static inline IntPack    Bits(FloatPack  value) { return _mm_castps_si128(value); }
+static inline IntPack    Bits(DoublePack value) { return _mm_castpd_si128(value); }
+static inline FloatPack  FloatFromBits (IntPack bits) { return _mm_castsi128_ps(bits); }
+static inline DoublePack DoubleFromBits(IntPack bits) { return _mm_castsi128_pd(bits); }
+
+static inline IntPack AndInt(IntPack left, IntPack right) { return _mm_and_si128(left, right); }
+static inline IntPack OrInt (IntPack left, IntPack right) { return _mm_or_si128(left, right); }
+
+static inline IntPack AddInt32(IntPack left, IntPack right) { return _mm_add_epi32(left, right); }
+static inline IntPack SubInt32(IntPack left, IntPack right) { return _mm_sub_epi32(left, right); }
+static inline IntPack AddInt64(IntPack left, IntPack right) { return _mm_add_epi64(left, right); }
+static inline IntPack SubInt64(IntPack left, IntPack right) { return _mm_sub_epi64(left, right); }
+
+template<int C> static inline IntPack ShiftLeft32 (IntPack value) { return _mm_slli_epi32(value, C); }
+template<int C> static inline IntPack ShiftRight32(IntPack value) { return _mm_srli_epi32(value, C); }
+template<int C> static inline IntPack ShiftRightSigned32(IntPack value) { return _mm_srai_epi32(value, C); }
+template<int C> static inline IntPack ShiftLeft64 (IntPack value) { return _mm_slli_epi64(value, C); }
+template<int C> static inline IntPack ShiftRight64(IntPack value) { return _mm_srli_epi64(value, C); }
+
+static inline FloatPack ToFloat(IntPack value) { return _mm_cvtepi32_ps(value); }
+
+// All ones in the lanes whose integer has its lowest bit set. SSE2 has no 64-bit compare, so the bit is moved to the
+// top and spread with a 32-bit arithmetic shift.
+static inline FloatPack OddMask32(IntPack value) { return FloatFromBits(_mm_cmpeq_epi32(_mm_and_si128(value, _mm_set1_epi32(1)), _mm_set1_epi32(1))); }
+
+static inline DoublePack OddMask64(IntPack value)
+{
+	IntPack high = _mm_srai_epi32(_mm_slli_epi64(value, 63), 31);
+	return DoubleFromBits(_mm_shuffle_epi32(high, _MM_SHUFFLE(3, 3, 1, 1)));
+}
+#endif
+
+static inline FloatPack  Abs(FloatPack  value) { return AndNot(Splat(-0.0f), value); }
+static inline DoublePack Abs(DoublePack value) { return AndNot(Splat(-0.0),  value); }
+
+// Adding 1.5 * 2^23 (2^52) rounds a float (double) to the nearest integer and leaves that integer in the low bits, so
+// the rounded value and its integer form come from one addition.
+static const float  FloatRounder  = 12582912.0f;
+static const double DoubleRounder = 6755399441055744.0;
+
+// Single precision kernels, after Cephes. Arguments of sin and cos are reduced by pi/2 in three parts, so the error
+// grows slowly with the argument past a few thousand.
+static FloatPack SinCosKernel(FloatPack x, int32_t quadrantOffset)
+{
+	FloatPack rounded = MulAdd(x, Splat(0.636619772367581343f), Splat(FloatRounder));
+	IntPack   quadrant = AddInt32(SubInt32(Bits(rounded), Bits(Splat(FloatRounder))), SplatInt32(quadrantOffset));
+	FloatPack n        = Sub(rounded, Splat(FloatRounder));
+
+	FloatPack r = MulAdd(n, Splat(-1.5703125f), x);
+	r = MulAdd(n, Splat(-4.837512969970703125e-4f), r);
+	r = MulAdd(n, Splat(-7.54978995489188216e-8f),  r);
+
+	FloatPack z = Mul(r, r);
+
+	FloatPack sine = MulAdd(z, Splat(-1.9515295891e-4f), Splat(8.3321608736e-3f));
+	sine = MulAdd(sine, z, Splat(-1.6666654611e-1f));
+	sine = MulAdd(Mul(sine, z), r, r);
+
+	FloatPack cosine = MulAdd(z, Splat(2.443315711809948e-5f), Splat(-1.388731625493765e-3f));
+	cosine = MulAdd(cosine, z, Splat(4.166664568298827e-2f));
+	cosine = MulAdd(Mul(cosine, z), z, MulAdd(z, Splat(-0.5f), Splat(1.0f)));
+
+	FloatPack sign = FloatFromBits(ShiftLeft32<30>(AndInt(quadrant, SplatInt32(2))));
+	return Xor(Select(OddMask32(quadrant), cosine, sine), sign);
+}
+
+static FloatPack SinKernel(FloatPack x) { return SinCosKernel(x, 0); }
+static FloatPack CosKernel(FloatPack x) { return SinCosKernel(x, 1); }
+
+// Past this the reduction loses accuracy, and past about 2^22 the quadrant no longer fits the rounding trick at all.
+static const float FastSinCosLimit = 8192.0f;
+
+static FloatPack SinCosInRange(FloatPack x) { return Less(Abs(x), Splat(FastSinCosLimit)); }
+
+// Multiplies by 2^n in two steps, so results in the subnormal range are rounded only once and 2^128 can be reached.
+static FloatPack ScaleByPowerOfTwo(FloatPack value, IntPack n)
+{
+	IntPack half = ShiftRightSigned32<1>(n);
+	IntPack rest = SubInt32(n, half);
+
+	value = Mul(value, FloatFromBits(ShiftLeft32<23>(AddInt32(half, SplatInt32(127)))));
+	return  Mul(value, FloatFromBits(ShiftLeft32<23>(AddInt32(rest, SplatInt32(127)))));
+}
+
+static FloatPack ExpKernel(FloatPack x)
+{
+	// Past these the result is infinite or rounds to zero anyway, and the exponent stays representable.
+	x = Min(Splat(89.0f), Max(Splat(-104.0f), x));
+
+	FloatPack rounded = MulAdd(x, Splat(1.44269504088896341f), Splat(FloatRounder));
+	IntPack   k       = SubInt32(Bits(rounded), Bits(Splat(FloatRounder)));
+	FloatPack n       = Sub(rounded, Splat(FloatRounder));
+
+	FloatPack r = MulAdd(n, Splat(-0.693359375f), x);
+	r = MulAdd(n, Splat(2.12194440e-4f), r);
+
+	FloatPack p = MulAdd(Splat(1.9875691500e-4f), r, Splat(1.3981999507e-3f));
+	p = MulAdd(p, r, Splat(8.3334519073e-3f));
+	p = MulAdd(p, r, Splat(4.1665795894e-2f));
+	p = MulAdd(p, r, Splat(1.6666665459e-1f));
+	p = MulAdd(p, r, Splat(5.0000001201e-1f));
+	p = MulAdd(p, Mul(r, r), Add(r, Splat(1.0f)));
+
+	return ScaleByPowerOfTwo(p, k);
+}
+
+static FloatPack LogKernel(FloatPack x)
+{
+	// Subnormals are scaled into the normal range first.
+	FloatPack subnormal = Less(x, Splat(1.17549435e-38f));
+	FloatPack scaled    = Select(subnormal, Mul(x, Splat(8388608.0f)), x);
+
+	// scaled = m * 2^e with m in [0.5, 1), then m is moved to [sqrt(1/2), sqrt(2)).
+	IntPack   bits = Bits(scaled);
+	FloatPack e    = Sub(ToFloat(ShiftRight32<23>(bits)), Select(subnormal, Splat(149.0f), Splat(126.0f)));
+	FloatPack m    = FloatFromBits(OrInt(AndInt(bits, SplatInt32(0x007FFFFF)), SplatInt32(0x3F000000)));
+
+	FloatPack small = Less(m, Splat(0.707106781186547524f));
+	FloatPack f     = Sub(Add(m, And(small, m)), Splat(1.0f));
+	e = Sub(e, And(small, Splat(1.0f)));
+
+	FloatPack z = Mul(f, f);
+
+	FloatPack p = MulAdd(Splat(7.0376836292e-2f), f, Splat(-1.1514610310e-1f));
+	p = MulAdd(p, f, Splat(1.1676998740e-1f));
+	p = MulAdd(p, f, Splat(-1.2420140846e-1f));
+	p = MulAdd(p, f, Splat(1.4249322787e-1f));
+	p = MulAdd(p, f, Splat(-1.6668057665e-1f));
+	p = MulAdd(p, f, Splat(2.0000714765e-1f));
+	p = MulAdd(p, f, Splat(-2.4999993993e-1f));
+	p = MulAdd(p, f, Splat(3.3333331174e-1f));
+
+	FloatPack y = Mul(Mul(p, f), z);
+	y = MulAdd(e, Splat(-2.12194440e-4f), y);
+	y = MulAdd(z, Splat(-0.5f), y);
+
+	FloatPack result = MulAdd(e, Splat(0.693359375f), Add(f, y));
+
+	result = Select(Equal(x, Splat(0.0f)), Splat(-std::numeric_limits<float>::infinity()), result);
+	result = Select(Less(x, Splat(0.0f)), Splat(std::numeric_limits<float>::quiet_NaN()), result);
+	result = Select(Equal(x, Splat(std::numeric_limits<float>::infinity())), x, result);
+	return Select(IsNaN(x), x, result);
+}
+
+static FloatPack PowKernel(FloatPack x, FloatPack y) { return ExpKernel(Mul(y, LogKernel(x))); }
+
+// Double precision kernels, also after Cephes. They are accurate to about a unit in the last place, which also makes
+// them the accurate single precision functions once rounded.
+static DoublePack SinCosKernel(DoublePack x, int64_t quadrantOffset)
+{
+	DoublePack rounded  = MulAdd(x, Splat(0.636619772367581343076), Splat(DoubleRounder));
+	IntPack    quadrant = AddInt64(SubInt64(Bits(rounded), Bits(Splat(DoubleRounder))), SplatInt64(quadrantOffset));
+	DoublePack n        = Sub(rounded, Splat(DoubleRounder));
+
+	DoublePack r = MulAdd(n, Splat(-1.570796251296997), x);
+	r = MulAdd(n, Splat(-7.549789415861596e-8), r);
+
+	// The rest of pi/2 is subtracted in one step, which rounds once. Close to a multiple of pi/2 that step is exact but
+	// the rest needs more precision, so it is split in two there.
+	DoublePack single = MulAdd(n, Splat(-5.390302858158119e-15), r);
+	DoublePack split  = MulAdd(n, Splat(2.6718907338610155e-24), MulAdd(n, Splat(-5.39030286083001e-15), r));
+	r = Select(Less(Abs(single), Splat(2.9802322387695312e-8)), split, single);
+
+	DoublePack z = Mul(r, r);
+
+	DoublePack sine = MulAdd(Splat(1.58962301576546568060e-10), z, Splat(-2.50507477628578072866e-8));
+	sine = MulAdd(sine, z, Splat(2.75573136213857245213e-6));
+	sine = MulAdd(sine, z, Splat(-1.98412698295895385996e-4));
+	sine = MulAdd(sine, z, Splat(8.33333333332211858878e-3));
+	sine = MulAdd(sine, z, Splat(-1.66666666666666307295e-1));
+	sine = MulAdd(Mul(sine, z), r, r);
+
+	DoublePack cosine = MulAdd(Splat(-1.13585365213876817300e-11), z, Splat(2.08757008419747316778e-9));
+	cosine = MulAdd(cosine, z, Splat(-2.75573141792967388112e-7));
+	cosine = MulAdd(cosine, z, Splat(2.48015872888517045348e-5));
+	cosine = MulAdd(cosine, z, Splat(-1.38888888888730564116e-3));
+	cosine = MulAdd(cosine, z, Splat(4.16666666666665929218e-2));
+	cosine = MulAdd(Mul(cosine, z), z, MulAdd(z, Splat(-0.5), Splat(1.0)));
+
+	DoublePack sign = DoubleFromBits(ShiftLeft64<62>(AndInt(quadrant, SplatInt64(2))));
+	return Xor(Select(OddMask64(quadrant), cosine, sine), sign);
+}
+
+static DoublePack SinKernel(DoublePack x) { return SinCosKernel(x, 0); }
+static DoublePack CosKernel(DoublePack x) { return SinCosKernel(x, 1); }
+
+// Each part of pi/2 times the quadrant is exact below 2^23, even without FMA.
+static DoublePack SinCosInRange(DoublePack x) { return Less(Abs(x), Splat(8388608.0)); }
+
+static DoublePack ScaleByPowerOfTwo(DoublePack value, DoublePack n, IntPack k)
+{
+	IntPack half = SubInt64(Bits(MulAdd(n, Splat(0.5), Splat(DoubleRounder))), Bits(Splat(DoubleRounder)));
+	IntPack rest = SubInt64(k, half);
+
+	value = Mul(value, DoubleFromBits(ShiftLeft64<52>(AddInt64(half, SplatInt64(1023)))));
+	return  Mul(value, DoubleFromBits(ShiftLeft64<52>(AddInt64(rest, SplatInt64(1023)))));
+}
+
+static DoublePack ExpKernel(DoublePack x)
+{
+	x = Min(Splat(710.0), Max(Splat(-746.0), x));
+
+	DoublePack rounded = MulAdd(x, Splat(1.4426950408889634073599), Splat(DoubleRounder));
+	IntPack    k       = SubInt64(Bits(rounded), Bits(Splat(DoubleRounder)));
+	DoublePack n       = Sub(rounded, Splat(DoubleRounder));
+
+	DoublePack r = MulAdd(n, Splat(-6.93145751953125e-1), x);
+	r = MulAdd(n, Splat(-1.42860682030941723212e-6), r);
+
+	DoublePack z = Mul(r, r);
+
+	DoublePack p = MulAdd(Splat(1.26177193074810590878e-4), z, Splat(3.02994407707441961300e-2));
+	p = Mul(MulAdd(p, z, Splat(9.99999999999999999910e-1)), r);
+
+	DoublePack q = MulAdd(Splat(3.00198505138664455042e-6), z, Splat(2.52448340349684104192e-3));
+	q = MulAdd(q, z, Splat(2.27265548208155028766e-1));
+	q = MulAdd(q, z, Splat(2.00000000000000000009e0));
+
+	DoublePack y = MulAdd(Div(p, Sub(q, p)), Splat(2.0), Splat(1.0));
+	return ScaleByPowerOfTwo(y, n, k);
+}
+
+static DoublePack LogKernel(DoublePack x)
+{
+	const double exponentBias = 4503599627370496.0;
+
+	DoublePack subnormal = Less(x, Splat(2.2250738585072014e-308));
+	DoublePack scaled    = Select(subnormal, Mul(x, Splat(18014398509481984.0)), x);
+
+	// The biased exponent is placed in the mantissa of 2^52, which turns it into a double without a conversion.
+	IntPack    bits = Bits(scaled);
+	DoublePack e    = DoubleFromBits(OrInt(ShiftRight64<52>(bits), Bits(Splat(exponentBias))));
+	e = Sub(e, Select(subnormal, Splat(exponentBias + 1076.0), Splat(exponentBias + 1022.0)));
+
+	DoublePack m = DoubleFromBits(OrInt(AndInt(bits, SplatInt64(0x000FFFFFFFFFFFFF)), SplatInt64(0x3FE0000000000000)));
+
+	DoublePack small = Less(m, Splat(0.70710678118654752440));
+	DoublePack f     = Sub(Add(m, And(small, m)), Splat(1.0));
+	e = Sub(e, And(small, Splat(1.0)));
+
+	DoublePack z = Mul(f, f);
+
+	DoublePack p = MulAdd(Splat(1.01875663804580931796e-4), f, Splat(4.97494994976747001425e-1));
+	p = MulAdd(p, f, Splat(4.70579119878881725854e0));
+	p = MulAdd(p, f, Splat(1.44989225341610930846e1));
+	p = MulAdd(p, f, Splat(1.79368678507819816313e1));
+	p = MulAdd(p, f, Splat(7.70838733755885391666e0));
+
+	DoublePack q = Add(f, Splat(1.12873587189167450590e1));
+	q = MulAdd(q, f, Splat(4.52279145837532221105e1));
+	q = MulAdd(q, f, Splat(8.29875266912776603211e1));
+	q = MulAdd(q, f, Splat(7.11544750618563894466e1));
+	q = MulAdd(q, f, Splat(2.31251620126765340583e1));
+
+	DoublePack y = Mul(f, Div(Mul(z, p), q));
+	y = MulAdd(e, Splat(-2.121944400546905827679e-4), y);
+	y = MulAdd(z, Splat(-0.5), y);
+
+	DoublePack result = MulAdd(e, Splat(0.693359375), Add(f, y));
+
+	result = Select(Equal(x, Splat(0.0)), Splat(-std::numeric_limits<double>::infinity()), result);
+	result = Select(Less(x, Splat(0.0)), Splat(std::numeric_limits<double>::quiet_NaN()), result);
+	result = Select(Equal(x, Splat(std::numeric_limits<double>::infinity())), x, result);
+	return Select(IsNaN(x), x, result);
+}
+
+static DoublePack PowKernel(DoublePack x, DoublePack y) { return ExpKernel(Mul(y, LogKernel(x))); }
+
+// Negative, zero, infinite and NaN arguments have too many special cases to be worth doing in the kernel.
+static FloatPack PowInRange(FloatPack x, FloatPack y)
+{
+	FloatPack infinity = Splat(std::numeric_limits<float>::infinity());
+	return And(And(Greater(x, Splat(0.0f)), Less(x, infinity)), Less(Abs(y), infinity));
+}
+
+static DoublePack PowInRange(DoublePack x, DoublePack y)
+{
+	DoublePack infinity = Splat(std::numeric_limits<double>::infinity());
+	return And(And(Greater(x, Splat(0.0)), Less(x, infinity)), Less(Abs(y), infinity));
+}
+
+// Runs a kernel a pack at a time. The last partial pack is padded rather than finished with scalar code, so every
+// element goes through the same kernel. Lanes outside the kernel's range are recomputed with the C library.
+template<typename T, typename P, P Kernel(P), P (*InRange)(P) = nullptr, T (*Fallback)(T) = nullptr>
+static void Apply(const T* input, T* output, size_t count)
+{
+	const size_t width = sizeof(P) / sizeof(T);
+
+	for(size_t i = 0U; i < count; i += width)
+	{
+		size_t lanes = count - i < width ? count - i : width;
+
+		T padded[width] = {};
+		if(lanes < width)
+			memcpy(padded, input + i, lanes * sizeof(T));
+
+		P value  = Load(lanes < width ? padded : input + i);
+		P result = Kernel(value);
+
+		int outOfRange = 0;
+		if constexpr(InRange != nullptr)
+			outOfRange = ~MoveMask(InRange(value)) & ((1 << lanes) - 1);
+
+		if(outOfRange == 0 && lanes == width)
+		{
+			Store(output + i, result);
+			continue;
+		}
+
+		T inputs[width];
+		T results[width];
+		Store(inputs,  value);
+		Store(results, result);
+
+		for(size_t lane = 0U; lane < lanes; lane++)
+			output[i + lane] = (outOfRange >> lane) & 1 ? Fallback(inputs[lane]) : results[lane];
+	}
+}
+
+template<typename T, typename P, P Kernel(P, P), P InRange(P, P), T Fallback(T, T)>
+static void Apply(const T* left, const T* right, T* output, size_t count)
+{
+	const size_t width = sizeof(P) / sizeof(T);
+
+	for(size_t i = 0U; i < count; i += width)
+	{
+		size_t lanes = count - i < width ? count - i : width;
+
+		T paddedLeft[width]  = {};
+		T paddedRight[width] = {};
+		if(lanes < width)
+		{
+			memcpy(paddedLeft,  left  + i, lanes * sizeof(T));
+			memcpy(paddedRight, right + i, lanes * sizeof(T));
+		}
+
+		P x      = Load(lanes < width ? paddedLeft  : left  + i);
+		P y      = Load(lanes < width ? paddedRight : right + i);
+		P result = Kernel(x, y);
+
+		int outOfRange = ~MoveMask(InRange(x, y)) & ((1 << lanes) - 1);
+		if(outOfRange == 0 && lanes == width)
+		{
+			Store(output + i, result);
+			continue;
+		}
+
+		T xs[width];
+		T ys[width];
+		T results[width];
+		Store(xs,      x);
+		Store(ys,      y);
+		Store(results, result);
+
+		for(size_t lane = 0U; lane < lanes; lane++)
+			output[i + lane] = (outOfRange >> lane) & 1 ? Fallback(xs[lane], ys[lane]) : results[lane];
+	}
+}
+
+// Accurate single precision functions run the double kernels on a widened copy of the input, and fast double
+// precision functions run the float kernels on a narrowed one. Both convert a block at a time on the stack.
+static const size_t ConversionBlockLength = 256U;
+
+template<typename From, typename To, void Function(const To*, To*, size_t)>
+static void Convert(const From* input, From* output, size_t count)
+{
+	To block[ConversionBlockLength];
+	for(size_t i = 0U; i < count; i += ConversionBlockLength)
+	{
+		size_t length = count - i < ConversionBlockLength ? count - i : ConversionBlockLength;
+
+		for(size_t j = 0U; j < length; j++)
+			block[j] = To(input[i + j]);
+
+		Function(block, block, length);
+
+		for(size_t j = 0U; j < length; j++)
+			output[i + j] = From(block[j]);
+	}
+}
+
+template<typename From, typename To, void Function(const To*, const To*, To*, size_t)>
+static void Convert(const From* left, const From* right, From* output, size_t count)
+{
+	To leftBlock[ConversionBlockLength];
+	To rightBlock[ConversionBlockLength];
+	for(size_t i = 0U; i < count; i += ConversionBlockLength)
+	{
+		size_t length = count - i < ConversionBlockLength ? count - i : ConversionBlockLength;
+
+		for(size_t j = 0U; j < length; j++)
+		{
+			leftBlock[j]  = To(left[i + j]);
+			rightBlock[j] = To(right[i + j]);
+		}
+
+		Function(leftBlock, rightBlock, leftBlock, length);
+
+		for(size_t j = 0U; j < length; j++)
+			output[i + j] = From(leftBlock[j]);
+	}
+}
+
+static float  SinFallback(float  x) { return sinf(x); }
+static double SinFallback(double x) { return sin(x);  }
+static float  CosFallback(float  x) { return cosf(x); }
+static double CosFallback(double x) { return cos(x);  }
+
+static float  PowFallback(float  x, float  y) { return powf(x, y); }
+static double PowFallback(double x, double y) { return pow(x, y);  }
+
+static void SinFast(const float*  input, float*  output, size_t count) { Apply<float,  FloatPack,  SinKernel, SinCosInRange, SinFallback>(input, output, count); }
+static void SinFull(const double* input, double* output, size_t count) { Apply<double, DoublePack, SinKernel, SinCosInRange, SinFallback>(input, output, count); }
+static void CosFast(const float*  input, float*  output, size_t count) { Apply<float,  FloatPack,  CosKernel, SinCosInRange, CosFallback>(input, output, count); }
+static void CosFull(const double* input, double* output, size_t count) { Apply<double, DoublePack, CosKernel, SinCosInRange, CosFallback>(input, output, count); }
+static void ExpFast(const float*  input, float*  output, size_t count) { Apply<float,  FloatPack,  ExpKernel>(input, output, count); }
+static void ExpFull(const double* input, double* output, size_t count) { Apply<double, DoublePack, ExpKernel>(input, output, count); }
+static void LogFast(const float*  input, float*  output, size_t count) { Apply<float,  FloatPack,  LogKernel>(input, output, count); }
+static void LogFull(const double* input, double* output, size_t count) { Apply<double, DoublePack, LogKernel>(input, output, count); }
+
+static void PowFast(const float*  x, const float*  y, float*  output, size_t count) { Apply<float,  FloatPack,  PowKernel, PowInRange, PowFallback>(x, y, output, count); }
+static void PowFull(const double* x, const double* y, double* output, size_t count) { Apply<double, DoublePack, PowKernel, PowInRange, PowFallback>(x, y, output, count); }
+
+static void SqrtFull(const float*  input, float*  output, size_t count) { Apply<float,  FloatPack,  Sqrt>(input, output, count); }
+static void SqrtFull(const double* input, double* output, size_t count) { Apply<double, DoublePack, Sqrt>(input, output, count); }
+
+// The fast Float64 sine and cosine run in single precision where the Float32 kernel is accurate. Larger arguments
+// would lose their fraction when rounded to Float32, so they go to the double precision C library instead.
+template<void Function(const float*, float*, size_t), double Fallback(double)>
+static void SinCosFast(const double* input, double* output, size_t count)
+{
+	float block[ConversionBlockLength];
+	for(size_t i = 0U; i < count; i += ConversionBlockLength)
+	{
+		size_t length = count - i < ConversionBlockLength ? count - i : ConversionBlockLength;
+
+		for(size_t j = 0U; j < length; j++)
+			block[j] = float(input[i + j]);
+
+		Function(block, block, length);
+
+		for(size_t j = 0U; j < length; j++)
+		{
+			double x = input[i + j];
+			output[i + j] = fabs(x) < FastSinCosLimit ? double(block[j]) : Fallback(x);
+		}
+	}
+}
+
+static void SinAccurate(const float*  input, float*  output, size_t count) { Convert<float,  double, SinFull>(input, output, count); }
+static void SinAccurate(const double* input, double* output, size_t count) { SinFull(input, output, count); }
+static void SinFast    (const double* input, double* output, size_t count) { SinCosFast<SinFast, SinFallback>(input, output, count); }
+static void CosAccurate(const float*  input, float*  output, size_t count) { Convert<float,  double, CosFull>(input, output, count); }
+static void CosAccurate(const double* input, double* output, size_t count) { CosFull(input, output, count); }
+static void CosFast    (const double* input, double* output, size_t count) { SinCosFast<CosFast, CosFallback>(input, output, count); }
+static void ExpAccurate(const float*  input, float*  output, size_t count) { Convert<float,  double, ExpFull>(input, output, count); }
+static void ExpAccurate(const double* input, double* output, size_t count) { ExpFull(input, output, count); }
+static void ExpFast    (const double* input, double* output, size_t count) { Convert<double, float,  ExpFast>(input, output, count); }
+static void LogAccurate(const float*  input, float*  output, size_t count) { Convert<float,  double, LogFull>(input, output, count); }
+static void LogAccurate(const double* input, double* output, size_t count) { LogFull(input, output, count); }
+static void LogFast    (const double* input, double* output, size_t count) { Convert<double, float,  LogFast>(input, output, count); }
+
+static void PowAccurate(const float* x, const float* y, float* output, size_t count) { Convert<float, double, PowFull>(x, y, output, count); }
+
+// exp(y * log(x)) loses the relative accuracy of the product when the result is far from one, which single
+// precision absorbs but double precision does not.
+static void PowAccurate(const double* x, const double* y, double* output, size_t count)
+{
+	for(size_t i = 0U; i < count; i++)
+		output[i] = pow(x[i], y[i]);
+}
+
+static void PowFast(const double* x, const double* y, double* output, size_t count) { Convert<double, float, PowFast>(x, y, output, count); }
+
+static void SqrtAccurate(const float*  input, float*  output, size_t count) { SqrtFull(input, output, count); }
+static void SqrtAccurate(const double* input, double* output, size_t count) { SqrtFull(input, output, count); }
+
+#else
+
+static void SinAccurate(const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = float(sin(double(input[i]))); }
+static void SinAccurate(const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = sin(input[i]); }
+static void SinFast    (const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = sinf(input[i]); }
+static void SinFast    (const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = fabs(input[i]) < 8192.0 ? sinf(float(input[i])) : sin(input[i]); }
+static void CosAccurate(const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = float(cos(double(input[i]))); }
+static void CosAccurate(const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = cos(input[i]); }
+static void CosFast    (const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = cosf(input[i]); }
+static void CosFast    (const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = fabs(input[i]) < 8192.0 ? cosf(float(input[i])) : cos(input[i]); }
+static void ExpAccurate(const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = float(exp(double(input[i]))); }
+static void ExpAccurate(const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = exp(input[i]); }
+static void ExpFast    (const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = expf(input[i]); }
+static void ExpFast    (const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = expf(float(input[i])); }
+static void LogAccurate(const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = float(log(double(input[i]))); }
+static void LogAccurate(const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = log(input[i]); }
+static void LogFast    (const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = logf(input[i]); }
+static void LogFast    (const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = logf(float(input[i])); }
+
+static void PowAccurate(const float*  x, const float*  y, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = float(pow(double(x[i]), double(y[i]))); }
+static void PowAccurate(const double* x, const double* y, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = pow(x[i], y[i]); }
+static void PowFast    (const float*  x, const float*  y, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = powf(x[i], y[i]); }
+static void PowFast    (const double* x, const double* y, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = powf(float(x[i]), float(y[i])); }
+
+static void SqrtAccurate(const float*  input, float*  output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = sqrtf(input[i]); }
+static void SqrtAccurate(const double* input, double* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = sqrt(input[i]); }
+
+#endif
+
+#if defined(MATH_VECTORIZED) && !defined(MATH_F16C)
+// Float16 conversions of four values with SSE2, after Fabian Giesen's, bit for bit what F16C gives. Values that are
+// subnormal in 16 bits are rounded by adding a magic number in floating point, which relies on rounding to nearest.
+static inline __m128i NarrowFloat16(__m128 value)
+{
+	__m128i sign     = _mm_and_si128(_mm_castps_si128(value), _mm_set1_epi32(int32_t(0x80000000U)));
+	__m128i absolute = _mm_xor_si128(_mm_castps_si128(value), sign);
+
+	// 2^-14 and 2^16, below and from which the result is subnormal and infinite, and the magic number that lines up
+	// the subnormal's mantissa with the bottom bits.
+	__m128i subnormal = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), absolute);
+	__m128i regular   = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absolute);
+	__m128  magic     = _mm_castsi128_ps(_mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23));
+
+	__m128i small = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(absolute), magic)), _mm_castps_si128(magic));
+
+	// Rebias, add just under half of the last kept place and one more when that place is odd, and shift into place.
+	__m128i odd    = _mm_srai_epi32(_mm_slli_epi32(absolute, 18), 31);
+	__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absolute, _mm_set1_epi32(0xFFF - ((127 - 15) << 23))), odd), 13);
+
+	// NaNs keep the top of their payload and are made quiet; everything else past the range is infinity.
+	__m128i nan     = _mm_castps_si128(_mm_cmpunord_ps(_mm_castsi128_ps(absolute), _mm_castsi128_ps(absolute)));
+	__m128i payload = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(absolute, 13), _mm_set1_epi32(0x3FF)), _mm_set1_epi32(0x200));
+	__m128i special = _mm_or_si128(_mm_and_si128(nan, payload), _mm_set1_epi32(0x7C00));
+
+	__m128i finite = _mm_or_si128(_mm_and_si128(subnormal, small), _mm_andnot_si128(subnormal, normal));
+	__m128i result = _mm_or_si128(_mm_and_si128(regular, finite), _mm_andnot_si128(regular, special));
+
+	// The sign comes back sign extended, so a signed saturating pack keeps all 16 bits.
+	return _mm_or_si128(result, _mm_srai_epi32(sign, 16));
+}
+
+// Takes four values zero extended to 32 bits. Subnormals are normalized by a subtraction of normal numbers, so this
+// is also exact when denormals are treated as zero.
+static inline __m128 WidenFloat16(__m128i bits)
+{
+	__m128i absolute = _mm_and_si128(bits, _mm_set1_epi32(0x7FFF));
+	__m128i shifted  = _mm_slli_epi32(absolute, 13);
+	__m128i exponent = _mm_and_si128(shifted, _mm_set1_epi32(0x0F800000));
+
+	__m128i rebiased = _mm_add_epi32(shifted, _mm_set1_epi32((127 - 15) << 23));
+	__m128i special  = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0F800000));
+	rebiased = _mm_add_epi32(rebiased, _mm_and_si128(special, _mm_set1_epi32((128 - 16) << 23)));
+
+	__m128i subnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+	__m128  magic     = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+	__m128i small     = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(rebiased, _mm_set1_epi32(1 << 23))), magic));
+
+	__m128i result = _mm_or_si128(_mm_and_si128(subnormal, small), _mm_andnot_si128(subnormal, rebiased));
+	__m128i quiet  = _mm_and_si128(_mm_cmpgt_epi32(absolute, _mm_set1_epi32(0x7C00)), _mm_set1_epi32(0x00400000));
+	__m128i sign   = _mm_slli_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x8000)), 16);
+
+	return _mm_castsi128_ps(_mm_or_si128(_mm_or_si128(result, quiet), sign));
+}
+#endif
+
+static void ToFloat16(const float* input, uint16_t* output, size_t count)
+{
+	size_t i = 0U;
+#if defined(MATH_F16C)
+	for(; i + 8U <= count; i += 8U)
+		_mm_storeu_si128((__m128i*)(output + i), _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT));
+#elif defined(MATH_VECTORIZED)
+	for(; i + 8U <= count; i += 8U)
+		_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi32(NarrowFloat16(_mm_loadu_ps(input + i)), NarrowFloat16(_mm_loadu_ps(input + i + 4U))));
+#endif
+	for(; i < count; i++)
+		output[i] = Float16(input[i]).ToRawValue();
+}
+
+static void FromFloat16(const uint16_t* input, float* output, size_t count)
+{
+	size_t i = 0U;
+#if defined(MATH_F16C)
+	for(; i + 8U <= count; i += 8U)
+		_mm256_storeu_ps(output + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(input + i))));
+#elif defined(MATH_VECTORIZED)
+	for(; i + 8U <= count; i += 8U)
+	{
+		__m128i bits = _mm_loadu_si128((const __m128i*)(input + i));
+		_mm_storeu_ps(output + i,      WidenFloat16(_mm_unpacklo_epi16(bits, _mm_setzero_si128())));
+		_mm_storeu_ps(output + i + 4U, WidenFloat16(_mm_unpackhi_epi16(bits, _mm_setzero_si128())));
+	}
+#endif
+	for(; i < count; i++)
+		output[i] = Float32(Float16::FromRawValue(input[i])).ToRawValue();
+}
+
+#if defined(MATH_VECTORIZED)
+// Rounds four values the way the scalar conversion does: add just under half of the last kept place, plus one if that
+// place is odd, except for NaNs, which are made quiet instead so they cannot round into infinity. The upper halves
+// come back sign extended so a signed saturating pack keeps all 16 bits.
+static inline __m128i NarrowBFloat16(__m128i bits)
+{
+	__m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(_mm_set1_epi32(0x7FFF), _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1))));
+	__m128i nan     = _mm_cmpgt_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF)), _mm_set1_epi32(0x7F800000));
+	__m128i quiet   = _mm_or_si128(bits, _mm_set1_epi32(0x00400000));
+
+	return _mm_srai_epi32(_mm_or_si128(_mm_and_si128(nan, quiet), _mm_andnot_si128(nan, rounded)), 16);
+}
+#endif
+
+#if defined(MATH_AVX2)
+// The same for eight values. Narrowing is bound by these operations rather than by memory, so twice the width is
+// nearly twice the speed.
+static inline __m256i NarrowBFloat16(__m256i bits)
+{
+	__m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(_mm256_set1_epi32(0x7FFF), _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1))));
+	__m256i nan     = _mm256_cmpgt_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_set1_epi32(0x7F800000));
+	__m256i quiet   = _mm256_or_si256(bits, _mm256_set1_epi32(0x00400000));
+
+	return _mm256_srai_epi32(_mm256_blendv_epi8(rounded, quiet, nan), 16);
+}
+#endif
+
+static void ToBFloat16(const float* input, uint16_t* output, size_t count)
+{
+	size_t i = 0U;
+#if defined(MATH_AVX2)
+	// The pack works within each half of the register, so the middle quarters are swapped back afterwards.
+	for(; i + 16U <= count; i += 16U)
+	{
+		__m256i low  = NarrowBFloat16(_mm256_castps_si256(_mm256_loadu_ps(input + i)));
+		__m256i high = NarrowBFloat16(_mm256_castps_si256(_mm256_loadu_ps(input + i + 8U)));
+		_mm256_storeu_si256((__m256i*)(output + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8));
+	}
+#endif
+#if defined(MATH_VECTORIZED)
+	for(; i + 8U <= count; i += 8U)
+	{
+		__m128i low  = NarrowBFloat16(_mm_castps_si128(_mm_loadu_ps(input + i)));
+		__m128i high = NarrowBFloat16(_mm_castps_si128(_mm_loadu_ps(input + i + 4U)));
+		_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi32(low, high));
+	}
+#endif
+	for(; i < count; i++)
+		output[i] = BFloat16(input[i]).ToRawValue();
+}
+
+static void FromBFloat16(const uint16_t* input, float* output, size_t count)
+{
+	size_t i = 0U;
+#if defined(MATH_VECTORIZED)
+	for(; i + 8U <= count; i += 8U)
+	{
+		__m128i bits = _mm_loadu_si128((const __m128i*)(input + i));
+		_mm_storeu_si128((__m128i*)(output + i),      _mm_unpacklo_epi16(_mm_setzero_si128(), bits));
+		_mm_storeu_si128((__m128i*)(output + i + 4U), _mm_unpackhi_epi16(_mm_setzero_si128(), bits));
+	}
+#endif
+	for(; i < count; i++)
+		output[i] = Float32(BFloat16::FromRawValue(input[i])).ToRawValue();
+}
+
+static void Run(void Function(const float*, float*, size_t), const ArraySpan<Float32>& input, const ArraySpan<Float32>& output)
+{
+	CheckCounts(input.Count(), output.Count());
+	Function((const float*)input.ToUnsafePointer(), (float*)output.ToUnsafePointer(), input.Count().ToRawValue());
+}
+
+static void Run(void Function(const double*, double*, size_t), const ArraySpan<Float64>& input, const ArraySpan<Float64>& output)
+{
+	CheckCounts(input.Count(), output.Count());
+	Function((const double*)input.ToUnsafePointer(), (double*)output.ToUnsafePointer(), input.Count().ToRawValue());
+}
+
+static void Run(void Function(const float*, const float*, float*, size_t), const ArraySpan<Float32>& x, const ArraySpan<Float32>& y, const ArraySpan<Float32>& output)
+{
+	CheckCounts(x.Count(), y.Count());
+	CheckCounts(x.Count(), output.Count());
+	Function((const float*)x.ToUnsafePointer(), (const float*)y.ToUnsafePointer(), (float*)output.ToUnsafePointer(), x.Count().ToRawValue());
+}
+
+static void Run(void Function(const double*, const double*, double*, size_t), const ArraySpan<Float64>& x, const ArraySpan<Float64>& y, const ArraySpan<Float64>& output)
+{
+	CheckCounts(x.Count(), y.Count());
+	CheckCounts(x.Count(), output.Count());
+	Function((const double*)x.ToUnsafePointer(), (const double*)y.ToUnsafePointer(), (double*)output.ToUnsafePointer(), x.Count().ToRawValue());
+}
+
+void Math::Sin    (const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(SinAccurate, input, output); }
+void Math::Sin    (const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(SinAccurate, input, output); }
+void Math::FastSin(const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(SinFast,     input, output); }
+void Math::FastSin(const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(SinFast,     input, output); }
+
+void Math::Cos    (const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(CosAccurate, input, output); }
+void Math::Cos    (const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(CosAccurate, input, output); }
+void Math::FastCos(const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(CosFast,     input, output); }
+void Math::FastCos(const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(CosFast,     input, output); }
+
+void Math::Exp    (const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(ExpAccurate, input, output); }
+void Math::Exp    (const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(ExpAccurate, input, output); }
+void Math::FastExp(const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(ExpFast,     input, output); }
+void Math::FastExp(const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(ExpFast,     input, output); }
+
+void Math::Log    (const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(LogAccurate, input, output); }
+void Math::Log    (const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(LogAccurate, input, output); }
+void Math::FastLog(const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(LogFast,     input, output); }
+void Math::FastLog(const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(LogFast,     input, output); }
+
+void Math::Pow    (const ArraySpan<Float32>& base, const ArraySpan<Float32>& exponent, ArraySpan<Float32> output) { Run(PowAccurate, base, exponent, output); }
+void Math::Pow    (const ArraySpan<Float64>& base, const ArraySpan<Float64>& exponent, ArraySpan<Float64> output) { Run(PowAccurate, base, exponent, output); }
+void Math::FastPow(const ArraySpan<Float32>& base, const ArraySpan<Float32>& exponent, ArraySpan<Float32> output) { Run(PowFast,     base, exponent, output); }
+void Math::FastPow(const ArraySpan<Float64>& base, const ArraySpan<Float64>& exponent, ArraySpan<Float64> output) { Run(PowFast,     base, exponent, output); }
+
+void Math::Sqrt(const ArraySpan<Float32>& input, ArraySpan<Float32> output) { Run(SqrtAccurate, input, output); }
+void Math::Sqrt(const ArraySpan<Float64>& input, ArraySpan<Float64> output) { Run(SqrtAccurate, input, output); }
+
+void Math::Convert(const ArraySpan<Float32>& input, ArraySpan<Float16> output)
+{
+	CheckCounts(input.Count(), output.Count());
+	ToFloat16((const float*)input.ToUnsafePointer(), (uint16_t*)output.ToUnsafePointer(), input.Count().ToRawValue());
+}
+
+void Math::Convert(const ArraySpan<Float16>& input, ArraySpan<Float32> output)
+{
+	CheckCounts(input.Count(), output.Count());
+	FromFloat16((const uint16_t*)input.ToUnsafePointer(), (float*)output.ToUnsafePointer(), input.Count().ToRawValue());
+}
+
+void Math::Convert(const ArraySpan<Float32>& input, ArraySpan<BFloat16> output)
+{
+	CheckCounts(input.Count(), output.Count());
+	ToBFloat16((const float*)input.ToUnsafePointer(), (uint16_t*)output.ToUnsafePointer(), input.Count().ToRawValue());
+}
+
+void Math::Convert(const ArraySpan<BFloat16>& input, ArraySpan<Float32> output)
+{
+	CheckCounts(input.Count(), output.Count());
+	FromBFloat16((const uint16_t*)input.ToUnsafePointer(), (float*)output.ToUnsafePointer(), input.Count().ToRawValue());
+}
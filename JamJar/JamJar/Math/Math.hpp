@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../Numerics.hpp"
+#include "../Data/Memory/Array.hpp"
+
+// Element-wise functions over whole spans, for code that evaluates the same function on many values. The output must
+// be as long as the input and may be the same span. With SSE2 or AVX2 the values are processed a register at a time
+// with polynomial kernels; elsewhere these call the C library.
+//
+// Every function has an accurate and a fast variant. Maximum errors in units in the last place, measured against a
+// higher precision reference over the ranges given below:
+//
+//                  Float32          Float32 fast           Float64          Float64 fast
+//     Sin, Cos     0.5, any x       1.5, |x| < pi          1.6, any x       single precision
+//     Exp          0.5              1.3                    1.8              single precision
+//     Log          0.5              1                      1                single precision
+//     Pow          0.5              120 (see below)        1 (C library)    single precision
+//     Sqrt         0.5, correctly rounded; there is no fast variant
+//
+// Accurate Float32 results are computed in double precision and rounded, so they are within 0.5 of the exact value
+// plus a negligible amount. The fast Float32 sine and cosine stay within 1e-7 of the exact value for |x| < 8192;
+// larger arguments, infinities and NaN are handed to the C library, as the fast Float64 ones hand theirs to the double
+// precision C library. The fast Float32 power is exp(y * log(x)) in single precision, whose error grows
+// with the magnitude of the result; 120 holds for results between 1e-30 and 1e30. Fast Float64 functions round their
+// arguments to Float32 and compute in single precision, so they are good to about 2^-20, relative for Exp and Pow and
+// absolute for the others; rounding the argument adds up to |x| * 2^-24 more to the sine and cosine.
+class Math
+{
+public:
+	static void Sin    (const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void Sin    (const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+	static void FastSin(const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void FastSin(const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+
+	static void Cos    (const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void Cos    (const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+	static void FastCos(const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void FastCos(const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+
+	static void Exp    (const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void Exp    (const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+	static void FastExp(const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void FastExp(const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+
+	static void Log    (const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void Log    (const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+	static void FastLog(const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void FastLog(const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+
+	static void Pow    (const ArraySpan<Float32>& base, const ArraySpan<Float32>& exponent, ArraySpan<Float32> output);
+	static void Pow    (const ArraySpan<Float64>& base, const ArraySpan<Float64>& exponent, ArraySpan<Float64> output);
+	static void FastPow(const ArraySpan<Float32>& base, const ArraySpan<Float32>& exponent, ArraySpan<Float32> output);
+	static void FastPow(const ArraySpan<Float64>& base, const ArraySpan<Float64>& exponent, ArraySpan<Float64> output);
+
+	static void Sqrt(const ArraySpan<Float32>& input, ArraySpan<Float32> output);
+	static void Sqrt(const ArraySpan<Float64>& input, ArraySpan<Float64> output);
+
+	// Rounds to nearest, ties to even, as the 16-bit constructors do. Float16 uses F16C where the build targets AVX2 and
+	// integer SSE2 otherwise; BFloat16 only moves bits and uses SSE2.
+	static void Convert(const ArraySpan<Float32>&  input, ArraySpan<Float16>  output);
+	static void Convert(const ArraySpan<Float16>&  input, ArraySpan<Float32>  output);
+	static void Convert(const ArraySpan<Float32>&  input, ArraySpan<BFloat16> output);
+	static void Convert(const ArraySpan<BFloat16>& input, ArraySpan<Float32>  output);
+};
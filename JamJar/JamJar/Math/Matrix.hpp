@@ -1,13 +1,14 @@
 #pragma once
 
-#include "../Data/Memory/Array.hpp"
 #include "Vector.hpp"
+#include "../Data/Memory/Array.hpp"
+#include "../StringBuilder.hpp"
 
 template<Number T, size_t R, size_t C>
 class Matrix
 {
 private:
-	StackBlock<Vector<T, C>, R> m_rows;
+	StackArray<Vector<T, C>, R> m_rows;
 public:
 	Matrix() : m_rows() {}
 
@@ -21,17 +22,21 @@ public:
 				m_rows[j][i] = value;
 			}
 		}
+		return *this;
 	}
 
+	      Vector<T, C>& operator[](Size row)       { return m_rows[row]; }
+	const Vector<T, C>& operator[](Size row) const { return m_rows[row]; }
+
 	friend Matrix<T, C, R> operator*(const Matrix<T, R, C>& left, const Matrix<T, C, R>& right)
 	{
 		Matrix<T, C, R> result;
-        for(Size i = 0; i < C; i++)
+        for(Size i = 0U; i < C; i++)
         {
-            for(Size j = 0; j < R; j++)
+            for(Size j = 0U; j < R; j++)
             {
 				result.m_rows[i][j] = T::Zero;
-                for(int k = 0; k < C; k++)
+                for(Size k = 0U; k < C; k++)
                     result.m_rows[i][j] = result.m_rows[i][j] + (left.m_rows[i][k] * right.m_rows[k][j]);
             }
         }
@@ -40,23 +45,23 @@ public:
 
 	String ToString() const
 	{
-		MutableString result;
+		StringBuilder result;
 		
-		for(Size i = 0; i < C; i++)
+		for(Size i = 0U; i < C; i++)
         {
-			result += "[";
+			result.Append("[");
 
-			for(Size j = 0; j < R; j++)
+			for(Size j = 0U; j < R; j++)
 			{
-				result += m_rows[j][i].ToString();
+				result.Append(m_rows[j][i]);
 				if(j < R - 1)
-					result += ", ";
+					result.Append(", ");
 			}
 
-			result += "]";
+			result.Append("]");
         }
 
-		return result;
+		return result.ToString();
 	}
 };
 
@@ -64,5 +69,10 @@ template<Number T>
 class Matrix4x4 : public Matrix<T, 4, 4>
 {
 public:
+	Matrix4x4() {}
+
+	Matrix4x4(const Matrix<T, 4, 4>& other) : Matrix<T, 4, 4>(other) {}
+};
 
-};
\ No newline at end of file
+using Matrix4x4F32 = Matrix4x4<Float32>;
+using Matrix4x4F64 = Matrix4x4<Float64>;
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "Random.hpp"
+
+#if defined(__AVX2__)
+#define RANDOM_AVX2
+#define RANDOM_VECTORIZED
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANDOM_VECTORIZED
+#include <emmintrin.h>
+#endif
+
+void SplitMix64::Generate(uint64_t* output, size_t count) noexcept
+{
+	for(size_t i = 0U; i < count; i++)
+		output[i] = Next().ToRawValue();
+}
+
+void Xoshiro256::Jump(const uint64_t (&polynomial)[4]) noexcept
+{
+	uint64_t state[4] = {};
+
+	for(size_t word = 0U; word < 4U; word++)
+	{
+		for(size_t bit = 0U; bit < 64U; bit++)
+		{
+			if((polynomial[word] >> bit) & 1U)
+			{
+				for(size_t i = 0U; i < 4U; i++)
+					state[i] ^= m_state[i];
+			}
+			Next();
+		}
+	}
+
+	for(size_t i = 0U; i < 4U; i++)
+		m_state[i] = state[i];
+}
+
+void Xoshiro256::Jump() noexcept
+{
+	static const uint64_t polynomial[4] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+	Jump(polynomial);
+}
+
+void Xoshiro256::LongJump() noexcept
+{
+	static const uint64_t polynomial[4] = { 0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL };
+	Jump(polynomial);
+}
+
+void Xoshiro256::Generate(uint64_t* output, size_t count) noexcept
+{
+	if(count <= 64U)
+	{
+		for(size_t i = 0U; i < count; i++)
+			output[i] = Next().ToRawValue();
+		return;
+	}
+
+	Xoshiro256 lanes[4] = { Split(), Split(), Split(), Split() };
+	size_t     blocks   = count / 4U;
+
+#if defined(RANDOM_AVX2)
+	// One lane per engine, so each register holds the same word of all four states.
+	__m256i s0 = _mm256_set_epi64x(lanes[3].m_state[0], lanes[2].m_state[0], lanes[1].m_state[0], lanes[0].m_state[0]);
+	__m256i s1 = _mm256_set_epi64x(lanes[3].m_state[1], lanes[2].m_state[1], lanes[1].m_state[1], lanes[0].m_state[1]);
+	__m256i s2 = _mm256_set_epi64x(lanes[3].m_state[2], lanes[2].m_state[2], lanes[1].m_state[2], lanes[0].m_state[2]);
+	__m256i s3 = _mm256_set_epi64x(lanes[3].m_state[3], lanes[2].m_state[3], lanes[1].m_state[3], lanes[0].m_state[3]);
+
+	for(size_t block = 0U; block < blocks; block++)
+	{
+		// There is no 64-bit multiply, but by 5 and by 9 are a shift and an add.
+		__m256i result = _mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2));
+		result = _mm256_or_si256(_mm256_slli_epi64(result, 7), _mm256_srli_epi64(result, 57));
+		result = _mm256_add_epi64(result, _mm256_slli_epi64(result, 3));
+
+		__m256i shifted = _mm256_slli_epi64(s1, 17);
+
+		s2 = _mm256_xor_si256(s2, s0);
+		s3 = _mm256_xor_si256(s3, s1);
+		s1 = _mm256_xor_si256(s1, s2);
+		s0 = _mm256_xor_si256(s0, s3);
+		s2 = _mm256_xor_si256(s2, shifted);
+		s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+
+		_mm256_storeu_si256((__m256i*)(output + block * 4U), result);
+	}
+
+	alignas(32) uint64_t words[4][4];
+	_mm256_store_si256((__m256i*)words[0], s0);
+	_mm256_store_si256((__m256i*)words[1], s1);
+	_mm256_store_si256((__m256i*)words[2], s2);
+	_mm256_store_si256((__m256i*)words[3], s3);
+
+	for(size_t lane = 0U; lane < 4U; lane++)
+	{
+		for(size_t i = 0U; i < 4U; i++)
+			lanes[lane].m_state[i] = words[i][lane];
+	}
+#else
+	for(size_t block = 0U; block < blocks; block++)
+	{
+		for(size_t lane = 0U; lane < 4U; lane++)
+			output[block * 4U + lane] = lanes[lane].Next().ToRawValue();
+	}
+#endif
+
+	for(size_t i = blocks * 4U; i < count; i++)
+		output[i] = lanes[i - blocks * 4U].Next().ToRawValue();
+}
+
+// Brown's "Random Number Generation with Arbitrary Strides": the step x -> a x + c applied n times is itself such a
+// step, built up from the squares of the single one.
+void Pcg64::Advance(UInt64 steps) noexcept
+{
+	uint64_t remaining      = steps.ToRawValue();
+	UInt128  multiplier     = Multiplier;
+	UInt128  increment      = m_increment;
+	UInt128  totalMultiplier(1U);
+	UInt128  totalIncrement;
+
+	while(remaining != 0U)
+	{
+		if(remaining & 1U)
+		{
+			totalMultiplier = totalMultiplier * multiplier;
+			totalIncrement  = totalIncrement * multiplier + increment;
+		}
+
+		increment  = (multiplier + UInt128(1U)) * increment;
+		multiplier = multiplier * multiplier;
+		remaining >>= 1U;
+	}
+
+	m_state = totalMultiplier * m_state + totalIncrement;
+}
+
+void Pcg64::Generate(uint64_t* output, size_t count) noexcept
+{
+	for(size_t i = 0U; i < count; i++)
+		output[i] = Next().ToRawValue();
+}
+
+void RandomConversion::ToFloat32(uint32_t* values, size_t count) noexcept
+{
+	size_t i = 0U;
+
+	// Below 2^24 the values convert exactly as signed integers, which is all there is before AVX-512.
+#if defined(RANDOM_AVX2)
+	for(; i + 8U <= count; i += 8U)
+	{
+		__m256i bits = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i*)(values + i)), 8);
+		_mm256_storeu_ps((float*)(values + i), _mm256_mul_ps(_mm256_cvtepi32_ps(bits), _mm256_set1_ps(0x1.0p-24f)));
+	}
+#elif defined(RANDOM_VECTORIZED)
+	for(; i + 4U <= count; i += 4U)
+	{
+		__m128i bits = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(values + i)), 8);
+		_mm_storeu_ps((float*)(values + i), _mm_mul_ps(_mm_cvtepi32_ps(bits), _mm_set1_ps(0x1.0p-24f)));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float value = float(values[i] >> 8U) * 0x1.0p-24f;
+		memcpy(values + i, &value, sizeof(float));
+	}
+}
+
+void RandomConversion::ToFloat64(uint64_t* values, size_t count) noexcept
+{
+	size_t i = 0U;
+
+	// There is no 64-bit integer conversion either, so the 53 bits are split in two and each half is placed in the
+	// mantissa of 2^52, which is then taken off again. Both halves and their sum are exact.
+#if defined(RANDOM_AVX2)
+	const __m256i lowMask  = _mm256_set1_epi64x((int64_t(1) << 26U) - 1);
+	const __m256i exponent = _mm256_set1_epi64x(0x4330000000000000LL);
+	const __m256d offset   = _mm256_set1_pd(0x1.0p52);
+
+	for(; i + 4U <= count; i += 4U)
+	{
+		__m256i bits = _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)(values + i)), 11);
+		__m256d high = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 26), exponent)), offset);
+		__m256d low  = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, lowMask), exponent)), offset);
+		_mm256_storeu_pd((double*)(values + i), _mm256_add_pd(_mm256_mul_pd(high, _mm256_set1_pd(0x1.0p-27)), _mm256_mul_pd(low, _mm256_set1_pd(0x1.0p-53))));
+	}
+#elif defined(RANDOM_VECTORIZED)
+	const __m128i lowMask  = _mm_set1_epi64x((int64_t(1) << 26U) - 1);
+	const __m128i exponent = _mm_set1_epi64x(0x4330000000000000LL);
+	const __m128d offset   = _mm_set1_pd(0x1.0p52);
+
+	for(; i + 2U <= count; i += 2U)
+	{
+		__m128i bits = _mm_srli_epi64(_mm_loadu_si128((const __m128i*)(values + i)), 11);
+		__m128d high = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(bits, 26), exponent)), offset);
+		__m128d low  = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, lowMask), exponent)), offset);
+		_mm_storeu_pd((double*)(values + i), _mm_add_pd(_mm_mul_pd(high, _mm_set1_pd(0x1.0p-27)), _mm_mul_pd(low, _mm_set1_pd(0x1.0p-53))));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		double value = double(values[i] >> 11U) * 0x1.0p-53;
+		memcpy(values + i, &value, sizeof(double));
+	}
+}
+
+// The engines are small enough to copy around freely and their first values must match the reference implementations.
+static_assert(sizeof(SplitMix64) == 8U && sizeof(Xoshiro256) == 32U && sizeof(Pcg64) == 32U && std::is_trivially_copyable_v<Xoshiro256>);
+static_assert(SplitMix64(0U).Next() == UInt64(0xE220A8397B1DCDAFULL) && Xoshiro256(0U).Next() == UInt64(0x99EC5F36CB75F2B4ULL));
+static_assert(Pcg64(42U, 54U).Next() == UInt64(0x86B1DA1D72062B68ULL));
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "../Numerics.hpp"
+#include "../Data/Memory/Array.hpp"
+#include "UInt128.hpp"
+
+#include <cstring>
+
+// The engines below keep their whole state inline and never allocate, so they can live on the stack or in a particle
+// system and be copied freely. Each produces 64-bit values with Next and fills raw buffers with Generate; Random wraps
+// one with the floating point, bounded and span outputs.
+//
+// For independent streams on several threads, give each thread its own engine from Split, or, for Xoshiro256, copy
+// one engine and Jump the original between copies, which keeps the streams from overlapping.
+
+// Steele, Lea and Flood's SplitMix64: a counter passed through a mixing function. Fast and good enough on its own, and
+// what the others are seeded with.
+class SplitMix64
+{
+private:
+	uint64_t m_state;
+public:
+	constexpr explicit SplitMix64(UInt64 seed) noexcept : m_state(seed.ToRawValue()) {}
+
+	constexpr UInt64 Next() noexcept
+	{
+		uint64_t value = (m_state += 0x9E3779B97F4A7C15ULL);
+		value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31U);
+	}
+
+	SplitMix64 Split() noexcept { return SplitMix64(Next()); }
+
+	void Generate(uint64_t* output, size_t count) noexcept;
+};
+
+// Blackman and Vigna's xoshiro256**, the default engine: 256 bits of state, a period of 2^256 - 1 and no multiplications.
+class Xoshiro256
+{
+private:
+	uint64_t m_state[4];
+
+	void Jump(const uint64_t (&polynomial)[4]) noexcept;
+public:
+	// The state is filled from SplitMix64, as the authors recommend, so similar seeds give unrelated streams.
+	constexpr explicit Xoshiro256(UInt64 seed) noexcept : m_state()
+	{
+		SplitMix64 seeder(seed);
+		for(size_t i = 0U; i < 4U; i++)
+			m_state[i] = seeder.Next().ToRawValue();
+	}
+
+	constexpr UInt64 Next() noexcept
+	{
+		uint64_t result = std::rotl(m_state[1] * 5U, 7) * 9U;
+		uint64_t shifted = m_state[1] << 17U;
+
+		m_state[2] ^= m_state[0];
+		m_state[3] ^= m_state[1];
+		m_state[1] ^= m_state[2];
+		m_state[0] ^= m_state[3];
+		m_state[2] ^= shifted;
+		m_state[3]  = std::rotl(m_state[3], 45);
+
+		return result;
+	}
+
+	// The same as 2^128 and 2^192 calls to Next.
+	void Jump() noexcept;
+	void LongJump() noexcept;
+
+	Xoshiro256 Split() noexcept { return Xoshiro256(Next()); }
+
+	// Up to 64 values are taken in order. Longer buffers are filled from four engines split from this one, interleaved,
+	// which AVX2 runs side by side; the values are the same with and without it.
+	void Generate(uint64_t* output, size_t count) noexcept;
+};
+
+// O'Neill's PCG64 (XSL RR 128/64): a 128-bit linear congruential generator with a permuted output. Each odd increment
+// is a separate stream, and Advance skips ahead any number of steps in logarithmic time.
+class Pcg64
+{
+private:
+	static constexpr UInt128 Multiplier = UInt128(0x2360ED051FC65DA4ULL, 0x4385DF649FCCF645ULL);
+
+	UInt128 m_state;
+	UInt128 m_increment;
+public:
+	constexpr explicit Pcg64(UInt64 seed, UInt64 stream = 0U) noexcept : m_state(0U), m_increment((UInt128(stream.ToRawValue()) << 1U) | UInt128(1U))
+	{
+		Next();
+		m_state = m_state + UInt128(seed.ToRawValue());
+		Next();
+	}
+
+	constexpr UInt64 Next() noexcept
+	{
+		m_state = m_state * Multiplier + m_increment;
+		return std::rotr(m_state.GetHigh() ^ m_state.GetLow(), int(m_state.GetHigh() >> 58U));
+	}
+
+	// The same as that many calls to Next.
+	void Advance(UInt64 steps) noexcept;
+
+	Pcg64 Split() noexcept
+	{
+		UInt64 seed = Next();
+		return Pcg64(seed, Next());
+	}
+
+	void Generate(uint64_t* output, size_t count) noexcept;
+};
+
+// The conversions Random uses on whole buffers, in place.
+class RandomConversion
+{
+public:
+	// Each 32-bit value becomes its upper 24 bits over 2^24.
+	static void ToFloat32(uint32_t* values, size_t count) noexcept;
+
+	// Each 64-bit value becomes its upper 53 bits over 2^53.
+	static void ToFloat64(uint64_t* values, size_t count) noexcept;
+};
+
+// Uniform values from an engine. Floating point values are in [0, 1) or [minimum, maximum), with every multiple of
+// 2^-24 or 2^-53 in [0, 1) equally likely. Bounded integers use Lemire's multiply and reject method, which is exactly
+// uniform and rarely needs a second value.
+template<typename Engine = Xoshiro256>
+class Random
+{
+private:
+	Engine m_engine;
+
+	static constexpr size_t HalvesBlockLength = 256U;
+
+	// The 64-bit values are generated into a block of their own and copied out, as the output holds 32-bit ones.
+	void GenerateHalves(uint32_t* output, size_t count) noexcept
+	{
+		uint64_t block[HalvesBlockLength];
+		for(size_t i = 0U; i + 1U < count; i += 2U * HalvesBlockLength)
+		{
+			size_t length = (count - i) / 2U < HalvesBlockLength ? (count - i) / 2U : HalvesBlockLength;
+
+			m_engine.Generate(block, length);
+			memcpy(output + i, block, length * sizeof(uint64_t));
+		}
+
+		if(count % 2U != 0U)
+			output[count - 1U] = uint32_t(m_engine.Next().ToRawValue());
+	}
+public:
+	explicit Random(UInt64 seed) noexcept : m_engine(seed) {}
+	explicit Random(const Engine& engine) noexcept : m_engine(engine) {}
+
+	Engine& GetEngine() noexcept { return m_engine; }
+
+	Random<Engine> Split() noexcept { return Random<Engine>(m_engine.Split()); }
+
+	UInt64 NextUInt64() noexcept { return m_engine.Next(); }
+	UInt32 NextUInt32() noexcept { return UInt32(uint32_t(m_engine.Next().ToRawValue() >> 32U)); }
+
+	Boolean NextBoolean() noexcept { return Boolean((m_engine.Next().ToRawValue() >> 63U) != 0U); }
+
+	Float32 NextFloat32() noexcept { return Float32(float(m_engine.Next().ToRawValue() >> 40U) * 0x1.0p-24f); }
+	Float64 NextFloat64() noexcept { return Float64(double(m_engine.Next().ToRawValue() >> 11U) * 0x1.0p-53); }
+
+	// Rounding can carry a value up to maximum itself; those are drawn again. An empty range gives minimum.
+	Float32 NextFloat32(Float32 minimum, Float32 maximum) noexcept
+	{
+		float low   = minimum.ToRawValue();
+		float high  = maximum.ToRawValue();
+		float value = low + (high - low) * NextFloat32().ToRawValue();
+
+		while(value >= high && low < high)
+			value = low + (high - low) * NextFloat32().ToRawValue();
+
+		return Float32(value);
+	}
+
+	Float64 NextFloat64(Float64 minimum, Float64 maximum) noexcept
+	{
+		double low   = minimum.ToRawValue();
+		double high  = maximum.ToRawValue();
+		double value = low + (high - low) * NextFloat64().ToRawValue();
+
+		while(value >= high && low < high)
+			value = low + (high - low) * NextFloat64().ToRawValue();
+
+		return Float64(value);
+	}
+
+	// In [0, bound); a bound of zero gives zero.
+	UInt32 NextUInt32(UInt32 bound) noexcept
+	{
+		uint32_t limit   = bound.ToRawValue();
+		uint64_t product = (m_engine.Next().ToRawValue() >> 32U) * limit;
+
+		if(uint32_t(product) < limit)
+		{
+			uint32_t threshold = (0U - limit) % limit;
+			while(uint32_t(product) < threshold)
+				product = (m_engine.Next().ToRawValue() >> 32U) * limit;
+		}
+
+		return UInt32(uint32_t(product >> 32U));
+	}
+
+	// In [0, bound); a bound of zero gives zero.
+	UInt64 NextUInt64(UInt64 bound) noexcept
+	{
+		uint64_t limit   = bound.ToRawValue();
+		UInt128  product = UInt128::Multiply(m_engine.Next().ToRawValue(), limit);
+
+		if(product.GetLow() < limit)
+		{
+			uint64_t threshold = (0U - limit) % limit;
+			while(product.GetLow() < threshold)
+				product = UInt128::Multiply(m_engine.Next().ToRawValue(), limit);
+		}
+
+		return UInt64(product.GetHigh());
+	}
+
+	// In [minimum, maximum); an empty range gives minimum.
+	SInt32 NextSInt32(SInt32 minimum, SInt32 maximum) noexcept
+	{
+		uint32_t range = minimum < maximum ? uint32_t(maximum.ToRawValue()) - uint32_t(minimum.ToRawValue()) : 0U;
+		return SInt32(int32_t(uint32_t(minimum.ToRawValue()) + NextUInt32(range).ToRawValue()));
+	}
+
+	SInt64 NextSInt64(SInt64 minimum, SInt64 maximum) noexcept
+	{
+		uint64_t range = minimum < maximum ? uint64_t(maximum.ToRawValue()) - uint64_t(minimum.ToRawValue()) : 0U;
+		return SInt64(int64_t(uint64_t(minimum.ToRawValue()) + NextUInt64(range).ToRawValue()));
+	}
+
+	// Fill a whole span at once, through the engine's Generate and vectorized conversions. The values are not the ones
+	// the Next functions would give in turn: each 64-bit value gives two 32-bit ones, low half first.
+	void Fill(ArraySpan<UInt64> output) noexcept { m_engine.Generate((uint64_t*)output.ToUnsafePointer(), output.Count().ToRawValue()); }
+
+	void Fill(ArraySpan<UInt32> output) noexcept { GenerateHalves((uint32_t*)output.ToUnsafePointer(), output.Count().ToRawValue()); }
+
+	void Fill(ArraySpan<Float32> output) noexcept
+	{
+		GenerateHalves((uint32_t*)output.ToUnsafePointer(), output.Count().ToRawValue());
+		RandomConversion::ToFloat32((uint32_t*)output.ToUnsafePointer(), output.Count().ToRawValue());
+	}
+
+	void Fill(ArraySpan<Float64> output) noexcept
+	{
+		m_engine.Generate((uint64_t*)output.ToUnsafePointer(), output.Count().ToRawValue());
+		RandomConversion::ToFloat64((uint64_t*)output.ToUnsafePointer(), output.Count().ToRawValue());
+	}
+};
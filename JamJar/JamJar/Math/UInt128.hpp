@@ -0,0 +1,175 @@
+#pragma once
+
+#include "../Numerics.hpp"
+
+#include <bit>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#define UINT128_INTRINSICS
+#endif
+
+// An unsigned 128-bit integer for the intermediate results of 64-bit arithmetic, such as the full product of two 64-bit
+// values. Multiplication and division use the compiler's 128-bit type or the x64 intrinsics where there are any, and
+// portable 32-bit steps otherwise and in constant expressions.
+class UInt128
+{
+private:
+	uint64_t m_high;
+	uint64_t m_low;
+
+	// (high:low) / divisor, where high < divisor so the quotient fits in 64 bits.
+	static constexpr uint64_t DivideNarrow(uint64_t high, uint64_t low, uint64_t divisor, uint64_t& remainder) noexcept
+	{
+#ifdef UINT128_INTRINSICS
+		if(!std::is_constant_evaluated())
+			return _udiv128(high, low, divisor, &remainder);
+#endif
+		// Long division in two 32-bit digits with a normalized divisor, after Hacker's Delight (divlu).
+		int shift = std::countl_zero(divisor);
+		divisor <<= shift;
+		if(shift > 0)
+		{
+			high = (high << shift) | (low >> (64 - shift));
+			low <<= shift;
+		}
+
+		uint64_t divisorHigh = divisor >> 32U;
+		uint64_t divisorLow  = divisor & 0xFFFFFFFFU;
+
+		uint64_t quotientHigh = high / divisorHigh;
+		uint64_t rest         = high % divisorHigh;
+		while(quotientHigh >> 32U != 0U || quotientHigh * divisorLow > ((rest << 32U) | (low >> 32U)))
+		{
+			quotientHigh--;
+			rest += divisorHigh;
+			if(rest >> 32U != 0U)
+				break;
+		}
+
+		uint64_t middle = ((high << 32U) | (low >> 32U)) - quotientHigh * divisor;
+
+		uint64_t quotientLow = middle / divisorHigh;
+		rest = middle % divisorHigh;
+		while(quotientLow >> 32U != 0U || quotientLow * divisorLow > ((rest << 32U) | (low & 0xFFFFFFFFU)))
+		{
+			quotientLow--;
+			rest += divisorHigh;
+			if(rest >> 32U != 0U)
+				break;
+		}
+
+		remainder = (((middle << 32U) | (low & 0xFFFFFFFFU)) - quotientLow * divisor) >> shift;
+		return (quotientHigh << 32U) | quotientLow;
+	}
+public:
+	constexpr UInt128()                            noexcept : m_high(0U),   m_low(0U)  {}
+	constexpr UInt128(uint64_t low)                noexcept : m_high(0U),   m_low(low) {}
+	constexpr UInt128(uint64_t high, uint64_t low) noexcept : m_high(high), m_low(low) {}
+
+	constexpr uint64_t GetHigh() const noexcept { return m_high; }
+	constexpr uint64_t GetLow()  const noexcept { return m_low;  }
+
+	// Rounded twice when the high half is large, which is fine for estimates.
+	constexpr double ToDouble() const noexcept { return double(m_high) * 18446744073709551616.0 + double(m_low); }
+
+	// The number of bits needed to hold the value.
+	constexpr size_t BitWidth() const noexcept { return m_high != 0U ? 128U - size_t(std::countl_zero(m_high)) : size_t(std::bit_width(m_low)); }
+
+	static constexpr UInt128 Multiply(uint64_t left, uint64_t right) noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 product = (unsigned __int128)left * right;
+		return UInt128(uint64_t(product >> 64U), uint64_t(product));
+#else
+	#ifdef UINT128_INTRINSICS
+		if(!std::is_constant_evaluated())
+		{
+			uint64_t high;
+			uint64_t low = _umul128(left, right, &high);
+			return UInt128(high, low);
+		}
+	#endif
+		uint64_t low     = (left & 0xFFFFFFFFU) * (right & 0xFFFFFFFFU);
+		uint64_t crossA  = (left >> 32U)        * (right & 0xFFFFFFFFU);
+		uint64_t crossB  = (left & 0xFFFFFFFFU) * (right >> 32U);
+		uint64_t high    = (left >> 32U)        * (right >> 32U);
+		uint64_t middle  = (low >> 32U) + (crossA & 0xFFFFFFFFU) + (crossB & 0xFFFFFFFFU);
+
+		return UInt128(high + (crossA >> 32U) + (crossB >> 32U) + (middle >> 32U), (middle << 32U) | (low & 0xFFFFFFFFU));
+#endif
+	}
+
+	// The quotient and remainder of a division by a 64-bit value, which must not be zero.
+	constexpr UInt128 Divide(uint64_t divisor, uint64_t& remainder) const noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 value = ((unsigned __int128)m_high << 64U) | m_low;
+		remainder = uint64_t(value % divisor);
+		unsigned __int128 quotient = value / divisor;
+		return UInt128(uint64_t(quotient >> 64U), uint64_t(quotient));
+#else
+		if(m_high == 0U)
+		{
+			remainder = m_low % divisor;
+			return UInt128(m_low / divisor);
+		}
+
+		if(m_high < divisor)
+			return UInt128(DivideNarrow(m_high, m_low, divisor, remainder));
+
+		return UInt128(m_high / divisor, DivideNarrow(m_high % divisor, m_low, divisor, remainder));
+#endif
+	}
+
+	friend constexpr UInt128 operator+(const UInt128& left, const UInt128& right) noexcept
+	{
+		uint64_t low = left.m_low + right.m_low;
+		return UInt128(left.m_high + right.m_high + (low < left.m_low ? 1U : 0U), low);
+	}
+
+	friend constexpr UInt128 operator-(const UInt128& left, const UInt128& right) noexcept
+	{
+		return UInt128(left.m_high - right.m_high - (left.m_low < right.m_low ? 1U : 0U), left.m_low - right.m_low);
+	}
+
+	// The low 128 bits of the product.
+	friend constexpr UInt128 operator*(const UInt128& left, const UInt128& right) noexcept
+	{
+		UInt128 low = Multiply(left.m_low, right.m_low);
+		return UInt128(low.m_high + left.m_high * right.m_low + left.m_low * right.m_high, low.m_low);
+	}
+
+	friend constexpr UInt128 operator&(const UInt128& left, const UInt128& right) noexcept { return UInt128(left.m_high & right.m_high, left.m_low & right.m_low); }
+	friend constexpr UInt128 operator|(const UInt128& left, const UInt128& right) noexcept { return UInt128(left.m_high | right.m_high, left.m_low | right.m_low); }
+	friend constexpr UInt128 operator^(const UInt128& left, const UInt128& right) noexcept { return UInt128(left.m_high ^ right.m_high, left.m_low ^ right.m_low); }
+
+	// Shifts must be below 128.
+	friend constexpr UInt128 operator<<(const UInt128& value, size_t shift) noexcept
+	{
+		if(shift == 0U)
+			return value;
+		if(shift >= 64U)
+			return UInt128(value.m_low << (shift - 64U), 0U);
+
+		return UInt128((value.m_high << shift) | (value.m_low >> (64U - shift)), value.m_low << shift);
+	}
+
+	friend constexpr UInt128 operator>>(const UInt128& value, size_t shift) noexcept
+	{
+		if(shift == 0U)
+			return value;
+		if(shift >= 64U)
+			return UInt128(value.m_high >> (shift - 64U));
+
+		return UInt128(value.m_high >> shift, (value.m_low >> shift) | (value.m_high << (64U - shift)));
+	}
+
+	friend constexpr Boolean operator==(const UInt128& left, const UInt128& right) noexcept { return left.m_high == right.m_high && left.m_low == right.m_low; }
+	friend constexpr Boolean operator!=(const UInt128& left, const UInt128& right) noexcept { return !(left == right); }
+
+	friend constexpr Boolean operator< (const UInt128& left, const UInt128& right) noexcept { return left.m_high != right.m_high ? left.m_high < right.m_high : left.m_low < right.m_low; }
+	friend constexpr Boolean operator> (const UInt128& left, const UInt128& right) noexcept { return right < left;    }
+	friend constexpr Boolean operator<=(const UInt128& left, const UInt128& right) noexcept { return !(right < left); }
+	friend constexpr Boolean operator>=(const UInt128& left, const UInt128& right) noexcept { return !(left < right); }
+};
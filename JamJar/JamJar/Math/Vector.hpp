@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../String.hpp"
+#include "../StringBuilder.hpp"
+#include "VectorPack.hpp"
 
 class IVector
 {
@@ -10,7 +12,23 @@ template<Number T, size_t D>
 class Vector : public IVector
 {
 private:
-	StackBlock<T, D> m_values;
+	template<Number, size_t>
+	friend class Vector;
+
+	using Pack     = VectorPack<T, D>;
+	using Register = typename Pack::Register;
+
+	StackArray<T, D> m_values;
+
+	Register Load() const                 { return Pack::Load(&m_values[0U]); }
+	void     Store(const Register& value) { Pack::Store(&m_values[0U], value); }
+
+	static Vector<T, D> From(const Register& value)
+	{
+		Vector<T, D> result;
+		result.Store(value);
+		return result;
+	}
 public:
 	Vector(T value = T::Zero)
 	{
@@ -19,149 +37,116 @@ public:
 	}
 
 	template<ConvertibleTo<T>... Args>
-	Vector(Args... args) requires Contains<Args..., D> : m_values { args... } {}
+	Vector(Args... args) requires Contains<Args..., D> : m_values()
+	{
+		Size i = 0U;
+		((m_values[i++] = args), ...);
+	}
 
 	Size Dimensions() const { return D; }
 
 	      T& operator[](Size index)       { return m_values[index]; }
 	const T& operator[](Size index) const { return m_values[index]; }
 
-	T LengthSquared() const
-	{
-		T result = T::Zero;
-		for(Size i = 0; i < D; i++)
-			result += m_values[i] * m_values[i];
-
-		return result;
-	}
+	T LengthSquared() const { return Pack::Dot(Load(), Load()); }
 
-	T Length() const { return LengthSquared().Sqrt(); }
+	T Length() const { return Pack::First(Pack::Length(Load())); }
 
-	T Dot(const Vector<T, D>& other) const
-	{
-		T result = T::Zero;
-		for(Size i = 0; i < D; i++)
-			result += m_values[i] * other[i];
-	}
+	T Dot(const Vector<T, D>& other) const { return Pack::Dot(Load(), other.Load()); }
 
 	Vector<T, D> Normalize() const
 	{
-		Vector<T, D> result;
-		for(Size i = 0; i < D; i++)
-			result[i] = m_values[i] / Length();
-
-		return result;
-	}
-
-	friend Vector<T, D> operator+(const Vector<T, D>& left, const Vector<T, D>& right)
-	{
-		Vector<T, D> result;
-		for(Size i = 0U; i < D; i++)
-			result[i] = left[i] + right[i];
-
-		return result;
+		Register value = Load();
+		return From(Pack::Div(value, Pack::Length(value)));
 	}
 
-	friend Vector<T, D> operator-(const Vector<T, D>& left, const Vector<T, D>& right)
+	// Within about 2^-22 of Normalize for Float32, from the reciprocal square root estimate.
+	Vector<T, D> FastNormalize() const requires FloatingPoint<T>
 	{
-		Vector<T, D> result;
-		for(Size i = 0U; i < D; i++)
-			result[i] = left[i] - right[i];
-
-		return result;
+		Register value = Load();
+		return From(Pack::Mul(value, Pack::FastReciprocalLength(value)));
 	}
 
-	friend Vector<T, D> operator*(const Vector<T, D>& left, const Vector<T, D>& right)
+	// The components at the given indices, in that order, with a single shuffle where both sizes have registers.
+	template<size_t... I>
+	Vector<T, sizeof...(I)> Swizzle() const requires ((I < D) && ...)
 	{
-		Vector<T, D> result;
-		for(Size i = 0U; i < D; i++)
-			result[i] = left[i] * right[i];
+		Vector<T, sizeof...(I)> result;
 
-		return result;
-	}
-
-	friend Vector<T, D> operator/(const Vector<T, D>& left, const Vector<T, D>& right)
-	{
-		Vector<T, D> result;
-		for(Size i = 0; i < D; i++)
-			result[i] = left[i] / right[i];
+		if constexpr(Pack::Enabled && VectorPack<T, sizeof...(I)>::Enabled && sizeof...(I) == 4U)
+			result.Store(Pack::template Shuffle<I...>(Load()));
+		else if constexpr(Pack::Enabled && VectorPack<T, sizeof...(I)>::Enabled)
+			result.Store(Pack::template Shuffle<I..., 3U>(Load()));
+		else
+		{
+			Size lane = 0U;
+			((result.m_values[lane++] = m_values[I]), ...);
+		}
 
 		return result;
 	}
 
-	friend Vector<T, D> operator+(const Vector<T, D>& left, T right) { return left + Vector<T, D>(right); }
-	friend Vector<T, D> operator-(const Vector<T, D>& left, T right) { return left - Vector<T, D>(right); }
-	friend Vector<T, D> operator*(const Vector<T, D>& left, T right) { return left * Vector<T, D>(right); }
-	friend Vector<T, D> operator/(const Vector<T, D>& left, T right) { return left / Vector<T, D>(right); }
-
-	friend Vector<T, D> operator+(T left, const Vector<T, D>& right) { return Vector<T, D>(left) + right; }
-	friend Vector<T, D> operator-(T left, const Vector<T, D>& right) { return Vector<T, D>(left) - right; }
-	friend Vector<T, D> operator*(T left, const Vector<T, D>& right) { return Vector<T, D>(left) * right; }
-	friend Vector<T, D> operator/(T left, const Vector<T, D>& right) { return Vector<T, D>(left) / right; }
-
-	friend Boolean operator==(const Vector<T, D>& left, const Vector<T, D>& right)
+	// Two shuffles of each side where there are registers, rather than four swizzles through memory.
+	Vector<T, D> Cross(const Vector<T, D>& other) const requires (D == 3U)
 	{
-		for(Size i = 0U; i < D; i++)
+		if constexpr(Pack::Enabled)
 		{
-			if(left[i] != right[i])
-				return false;
+			Register left  = Load();
+			Register right = other.Load();
+
+			Register products   = Pack::Mul(Pack::template Shuffle<1U, 2U, 0U, 3U>(left), Pack::template Shuffle<2U, 0U, 1U, 3U>(right));
+			Register correction = Pack::Mul(Pack::template Shuffle<2U, 0U, 1U, 3U>(left), Pack::template Shuffle<1U, 2U, 0U, 3U>(right));
+			return From(Pack::Sub(products, correction));
 		}
-		return true;
+		else
+			return Vector<T, D>(m_values[1U] * other.m_values[2U] - m_values[2U] * other.m_values[1U], m_values[2U] * other.m_values[0U] - m_values[0U] * other.m_values[2U], m_values[0U] * other.m_values[1U] - m_values[1U] * other.m_values[0U]);
 	}
 
-	friend Boolean operator!=(const Vector<T, D>& left, const Vector<T, D>& right) { return !(left == right); }
-
-
-	Vector<T, D>& operator+=(const Vector<T, D>& other)
-	{
-		for(Size i = 0U; i < D; i++)
-			m_values[i] += other[i];
+	friend Vector<T, D> operator+(const Vector<T, D>& left, const Vector<T, D>& right) { return From(Pack::Add(left.Load(), right.Load())); }
+	friend Vector<T, D> operator-(const Vector<T, D>& left, const Vector<T, D>& right) { return From(Pack::Sub(left.Load(), right.Load())); }
+	friend Vector<T, D> operator*(const Vector<T, D>& left, const Vector<T, D>& right) { return From(Pack::Mul(left.Load(), right.Load())); }
+	friend Vector<T, D> operator/(const Vector<T, D>& left, const Vector<T, D>& right) { return From(Pack::Div(left.Load(), right.Load())); }
 
-		return *this;
-	}
+	friend Vector<T, D> operator+(const Vector<T, D>& left, T right) { return From(Pack::Add(left.Load(), Pack::Splat(right))); }
+	friend Vector<T, D> operator-(const Vector<T, D>& left, T right) { return From(Pack::Sub(left.Load(), Pack::Splat(right))); }
+	friend Vector<T, D> operator*(const Vector<T, D>& left, T right) { return From(Pack::Mul(left.Load(), Pack::Splat(right))); }
+	friend Vector<T, D> operator/(const Vector<T, D>& left, T right) { return From(Pack::Div(left.Load(), Pack::Splat(right))); }
 
-	Vector<T, D>& operator-=(const Vector<T, D>& other)
-	{
-		for(Size i = 0; i < D; i++)
-			m_values[i] -= other[i];
+	friend Vector<T, D> operator+(T left, const Vector<T, D>& right) { return From(Pack::Add(Pack::Splat(left), right.Load())); }
+	friend Vector<T, D> operator-(T left, const Vector<T, D>& right) { return From(Pack::Sub(Pack::Splat(left), right.Load())); }
+	friend Vector<T, D> operator*(T left, const Vector<T, D>& right) { return From(Pack::Mul(Pack::Splat(left), right.Load())); }
+	friend Vector<T, D> operator/(T left, const Vector<T, D>& right) { return From(Pack::Div(Pack::Splat(left), right.Load())); }
 
-		return *this;
-	}
-
-	Vector<T, D>& operator*=(const Vector<T, D>& other)
-	{
-		for(Size i = 0; i < D; i++)
-			m_values[i] *= other[i];
-
-		return *this;
-	}
-
-	Vector<T, D>& operator/=(const Vector<T, D>& other)
-	{
-		for(Size i = 0; i < D; i++)
-			m_values[i] /= other[i];
+	friend Boolean operator==(const Vector<T, D>& left, const Vector<T, D>& right) { return Pack::Equal(left.Load(), right.Load()); }
+	friend Boolean operator!=(const Vector<T, D>& left, const Vector<T, D>& right) { return !(left == right); }
 
-		return *this;
-	}
+	Vector<T, D>& operator+=(const Vector<T, D>& other) { Store(Pack::Add(Load(), other.Load())); return *this; }
+	Vector<T, D>& operator-=(const Vector<T, D>& other) { Store(Pack::Sub(Load(), other.Load())); return *this; }
+	Vector<T, D>& operator*=(const Vector<T, D>& other) { Store(Pack::Mul(Load(), other.Load())); return *this; }
+	Vector<T, D>& operator/=(const Vector<T, D>& other) { Store(Pack::Div(Load(), other.Load())); return *this; }
 
-	Vector<T, D>& operator+=(T other) { return (*this) += Vector<T, D>(other); }
-	Vector<T, D>& operator-=(T other) { return (*this) -= Vector<T, D>(other); }
-	Vector<T, D>& operator*=(T other) { return (*this) *= Vector<T, D>(other); }
-	Vector<T, D>& operator/=(T other) { return (*this) /= Vector<T, D>(other); }
+	Vector<T, D>& operator+=(T other) { Store(Pack::Add(Load(), Pack::Splat(other))); return *this; }
+	Vector<T, D>& operator-=(T other) { Store(Pack::Sub(Load(), Pack::Splat(other))); return *this; }
+	Vector<T, D>& operator*=(T other) { Store(Pack::Mul(Load(), Pack::Splat(other))); return *this; }
+	Vector<T, D>& operator/=(T other) { Store(Pack::Div(Load(), Pack::Splat(other))); return *this; }
 
 	Vector<T, D> operator+() const requires SignedNumber<T> { return  *this;          }
 	Vector<T, D> operator-() const requires SignedNumber<T> { return (*this) * T(-1); }
 	
 	String ToString() const requires Printable<T>
 	{
-		MutableString result;
-		result += MutableString("Vector") += MutableString(Size(D).ToString()) += MutableString("(");
+		StringBuilder result;
+		result.Append("Vector").Append(Size(D)).Append("(");
 
-		for(T value : m_values)
-			result += MutableString(value.ToString()) += MutableString(", ");
+		for(Size i = 0U; i < D; i++)
+		{
+			if(i > 0U)
+				result.Append(", ");
+
+			result.Append(m_values[i]);
+		}
 
-		result.TrimEnd(2U);
-		result += ")";
+		result.Append(")");
 
 		return result.ToString();
 	}
@@ -182,11 +167,11 @@ public:
 	void SetX(T x) { (*this)[0U] = x; }
 	void SetY(T y) { (*this)[1U] = y; }
 
-	T Cross(const Vector2& other) const { return GetX() * other.GetY() + GetY() * other.GetX(); }
+	T Cross(const Vector2& other) const { return GetX() * other.GetY() - GetY() * other.GetX(); }
 
 	Vector2 Rotate(T angle) const requires FloatingPoint<T> 
 	{
-		return Vector2(angle.Cos() * GetX() + angle.Sin() * GetY(), angle.Sin() * GetX() + angle.Cos() * GetY());
+		return Vector2(angle.Cos() * GetX() - angle.Sin() * GetY(), angle.Sin() * GetX() + angle.Cos() * GetY());
 	}
 };
 
@@ -210,30 +195,28 @@ public:
 	void SetY(T y) { (*this)[1U] = y; }
 	void SetZ(T z) { (*this)[2U] = z; }
 
-	Vector2<T> GetXY() const { return Vector2<T>(GetX(), GetY()); }
-	Vector2<T> GetXZ() const { return Vector2<T>(GetX(), GetZ()); }
+	Vector2<T> GetXY() const { return this->template Swizzle<0U, 1U>(); }
+	Vector2<T> GetXZ() const { return this->template Swizzle<0U, 2U>(); }
 
-	Vector2<T> GetYX() const { return Vector2<T>(GetY(), GetX()); }
-	Vector2<T> GetYZ() const { return Vector2<T>(GetY(), GetZ()); }
+	Vector2<T> GetYX() const { return this->template Swizzle<1U, 0U>(); }
+	Vector2<T> GetYZ() const { return this->template Swizzle<1U, 2U>(); }
 
-	Vector2<T> GetZX() const { return Vector2<T>(GetZ(), GetX()); }
-	Vector2<T> GetZY() const { return Vector2<T>(GetZ(), GetY()); }
+	Vector2<T> GetZX() const { return this->template Swizzle<2U, 0U>(); }
+	Vector2<T> GetZY() const { return this->template Swizzle<2U, 1U>(); }
 
-	Vector3<T> Cross(const Vector3<T>& other) const
-	{
-		float x = GetY() * other.GetZ() - GetZ() * other.GetY();
-		float y = GetZ() * other.GetX() - GetX() * other.GetZ();
-		float z = GetX() * other.GetY() - GetY() * other.GetX();
-		return Vector3<T>(x, y, z);
-	}
+	Vector3<T> GetYZX() const { return this->template Swizzle<1U, 2U, 0U>(); }
+	Vector3<T> GetZXY() const { return this->template Swizzle<2U, 0U, 1U>(); }
 
+	Vector3<T> Cross(const Vector3<T>& other) const { return Vector<T, 3>::Cross(other); }
+
+	// Rodrigues' formula, about an axis of length one.
 	Vector3<T> Rotate(const Vector3<T>& axis, T angle) const requires FloatingPoint<T>
 	{
 		T rad      = angle.ToRadians();
-        T sinAngle = -rad.Sin();
-        T cosAngle = -rad.Cos();
+		T sinAngle = rad.Sin();
+		T cosAngle = rad.Cos();
 
-        return Cross(axis * sinAngle) + ((*this) * cosAngle + (axis * Dot(axis * (1 - cosAngle))));
+		return (*this) * cosAngle + axis.Cross(*this) * sinAngle + axis * (axis.Dot(*this) * (T::One - cosAngle));
 	}
 
 	//Vector3<T> Rotate(const Quaternion<T>& rotation);
@@ -268,61 +251,61 @@ public:
 	void SetW(T w) { (*this)[3U] = w; }
 
 
-	Vector2<T> GetXY() const { return Vector2<T>(GetX(), GetY()); }
-	Vector2<T> GetXZ() const { return Vector2<T>(GetX(), GetZ()); }
-	Vector2<T> GetXW() const { return Vector2<T>(GetX(), GetW()); }
+	Vector2<T> GetXY() const { return this->template Swizzle<0U, 1U>(); }
+	Vector2<T> GetXZ() const { return this->template Swizzle<0U, 2U>(); }
+	Vector2<T> GetXW() const { return this->template Swizzle<0U, 3U>(); }
 
-	Vector2<T> GetYX() const { return Vector2<T>(GetY(), GetX()); }
-	Vector2<T> GetYZ() const { return Vector2<T>(GetY(), GetZ()); }
-	Vector2<T> GetYW() const { return Vector2<T>(GetY(), GetW()); }
+	Vector2<T> GetYX() const { return this->template Swizzle<1U, 0U>(); }
+	Vector2<T> GetYZ() const { return this->template Swizzle<1U, 2U>(); }
+	Vector2<T> GetYW() const { return this->template Swizzle<1U, 3U>(); }
 
-	Vector2<T> GetZX() const { return Vector2<T>(GetZ(), GetX()); }
-	Vector2<T> GetZY() const { return Vector2<T>(GetZ(), GetY()); }
-	Vector2<T> GetZW() const { return Vector2<T>(GetZ(), GetW()); }
+	Vector2<T> GetZX() const { return this->template Swizzle<2U, 0U>(); }
+	Vector2<T> GetZY() const { return this->template Swizzle<2U, 1U>(); }
+	Vector2<T> GetZW() const { return this->template Swizzle<2U, 3U>(); }
 	
-	Vector2<T> GetWX() const { return Vector2<T>(GetW(), GetX()); }
-	Vector2<T> GetWY() const { return Vector2<T>(GetW(), GetY()); }
-	Vector2<T> GetWZ() const { return Vector2<T>(GetW(), GetZ()); }
+	Vector2<T> GetWX() const { return this->template Swizzle<3U, 0U>(); }
+	Vector2<T> GetWY() const { return this->template Swizzle<3U, 1U>(); }
+	Vector2<T> GetWZ() const { return this->template Swizzle<3U, 2U>(); }
 
 
-	Vector3<T> GetXYZ() const { return Vector3<T>(GetX(), GetY(), GetZ()); }
-	Vector3<T> GetXYW() const { return Vector3<T>(GetX(), GetY(), GetW()); }
+	Vector3<T> GetXYZ() const { return this->template Swizzle<0U, 1U, 2U>(); }
+	Vector3<T> GetXYW() const { return this->template Swizzle<0U, 1U, 3U>(); }
 
-	Vector3<T> GetXZY() const { return Vector3<T>(GetX(), GetZ(), GetY()); }
-	Vector3<T> GetXZW() const { return Vector3<T>(GetX(), GetZ(), GetW()); }
+	Vector3<T> GetXZY() const { return this->template Swizzle<0U, 2U, 1U>(); }
+	Vector3<T> GetXZW() const { return this->template Swizzle<0U, 2U, 3U>(); }
 
-	Vector3<T> GetXWY() const { return Vector3<T>(GetX(), GetW(), GetY()); }
-	Vector3<T> GetXWZ() const { return Vector3<T>(GetX(), GetW(), GetZ()); }
+	Vector3<T> GetXWY() const { return this->template Swizzle<0U, 3U, 1U>(); }
+	Vector3<T> GetXWZ() const { return this->template Swizzle<0U, 3U, 2U>(); }
 
 
-	Vector3<T> GetYXZ() const { return Vector3<T>(GetY(), GetX(), GetZ()); }
-	Vector3<T> GetYXW() const { return Vector3<T>(GetY(), GetX(), GetW()); }
+	Vector3<T> GetYXZ() const { return this->template Swizzle<1U, 0U, 2U>(); }
+	Vector3<T> GetYXW() const { return this->template Swizzle<1U, 0U, 3U>(); }
 
-	Vector3<T> GetYZX() const { return Vector3<T>(GetY(), GetZ(), GetX()); }
-	Vector3<T> GetYZW() const { return Vector3<T>(GetY(), GetZ(), GetW()); }
+	Vector3<T> GetYZX() const { return this->template Swizzle<1U, 2U, 0U>(); }
+	Vector3<T> GetYZW() const { return this->template Swizzle<1U, 2U, 3U>(); }
 
-	Vector3<T> GetYWX() const { return Vector3<T>(GetY(), GetW(), GetX()); }
-	Vector3<T> GetYWZ() const { return Vector3<T>(GetY(), GetW(), GetZ()); }
+	Vector3<T> GetYWX() const { return this->template Swizzle<1U, 3U, 0U>(); }
+	Vector3<T> GetYWZ() const { return this->template Swizzle<1U, 3U, 2U>(); }
 
 
-	Vector3<T> GetZXY() const { return Vector3<T>(GetZ(), GetX(), GetY()); }
-	Vector3<T> GetZXW() const { return Vector3<T>(GetZ(), GetX(), GetW()); }
+	Vector3<T> GetZXY() const { return this->template Swizzle<2U, 0U, 1U>(); }
+	Vector3<T> GetZXW() const { return this->template Swizzle<2U, 0U, 3U>(); }
 
-	Vector3<T> GetZYX() const { return Vector3<T>(GetZ(), GetY(), GetX()); }
-	Vector3<T> GetZYW() const { return Vector3<T>(GetZ(), GetY(), GetW()); }
+	Vector3<T> GetZYX() const { return this->template Swizzle<2U, 1U, 0U>(); }
+	Vector3<T> GetZYW() const { return this->template Swizzle<2U, 1U, 3U>(); }
 
-	Vector3<T> GetZWX() const { return Vector3<T>(GetZ(), GetW(), GetX()); }
-	Vector3<T> GetZWY() const { return Vector3<T>(GetZ(), GetW(), GetY()); }
+	Vector3<T> GetZWX() const { return this->template Swizzle<2U, 3U, 0U>(); }
+	Vector3<T> GetZWY() const { return this->template Swizzle<2U, 3U, 1U>(); }
 
 
-	Vector3<T> GetWXY() const { return Vector3<T>(GetW(), GetX(), GetY()); }
-	Vector3<T> GetWXZ() const { return Vector3<T>(GetW(), GetX(), GetZ()); }
+	Vector3<T> GetWXY() const { return this->template Swizzle<3U, 0U, 1U>(); }
+	Vector3<T> GetWXZ() const { return this->template Swizzle<3U, 0U, 2U>(); }
 
-	Vector3<T> GetWYX() const { return Vector3<T>(GetW(), GetY(), GetX()); }
-	Vector3<T> GetWYZ() const { return Vector3<T>(GetW(), GetY(), GetZ()); }
+	Vector3<T> GetWYX() const { return this->template Swizzle<3U, 1U, 0U>(); }
+	Vector3<T> GetWYZ() const { return this->template Swizzle<3U, 1U, 2U>(); }
 
-	Vector3<T> GetWZX() const { return Vector3<T>(GetW(), GetZ(), GetX()); }
-	Vector3<T> GetWZY() const { return Vector3<T>(GetW(), GetZ(), GetY()); }
+	Vector3<T> GetWZX() const { return this->template Swizzle<3U, 2U, 0U>(); }
+	Vector3<T> GetWZY() const { return this->template Swizzle<3U, 2U, 1U>(); }
 };
 
 using Vector2UI = Vector2<UInt32>;
@@ -340,3 +323,7 @@ using Vector4F32 = Vector4<Float32>;
 using Vector2F64 = Vector2<Float64>;
 using Vector3F64 = Vector3<Float64>;
 using Vector4F64 = Vector4<Float64>;
+
+// Vectors are laid out like arrays of their components, registers or not, so they can be handed to graphics APIs as is.
+static_assert(sizeof(Vector3F32) == 3U * sizeof(Float32) && sizeof(Vector4F32) == 4U * sizeof(Float32));
+static_assert(sizeof(Vector3F64) == 3U * sizeof(Float64) && sizeof(Vector4F64) == 4U * sizeof(Float64));
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "../Numerics.hpp"
+#include "../Data/Memory/Array.hpp"
+
+#if defined(__AVX2__)
+#define VECTOR_AVX2
+#define VECTOR_VECTORIZED
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTOR_VECTORIZED
+#include <emmintrin.h>
+#endif
+
+// What Vector<T, D> does its arithmetic with: whole registers for three and four Float32 or Float64 components, and a
+// loop over the components for everything else. A vector keeps exactly D components in memory. Three are loaded and
+// stored in two parts, never touching what follows them, and the fourth lane of the register is padding, whatever the
+// arithmetic leaves there; Dot and Equal leave it out.
+template<typename T, size_t D>
+class VectorPack
+{
+private:
+	template<typename Operation>
+	static StackArray<T, D> Combine(const StackArray<T, D>& left, const StackArray<T, D>& right, Operation operation)
+	{
+		StackArray<T, D> result;
+		for(Size i = 0U; i < D; i++)
+			result[i] = operation(left[i], right[i]);
+
+		return result;
+	}
+public:
+	using Register = StackArray<T, D>;
+
+	static constexpr bool Enabled = false;
+
+	static Register Load(const T* values)
+	{
+		Register result;
+		for(size_t i = 0U; i < D; i++)
+			result[i] = values[i];
+
+		return result;
+	}
+
+	static void Store(T* values, const Register& value)
+	{
+		for(size_t i = 0U; i < D; i++)
+			values[i] = value[i];
+	}
+
+	static Register Splat(T value)
+	{
+		Register result;
+		for(Size i = 0U; i < D; i++)
+			result[i] = value;
+
+		return result;
+	}
+
+	static Register Add(const Register& left, const Register& right) { return Combine(left, right, [](T a, T b) { return a + b; }); }
+	static Register Sub(const Register& left, const Register& right) { return Combine(left, right, [](T a, T b) { return a - b; }); }
+	static Register Mul(const Register& left, const Register& right) { return Combine(left, right, [](T a, T b) { return a * b; }); }
+	static Register Div(const Register& left, const Register& right) { return Combine(left, right, [](T a, T b) { return a / b; }); }
+
+	static T First(const Register& value) { return value[0U]; }
+
+	static T Dot(const Register& left, const Register& right)
+	{
+		T result = T::Zero;
+		for(Size i = 0U; i < D; i++)
+			result += left[i] * right[i];
+
+		return result;
+	}
+
+	static Register Length(const Register& value) { return Splat(Dot(value, value).Sqrt()); }
+
+	static Register FastReciprocalLength(const Register& value) { return Splat(T::One / Dot(value, value).Sqrt()); }
+
+	static bool Equal(const Register& left, const Register& right)
+	{
+		for(Size i = 0U; i < D; i++)
+		{
+			if(left[i] != right[i])
+				return false;
+		}
+		return true;
+	}
+};
+
+#if defined(VECTOR_VECTORIZED)
+
+template<size_t D> requires (D == 3U || D == 4U)
+class VectorPack<Float32, D>
+{
+private:
+	static constexpr int Mask = (1 << D) - 1;
+public:
+	using Register = __m128;
+
+	static constexpr bool Enabled = true;
+
+	static Register Load(const Float32* values)
+	{
+		if constexpr(D == 3U)
+			return _mm_movelh_ps(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)values)), _mm_load_ss((const float*)values + 2));
+		else
+			return _mm_loadu_ps((const float*)values);
+	}
+
+	static void Store(Float32* values, Register value)
+	{
+		if constexpr(D == 3U)
+		{
+			_mm_storel_epi64((__m128i*)values, _mm_castps_si128(value));
+			_mm_store_ss((float*)values + 2, _mm_movehl_ps(value, value));
+		}
+		else
+			_mm_storeu_ps((float*)values, value);
+	}
+
+	static Register Splat(Float32 value) { return _mm_set1_ps(value.ToRawValue()); }
+
+	static Register Add(Register left, Register right) { return _mm_add_ps(left, right); }
+	static Register Sub(Register left, Register right) { return _mm_sub_ps(left, right); }
+	static Register Mul(Register left, Register right) { return _mm_mul_ps(left, right); }
+	static Register Div(Register left, Register right) { return _mm_div_ps(left, right); }
+
+	static Float32 First(Register value) { return _mm_cvtss_f32(value); }
+
+	// The sum of the first D lanes, in every lane.
+	static Register Sum(Register value)
+	{
+		if constexpr(D == 3U)
+			value = _mm_and_ps(value, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+
+		value = _mm_add_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+		return  _mm_add_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+
+	static Float32 Dot(Register left, Register right) { return First(Sum(_mm_mul_ps(left, right))); }
+
+	static Register Length(Register value) { return _mm_sqrt_ps(Sum(_mm_mul_ps(value, value))); }
+
+	// The 12-bit estimate and one Newton step, y (3 - x y^2) / 2, which brings it to about 22 bits.
+	static Register FastReciprocalLength(Register value)
+	{
+		Register squared  = Sum(_mm_mul_ps(value, value));
+		Register estimate = _mm_rsqrt_ps(squared);
+		Register error    = _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(squared, estimate), estimate));
+
+		return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), estimate), error);
+	}
+
+	static bool Equal(Register left, Register right) { return (_mm_movemask_ps(_mm_cmpeq_ps(left, right)) & Mask) == Mask; }
+
+	template<size_t X, size_t Y, size_t Z, size_t W>
+	static Register Shuffle(Register value) { return _mm_shuffle_ps(value, value, _MM_SHUFFLE(W, Z, Y, X)); }
+};
+
+#if !defined(VECTOR_AVX2)
+// Four doubles without AVX, as two halves of two lanes each. 32-bit MSVC cannot pass a structure of aligned registers by
+// value, so the pair is always passed by reference.
+struct VectorDoublePair
+{
+	__m128d low;
+	__m128d high;
+};
+#endif
+
+// There is no double precision estimate of the reciprocal square root before AVX-512, so the fast one is exact here.
+template<size_t D> requires (D == 3U || D == 4U)
+class VectorPack<Float64, D>
+{
+private:
+	static constexpr int Mask = (1 << D) - 1;
+public:
+#if defined(VECTOR_AVX2)
+	using Register = __m256d;
+
+	static constexpr bool Enabled = true;
+
+	static Register Load(const Float64* values)
+	{
+		if constexpr(D == 3U)
+			return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd((const double*)values)), _mm_load_sd((const double*)values + 2), 1);
+		else
+			return _mm256_loadu_pd((const double*)values);
+	}
+
+	static void Store(Float64* values, Register value)
+	{
+		if constexpr(D == 3U)
+		{
+			_mm_storeu_pd((double*)values,    _mm256_castpd256_pd128(value));
+			_mm_store_sd ((double*)values + 2, _mm256_extractf128_pd(value, 1));
+		}
+		else
+			_mm256_storeu_pd((double*)values, value);
+	}
+
+	static Register Splat(Float64 value) { return _mm256_set1_pd(value.ToRawValue()); }
+
+	static Register Add(Register left, Register right) { return _mm256_add_pd(left, right); }
+	static Register Sub(Register left, Register right) { return _mm256_sub_pd(left, right); }
+	static Register Mul(Register left, Register right) { return _mm256_mul_pd(left, right); }
+	static Register Div(Register left, Register right) { return _mm256_div_pd(left, right); }
+
+	static Float64 First(Register value) { return _mm256_cvtsd_f64(value); }
+
+	static Register Sum(Register value)
+	{
+		if constexpr(D == 3U)
+			value = _mm256_and_pd(value, _mm256_castsi256_pd(_mm256_set_epi64x(0, -1, -1, -1)));
+
+		value = _mm256_add_pd(value, _mm256_permute_pd(value, 0x5));
+		return  _mm256_add_pd(value, _mm256_permute2f128_pd(value, value, 0x1));
+	}
+
+	static Register Sqrt(Register value) { return _mm256_sqrt_pd(value); }
+
+	static bool Equal(Register left, Register right) { return (_mm256_movemask_pd(_mm256_cmp_pd(left, right, _CMP_EQ_OQ)) & Mask) == Mask; }
+
+	template<size_t X, size_t Y, size_t Z, size_t W>
+	static Register Shuffle(Register value) { return _mm256_permute4x64_pd(value, int(X | Y << 2U | Z << 4U | W << 6U)); }
+#else
+	using Register = VectorDoublePair;
+
+	static constexpr bool Enabled = true;
+
+	static Register Load(const Float64* values)
+	{
+		if constexpr(D == 3U)
+			return { _mm_loadu_pd((const double*)values), _mm_load_sd((const double*)values + 2) };
+		else
+			return { _mm_loadu_pd((const double*)values), _mm_loadu_pd((const double*)values + 2) };
+	}
+
+	static void Store(Float64* values, const Register& value)
+	{
+		_mm_storeu_pd((double*)values, value.low);
+
+		if constexpr(D == 3U)
+			_mm_store_sd((double*)values + 2, value.high);
+		else
+			_mm_storeu_pd((double*)values + 2, value.high);
+	}
+
+	static Register Splat(Float64 value) { return { _mm_set1_pd(value.ToRawValue()), _mm_set1_pd(value.ToRawValue()) }; }
+
+	static Register Add(const Register& left, const Register& right) { return { _mm_add_pd(left.low, right.low), _mm_add_pd(left.high, right.high) }; }
+	static Register Sub(const Register& left, const Register& right) { return { _mm_sub_pd(left.low, right.low), _mm_sub_pd(left.high, right.high) }; }
+	static Register Mul(const Register& left, const Register& right) { return { _mm_mul_pd(left.low, right.low), _mm_mul_pd(left.high, right.high) }; }
+	static Register Div(const Register& left, const Register& right) { return { _mm_div_pd(left.low, right.low), _mm_div_pd(left.high, right.high) }; }
+
+	static Float64 First(const Register& value) { return _mm_cvtsd_f64(value.low); }
+
+	static Register Sum(const Register& value)
+	{
+		__m128d upper = value.high;
+		if constexpr(D == 3U)
+			upper = _mm_move_sd(_mm_setzero_pd(), upper);
+
+		// (x + y) + (z + w), in the same order as the other registers.
+		__m128d low  = _mm_add_pd(value.low, _mm_shuffle_pd(value.low, value.low, 0x1));
+		__m128d high = _mm_add_pd(upper,     _mm_shuffle_pd(upper,     upper,     0x1));
+		__m128d pair = _mm_add_pd(low, high);
+		return { pair, pair };
+	}
+
+	static Register Sqrt(const Register& value) { return { _mm_sqrt_pd(value.low), _mm_sqrt_pd(value.high) }; }
+
+	static bool Equal(const Register& left, const Register& right)
+	{
+		int mask = _mm_movemask_pd(_mm_cmpeq_pd(left.low, right.low)) | _mm_movemask_pd(_mm_cmpeq_pd(left.high, right.high)) << 2;
+		return (mask & Mask) == Mask;
+	}
+
+	template<size_t X, size_t Y>
+	static __m128d Pair(const Register& value) { return _mm_shuffle_pd(X < 2U ? value.low : value.high, Y < 2U ? value.low : value.high, int((X & 1U) | (Y & 1U) << 1U)); }
+
+	template<size_t X, size_t Y, size_t Z, size_t W>
+	static Register Shuffle(const Register& value) { return { Pair<X, Y>(value), Pair<Z, W>(value) }; }
+#endif
+
+	static Float64 Dot(const Register& left, const Register& right) { return First(Sum(Mul(left, right))); }
+
+	static Register Length(const Register& value) { return Sqrt(Sum(Mul(value, value))); }
+
+	static Register FastReciprocalLength(const Register& value) { return Div(Splat(1.0), Length(value)); }
+};
+
+#endif
@@ -0,0 +1,492 @@
+#include "VectorStream.hpp"
+#include "../Exception.hpp"
+
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define VECTORSTREAM_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTORSTREAM_SSE2
+#include <emmintrin.h>
+#endif
+
+// The same thin layer over the intrinsics as in Math.cpp, down to plain scalars where there are no vector registers,
+// so each kernel is written once. Float and double packs are told apart by overloading.
+#if defined(VECTORSTREAM_AVX2)
+using FloatPack  = __m256;
+using DoublePack = __m256d;
+
+static inline FloatPack  Splat(float  value) { return _mm256_set1_ps(value); }
+static inline DoublePack Splat(double value) { return _mm256_set1_pd(value); }
+
+static inline FloatPack  Load(const float*  source) { return _mm256_load_ps(source); }
+static inline DoublePack Load(const double* source) { return _mm256_load_pd(source); }
+
+static inline void Store(float*  destination, FloatPack  value) { _mm256_store_ps(destination, value); }
+static inline void Store(double* destination, DoublePack value) { _mm256_store_pd(destination, value); }
+
+static inline FloatPack  Add(FloatPack  left, FloatPack  right) { return _mm256_add_ps(left, right); }
+static inline DoublePack Add(DoublePack left, DoublePack right) { return _mm256_add_pd(left, right); }
+static inline FloatPack  Sub(FloatPack  left, FloatPack  right) { return _mm256_sub_ps(left, right); }
+static inline DoublePack Sub(DoublePack left, DoublePack right) { return _mm256_sub_pd(left, right); }
+static inline FloatPack  Mul(FloatPack  left, FloatPack  right) { return _mm256_mul_ps(left, right); }
+static inline DoublePack Mul(DoublePack left, DoublePack right) { return _mm256_mul_pd(left, right); }
+static inline FloatPack  Div(FloatPack  left, FloatPack  right) { return _mm256_div_ps(left, right); }
+static inline DoublePack Div(DoublePack left, DoublePack right) { return _mm256_div_pd(left, right); }
+
+// a * b + c, rounded once.
+static inline FloatPack  MulAdd(FloatPack  a, FloatPack  b, FloatPack  c) { return _mm256_fmadd_ps(a, b, c); }
+static inline DoublePack MulAdd(DoublePack a, DoublePack b, DoublePack c) { return _mm256_fmadd_pd(a, b, c); }
+
+static inline FloatPack  Sqrt(FloatPack  value) { return _mm256_sqrt_ps(value); }
+static inline DoublePack Sqrt(DoublePack value) { return _mm256_sqrt_pd(value); }
+
+static inline FloatPack ReciprocalSqrtEstimate(FloatPack value) { return _mm256_rsqrt_ps(value); }
+#elif defined(VECTORSTREAM_SSE2)
+using FloatPack  = __m128;
+using DoublePack = __m128d;
+
+static inline FloatPack  Splat(float  value) { return _mm_set1_ps(value); }
+static inline DoublePack Splat(double value) { return _mm_set1_pd(value); }
+
+static inline FloatPack  Load(const float*  source) { return _mm_load_ps(source); }
+static inline DoublePack Load(const double* source) { return _mm_load_pd(source); }
+
+static inline void Store(float*  destination, FloatPack  value) { _mm_store_ps(destination, value); }
+static inline void Store(double* destination, DoublePack value) { _mm_store_pd(destination, value); }
+
+static inline FloatPack  Add(FloatPack  left, FloatPack  right) { return _mm_add_ps(left, right); }
+static inline DoublePack Add(DoublePack left, DoublePack right) { return _mm_add_pd(left, right); }
+static inline FloatPack  Sub(FloatPack  left, FloatPack  right) { return _mm_sub_ps(left, right); }
+static inline DoublePack Sub(DoublePack left, DoublePack right) { return _mm_sub_pd(left, right); }
+static inline FloatPack  Mul(FloatPack  left, FloatPack  right) { return _mm_mul_ps(left, right); }
+static inline DoublePack Mul(DoublePack left, DoublePack right) { return _mm_mul_pd(left, right); }
+static inline FloatPack  Div(FloatPack  left, FloatPack  right) { return _mm_div_ps(left, right); }
+static inline DoublePack Div(DoublePack left, DoublePack right) { return _mm_div_pd(left, right); }
+
+static inline FloatPack  MulAdd(FloatPack  a, FloatPack  b, FloatPack  c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+static inline DoublePack MulAdd(DoublePack a, DoublePack b, DoublePack c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+static inline FloatPack  Sqrt(FloatPack  value) { return _mm_sqrt_ps(value); }
+static inline DoublePack Sqrt(DoublePack value) { return _mm_sqrt_pd(value); }
+
+static inline FloatPack ReciprocalSqrtEstimate(FloatPack value) { return _mm_rsqrt_ps(value); }
+#else
+using FloatPack  = float;
+using DoublePack = double;
+
+static inline FloatPack  Splat(float  value) { return value; }
+static inline DoublePack Splat(double value) { return value; }
+
+static inline FloatPack  Load(const float*  source) { return *source; }
+static inline DoublePack Load(const double* source) { return *source; }
+
+static inline void Store(float*  destination, FloatPack  value) { *destination = value; }
+static inline void Store(double* destination, DoublePack value) { *destination = value; }
+
+static inline FloatPack  Add(FloatPack  left, FloatPack  right) { return left + right; }
+static inline DoublePack Add(DoublePack left, DoublePack right) { return left + right; }
+static inline FloatPack  Sub(FloatPack  left, FloatPack  right) { return left - right; }
+static inline DoublePack Sub(DoublePack left, DoublePack right) { return left - right; }
+static inline FloatPack  Mul(FloatPack  left, FloatPack  right) { return left * right; }
+static inline DoublePack Mul(DoublePack left, DoublePack right) { return left * right; }
+static inline FloatPack  Div(FloatPack  left, FloatPack  right) { return left / right; }
+static inline DoublePack Div(DoublePack left, DoublePack right) { return left / right; }
+
+static inline FloatPack  MulAdd(FloatPack  a, FloatPack  b, FloatPack  c) { return a * b + c; }
+static inline DoublePack MulAdd(DoublePack a, DoublePack b, DoublePack c) { return a * b + c; }
+
+static inline FloatPack  Sqrt(FloatPack  value) { return sqrtf(value); }
+static inline DoublePack Sqrt(DoublePack value) { return sqrt(value);  }
+
+static inline FloatPack ReciprocalSqrtEstimate(FloatPack value) { return 1.0f / sqrtf(value); }
+#endif
+
+template<typename E>
+struct PackOf;
+
+template<>
+struct PackOf<float>
+{
+	using Type = FloatPack;
+	static const size_t Lanes = sizeof(FloatPack) / sizeof(float);
+};
+
+template<>
+struct PackOf<double>
+{
+	using Type = DoublePack;
+	static const size_t Lanes = sizeof(DoublePack) / sizeof(double);
+};
+
+// The estimate and one Newton step, y (3 - x y^2) / 2, as Vector::FastNormalize does it.
+static inline FloatPack FastReciprocalSqrt(FloatPack value)
+{
+	FloatPack estimate = ReciprocalSqrtEstimate(value);
+	FloatPack error    = Sub(Splat(3.0f), Mul(Mul(value, estimate), estimate));
+
+	return Mul(Mul(Splat(0.5f), estimate), error);
+}
+
+// Doubles have no estimate to start from before AVX-512.
+static inline DoublePack FastReciprocalSqrt(DoublePack value) { return Div(Splat(1.0), Sqrt(value)); }
+
+// Summed pairwise, in the order Vector sums the lanes of a register.
+template<size_t D, typename P>
+static inline P SumOfProducts(const P* left, const P* right)
+{
+	if constexpr(D == 2U)
+		return Add(Mul(left[0], right[0]), Mul(left[1], right[1]));
+	else if constexpr(D == 3U)
+		return Add(Add(Mul(left[0], right[0]), Mul(left[1], right[1])), Mul(left[2], right[2]));
+	else
+		return Add(Add(Mul(left[0], right[0]), Mul(left[1], right[1])), Add(Mul(left[2], right[2]), Mul(left[3], right[3])));
+}
+
+static void CheckCounts(Size left, Size right)
+{
+	if(left != right)
+		Exception("The streams must have the same count."_s).Throw();
+}
+
+// Waits for the workers it is given when it goes out of scope, so RunChunks never returns or unwinds past a running one.
+class ThreadJoiner
+{
+private:
+	std::vector<std::thread>& m_threads;
+public:
+	ThreadJoiner(std::vector<std::thread>& threads) : m_threads(threads) {}
+
+	ThreadJoiner(const ThreadJoiner& other) = delete;
+
+	~ThreadJoiner()
+	{
+		for(std::thread& thread : m_threads)
+			thread.join();
+	}
+};
+
+// Runs kernel over [0, count) in one range of whole blocks per worker, the calling thread taking the first.
+template<typename Kernel>
+static void RunChunks(size_t count, size_t block, size_t minimumChunk, Size threadCount, const Kernel& kernel)
+{
+	size_t workers = threadCount.ToRawValue();
+	if(workers == 0U)
+		workers = std::thread::hardware_concurrency();
+	if(workers > count / minimumChunk)
+		workers = count / minimumChunk;
+	if(workers <= 1U)
+	{
+		kernel(0U, count);
+		return;
+	}
+
+	size_t chunk = ((count + workers - 1U) / workers + block - 1U) / block * block;
+
+	std::vector<std::thread> threads;
+	threads.reserve(workers - 1U);
+
+	ThreadJoiner joiner(threads);
+	for(size_t i = 1U; i < workers; i++)
+	{
+		size_t begin = i * chunk < count ? i * chunk : count;
+		size_t end   = begin + chunk < count ? begin + chunk : count;
+		threads.emplace_back([&kernel, begin, end]() { kernel(begin, end); });
+	}
+
+	kernel(0U, chunk < count ? chunk : count);
+}
+
+template<typename T, size_t D>
+VectorStream<T, D>::VectorStream(Size count) : m_data(nullptr), m_count(count), m_stride(StrideFor(count))
+{
+	m_data = (T*)::operator new(D * m_stride * sizeof(T), std::align_val_t(Alignment));
+	std::uninitialized_value_construct_n(m_data, D * m_stride);
+}
+
+template<typename T, size_t D>
+VectorStream<T, D>::VectorStream(const HeapArray<Element>& vectors) : VectorStream(vectors.Count())
+{
+	for(size_t i = 0U; i < m_count.ToRawValue(); i++)
+	{
+		const Vector<T, D>& vector = vectors[i];
+		for(size_t j = 0U; j < D; j++)
+			m_data[j * m_stride + i] = vector[j];
+	}
+}
+
+template<typename T, size_t D>
+VectorStream<T, D>::VectorStream(const VectorStream<T, D>& other) : VectorStream(other.m_count)
+{
+	memcpy(m_data, other.m_data, D * m_stride * sizeof(T));
+}
+
+template<typename T, size_t D>
+VectorStream<T, D>::VectorStream(VectorStream<T, D>&& other) noexcept : m_data(other.m_data), m_count(other.m_count), m_stride(other.m_stride)
+{
+	other.m_data   = nullptr;
+	other.m_count  = 0U;
+	other.m_stride = 0U;
+}
+
+template<typename T, size_t D>
+VectorStream<T, D>::~VectorStream()
+{
+	if(m_data)
+		::operator delete(m_data, std::align_val_t(Alignment));
+}
+
+template<typename T, size_t D>
+VectorStream<T, D>& VectorStream<T, D>::operator=(const VectorStream<T, D>& other)
+{
+	if(this != &other)
+		*this = VectorStream<T, D>(other);
+
+	return *this;
+}
+
+template<typename T, size_t D>
+VectorStream<T, D>& VectorStream<T, D>::operator=(VectorStream<T, D>&& other) noexcept
+{
+	if(this == &other)
+		return *this;
+
+	if(m_data)
+		::operator delete(m_data, std::align_val_t(Alignment));
+
+	m_data   = other.m_data;
+	m_count  = other.m_count;
+	m_stride = other.m_stride;
+
+	other.m_data   = nullptr;
+	other.m_count  = 0U;
+	other.m_stride = 0U;
+
+	return *this;
+}
+
+template<typename T, size_t D>
+HeapArray<typename VectorStream<T, D>::Element> VectorStream<T, D>::ToArray() const
+{
+	HeapArray<Element> result(m_count);
+	for(size_t i = 0U; i < m_count.ToRawValue(); i++)
+		result[i] = Get(i);
+
+	return result;
+}
+
+// Add and Scale treat the whole stream as one array, since every component array is the same length.
+template<typename T, size_t D>
+void VectorStream<T, D>::Add(const VectorStream<T, D>& left, const VectorStream<T, D>& right, VectorStream<T, D>& output, Size threadCount)
+{
+	CheckCounts(left.m_count, right.m_count);
+	CheckCounts(left.m_count, output.m_count);
+
+	using E = decltype(T().ToRawValue());
+	const size_t Lanes = PackOf<E>::Lanes;
+
+	const E* a = (const E*)left.m_data;
+	const E* b = (const E*)right.m_data;
+	E*       o = (E*)output.m_data;
+
+	RunChunks(D * left.m_stride, Block, MinimumChunk, threadCount, [=](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; i += Lanes)
+			Store(o + i, ::Add(Load(a + i), Load(b + i)));
+	});
+}
+
+template<typename T, size_t D>
+void VectorStream<T, D>::Scale(const VectorStream<T, D>& input, T factor, VectorStream<T, D>& output, Size threadCount)
+{
+	CheckCounts(input.m_count, output.m_count);
+
+	using E = decltype(T().ToRawValue());
+	const size_t Lanes = PackOf<E>::Lanes;
+
+	const E* a = (const E*)input.m_data;
+	E*       o = (E*)output.m_data;
+	auto     f = Splat(factor.ToRawValue());
+
+	RunChunks(D * input.m_stride, Block, MinimumChunk, threadCount, [=](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; i += Lanes)
+			Store(o + i, Mul(Load(a + i), f));
+	});
+}
+
+// The output has no padding, so only the part of the last pack that is in it is copied out.
+template<typename T, size_t D>
+void VectorStream<T, D>::Dot(const VectorStream<T, D>& left, const VectorStream<T, D>& right, ArraySpan<T> output, Size threadCount)
+{
+	CheckCounts(left.m_count, right.m_count);
+	CheckCounts(left.m_count, output.Count());
+
+	using E = decltype(T().ToRawValue());
+	using P = typename PackOf<E>::Type;
+	const size_t Lanes = PackOf<E>::Lanes;
+
+	const E* a      = (const E*)left.m_data;
+	const E* b      = (const E*)right.m_data;
+	E*       o      = (E*)output.ToUnsafePointer();
+	size_t   stride = left.m_stride;
+
+	RunChunks(left.m_count.ToRawValue(), Block, MinimumChunk, threadCount, [=](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; i += Lanes)
+		{
+			P x[D], y[D];
+			for(size_t j = 0U; j < D; j++)
+			{
+				x[j] = Load(a + j * stride + i);
+				y[j] = Load(b + j * stride + i);
+			}
+
+			alignas(Alignment) E values[Lanes];
+			Store(values, SumOfProducts<D>(x, y));
+			memcpy(o + i, values, (end - i < Lanes ? end - i : Lanes) * sizeof(E));
+		}
+	});
+}
+
+template<typename T, size_t D>
+void VectorStream<T, D>::Normalize(const VectorStream<T, D>& input, VectorStream<T, D>& output, Size threadCount)
+{
+	CheckCounts(input.m_count, output.m_count);
+
+	using E = decltype(T().ToRawValue());
+	using P = typename PackOf<E>::Type;
+	const size_t Lanes = PackOf<E>::Lanes;
+
+	const E* a      = (const E*)input.m_data;
+	E*       o      = (E*)output.m_data;
+	size_t   stride = input.m_stride;
+
+	RunChunks(stride, Block, MinimumChunk, threadCount, [=](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; i += Lanes)
+		{
+			P x[D];
+			for(size_t j = 0U; j < D; j++)
+				x[j] = Load(a + j * stride + i);
+
+			P length = Sqrt(SumOfProducts<D>(x, x));
+			for(size_t j = 0U; j < D; j++)
+				Store(o + j * stride + i, Div(x[j], length));
+		}
+	});
+}
+
+template<typename T, size_t D>
+void VectorStream<T, D>::FastNormalize(const VectorStream<T, D>& input, VectorStream<T, D>& output, Size threadCount)
+{
+	CheckCounts(input.m_count, output.m_count);
+
+	using E = decltype(T().ToRawValue());
+	using P = typename PackOf<E>::Type;
+	const size_t Lanes = PackOf<E>::Lanes;
+
+	const E* a      = (const E*)input.m_data;
+	E*       o      = (E*)output.m_data;
+	size_t   stride = input.m_stride;
+
+	RunChunks(stride, Block, MinimumChunk, threadCount, [=](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; i += Lanes)
+		{
+			P x[D];
+			for(size_t j = 0U; j < D; j++)
+				x[j] = Load(a + j * stride + i);
+
+			P reciprocal = FastReciprocalSqrt(SumOfProducts<D>(x, x));
+			for(size_t j = 0U; j < D; j++)
+				Store(o + j * stride + i, Mul(x[j], reciprocal));
+		}
+	});
+}
+
+template<typename T, size_t D>
+void VectorStream<T, D>::Cross(const VectorStream<T, D>& left, const VectorStream<T, D>& right, VectorStream<T, D>& output, Size threadCount) requires (D == 3U)
+{
+	CheckCounts(left.m_count, right.m_count);
+	CheckCounts(left.m_count, output.m_count);
+
+	using E = decltype(T().ToRawValue());
+	const size_t Lanes = PackOf<E>::Lanes;
+
+	const E* a      = (const E*)left.m_data;
+	const E* b      = (const E*)right.m_data;
+	E*       o      = (E*)output.m_data;
+	size_t   stride = left.m_stride;
+
+	RunChunks(stride, Block, MinimumChunk, threadCount, [=](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; i += Lanes)
+		{
+			auto ax = Load(a + i), ay = Load(a + stride + i), az = Load(a + 2U * stride + i);
+			auto bx = Load(b + i), by = Load(b + stride + i), bz = Load(b + 2U * stride + i);
+
+			Store(o + i,               Sub(Mul(ay, bz), Mul(az, by)));
+			Store(o + stride + i,      Sub(Mul(az, bx), Mul(ax, bz)));
+			Store(o + 2U * stride + i, Sub(Mul(ax, by), Mul(ay, bx)));
+		}
+	});
+}
+
+template<typename T, size_t D>
+void VectorStream<T, D>::Transform(const Matrix4x4<T>& matrix, const VectorStream<T, D>& input, VectorStream<T, D>& output, Size threadCount) requires (D >= 3U)
+{
+	CheckCounts(input.m_count, output.m_count);
+
+	using E = decltype(T().ToRawValue());
+	using P = typename PackOf<E>::Type;
+	const size_t Lanes = PackOf<E>::Lanes;
+
+	P m[4][4];
+	for(size_t row = 0U; row < 4U; row++)
+	{
+		for(size_t column = 0U; column < 4U; column++)
+			m[row][column] = Splat(matrix[row][column].ToRawValue());
+	}
+
+	const E* a      = (const E*)input.m_data;
+	E*       o      = (E*)output.m_data;
+	size_t   stride = input.m_stride;
+
+	RunChunks(stride, Block, MinimumChunk, threadCount, [=, &m](size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; i += Lanes)
+		{
+			P x[D];
+			for(size_t j = 0U; j < D; j++)
+				x[j] = Load(a + j * stride + i);
+
+			P result[D];
+			for(size_t row = 0U; row < D; row++)
+			{
+				P sum = m[row][3];
+				if constexpr(D == 4U)
+					sum = Mul(sum, x[3]);
+
+				sum = MulAdd(m[row][2], x[2], sum);
+				sum = MulAdd(m[row][1], x[1], sum);
+				result[row] = MulAdd(m[row][0], x[0], sum);
+			}
+
+			for(size_t j = 0U; j < D; j++)
+				Store(o + j * stride + i, result[j]);
+		}
+	});
+}
+
+template class VectorStream<Float32, 2U>;
+template class VectorStream<Float32, 3U>;
+template class VectorStream<Float32, 4U>;
+
+template class VectorStream<Float64, 2U>;
+template class VectorStream<Float64, 3U>;
+template class VectorStream<Float64, 4U>;
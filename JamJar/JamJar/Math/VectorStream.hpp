@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Matrix.hpp"
+
+// Many vectors stored a component at a time: every x, then every y, and so on. An array of Vector3F32 fills at most
+// three lanes of a register per vector; here each lane holds a different vector, so the batch operations below work on
+// eight Float32 or four Float64 vectors per instruction with AVX2, and four or two with SSE2. Each component array is
+// aligned to a cache line and padded to a whole number of blocks, so the loops have no remainder to deal with.
+//
+// The batch operations take streams of the same count, and the output may be one of the inputs. With a thread count
+// other than one the work is split into that many chunks of whole blocks, run on separate threads with the calling
+// thread as one of them; zero uses one thread per processor. Starting threads costs tens of microseconds, so streams
+// are never split into chunks of fewer than MinimumChunk components.
+//
+// Only Float32 and Float64 streams of two to four components are provided.
+template<typename T, size_t D>
+class VectorStream
+{
+private:
+	static_assert((SameAs<T, Float32> || SameAs<T, Float64>) && D >= 2U && D <= 4U);
+
+	T*     m_data;
+	Size   m_count;
+	size_t m_stride;
+
+	static size_t StrideFor(Size count) { return (count.ToRawValue() + Block - 1U) / Block * Block; }
+public:
+	using Element = std::conditional_t<D == 2U, Vector2<T>, std::conditional_t<D == 3U, Vector3<T>, Vector4<T>>>;
+
+	static constexpr size_t Alignment    = 64U;
+	static constexpr size_t Block        = 16U;
+	static constexpr size_t MinimumChunk = 65536U;
+
+	// All zero.
+	explicit VectorStream(Size count = 0U);
+
+	explicit VectorStream(const HeapArray<Element>& vectors);
+
+	VectorStream(const VectorStream<T, D>& other);
+	VectorStream(VectorStream<T, D>&& other) noexcept;
+
+	~VectorStream();
+
+	VectorStream<T, D>& operator=(const VectorStream<T, D>& other);
+	VectorStream<T, D>& operator=(VectorStream<T, D>&& other) noexcept;
+
+	Size Count() const { return m_count; }
+
+	Element Get(Size index) const
+	{
+		Element result;
+		for(size_t i = 0U; i < D; i++)
+			result[i] = m_data[i * m_stride + index.ToRawValue()];
+
+		return result;
+	}
+
+	void Set(Size index, const Vector<T, D>& value)
+	{
+		for(size_t i = 0U; i < D; i++)
+			m_data[i * m_stride + index.ToRawValue()] = value[i];
+	}
+
+	// The array of one component, Count long and aligned to Alignment.
+	      T* ToUnsafePointer(Size component)       { return m_data + component.ToRawValue() * m_stride; }
+	const T* ToUnsafePointer(Size component) const { return m_data + component.ToRawValue() * m_stride; }
+
+	HeapArray<Element> ToArray() const;
+
+	static void Add  (const VectorStream<T, D>& left, const VectorStream<T, D>& right, VectorStream<T, D>& output, Size threadCount = 1U);
+	static void Scale(const VectorStream<T, D>& input, T factor, VectorStream<T, D>& output, Size threadCount = 1U);
+
+	// The output must be Count long.
+	static void Dot(const VectorStream<T, D>& left, const VectorStream<T, D>& right, ArraySpan<T> output, Size threadCount = 1U);
+
+	// FastNormalize is good to about 2^-22 for Float32 and exact for Float64, as on Vector.
+	static void Normalize    (const VectorStream<T, D>& input, VectorStream<T, D>& output, Size threadCount = 1U);
+	static void FastNormalize(const VectorStream<T, D>& input, VectorStream<T, D>& output, Size threadCount = 1U);
+
+	static void Cross(const VectorStream<T, D>& left, const VectorStream<T, D>& right, VectorStream<T, D>& output, Size threadCount = 1U) requires (D == 3U);
+
+	// The matrix times each vector as a column. Three components are a point with a w of one, and the last row of the
+	// matrix is left out.
+	static void Transform(const Matrix4x4<T>& matrix, const VectorStream<T, D>& input, VectorStream<T, D>& output, Size threadCount = 1U) requires (D >= 3U);
+};
+
+using VectorStream2F32 = VectorStream<Float32, 2U>;
+using VectorStream3F32 = VectorStream<Float32, 3U>;
+using VectorStream4F32 = VectorStream<Float32, 4U>;
+
+using VectorStream2F64 = VectorStream<Float64, 2U>;
+using VectorStream3F64 = VectorStream<Float64, 3U>;
+using VectorStream4F64 = VectorStream<Float64, 4U>;
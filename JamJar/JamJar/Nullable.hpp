@@ -15,7 +15,7 @@ public:
 
 	Boolean IsNull() const { return !m_hasValue; }
 
-	T& GetValue() const { return m_value; }
+	const T& GetValue() const { return m_value; }
 
 	friend Boolean operator==(const Nullable<T>& left, std::nullptr_t) { return  left.IsNull(); }
 	friend Boolean operator!=(const Nullable<T>& left, std::nullptr_t) { return !left.IsNull(); }
@@ -0,0 +1,366 @@
+#include "NumberFormat.hpp"
+#include "Math/UInt128.hpp"
+
+#include <charconv>
+
+static const char DigitPairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const size_t MaximumParsedFloatLength = 768U;
+
+static void WriteDigits(uint64_t value, wchar_t* end)
+{
+	while(value >= 100U)
+	{
+		size_t pair = size_t(value % 100U) * 2U;
+		value /= 100U;
+
+		*--end = wchar_t(DigitPairs[pair + 1U]);
+		*--end = wchar_t(DigitPairs[pair]);
+	}
+
+	if(value >= 10U)
+	{
+		size_t pair = size_t(value) * 2U;
+
+		*--end = wchar_t(DigitPairs[pair + 1U]);
+		*--end = wchar_t(DigitPairs[pair]);
+	}
+	else
+		*--end = wchar_t(L'0' + value);
+}
+
+// Reads eight ASCII digits at once (SWAR). Returns false if any of them is not a digit.
+static Boolean ParseEightDigits(const wchar_t* characters, uint64_t& result)
+{
+	uint64_t packed   = 0U;
+	uint32_t combined = 0U;
+	for(size_t i = 0U; i < 8U; i++)
+	{
+		combined |= uint32_t(characters[i]);
+		packed   |= uint64_t(uint8_t(characters[i])) << (i * 8U);
+	}
+
+	if(combined > 0x7FU)
+		return false;
+
+	packed -= 0x3030303030303030ULL;
+	if(((packed + 0x7676767676767676ULL) | packed) & 0x8080808080808080ULL)
+		return false;
+
+	packed = (packed * 10U) + (packed >> 8U);
+	packed = (((packed & 0x000000FF000000FFULL) * (100U + (1000000ULL << 32U))) +
+	         (((packed >> 16U) & 0x000000FF000000FFULL) * (1U + (10000ULL << 32U)))) >> 32U;
+
+	result = packed;
+	return true;
+}
+
+static Boolean ParseDigits(const wchar_t* characters, size_t length, uint64_t maximum, uint64_t& result)
+{
+	if(length == 0U)
+		return false;
+
+	uint64_t value = 0U;
+	size_t i = 0U;
+
+	while(length - i >= 8U)
+	{
+		uint64_t chunk;
+		if(!ParseEightDigits(characters + i, chunk))
+			return false;
+
+		if(chunk > maximum || value > (maximum - chunk) / 100000000U)
+			return false;
+
+		value = value * 100000000U + chunk;
+		i += 8U;
+	}
+
+	for(; i < length; i++)
+	{
+		uint32_t digit = uint32_t(characters[i]) - uint32_t(L'0');
+		if(digit > 9U)
+			return false;
+
+		if(digit > maximum || value > (maximum - digit) / 10U)
+			return false;
+
+		value = value * 10U + digit;
+	}
+
+	result = value;
+	return true;
+}
+
+template<std::floating_point T>
+static size_t FormatFloat(T value, wchar_t* destination)
+{
+	char buffer[NumberFormat::MaximumFloatLength];
+	std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+	size_t count = size_t(result.ptr - buffer);
+	for(size_t i = 0U; i < count; i++)
+		destination[i] = wchar_t(buffer[i]);
+
+	return count;
+}
+
+template<std::floating_point T>
+static Boolean ParseFloat(const wchar_t* characters, size_t length, T& result)
+{
+	// from_chars takes no plus sign; one is allowed here as it is for integers, but not in front of a minus.
+	if(length > 1U && characters[0] == L'+' && characters[1] != L'-')
+	{
+		characters++;
+		length--;
+	}
+
+	if(length == 0U || length > MaximumParsedFloatLength)
+		return false;
+
+	// Narrowed without a branch per character and eight at a time, so the inner loop has a fixed count and vectorizes
+	// even where a loop of unknown length does not; anything outside ASCII is caught afterwards.
+	char     buffer[MaximumParsedFloatLength];
+	uint32_t combined = 0U;
+	size_t   i        = 0U;
+	for(; i + 8U <= length; i += 8U)
+	{
+		for(size_t j = 0U; j < 8U; j++)
+		{
+			combined      |= uint32_t(characters[i + j]);
+			buffer[i + j]  = char(characters[i + j]);
+		}
+	}
+
+	for(; i < length; i++)
+	{
+		combined |= uint32_t(characters[i]);
+		buffer[i]  = char(characters[i]);
+	}
+
+	if(combined > 0x7FU)
+		return false;
+
+	std::from_chars_result parsed = std::from_chars(buffer, buffer + length, result);
+	return parsed.ec == std::errc() && parsed.ptr == buffer + length;
+}
+
+size_t NumberFormat::GetDigitCount(uint64_t value)
+{
+	size_t count = 1U;
+	while(value >= 10000U)
+	{
+		value /= 10000U;
+		count += 4U;
+	}
+
+	if(value >= 10U)
+		count++;
+	if(value >= 100U)
+		count++;
+	if(value >= 1000U)
+		count++;
+
+	return count;
+}
+
+size_t NumberFormat::Format(uint64_t value, wchar_t* destination)
+{
+	size_t count = GetDigitCount(value);
+	WriteDigits(value, destination + count);
+	return count;
+}
+
+size_t NumberFormat::Format(int64_t value, wchar_t* destination)
+{
+	if(value < 0)
+	{
+		*destination = L'-';
+		return Format(0U - uint64_t(value), destination + 1U) + 1U;
+	}
+
+	return Format(uint64_t(value), destination);
+}
+
+size_t NumberFormat::Format(float  value, wchar_t* destination) { return FormatFloat(value, destination); }
+size_t NumberFormat::Format(double value, wchar_t* destination) { return FormatFloat(value, destination); }
+
+size_t NumberFormat::Format(float value, size_t significantDigits, wchar_t* destination)
+{
+	char buffer[NumberFormat::MaximumFloatLength];
+	std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, int(significantDigits));
+
+	size_t count = size_t(result.ptr - buffer);
+	for(size_t i = 0U; i < count; i++)
+		destination[i] = wchar_t(buffer[i]);
+
+	return count;
+}
+
+size_t NumberFormat::FormatFixed(int64_t value, size_t fractionBits, wchar_t* destination)
+{
+	wchar_t* start = destination;
+	if(value < 0)
+		*destination++ = L'-';
+
+	uint64_t magnitude = value < 0 ? 0U - uint64_t(value) : uint64_t(value);
+	uint64_t mask      = (uint64_t(1) << fractionBits) - 1U;
+	uint64_t integer   = magnitude >> fractionBits;
+	uint64_t fraction  = magnitude & mask;
+
+	// Produce digits until they, or they with the last one rounded up, are within half a unit in the last place of the
+	// value, taking the nearer if both are; parsing rounds halfway cases away from zero, so only the digits below the
+	// value may be exactly half off. This takes at most 19 digits, as 10^19 > 2^63.
+	uint64_t digits = 0U;
+	uint64_t scale  = 1U;
+	size_t   count  = 0U;
+
+	while(fraction != 0U)
+	{
+		UInt128 product = UInt128::Multiply(fraction, 10U);
+		digits   = digits * 10U + (product >> fractionBits).GetLow();
+		fraction = product.GetLow() & mask;
+		scale   *= 10U;
+		count++;
+
+		uint64_t below = fraction;
+		uint64_t above = mask + 1U - fraction;
+
+		Boolean truncate = 2U * below <= scale;
+		Boolean roundUp  = 2U * above <  scale;
+
+		if(roundUp && (!truncate || above < below))
+		{
+			if(++digits == scale)
+			{
+				integer++;
+				digits = 0U;
+			}
+			break;
+		}
+
+		if(truncate)
+			break;
+	}
+
+	while(count > 0U && digits % 10U == 0U)
+	{
+		digits /= 10U;
+		count--;
+	}
+
+	destination += Format(integer, destination);
+
+	if(count > 0U)
+	{
+		*destination++ = L'.';
+		for(size_t i = 0U; i < count; i++)
+			destination[i] = L'0';
+
+		WriteDigits(digits, destination + count);
+		destination += count;
+	}
+
+	return size_t(destination - start);
+}
+
+Boolean NumberFormat::Parse(const wchar_t* characters, size_t length, uint64_t maximum, uint64_t& result)
+{
+	if(length > 0U && characters[0] == L'+')
+	{
+		characters++;
+		length--;
+	}
+
+	return ParseDigits(characters, length, maximum, result);
+}
+
+Boolean NumberFormat::Parse(const wchar_t* characters, size_t length, int64_t minimum, int64_t maximum, int64_t& result)
+{
+	Boolean negative = false;
+	if(length > 0U && (characters[0] == L'-' || characters[0] == L'+'))
+	{
+		negative = characters[0] == L'-';
+		characters++;
+		length--;
+	}
+
+	uint64_t magnitude;
+	if(negative)
+	{
+		if(!ParseDigits(characters, length, 0U - uint64_t(minimum), magnitude))
+			return false;
+
+		result = int64_t(0U - magnitude);
+		return true;
+	}
+
+	if(!ParseDigits(characters, length, uint64_t(maximum), magnitude))
+		return false;
+
+	result = int64_t(magnitude);
+	return true;
+}
+
+Boolean NumberFormat::Parse(const wchar_t* characters, size_t length, float&  result) { return ParseFloat(characters, length, result); }
+Boolean NumberFormat::Parse(const wchar_t* characters, size_t length, double& result) { return ParseFloat(characters, length, result); }
+
+Boolean NumberFormat::ParseFixed(const wchar_t* characters, size_t length, size_t fractionBits, int64_t minimum, int64_t maximum, int64_t& result)
+{
+	Boolean negative = false;
+	if(length > 0U && (characters[0] == L'-' || characters[0] == L'+'))
+	{
+		negative = characters[0] == L'-';
+		characters++;
+		length--;
+	}
+
+	size_t point = 0U;
+	while(point < length && characters[point] != L'.')
+		point++;
+
+	uint64_t integer;
+	if(!ParseDigits(characters, point, UINT64_MAX >> fractionBits, integer))
+		return false;
+
+	// The fraction in Q0.124, from the last digit to the first. Each step divides by ten rounding down, and nested floor
+	// divisions give the floor of the whole, so the rounding below is exact however many digits there are.
+	UInt128 fraction;
+	if(point < length)
+	{
+		if(point + 1U == length)
+			return false;
+
+		for(size_t i = length - 1U; i > point; i--)
+		{
+			uint32_t digit = uint32_t(characters[i]) - uint32_t(L'0');
+			if(digit > 9U)
+				return false;
+
+			uint64_t remainder;
+			fraction = ((UInt128(digit) << 124U) | fraction).Divide(10U, remainder);
+		}
+	}
+
+	// Halfway cases round away from zero.
+	uint64_t rounded   = (((fraction >> (123U - fractionBits)) + UInt128(1U)) >> 1U).GetLow();
+	uint64_t magnitude = (integer << fractionBits) + rounded;
+	if(magnitude < rounded)
+		return false;
+
+	if(negative ? magnitude > 0U - uint64_t(minimum) : magnitude > uint64_t(maximum))
+		return false;
+
+	result = negative ? int64_t(0U - magnitude) : int64_t(magnitude);
+	return true;
+}
\ No newline at end of file
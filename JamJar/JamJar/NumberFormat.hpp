@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Numerics.hpp"
+
+// Formats and parses numbers directly on wide character buffers, without going through std::string.
+// Integers are written two digits at a time from a digit-pair table, floating point values use the shortest
+// representation that round-trips (std::to_chars). Fixed point values are raw integers with a number of fraction bits;
+// they are written with the fewest digits that read back as the same value and read with exact rounding.
+class NumberFormat
+{
+public:
+	static const size_t MaximumIntegerLength = 20U;
+	static const size_t MaximumFloatLength   = 32U;
+	static const size_t MaximumFixedLength   = 40U;
+
+	static size_t GetDigitCount(uint64_t value);
+
+	static size_t GetLength(uint64_t value) { return GetDigitCount(value); }
+	static size_t GetLength(int64_t  value) { return value < 0 ? GetDigitCount(0U - uint64_t(value)) + 1U : GetDigitCount(uint64_t(value)); }
+
+	static size_t Format(uint64_t value, wchar_t* destination);
+	static size_t Format(int64_t  value, wchar_t* destination);
+	static size_t Format(float    value, wchar_t* destination);
+	static size_t Format(double   value, wchar_t* destination);
+
+	// At most the given number of significant digits, without trailing zeros.
+	static size_t Format(float value, size_t significantDigits, wchar_t* destination);
+
+	static size_t FormatFixed(int64_t value, size_t fractionBits, wchar_t* destination);
+
+	static Boolean Parse(const wchar_t* characters, size_t length, uint64_t maximum, uint64_t& result);
+	static Boolean Parse(const wchar_t* characters, size_t length, int64_t minimum, int64_t maximum, int64_t& result);
+	static Boolean Parse(const wchar_t* characters, size_t length, float&  result);
+	static Boolean Parse(const wchar_t* characters, size_t length, double& result);
+
+	static Boolean ParseFixed(const wchar_t* characters, size_t length, size_t fractionBits, int64_t minimum, int64_t maximum, int64_t& result);
+};
\ No newline at end of file
@@ -98,3 +98,47 @@ Float<double> Float<double>::ATanH() { return Float<double>(atanh(m_value)); }
 
 template<>
 Float<double> Float<double>::ATan2(Float<double> x) { return Float<double>(atan2(m_value, x.ToRawValue())); }
+
+// The wrappers must cost nothing over the raw types: same layout, trivially copied, and usable in constant expressions.
+// That they vectorize as well is checked at run time, by the numerics tests in the Test project.
+static_assert(sizeof(UInt8)  == sizeof(uint8_t)  && alignof(UInt8)  == alignof(uint8_t));
+static_assert(sizeof(UInt64) == sizeof(uint64_t) && alignof(UInt64) == alignof(uint64_t));
+static_assert(sizeof(SInt32) == sizeof(int32_t)  && alignof(SInt32) == alignof(int32_t));
+static_assert(sizeof(Float32) == sizeof(float)   && alignof(Float32) == alignof(float));
+static_assert(sizeof(Float64) == sizeof(double)  && alignof(Float64) == alignof(double));
+
+static_assert(std::is_trivially_copyable_v<Size>    && std::is_trivially_destructible_v<Size>    && std::is_standard_layout_v<Size>);
+static_assert(std::is_trivially_copyable_v<SInt64>  && std::is_trivially_destructible_v<SInt64>  && std::is_standard_layout_v<SInt64>);
+static_assert(std::is_trivially_copyable_v<Float32> && std::is_trivially_destructible_v<Float32> && std::is_standard_layout_v<Float32>);
+
+static_assert(std::is_nothrow_copy_constructible_v<UInt32> && std::is_nothrow_default_constructible_v<Float64>);
+
+static_assert(UInt8::Maximum.ToRawValue()  == 0xFFU);
+static_assert(UInt64::Maximum.ToRawValue() == UINT64_MAX);
+static_assert(SInt16::Minimum.ToRawValue() == INT16_MIN && SInt16::Maximum.ToRawValue() == INT16_MAX);
+static_assert(SInt64::Minimum.ToRawValue() == INT64_MIN);
+
+static_assert((UInt32(7U) * UInt32(6U) + UInt32::One).ToRawValue() == 43U);
+static_assert((SInt32(-5) % SInt32(3)).ToRawValue() == -2 && SInt32(-9).Abs() == SInt32(9));
+static_assert(UInt16(300U).Clamp(UInt16::Zero, UInt16(255U)) == UInt16(255U));
+static_assert(Float64(2.5).Min(Float64::One) == Float64::One && (-Float32(1.5f)).Abs() == Float32(1.5f));
+static_assert(Float64::NaN.IsNaN() && Float32::PositiveInfinity.IsInfinity() && !Float32::Maximum.IsInfinity());
+static_assert(Float64(180.0).ToRadians() == Float64::PI);
+
+// The 16-bit formats must be bit for bit what the hardware conversions produce, which the span conversions rely on.
+static_assert(sizeof(Float16) == sizeof(uint16_t) && sizeof(BFloat16) == sizeof(uint16_t) && std::is_trivially_copyable_v<Float16>);
+static_assert(SignedNumber<Float16> && SignedNumber<BFloat16>);
+static_assert(Float16::One.ToRawValue() == 0x3C00U && Float16::Maximum.ToRawValue() == 0x7BFFU && Float16::PI.ToRawValue() == 0x4248U);
+static_assert(BFloat16::One.ToRawValue() == 0x3F80U && BFloat16::Maximum.ToRawValue() == 0x7F7FU && BFloat16::PI.ToRawValue() == 0x4049U);
+static_assert(Float16(65519.0f).ToRawValue() == 0x7BFFU && Float16(65520.0f).IsPositiveInfinity() && Float16(1.0e-8f).ToRawValue() == 0U);
+static_assert(Float16(5.9604645e-8f).ToRawValue() == 0x0001U && Float16(-2.0f).ToRawValue() == 0xC000U && Float16(2049.0f).ToRawValue() == 0x6800U);
+static_assert(Float16::NaN.IsNaN() && Float16(Float32::NaN).IsNaN() && BFloat16(Float64::NaN).IsNaN() && !Float16::NegativeInfinity.IsNaN());
+static_assert(Float32(Float16::FromRawValue(0x0001U)) == Float32(5.9604645e-8f) && Float32(BFloat16(1.00390625f)) == Float32::One);
+static_assert(Float16(0.5f) + Float16(0.25f) == Float16(0.75f) && (Float16(3) * Float16(-2)).Abs() == Float16(6));
+
+static_assert(UInt32(0xF0F0U).PopCount() == UInt32(8U) && UInt64(1U).LeadingZeros() == UInt64(63U) && UInt16(0U).TrailingZeros() == UInt16(16U));
+static_assert(UInt8(0x81U).RotateLeft(UInt8(1U)) == UInt8(0x03U) && SInt32(1).RotateRight(-1) == SInt32(2) && UInt32(0x12345678U).ByteSwap() == UInt32(0x78563412U));
+static_assert(UInt32(1000U).Log2() == UInt32(9U) && UInt32(0U).Log2() == UInt32::Maximum && UInt64(4096U).IsPowerOfTwo() && !SInt32(-4).IsPowerOfTwo());
+static_assert(UInt32(1000U).NextPowerOfTwo() == UInt32(1024U) && UInt8(200U).NextPowerOfTwo() == UInt8::Zero && SInt8(100).NextPowerOfTwo() == SInt8::Zero);
+static_assert(UInt64::Maximum.ISqrt() == UInt64(0xFFFFFFFFU) && UInt32(99U).Sqrt() == UInt32(9U) && SInt32(-4).ISqrt() == SInt32::Zero);
+static_assert(UInt64(3U).IPow(40U) == UInt64(12157665459056928801ULL) && SInt32(-2).IPow(31) == SInt32::Minimum && SInt32(-1).IPow(-3) == SInt32(-1));
@@ -3,6 +3,7 @@
 #include "Concepts.hpp"
 #include "HashCode.hpp"
 #include <limits>
+#include <bit>
 
 template<std::signed_integral T>
 class SignedInteger;
@@ -10,6 +11,115 @@ class SignedInteger;
 template<std::floating_point T>
 class Float;
 
+// Integer operations on the raw unsigned types that UnsignedInteger and SignedInteger share. Counting and rotating go
+// through <bit>, which compiles to popcnt, lzcnt, tzcnt and rol where the target has them; byte swaps use the compiler
+// intrinsics outside of constant expressions.
+class IntegerMath
+{
+public:
+	template<std::unsigned_integral T>
+	static constexpr T ByteSwap(T value) noexcept
+	{
+		if constexpr(sizeof(T) == 1U)
+			return value;
+		else
+		{
+			if(!std::is_constant_evaluated())
+			{
+#if defined(_MSC_VER) && !defined(__clang__)
+				if constexpr(sizeof(T) == 2U)
+					return T(_byteswap_ushort(value));
+				else if constexpr(sizeof(T) == 4U)
+					return T(_byteswap_ulong(value));
+				else
+					return T(_byteswap_uint64(value));
+#else
+				if constexpr(sizeof(T) == 2U)
+					return T(__builtin_bswap16(value));
+				else if constexpr(sizeof(T) == 4U)
+					return T(__builtin_bswap32(value));
+				else
+					return T(__builtin_bswap64(value));
+#endif
+			}
+
+			T result = 0U;
+			for(size_t i = 0U; i < sizeof(T); i++)
+			{
+				result = T((result << 8U) | (value & 0xFFU));
+				value  = T(value >> 8U);
+			}
+
+			return result;
+		}
+	}
+
+	// The smallest power of two not below the value, one for zero, and zero when it does not fit in T.
+	template<std::unsigned_integral T>
+	static constexpr T NextPowerOfTwo(T value) noexcept
+	{
+		if(value <= 1U)
+			return 1U;
+
+		int width = std::bit_width(T(value - 1U));
+		return width < std::numeric_limits<T>::digits ? T(T(1U) << width) : T(0U);
+	}
+
+	// The square root rounded down. A double estimate is within one of it for every 64-bit value, which the corrections
+	// fix; constant expressions take one bit at a time instead.
+	template<std::unsigned_integral T>
+	static constexpr T SquareRoot(T value) noexcept
+	{
+		if(std::is_constant_evaluated())
+		{
+			T root      = 0U;
+			T remainder = value;
+			for(T bit = T(T(1U) << (std::numeric_limits<T>::digits - 2)); bit != 0U; bit = T(bit >> 2U))
+			{
+				if(remainder >= T(root + bit))
+				{
+					remainder = T(remainder - (root + bit));
+					root      = T((root >> 1U) + bit);
+				}
+				else
+					root = T(root >> 1U);
+			}
+
+			return root;
+		}
+
+		// The largest value whose square fits in T.
+		constexpr T RootMaximum = T(std::numeric_limits<T>::max() >> (std::numeric_limits<T>::digits / 2));
+
+		uint64_t root = uint64_t(sqrt(double(value)));
+		if(root > RootMaximum)
+			root = RootMaximum;
+		if(root * root > value)
+			root--;
+		else if(root < RootMaximum && (root + 1U) * (root + 1U) <= value)
+			root++;
+
+		return T(root);
+	}
+
+	// Exponentiation by squaring, wrapping around on overflow like multiplication does.
+	template<std::unsigned_integral T>
+	static constexpr T Power(T base, uint64_t exponent) noexcept
+	{
+		T result = 1U;
+		while(exponent != 0U)
+		{
+			if((exponent & 1U) != 0U)
+				result = T(uint64_t(result) * base);
+
+			base     = T(uint64_t(base) * base);
+			exponent >>= 1U;
+		}
+
+		return result;
+	}
+};
+
 template<std::unsigned_integral T>
 class UnsignedInteger
 {
@@ -22,84 +132,84 @@ public:
 	static const UnsignedInteger<T> Zero;
 	static const UnsignedInteger<T> One;
 	
-	UnsignedInteger()                                : m_value(0)             {}
-	UnsignedInteger(const UnsignedInteger<T>& other) : m_value(other.m_value) {}
+	constexpr UnsignedInteger()                                noexcept : m_value(0) {}
+	constexpr UnsignedInteger(const UnsignedInteger<T>& other) noexcept = default;
 
 	template<std::unsigned_integral T2>
-	UnsignedInteger(T2 value) requires GreaterOrEqualSize<T, T2> : m_value((T)value) {}
+	constexpr UnsignedInteger(T2 value) noexcept requires GreaterOrEqualSize<T, T2> : m_value((T)value) {}
 	
 	template<std::unsigned_integral T2>
-	explicit UnsignedInteger(T2 value) requires SmallerSize<T, T2> : m_value((T)value) {}
+	explicit constexpr UnsignedInteger(T2 value) noexcept requires SmallerSize<T, T2> : m_value((T)value) {}
 
 	template<std::signed_integral T2>
-	explicit UnsignedInteger(T2 value) : m_value((T)value) {}
+	explicit constexpr UnsignedInteger(T2 value) noexcept : m_value((T)value) {}
 
 	template<std::floating_point T2>
-	explicit UnsignedInteger(T2 value) : m_value((T)value) {}
+	explicit constexpr UnsignedInteger(T2 value) noexcept : m_value((T)value) {}
 
-	T ToRawValue() const { return m_value; }
+	constexpr T ToRawValue() const noexcept { return m_value; }
 
 	template<std::unsigned_integral T2>
-	operator UnsignedInteger<T2>() const requires SmallerOrEqualSize<T, T2> { return UnsignedInteger<T2>((T2)m_value); }
+	constexpr operator UnsignedInteger<T2>() const noexcept requires SmallerOrEqualSize<T, T2> { return UnsignedInteger<T2>((T2)m_value); }
 
 	template<std::signed_integral T2>
-	operator SignedInteger<T2>() const requires SmallerSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
+	constexpr operator SignedInteger<T2>() const noexcept requires SmallerSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
 
 	template<std::floating_point T2>
-	operator Float<T2>() const { return Float<T2>((T2)m_value); }
+	constexpr operator Float<T2>() const noexcept { return Float<T2>((T2)m_value); }
 
 	template<std::unsigned_integral T2>
-	explicit operator UnsignedInteger<T2>() const requires GreaterSize<T, T2> { return UnsignedInteger<T2>((T2)m_value); }
+	explicit constexpr operator UnsignedInteger<T2>() const noexcept requires GreaterSize<T, T2> { return UnsignedInteger<T2>((T2)m_value); }
 
 	template<std::signed_integral T2>
-	explicit operator SignedInteger<T2>() const requires GreaterOrEqualSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
+	explicit constexpr operator SignedInteger<T2>() const noexcept requires GreaterOrEqualSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
 
-	friend UnsignedInteger<T> operator+(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value + right.m_value; }
-	friend UnsignedInteger<T> operator-(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value - right.m_value; }
-	friend UnsignedInteger<T> operator*(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value * right.m_value; }
-	friend UnsignedInteger<T> operator/(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value / right.m_value; }
-	friend UnsignedInteger<T> operator%(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value % right.m_value; }
+	friend constexpr UnsignedInteger<T> operator+(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value + right.m_value; }
+	friend constexpr UnsignedInteger<T> operator-(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value - right.m_value; }
+	friend constexpr UnsignedInteger<T> operator*(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value * right.m_value; }
+	friend constexpr UnsignedInteger<T> operator/(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value / right.m_value; }
+	friend constexpr UnsignedInteger<T> operator%(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value % right.m_value; }
 
-	friend UnsignedInteger<T> operator&(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value & right.m_value; }
-	friend UnsignedInteger<T> operator|(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value | right.m_value; }
-	friend UnsignedInteger<T> operator^(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value ^ right.m_value; }
+	friend constexpr UnsignedInteger<T> operator&(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value & right.m_value; }
+	friend constexpr UnsignedInteger<T> operator|(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value | right.m_value; }
+	friend constexpr UnsignedInteger<T> operator^(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value ^ right.m_value; }
 
-	friend UnsignedInteger<T> operator<<(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value << right.m_value; }
-	friend UnsignedInteger<T> operator>>(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value >> right.m_value; }
+	friend constexpr UnsignedInteger<T> operator<<(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value << right.m_value; }
+	friend constexpr UnsignedInteger<T> operator>>(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value >> right.m_value; }
 
-	friend Boolean operator< (UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value <  right.m_value; }
-	friend Boolean operator> (UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value >  right.m_value; }
-	friend Boolean operator<=(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value <= right.m_value; }
-	friend Boolean operator>=(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value >= right.m_value; }
-	friend Boolean operator==(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value == right.m_value; }
-	friend Boolean operator!=(UnsignedInteger<T> left, UnsignedInteger<T> right) { return left.m_value != right.m_value; }
+	friend constexpr Boolean operator< (UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value <  right.m_value; }
+	friend constexpr Boolean operator> (UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value >  right.m_value; }
+	friend constexpr Boolean operator<=(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value <= right.m_value; }
+	friend constexpr Boolean operator>=(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value >= right.m_value; }
+	friend constexpr Boolean operator==(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value == right.m_value; }
+	friend constexpr Boolean operator!=(UnsignedInteger<T> left, UnsignedInteger<T> right) noexcept { return left.m_value != right.m_value; }
 
-	UnsignedInteger<T>& operator+=(UnsignedInteger<T> other) { m_value += other.m_value; return *this; }
-	UnsignedInteger<T>& operator-=(UnsignedInteger<T> other) { m_value -= other.m_value; return *this; }
-	UnsignedInteger<T>& operator*=(UnsignedInteger<T> other) { m_value *= other.m_value; return *this; }
-	UnsignedInteger<T>& operator/=(UnsignedInteger<T> other) { m_value /= other.m_value; return *this; }
-	UnsignedInteger<T>& operator%=(UnsignedInteger<T> other) { m_value %= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator+=(UnsignedInteger<T> other) noexcept { m_value += other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator-=(UnsignedInteger<T> other) noexcept { m_value -= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator*=(UnsignedInteger<T> other) noexcept { m_value *= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator/=(UnsignedInteger<T> other) noexcept { m_value /= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator%=(UnsignedInteger<T> other) noexcept { m_value %= other.m_value; return *this; }
 
-	UnsignedInteger<T>& operator&=(UnsignedInteger<T> other) { m_value &= other.m_value; return *this; }
-	UnsignedInteger<T>& operator|=(UnsignedInteger<T> other) { m_value |= other.m_value; return *this; }
-	UnsignedInteger<T>& operator^=(UnsignedInteger<T> other) { m_value ^= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator&=(UnsignedInteger<T> other) noexcept { m_value &= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator|=(UnsignedInteger<T> other) noexcept { m_value |= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator^=(UnsignedInteger<T> other) noexcept { m_value ^= other.m_value; return *this; }
 
-	UnsignedInteger<T>& operator<<=(UnsignedInteger<T> other) { m_value <<= other.m_value; return *this; }
-	UnsignedInteger<T>& operator>>=(UnsignedInteger<T> other) { m_value >>= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator<<=(UnsignedInteger<T> other) noexcept { m_value <<= other.m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator>>=(UnsignedInteger<T> other) noexcept { m_value >>= other.m_value; return *this; }
 
-	UnsignedInteger<T> operator~() const { return UnsignedInteger<T>(~m_value); }
+	constexpr UnsignedInteger<T> operator~() const noexcept { return UnsignedInteger<T>(~m_value); }
 
-	UnsignedInteger<T>& operator++() { ++m_value; return *this; }
-	UnsignedInteger<T>& operator--() { --m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator++() noexcept { ++m_value; return *this; }
+	constexpr UnsignedInteger<T>& operator--() noexcept { --m_value; return *this; }
 
-	UnsignedInteger<T> operator++(int) 
+	constexpr UnsignedInteger<T> operator++(int) noexcept
 	{ 
 		UnsignedInteger<T> result = *this;
 		++(*this);
 		return result;
 	}
 
-	UnsignedInteger<T> operator--(int)
+	constexpr UnsignedInteger<T> operator--(int) noexcept
 	{ 
 		UnsignedInteger<T> result = *this;
 		--(*this);
@@ -109,37 +219,65 @@ public:
 	UnsignedInteger<T> ToRadians() const requires GreaterSize<T, unsigned char>; //{ return UnsignedInteger<T>((*this) * (Float32::PI / 180)); }
 	UnsignedInteger<T> ToDegrees() const requires GreaterSize<T, unsigned char>; //{ return UnsignedInteger<T>((*this) * (180 / Float32::PI)); }
 
-	UnsignedInteger<T> Sqrt() const { return UnsignedInteger<T>(sqrtf(m_value)); }
+	// Exact, the square root rounded down.
+	constexpr UnsignedInteger<T> Sqrt() const noexcept { return ISqrt(); }
 
-	UnsignedInteger<T> Min(const UnsignedInteger<T>& other) const { return m_value < other.m_value ? *this : other; }
-	UnsignedInteger<T> Max(const UnsignedInteger<T>& other) const { return m_value > other.m_value ? *this : other; }
+	constexpr UnsignedInteger<T> Min(const UnsignedInteger<T>& other) const noexcept { return m_value < other.m_value ? *this : other; }
+	constexpr UnsignedInteger<T> Max(const UnsignedInteger<T>& other) const noexcept { return m_value > other.m_value ? *this : other; }
 
-	UnsignedInteger<T> Clamp(const UnsignedInteger<T>& min, const UnsignedInteger<T>& max) const { return min.Max(this->Min(max)); }
+	constexpr UnsignedInteger<T> Clamp(const UnsignedInteger<T>& min, const UnsignedInteger<T>& max) const noexcept { return min.Max(this->Min(max)); }
 
 	template<std::floating_point T2>
 	UnsignedInteger<T> Pow(Float<T2> power) const { return UnsignedInteger<T>(powf(m_value, power.ToRawValue())); }
 
+	constexpr UnsignedInteger<T> PopCount()      const noexcept { return UnsignedInteger<T>(T(std::popcount(m_value)));  }
+	constexpr UnsignedInteger<T> LeadingZeros()  const noexcept { return UnsignedInteger<T>(T(std::countl_zero(m_value))); }
+	constexpr UnsignedInteger<T> TrailingZeros() const noexcept { return UnsignedInteger<T>(T(std::countr_zero(m_value))); }
+
+	constexpr UnsignedInteger<T> RotateLeft (UnsignedInteger<T> count) const noexcept { return UnsignedInteger<T>(std::rotl(m_value, int(count.m_value % std::numeric_limits<T>::digits))); }
+	constexpr UnsignedInteger<T> RotateRight(UnsignedInteger<T> count) const noexcept { return UnsignedInteger<T>(std::rotr(m_value, int(count.m_value % std::numeric_limits<T>::digits))); }
+
+	constexpr UnsignedInteger<T> ByteSwap() const noexcept { return UnsignedInteger<T>(IntegerMath::ByteSwap(m_value)); }
+
+	// The logarithm rounded down; zero has none and gives Maximum.
+	constexpr UnsignedInteger<T> Log2() const noexcept { return UnsignedInteger<T>(T(std::bit_width(m_value) - 1)); }
+
+	constexpr Boolean IsPowerOfTwo() const noexcept { return std::has_single_bit(m_value); }
+
+	// The smallest power of two not below this, which is one for zero and zero when it does not fit.
+	constexpr UnsignedInteger<T> NextPowerOfTwo() const noexcept { return UnsignedInteger<T>(IntegerMath::NextPowerOfTwo(m_value)); }
+
+	constexpr UnsignedInteger<T> ISqrt() const noexcept { return UnsignedInteger<T>(IntegerMath::SquareRoot(m_value)); }
+
+	// Wraps around on overflow, like multiplication.
+	constexpr UnsignedInteger<T> IPow(UnsignedInteger<T> exponent) const noexcept { return UnsignedInteger<T>(IntegerMath::Power(m_value, uint64_t(exponent.m_value))); }
+
 	HashCode GetHashCode() const { return HashCode(size_t(m_value)); }
 
 	String ToString() const;
+
+	static Boolean TryParse(const String& string, UnsignedInteger<T>& result);
+	static UnsignedInteger<T> Parse(const String& string);
 };
 
 template<std::unsigned_integral T>
-const UnsignedInteger<T> UnsignedInteger<T>::Minimum(0);
+constexpr UnsignedInteger<T> UnsignedInteger<T>::Minimum(0);
 
 template<std::unsigned_integral T>
-const UnsignedInteger<T> UnsignedInteger<T>::Maximum((1ULL << (sizeof(T) * 8ULL)) - 1ULL);
+constexpr UnsignedInteger<T> UnsignedInteger<T>::Maximum(std::numeric_limits<T>::max());
 
 template<std::unsigned_integral T>
-const UnsignedInteger<T> UnsignedInteger<T>::Zero(0);
+constexpr UnsignedInteger<T> UnsignedInteger<T>::Zero(0);
 
 template<std::unsigned_integral T>
-const UnsignedInteger<T> UnsignedInteger<T>::One(1);
+constexpr UnsignedInteger<T> UnsignedInteger<T>::One(1);
 
 template<std::signed_integral T>
 class SignedInteger
 {
 private:
+	using Unsigned = std::make_unsigned_t<T>;
+
 	T m_value;
 public:
 	static const SignedInteger<T> Minimum;
@@ -148,96 +286,96 @@ public:
 	static const SignedInteger<T> Zero;
 	static const SignedInteger<T> One;
 
-	SignedInteger()                              : m_value(0)             {}
-	SignedInteger(const SignedInteger<T>& other) : m_value(other.m_value) {}
+	constexpr SignedInteger()                              noexcept : m_value(0) {}
+	constexpr SignedInteger(const SignedInteger<T>& other) noexcept = default;
 
 	template<std::signed_integral T2>
-	SignedInteger(T2 value) requires GreaterOrEqualSize<T, T2> : m_value((T)value) {}
+	constexpr SignedInteger(T2 value) noexcept requires GreaterOrEqualSize<T, T2> : m_value((T)value) {}
 
 	template<std::unsigned_integral T2>
-	SignedInteger(T2 value) requires GreaterSize<T, T2> : m_value((T)value) {}
+	constexpr SignedInteger(T2 value) noexcept requires GreaterSize<T, T2> : m_value((T)value) {}
 
 	template<std::signed_integral T2>
-	explicit SignedInteger(T2 value) requires SmallerSize<T, T2> : m_value((T)value) {}
+	explicit constexpr SignedInteger(T2 value) noexcept requires SmallerSize<T, T2> : m_value((T)value) {}
 
 	template<std::unsigned_integral T2>
-	explicit SignedInteger(T2 value) requires SmallerOrEqualSize<T, T2> : m_value((T)value) {}
+	explicit constexpr SignedInteger(T2 value) noexcept requires SmallerOrEqualSize<T, T2> : m_value((T)value) {}
 
 	template<std::floating_point T2>
-	explicit SignedInteger(T2 value) : m_value((T)value) {}
+	explicit constexpr SignedInteger(T2 value) noexcept : m_value((T)value) {}
 
-	T ToRawValue() const { return m_value; }
+	constexpr T ToRawValue() const noexcept { return m_value; }
 	
 	template<std::signed_integral T2>
-	operator SignedInteger<T2>() const requires SmallerOrEqualSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
+	constexpr operator SignedInteger<T2>() const noexcept requires SmallerOrEqualSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
 
 	template<std::floating_point T2>
-	operator Float<T2>() const { return Float<T2>((T2)m_value); }
+	constexpr operator Float<T2>() const noexcept { return Float<T2>((T2)m_value); }
 
 	template<std::signed_integral T2>
-	explicit operator SignedInteger<T2>() const requires GreaterSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
+	explicit constexpr operator SignedInteger<T2>() const noexcept requires GreaterSize<T, T2> { return SignedInteger<T2>((T2)m_value); }
 
 	template<std::unsigned_integral T2>
-	explicit operator UnsignedInteger<T2>() const { return UnsignedInteger<T2>((T2)m_value); }
+	explicit constexpr operator UnsignedInteger<T2>() const noexcept { return UnsignedInteger<T2>((T2)m_value); }
 
-	friend SignedInteger<T> operator+(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value + right.m_value; }
-	friend SignedInteger<T> operator-(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value - right.m_value; }
-	friend SignedInteger<T> operator*(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value * right.m_value; }
-	friend SignedInteger<T> operator/(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value / right.m_value; }
-	friend SignedInteger<T> operator%(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value % right.m_value; }
+	friend constexpr SignedInteger<T> operator+(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value + right.m_value; }
+	friend constexpr SignedInteger<T> operator-(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value - right.m_value; }
+	friend constexpr SignedInteger<T> operator*(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value * right.m_value; }
+	friend constexpr SignedInteger<T> operator/(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value / right.m_value; }
+	friend constexpr SignedInteger<T> operator%(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value % right.m_value; }
 
-	friend SignedInteger<T> operator&(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value & right.m_value; }
-	friend SignedInteger<T> operator|(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value | right.m_value; }
-	friend SignedInteger<T> operator^(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value ^ right.m_value; }
+	friend constexpr SignedInteger<T> operator&(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value & right.m_value; }
+	friend constexpr SignedInteger<T> operator|(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value | right.m_value; }
+	friend constexpr SignedInteger<T> operator^(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value ^ right.m_value; }
 
-	friend SignedInteger<T> operator<<(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value << right.m_value; }
-	friend SignedInteger<T> operator>>(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value >> right.m_value; }
+	friend constexpr SignedInteger<T> operator<<(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value << right.m_value; }
+	friend constexpr SignedInteger<T> operator>>(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value >> right.m_value; }
 
-	friend Boolean operator< (SignedInteger<T> left, SignedInteger<T> right) { return left.m_value <  right.m_value; }
-	friend Boolean operator> (SignedInteger<T> left, SignedInteger<T> right) { return left.m_value >  right.m_value; }
-	friend Boolean operator<=(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value <= right.m_value; }
-	friend Boolean operator>=(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value >= right.m_value; }
-	friend Boolean operator==(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value == right.m_value; }
-	friend Boolean operator!=(SignedInteger<T> left, SignedInteger<T> right) { return left.m_value != right.m_value; }
+	friend constexpr Boolean operator< (SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value <  right.m_value; }
+	friend constexpr Boolean operator> (SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value >  right.m_value; }
+	friend constexpr Boolean operator<=(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value <= right.m_value; }
+	friend constexpr Boolean operator>=(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value >= right.m_value; }
+	friend constexpr Boolean operator==(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value == right.m_value; }
+	friend constexpr Boolean operator!=(SignedInteger<T> left, SignedInteger<T> right) noexcept { return left.m_value != right.m_value; }
 
 
-	SignedInteger<T>& operator+=(SignedInteger<T> other) { m_value += other.m_value; return *this; }
-	SignedInteger<T>& operator-=(SignedInteger<T> other) { m_value -= other.m_value; return *this; }
-	SignedInteger<T>& operator*=(SignedInteger<T> other) { m_value *= other.m_value; return *this; }
-	SignedInteger<T>& operator/=(SignedInteger<T> other) { m_value /= other.m_value; return *this; }
-	SignedInteger<T>& operator%=(SignedInteger<T> other) { m_value %= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator+=(SignedInteger<T> other) noexcept { m_value += other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator-=(SignedInteger<T> other) noexcept { m_value -= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator*=(SignedInteger<T> other) noexcept { m_value *= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator/=(SignedInteger<T> other) noexcept { m_value /= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator%=(SignedInteger<T> other) noexcept { m_value %= other.m_value; return *this; }
 
-	SignedInteger<T>& operator&=(SignedInteger<T> other) { m_value &= other.m_value; return *this; }
-	SignedInteger<T>& operator|=(SignedInteger<T> other) { m_value |= other.m_value; return *this; }
-	SignedInteger<T>& operator^=(SignedInteger<T> other) { m_value ^= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator&=(SignedInteger<T> other) noexcept { m_value &= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator|=(SignedInteger<T> other) noexcept { m_value |= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator^=(SignedInteger<T> other) noexcept { m_value ^= other.m_value; return *this; }
 
-	SignedInteger<T>& operator<<=(SignedInteger<T> other) { m_value <<= other.m_value; return *this; }
-	SignedInteger<T>& operator>>=(SignedInteger<T> other) { m_value >>= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator<<=(SignedInteger<T> other) noexcept { m_value <<= other.m_value; return *this; }
+	constexpr SignedInteger<T>& operator>>=(SignedInteger<T> other) noexcept { m_value >>= other.m_value; return *this; }
 
 
-	SignedInteger<T> operator+() const { return SignedInteger<T>(+m_value); }
-	SignedInteger<T> operator-() const { return SignedInteger<T>(-m_value); }
+	constexpr SignedInteger<T> operator+() const noexcept { return SignedInteger<T>(+m_value); }
+	constexpr SignedInteger<T> operator-() const noexcept { return SignedInteger<T>(-m_value); }
 
-	SignedInteger<T> operator~() const { return SignedInteger<T>(~m_value); }
+	constexpr SignedInteger<T> operator~() const noexcept { return SignedInteger<T>(~m_value); }
 
-	SignedInteger<T>& operator++() { ++m_value; return *this; }
-	SignedInteger<T>& operator--() { --m_value; return *this; }
+	constexpr SignedInteger<T>& operator++() noexcept { ++m_value; return *this; }
+	constexpr SignedInteger<T>& operator--() noexcept { --m_value; return *this; }
 
-	SignedInteger<T> operator++(int)
+	constexpr SignedInteger<T> operator++(int) noexcept
 	{
 		SignedInteger<T> result = *this;
 		++(*this);
 		return result;
 	}
 
-	SignedInteger<T> operator--(int)
+	constexpr SignedInteger<T> operator--(int) noexcept
 	{
 		SignedInteger<T> result = *this;
 		--(*this);
 		return result;
 	}
 
-	SignedInteger<T> Abs() const
+	constexpr SignedInteger<T> Abs() const noexcept
 	{
 		if(m_value < 0)
 			return SignedInteger<T>(-m_value);
@@ -248,32 +386,71 @@ public:
 	SignedInteger<T> ToRadians() const requires GreaterSize<T, char>; //{ return SignedInteger<T>((*this) * (Float32::PI / 180)); }
 	SignedInteger<T> ToDegrees() const requires GreaterSize<T, char>; //{ return SignedInteger<T>((*this) * (180 / Float32::PI)); }
 
-	SignedInteger<T> Sqrt() const { return SignedInteger<T>(sqrtf(m_value)); }
+	// Exact, the square root rounded down; negative values give zero.
+	constexpr SignedInteger<T> Sqrt() const noexcept { return ISqrt(); }
 
-	SignedInteger<T> Min(const SignedInteger<T>& other) const { return m_value < other.m_value ? *this : other; }
-	SignedInteger<T> Max(const SignedInteger<T>& other) const { return m_value > other.m_value ? *this : other; }
+	constexpr SignedInteger<T> Min(const SignedInteger<T>& other) const noexcept { return m_value < other.m_value ? *this : other; }
+	constexpr SignedInteger<T> Max(const SignedInteger<T>& other) const noexcept { return m_value > other.m_value ? *this : other; }
 
-	SignedInteger<T> Clamp(const SignedInteger<T>& min, const SignedInteger<T>& max) const { return min.Max(this->Min(max)); }
+	constexpr SignedInteger<T> Clamp(const SignedInteger<T>& min, const SignedInteger<T>& max) const noexcept { return min.Max(this->Min(max)); }
 
 	template<std::floating_point T2>
 	SignedInteger<T> Pow(Float<T2> power) const { return SignedInteger<T>(powf(m_value, power.ToRawValue())); }
 
+	// The bit operations work on the two's complement bits.
+	constexpr SignedInteger<T> PopCount()      const noexcept { return SignedInteger<T>(T(std::popcount(Unsigned(m_value))));  }
+	constexpr SignedInteger<T> LeadingZeros()  const noexcept { return SignedInteger<T>(T(std::countl_zero(Unsigned(m_value)))); }
+	constexpr SignedInteger<T> TrailingZeros() const noexcept { return SignedInteger<T>(T(std::countr_zero(Unsigned(m_value)))); }
+
+	// Negative counts rotate the other way.
+	constexpr SignedInteger<T> RotateLeft (SignedInteger<T> count) const noexcept { return SignedInteger<T>(T(std::rotl(Unsigned(m_value), int(count.m_value % std::numeric_limits<Unsigned>::digits)))); }
+	constexpr SignedInteger<T> RotateRight(SignedInteger<T> count) const noexcept { return SignedInteger<T>(T(std::rotr(Unsigned(m_value), int(count.m_value % std::numeric_limits<Unsigned>::digits)))); }
+
+	constexpr SignedInteger<T> ByteSwap() const noexcept { return SignedInteger<T>(T(IntegerMath::ByteSwap(Unsigned(m_value)))); }
+
+	// The logarithm rounded down; zero and negative values have none and give -1.
+	constexpr SignedInteger<T> Log2() const noexcept { return SignedInteger<T>(m_value > 0 ? T(std::bit_width(Unsigned(m_value)) - 1) : T(-1)); }
+
+	constexpr Boolean IsPowerOfTwo() const noexcept { return m_value > 0 && std::has_single_bit(Unsigned(m_value)); }
+
+	// The smallest power of two not below this, which is one for zero and negative values and zero when it does not fit.
+	constexpr SignedInteger<T> NextPowerOfTwo() const noexcept
+	{
+		Unsigned power = IntegerMath::NextPowerOfTwo(m_value > 0 ? Unsigned(m_value) : Unsigned(0U));
+		return SignedInteger<T>(power > Unsigned(std::numeric_limits<T>::max()) ? T(0) : T(power));
+	}
+
+	constexpr SignedInteger<T> ISqrt() const noexcept { return SignedInteger<T>(m_value > 0 ? T(IntegerMath::SquareRoot(Unsigned(m_value))) : T(0)); }
+
+	// Wraps around on overflow, like multiplication. A negative exponent gives the reciprocal rounded toward zero, which
+	// is zero unless this is one or minus one.
+	constexpr SignedInteger<T> IPow(SignedInteger<T> exponent) const noexcept
+	{
+		if(exponent.m_value < 0)
+			return SignedInteger<T>(m_value == 1 || m_value == -1 ? T(IntegerMath::Power(Unsigned(m_value), uint64_t(exponent.m_value) & 1U)) : T(0));
+
+		return SignedInteger<T>(T(IntegerMath::Power(Unsigned(m_value), uint64_t(exponent.m_value))));
+	}
+
 	HashCode GetHashCode() const { return HashCode(size_t(m_value)); }
 
 	String ToString() const;
+
+	static Boolean TryParse(const String& string, SignedInteger<T>& result);
+	static SignedInteger<T> Parse(const String& string);
 };
 
 template<std::signed_integral T>
-const SignedInteger<T> SignedInteger<T>::Minimum(1LL << (sizeof(T) * 8ULL - 1LL));
+constexpr SignedInteger<T> SignedInteger<T>::Minimum(std::numeric_limits<T>::min());
 
 template<std::signed_integral T>
-const SignedInteger<T> SignedInteger<T>::Maximum((1LL << (sizeof(T) * 8ULL - 1LL)) - 1LL);
+constexpr SignedInteger<T> SignedInteger<T>::Maximum(std::numeric_limits<T>::max());
 
 template<std::signed_integral T>
-const SignedInteger<T> SignedInteger<T>::Zero(0);
+constexpr SignedInteger<T> SignedInteger<T>::Zero(0);
 
 template<std::signed_integral T>
-const SignedInteger<T> SignedInteger<T>::One(1);
+constexpr SignedInteger<T> SignedInteger<T>::One(1);
 
 template<std::floating_point T>
 class Float
@@ -294,86 +471,94 @@ public:
 
 	static const Float<T> PI;
 
-	Float()                      : m_value(0)             {}
-	Float(const Float<T>& other) : m_value(other.m_value) {}
+	constexpr Float() noexcept                      : m_value(0)             {}
+	constexpr Float(const Float<T>& other) noexcept = default;
 
 	template<std::floating_point T2>
-	Float(T2 value) requires GreaterOrEqualSize<T, T2> : m_value(value) {}
+	constexpr Float(T2 value) noexcept requires GreaterOrEqualSize<T, T2> : m_value(value) {}
 
 	template<std::integral T2>
-	Float(T2 value) : m_value(value) {}
+	constexpr Float(T2 value) noexcept : m_value(value) {}
 
 	template<std::floating_point T2>
-	explicit Float(T2 value) requires SmallerSize<T, T2> : m_value(value) {}
+	explicit constexpr Float(T2 value) noexcept requires SmallerSize<T, T2> : m_value(value) {}
 
-	T ToRawValue() const { return m_value; }
+	constexpr T ToRawValue() const noexcept { return m_value; }
 
 	template<std::floating_point T2>
-	operator Float<T2>() const requires SmallerOrEqualSize<T, T2> { return Float<T2>((T2)m_value); }
+	constexpr operator Float<T2>() const noexcept requires SmallerOrEqualSize<T, T2> { return Float<T2>((T2)m_value); }
 
 	template<std::floating_point T2>
-	explicit operator Float<T2>() const requires GreaterSize<T, T2> { return Float<T2>((T2)m_value); }
+	explicit constexpr operator Float<T2>() const noexcept requires GreaterSize<T, T2> { return Float<T2>((T2)m_value); }
 
 	template<std::unsigned_integral T2>
-	explicit operator UnsignedInteger<T2>() const { return UnsignedInteger<T2>((T2)m_value); }
+	explicit constexpr operator UnsignedInteger<T2>() const noexcept { return UnsignedInteger<T2>((T2)m_value); }
 
 	template<std::signed_integral T2>
-	explicit operator SignedInteger<T2>() const { return SignedInteger<T2>((T2)m_value); }
+	explicit constexpr operator SignedInteger<T2>() const noexcept { return SignedInteger<T2>((T2)m_value); }
+
+	constexpr Boolean IsInfinity()         const noexcept { return IsPositiveInfinity() || IsNegativeInfinity();          }
+	constexpr Boolean IsPositiveInfinity() const noexcept { return m_value ==  std::numeric_limits<T>::infinity(); }
+	constexpr Boolean IsNegativeInfinity() const noexcept { return m_value == -std::numeric_limits<T>::infinity(); }
+
+	// NaN is the only value not equal to itself, but fast floating point modes may assume otherwise at run time.
+	constexpr Boolean IsNaN() const noexcept
+	{
+		if(std::is_constant_evaluated())
+			return m_value != m_value;
 
-	Boolean IsInfinity()         const { return isinf(m_value);                }
-	Boolean IsPositiveInfinity() const { return isinf(m_value) && m_value > 0; }
-	Boolean IsNegativeInfinity() const { return isinf(m_value) && m_value < 0; }
-	Boolean IsNaN()              const { return isnan(m_value);                }
+		return isnan(m_value);
+	}
 
-	friend Float<T> operator+(Float<T> left, Float<T> right) { return left.m_value + right.m_value; }
-	friend Float<T> operator-(Float<T> left, Float<T> right) { return left.m_value - right.m_value; }
-	friend Float<T> operator*(Float<T> left, Float<T> right) { return left.m_value * right.m_value; }
-	friend Float<T> operator/(Float<T> left, Float<T> right) { return left.m_value / right.m_value; }
+	friend constexpr Float<T> operator+(Float<T> left, Float<T> right) noexcept { return left.m_value + right.m_value; }
+	friend constexpr Float<T> operator-(Float<T> left, Float<T> right) noexcept { return left.m_value - right.m_value; }
+	friend constexpr Float<T> operator*(Float<T> left, Float<T> right) noexcept { return left.m_value * right.m_value; }
+	friend constexpr Float<T> operator/(Float<T> left, Float<T> right) noexcept { return left.m_value / right.m_value; }
 
 	friend Float<T> operator%(Float<T> left, Float<T> right);
 
-	friend Boolean operator< (Float<T> left, Float<T> right) { return left.m_value <  right.m_value; }
-	friend Boolean operator> (Float<T> left, Float<T> right) { return left.m_value >  right.m_value; }
-	friend Boolean operator<=(Float<T> left, Float<T> right) { return left.m_value <= right.m_value; }
-	friend Boolean operator>=(Float<T> left, Float<T> right) { return left.m_value >= right.m_value; }
-	friend Boolean operator==(Float<T> left, Float<T> right) { return left.m_value == right.m_value; }
-	friend Boolean operator!=(Float<T> left, Float<T> right) { return left.m_value != right.m_value; }
-
-	Float<T>& operator+=(Float<T> other) { m_value += other.m_value; return *this; }
-	Float<T>& operator-=(Float<T> other) { m_value -= other.m_value; return *this; }
-	Float<T>& operator*=(Float<T> other) { m_value *= other.m_value; return *this; }
-	Float<T>& operator/=(Float<T> other) { m_value /= other.m_value; return *this; }
+	friend constexpr Boolean operator< (Float<T> left, Float<T> right) noexcept { return left.m_value <  right.m_value; }
+	friend constexpr Boolean operator> (Float<T> left, Float<T> right) noexcept { return left.m_value >  right.m_value; }
+	friend constexpr Boolean operator<=(Float<T> left, Float<T> right) noexcept { return left.m_value <= right.m_value; }
+	friend constexpr Boolean operator>=(Float<T> left, Float<T> right) noexcept { return left.m_value >= right.m_value; }
+	friend constexpr Boolean operator==(Float<T> left, Float<T> right) noexcept { return left.m_value == right.m_value; }
+	friend constexpr Boolean operator!=(Float<T> left, Float<T> right) noexcept { return left.m_value != right.m_value; }
+
+	constexpr Float<T>& operator+=(Float<T> other) noexcept { m_value += other.m_value; return *this; }
+	constexpr Float<T>& operator-=(Float<T> other) noexcept { m_value -= other.m_value; return *this; }
+	constexpr Float<T>& operator*=(Float<T> other) noexcept { m_value *= other.m_value; return *this; }
+	constexpr Float<T>& operator/=(Float<T> other) noexcept { m_value /= other.m_value; return *this; }
 	Float<T>& operator%=(Float<T> other) { m_value %= other.m_value; return *this; }
 
-	Float<T> operator+() const { return SignedInteger<T>(+m_value); }
-	Float<T> operator-() const { return SignedInteger<T>(-m_value); }
+	constexpr Float<T> operator+() const noexcept { return Float<T>(+m_value); }
+	constexpr Float<T> operator-() const noexcept { return Float<T>(-m_value); }
 
-	Float<T>& operator++() { ++m_value; return *this; }
-	Float<T>& operator--() { --m_value; return *this; }
+	constexpr Float<T>& operator++() noexcept { ++m_value; return *this; }
+	constexpr Float<T>& operator--() noexcept { --m_value; return *this; }
 
-	Float<T> operator++(int)
+	constexpr Float<T> operator++(int) noexcept
 	{
 		Float<T> result = *this;
 		++(*this);
 		return result;
 	}
 
-	Float<T> operator--(int)
+	constexpr Float<T> operator--(int) noexcept
 	{
 		Float<T> result = *this;
 		--(*this);
 		return result;
 	}
 
-	Float<T> Min(const Float<T>& other) const { return m_value < other.m_value ? *this : other; }
-	Float<T> Max(const Float<T>& other) const { return m_value > other.m_value ? *this : other; }
+	constexpr Float<T> Min(const Float<T>& other) const noexcept { return m_value < other.m_value ? *this : other; }
+	constexpr Float<T> Max(const Float<T>& other) const noexcept { return m_value > other.m_value ? *this : other; }
 
-	Float<T> Clamp(const Float<T>& min, const Float<T>& max) const { return min.Max(this->Min(max)); }
+	constexpr Float<T> Clamp(const Float<T>& min, const Float<T>& max) const noexcept { return min.Max(this->Min(max)); }
 
-	Float<T> Abs() const
+	constexpr Float<T> Abs() const noexcept
 	{
 		if(m_value < 0)
-			return SignedInteger<T>(-m_value);
+			return Float<T>(-m_value);
 
 		return m_value;
 	}
@@ -381,8 +566,8 @@ public:
 	Float<T> Sqrt() const;
 	Float<T> Pow(Float<T> power) const;
 
-	Float<T> ToRadians() const { return m_value * (PI / 180); }
-	Float<T> ToDegrees() const { return m_value * (180 / PI); }
+	constexpr Float<T> ToRadians() const noexcept { return m_value * (PI / 180); }
+	constexpr Float<T> ToDegrees() const noexcept { return m_value * (180 / PI); }
 	
 	Float<T> Floor();
 	Float<T> Ceiling();
@@ -415,50 +600,52 @@ public:
 	}
 
 	String ToString() const;
+
+	static Boolean TryParse(const String& string, Float<T>& result);
+	static Float<T> Parse(const String& string);
 };
 
-template<>
-const Float<float> Float<float>::Minimum(-FLT_MAX);
+template<std::floating_point T>
+constexpr Float<T> Float<T>::NaN(std::numeric_limits<T>::signaling_NaN());
 
-template<>
-const Float<float> Float<float>::Maximum(+FLT_MAX);
+template<std::floating_point T>
+constexpr Float<T> Float<T>::PositiveInfinity(+std::numeric_limits<T>::infinity());
 
-template<>
-const Float<float> Float<float>::Zero(0.0f);
+template<std::floating_point T>
+constexpr Float<T> Float<T>::NegativeInfinity(-std::numeric_limits<T>::infinity());
 
-template<>
-const Float<float> Float<float>::One(1.0f);
+template<std::floating_point T>
+constexpr Float<T> Float<T>::PI((T)3.1415926535897932384626433832795);
 
 template<>
-const Float<float> Float<float>::Epsilon(+FLT_MIN);
+constexpr Float<float> Float<float>::Minimum(-FLT_MAX);
 
 template<>
-const Float<double> Float<double>::Minimum(-DBL_MAX);
+constexpr Float<float> Float<float>::Maximum(+FLT_MAX);
 
 template<>
-const Float<double> Float<double>::Maximum(+DBL_MAX);
+constexpr Float<float> Float<float>::Zero(0.0f);
 
 template<>
-const Float<double> Float<double>::Epsilon(+DBL_MIN);
+constexpr Float<float> Float<float>::One(1.0f);
 
 template<>
-const Float<double> Float<double>::Zero(0.0);
+constexpr Float<float> Float<float>::Epsilon(+FLT_MIN);
 
 template<>
-const Float<double> Float<double>::One(1.0);
+constexpr Float<double> Float<double>::Minimum(-DBL_MAX);
 
+template<>
+constexpr Float<double> Float<double>::Maximum(+DBL_MAX);
 
-template<std::floating_point T>
-const Float<T> Float<T>::NaN(std::numeric_limits<T>::signaling_NaN());
-
-template<std::floating_point T>
-const Float<T> Float<T>::PositiveInfinity(+std::numeric_limits<T>::infinity());
+template<>
+constexpr Float<double> Float<double>::Epsilon(+DBL_MIN);
 
-template<std::floating_point T>
-const Float<T> Float<T>::NegativeInfinity(-std::numeric_limits<T>::infinity());
+template<>
+constexpr Float<double> Float<double>::Zero(0.0);
 
-template<std::floating_point T>
-const Float<T> Float<T>::PI((T)3.1415926535897932384626433832795);
+template<>
+constexpr Float<double> Float<double>::One(1.0);
 
 using UInt8  = UnsignedInteger<uint8_t>;
 using UInt16 = UnsignedInteger<uint16_t>;
@@ -487,6 +674,227 @@ SignedInteger<T> SignedInteger<T>::ToRadians() const requires GreaterSize<T, cha
 template<std::signed_integral T>
 SignedInteger<T> SignedInteger<T>::ToDegrees() const requires GreaterSize<T, char> { return SignedInteger<T>((*this) * (180 / Float32::PI)); }
 
+// A floating point number in 16 bits: a sign, ExponentBits bits of exponent and the rest mantissa. Float16 is IEEE
+// half precision and BFloat16 is the upper half of a Float32, with its range but only 8 bits of precision. They are
+// for storing many values in half the memory, such as vertex attributes, colors and feature arrays; Math::Convert
+// converts whole spans.
+//
+// Arithmetic is done in Float32 and rounded back to nearest, ties to even. Float32 has more than twice the precision,
+// so this gives the correctly rounded result of +, -, *, / and Sqrt, the same as native half precision hardware.
+template<size_t ExponentBits>
+class HalfFloat
+{
+private:
+	static_assert(ExponentBits == 5U || ExponentBits == 8U, "HalfFloat is IEEE half precision or bfloat16.");
+
+	static constexpr size_t   MantissaBits = 15U - ExponentBits;
+	static constexpr int      Bias         = (1 << (ExponentBits - 1U)) - 1;
+	static constexpr uint16_t SignMask     = 0x8000U;
+	static constexpr uint16_t ExponentMask = uint16_t(((1U << ExponentBits) - 1U) << MantissaBits);
+	static constexpr uint16_t MantissaMask = uint16_t((1U << MantissaBits) - 1U);
+
+	// Enough significant digits to tell every value apart.
+	static constexpr size_t MaximumDigits = MantissaBits * 3U / 10U + 2U;
+
+	uint16_t m_bits;
+
+	template<std::floating_point T>
+	static constexpr uint16_t Encode(T value) noexcept
+	{
+		using Bits = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+
+		constexpr size_t SourceBits     = sizeof(T) * 8U;
+		constexpr size_t SourceMantissa = size_t(std::numeric_limits<T>::digits) - 1U;
+		constexpr int    SourceBias     = std::numeric_limits<T>::max_exponent - 1;
+
+		Bits     bits     = std::bit_cast<Bits>(value);
+		uint16_t sign     = uint16_t(bits >> (SourceBits - 16U)) & SignMask;
+		Bits     absolute = bits & ~(Bits(1) << (SourceBits - 1U));
+		int      exponent = int(absolute >> SourceMantissa);
+
+		// NaN keeps the top of its payload and is made quiet, which also keeps an empty payload from reading as infinity.
+		if(absolute > Bits(2 * SourceBias + 1) << SourceMantissa)
+			return uint16_t(sign | ExponentMask | (1U << (MantissaBits - 1U)) | (uint16_t(absolute >> (SourceMantissa - MantissaBits)) & MantissaMask));
+
+		if(exponent > SourceBias + Bias)
+			return uint16_t(sign | ExponentMask);
+
+		// Round to nearest, ties to even. A carry out of the mantissa goes into the exponent, up to infinity.
+		if(exponent > SourceBias - Bias)
+		{
+			constexpr size_t Shift = SourceMantissa - MantissaBits;
+
+			Bits rebased = absolute - (Bits(SourceBias - Bias) << SourceMantissa);
+			return uint16_t(sign | ((rebased + (Bits(1) << (Shift - 1U)) - 1U + ((rebased >> Shift) & 1U)) >> Shift));
+		}
+
+		// Subnormal in 16 bits: the mantissa with its implicit bit, in units of the smallest subnormal.
+		Bits   mantissa = (absolute & ((Bits(1) << SourceMantissa) - 1U)) | (exponent != 0 ? Bits(1) << SourceMantissa : Bits(0));
+		size_t shift    = size_t(SourceBias + int(SourceMantissa) + 1 - Bias - int(MantissaBits) - (exponent != 0 ? exponent : 1));
+		if(shift > SourceMantissa + 1U)
+			return sign;
+
+		Bits half     = Bits(1) << (shift - 1U);
+		Bits rest     = mantissa & ((half << 1U) - 1U);
+		Bits quotient = mantissa >> shift;
+		if(rest > half || (rest == half && (quotient & 1U) != 0U))
+			quotient++;
+
+		return uint16_t(sign | quotient);
+	}
+
+	// Every value is exact in Float32.
+	static constexpr float Decode(uint16_t bits) noexcept
+	{
+		if constexpr(ExponentBits == 8U)
+			return std::bit_cast<float>(uint32_t(bits) << 16U);
+		else
+		{
+			uint32_t sign     = uint32_t(bits & SignMask) << 16U;
+			uint32_t exponent = uint32_t(bits & ExponentMask) >> MantissaBits;
+			uint32_t mantissa = uint32_t(bits & MantissaMask);
+
+			// NaNs come out quiet, as they do from the hardware conversion.
+			if(exponent == (1U << ExponentBits) - 1U)
+				return std::bit_cast<float>(sign | 0x7F800000U | (mantissa != 0U ? 0x00400000U : 0U) | (mantissa << (23U - MantissaBits)));
+			if(exponent != 0U)
+				return std::bit_cast<float>(sign | ((exponent + uint32_t(127 - Bias)) << 23U) | (mantissa << (23U - MantissaBits)));
+
+			float magnitude = float(mantissa) / float(uint64_t(1) << (Bias + MantissaBits - 1U));
+			return sign != 0U ? -magnitude : magnitude;
+		}
+	}
+public:
+	static const HalfFloat<ExponentBits> Minimum;
+	static const HalfFloat<ExponentBits> Maximum;
+
+	static const HalfFloat<ExponentBits> Zero;
+	static const HalfFloat<ExponentBits> One;
+
+	static const HalfFloat<ExponentBits> Epsilon;
+	static const HalfFloat<ExponentBits> PositiveInfinity;
+	static const HalfFloat<ExponentBits> NegativeInfinity;
+	static const HalfFloat<ExponentBits> NaN;
+
+	static const HalfFloat<ExponentBits> PI;
+
+	constexpr HalfFloat() noexcept                                    : m_bits(0U) {}
+	constexpr HalfFloat(const HalfFloat<ExponentBits>& other) noexcept = default;
+
+	template<std::integral T>
+	constexpr HalfFloat(T value) noexcept : m_bits(Encode(double(value))) {}
+
+	template<std::floating_point T>
+	explicit constexpr HalfFloat(T value) noexcept : m_bits(Encode(value)) {}
+
+	template<std::floating_point T>
+	explicit constexpr HalfFloat(Float<T> value) noexcept : m_bits(Encode(value.ToRawValue())) {}
+
+	static constexpr HalfFloat<ExponentBits> FromRawValue(uint16_t bits) noexcept
+	{
+		HalfFloat<ExponentBits> result;
+		result.m_bits = bits;
+		return result;
+	}
+
+	constexpr uint16_t ToRawValue() const noexcept { return m_bits; }
+
+	template<std::floating_point T>
+	constexpr operator Float<T>() const noexcept { return Float<T>(T(Decode(m_bits))); }
+
+	constexpr Boolean IsInfinity()         const noexcept { return (m_bits & ~SignMask) == ExponentMask; }
+	constexpr Boolean IsPositiveInfinity() const noexcept { return m_bits == ExponentMask; }
+	constexpr Boolean IsNegativeInfinity() const noexcept { return m_bits == (SignMask | ExponentMask); }
+	constexpr Boolean IsNaN()              const noexcept { return (m_bits & ~SignMask) > ExponentMask; }
+
+	friend constexpr HalfFloat<ExponentBits> operator+(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return HalfFloat<ExponentBits>(Decode(left.m_bits) + Decode(right.m_bits)); }
+	friend constexpr HalfFloat<ExponentBits> operator-(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return HalfFloat<ExponentBits>(Decode(left.m_bits) - Decode(right.m_bits)); }
+	friend constexpr HalfFloat<ExponentBits> operator*(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return HalfFloat<ExponentBits>(Decode(left.m_bits) * Decode(right.m_bits)); }
+	friend constexpr HalfFloat<ExponentBits> operator/(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return HalfFloat<ExponentBits>(Decode(left.m_bits) / Decode(right.m_bits)); }
+
+	friend HalfFloat<ExponentBits> operator%(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) { return HalfFloat<ExponentBits>(Float<float>(left) % Float<float>(right)); }
+
+	friend constexpr Boolean operator< (HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return Decode(left.m_bits) <  Decode(right.m_bits); }
+	friend constexpr Boolean operator> (HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return Decode(left.m_bits) >  Decode(right.m_bits); }
+	friend constexpr Boolean operator<=(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return Decode(left.m_bits) <= Decode(right.m_bits); }
+	friend constexpr Boolean operator>=(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return Decode(left.m_bits) >= Decode(right.m_bits); }
+	friend constexpr Boolean operator==(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return Decode(left.m_bits) == Decode(right.m_bits); }
+	friend constexpr Boolean operator!=(HalfFloat<ExponentBits> left, HalfFloat<ExponentBits> right) noexcept { return Decode(left.m_bits) != Decode(right.m_bits); }
+
+	constexpr HalfFloat<ExponentBits>& operator+=(HalfFloat<ExponentBits> other) noexcept { return *this = *this + other; }
+	constexpr HalfFloat<ExponentBits>& operator-=(HalfFloat<ExponentBits> other) noexcept { return *this = *this - other; }
+	constexpr HalfFloat<ExponentBits>& operator*=(HalfFloat<ExponentBits> other) noexcept { return *this = *this * other; }
+	constexpr HalfFloat<ExponentBits>& operator/=(HalfFloat<ExponentBits> other) noexcept { return *this = *this / other; }
+	HalfFloat<ExponentBits>& operator%=(HalfFloat<ExponentBits> other) { return *this = *this % other; }
+
+	constexpr HalfFloat<ExponentBits> operator+() const noexcept { return *this; }
+	constexpr HalfFloat<ExponentBits> operator-() const noexcept { return FromRawValue(uint16_t(m_bits ^ SignMask)); }
+
+	constexpr HalfFloat<ExponentBits>& operator++() noexcept { return *this += One; }
+	constexpr HalfFloat<ExponentBits>& operator--() noexcept { return *this -= One; }
+
+	constexpr HalfFloat<ExponentBits> operator++(int) noexcept
+	{
+		HalfFloat<ExponentBits> result = *this;
+		++(*this);
+		return result;
+	}
+
+	constexpr HalfFloat<ExponentBits> operator--(int) noexcept
+	{
+		HalfFloat<ExponentBits> result = *this;
+		--(*this);
+		return result;
+	}
+
+	constexpr HalfFloat<ExponentBits> Min(const HalfFloat<ExponentBits>& other) const noexcept { return *this < other ? *this : other; }
+	constexpr HalfFloat<ExponentBits> Max(const HalfFloat<ExponentBits>& other) const noexcept { return *this > other ? *this : other; }
+
+	constexpr HalfFloat<ExponentBits> Clamp(const HalfFloat<ExponentBits>& min, const HalfFloat<ExponentBits>& max) const noexcept { return min.Max(this->Min(max)); }
+
+	constexpr HalfFloat<ExponentBits> Abs() const noexcept { return FromRawValue(uint16_t(m_bits & ~SignMask)); }
+
+	HalfFloat<ExponentBits> Sqrt() const { return HalfFloat<ExponentBits>(Float<float>(*this).Sqrt()); }
+
+	HashCode GetHashCode() const { return HashCode(size_t(m_bits)); }
+
+	String ToString() const;
+
+	static Boolean TryParse(const String& string, HalfFloat<ExponentBits>& result);
+	static HalfFloat<ExponentBits> Parse(const String& string);
+};
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::Minimum = HalfFloat<ExponentBits>::FromRawValue(uint16_t(SignMask | (ExponentMask - (1U << MantissaBits)) | MantissaMask));
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::Maximum = HalfFloat<ExponentBits>::FromRawValue(uint16_t((ExponentMask - (1U << MantissaBits)) | MantissaMask));
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::Zero = HalfFloat<ExponentBits>::FromRawValue(0U);
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::One(1.0f);
+
+// The smallest positive normal value, as for Float.
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::Epsilon = HalfFloat<ExponentBits>::FromRawValue(uint16_t(1U << MantissaBits));
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::PositiveInfinity = HalfFloat<ExponentBits>::FromRawValue(ExponentMask);
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::NegativeInfinity = HalfFloat<ExponentBits>::FromRawValue(uint16_t(SignMask | ExponentMask));
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::NaN = HalfFloat<ExponentBits>::FromRawValue(uint16_t(ExponentMask | (1U << (MantissaBits - 1U))));
+
+template<size_t ExponentBits>
+constexpr HalfFloat<ExponentBits> HalfFloat<ExponentBits>::PI(3.1415926535897932384626433832795);
+
+using Float16  = HalfFloat<5U>;
+using BFloat16 = HalfFloat<8U>;
+
 
 
 //class UInt8
@@ -95,7 +95,7 @@ public:
 	ColorF operator+(Float32 other) { return ColorF(m_alpha + other, m_red + other, m_green + other, m_blue + other); }
 	ColorF operator*(Float32 other) { return ColorF(m_alpha * other, m_red * other, m_green * other, m_blue * other); }
 
-	String ToString() const { return "Color(" + m_alpha + ", " + m_red + ", " + m_green + ", " + m_blue + ")"; }
+	String ToString() const { return Format("Color({}, {}, {}, {})", m_alpha, m_red, m_green, m_blue); }
 };
 
 class Color
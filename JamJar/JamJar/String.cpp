@@ -1,27 +1,37 @@
 #include "String.hpp"
+#include "StringSearch.hpp"
+#include "Encoding.hpp"
 
 //#include "Data/Collections/Lists/ArrayList.hpp"
 #include "Data/Memory/Refs.hpp"
 
-String Boolean::ToString() const { return m_value ? "True" : "False"; }
+#include <atomic>
+
+// Strings sharing an array may hash it on several threads at once. They all store the same value, so relaxed accesses
+// are enough to keep the slot free of torn reads.
+static size_t LoadHash(size_t* slot) { return std::atomic_ref<size_t>(*slot).load(std::memory_order_relaxed); }
+
+static void StoreHash(size_t* slot, size_t hash) { std::atomic_ref<size_t>(*slot).store(hash, std::memory_order_relaxed); }
+
+String Boolean::ToString() const { return m_value ? "True"_s : "False"_s; }
 
 String Character::ToString() const { return String(m_value, 1U); }
 
 SharedArrayRef<Character> String::FromCString(const char* cString)
 {
-	SharedArrayRef<Character> result = HeapArray<Character>(strlen(cString));
-	for(Size i = 0U; i < result.Count(); i++)
-		result[i] = cString[i.ToRawValue()];
+	size_t length = strlen(cString);
 
+	SharedArrayRef<Character> result = HeapArray<Character>(Encoding::NarrowToWide(cString, length, nullptr));
+	Encoding::NarrowToWide(cString, length, (wchar_t*)result.ToUnsafePointer());
 	return result;
 }
 
 SharedArrayRef<Character> String::FromWCString(const wchar_t* wcString)
 {
-	SharedArrayRef<Character> result = HeapArray<Character>(wcslen(wcString));
-	for(Size i = 0U; i < result.Count(); i++)
-		result[i] = wcString[i.ToRawValue()];
+	size_t length = wcslen(wcString);
 
+	SharedArrayRef<Character> result = HeapArray<Character>(length);
+	memcpy(result.ToUnsafePointer(), wcString, length * sizeof(wchar_t));
 	return result;
 }
 
@@ -41,96 +51,127 @@ String::String(Character character, Size length) : m_chars(FromChar(character, l
 
 String::String(const SharedArraySpan<Character>& chars) : m_chars(chars) {}
 
+String::String(StringView view) : m_chars(HeapArray<Character>(view.Length()))
+{
+	memcpy(m_chars.ToUnsafePointer(), view.ToUnsafePointer(), view.Length().ToRawValue() * sizeof(Character));
+}
+
 String::String(const String& other) : m_chars(other.m_chars) {}
 
+String& String::operator=(const String& other)
+{
+	m_chars = other.m_chars;
+	return *this;
+}
+
 const Character& String::operator[](Size index) const { return m_chars[index]; }
 
 SharedArrayRef<Character> String::ToCharacterArray() const { return m_chars.ToArray(); }
 
-Nullable<Size> String::IndexOf(const String& string, Size offset) const
+Nullable<Size> String::IndexOf(StringView string, Size offset) const
 {
-	for(Size i = offset; i < Length() - string.Length(); i++)
-	{
-		if(Slice(i, string.Length()) == string)
-			return i;
-	}
+	if(offset > Length())
+		return nullptr;
+
+	Nullable<Size> result = StringSearch::IndexOf(GetAddress() + offset.ToRawValue(), Length() - offset, string.ToUnsafePointer(), string.Length());
+	if(result == nullptr)
+		return nullptr;
 
-	return nullptr;
+	return result.GetValue() + offset;
 }
 
-Nullable<Size> String::LastIndexOf(const String& string, Size offset) const
+Nullable<Size> String::LastIndexOf(StringView string, Size offset) const
 {
-	for(Size i = offset - string.Length(); i < Length(); i--)
-	{
-		if(Slice(i, string.Length()) == string)
-			return i;
-	}
+	if(offset > Length())
+		return nullptr;
 
-	return nullptr;
+	Nullable<Size> result = StringSearch::LastIndexOf(GetAddress() + offset.ToRawValue(), Length() - offset, string.ToUnsafePointer(), string.Length());
+	if(result == nullptr)
+		return nullptr;
+
+	return result.GetValue() + offset;
+}
+
+Nullable<Size> String::IndexOfAny(const ArraySpan<String>& strings, Size offset) const
+{
+	if(offset > Length())
+		return nullptr;
+
+	Nullable<Size> result = StringSearch::IndexOfAny(GetAddress() + offset.ToRawValue(), Length() - offset, strings);
+	if(result == nullptr)
+		return nullptr;
+
+	return result.GetValue() + offset;
+}
+
+Size String::CountOccurrences(StringView string) const
+{
+	return StringSearch::CountOccurrences(GetAddress(), Length(), string.ToUnsafePointer(), string.Length());
 }
 
 String String::Slice(Size index) const { return Slice(index, Length() - index); }
 
 String String::Slice(Size index, Size length) const { return String(m_chars.Slice(index, length)); }
 
-//SharedArrayRef<String> String::Split(const String& splitter) const
-//{
-//	ArrayList<String> resultList;
-//
-//	if(splitter.Length() == 0U)
-//		return resultList.ToArray();
-//
-//	Size lastIndex = 0U;
-//	for(Size i = 0U; i < Length() - splitter.Length(); i++)
-//	{
-//		if(Slice(i, splitter.Length()) == splitter)
-//		{
-//			if(lastIndex != i)
-//				resultList.Add(Slice(lastIndex, i - lastIndex));
-//
-//			lastIndex = i + splitter.Length();
-//		}
-//	}
-//
-//	Size leftLength = Length() - lastIndex;
-//
-//	if(leftLength > 0U)
-//		resultList.Add(Slice(lastIndex, leftLength));
-//
-//	return resultList.ToArray();
-//}
-
-String String::Replace(const String& oldString, const String& newString) const
-{
-	MutableString resultBuilder;
+StringSplitter String::Split(Character separator, SplitOptions options) const
+{
+	return StringSplitter(*this, String(), separator, StringSplitter::SeparatorKind::Character, options);
+}
+
+StringSplitter String::Split(const String& separator, SplitOptions options) const
+{
+	return StringSplitter(*this, separator, Character(), StringSplitter::SeparatorKind::String, options);
+}
 
+StringSplitter String::Split() const
+{
+	return StringSplitter(*this, String(), Character(), StringSplitter::SeparatorKind::WhiteSpace, SplitOptions::RemoveEmptyEntries);
+}
+
+String String::Replace(StringView oldString, StringView newString) const
+{
 	if(oldString.Length() == 0U)
 		return *this;
 
-	Size lastIndex = 0U;
-	for(Size i = 0U; i < Length() - oldString.Length(); i++)
+	Size count = CountOccurrences(oldString);
+	if(count == 0U)
+		return *this;
+
+	SharedArrayRef<Character> resultChars = HeapArray<Character>(Length() - count * oldString.Length() + count * newString.Length());
+
+	      Character* dest   = resultChars.ToUnsafePointer();
+	const Character* source = GetAddress();
+	const Character* end    = source + Length().ToRawValue();
+
+	size_t oldLength = oldString.Length().ToRawValue();
+	size_t newLength = newString.Length().ToRawValue();
+
+	while(true)
 	{
-		if(Slice(i, oldString.Length()) == oldString)
-		{
-			if(lastIndex != i)
-				resultBuilder += MutableString(Slice(lastIndex, i - lastIndex)) += newString;
+		Nullable<Size> index = StringSearch::IndexOf(source, Size(end - source), oldString.ToUnsafePointer(), oldLength);
+		if(index == nullptr)
+			break;
 
-			lastIndex = i + oldString.Length();
-		}
-	}
+		size_t skipped = index.GetValue().ToRawValue();
+
+		memcpy(dest, source, skipped * sizeof(Character));
+		dest += skipped;
+
+		memcpy(dest, newString.ToUnsafePointer(), newLength * sizeof(Character));
+		dest += newLength;
 
-	Size leftLength = Length() - lastIndex;
+		source += skipped + oldLength;
+	}
 
-	if(leftLength > 0U)
-		resultBuilder += Slice(lastIndex, leftLength);
+	memcpy(dest, source, (end - source) * sizeof(Character));
 
-	return resultBuilder.ToString();
+	return String(resultChars);
 }
 
-Boolean String::Contains(const String& string) const { return IndexOf(string) != nullptr; }
+Boolean String::Contains(StringView string) const { return IndexOf(string) != nullptr; }
 
-Boolean String::StartsWith(const String& string) const { return Slice(0U                        , string.Length()) == string; }
-Boolean String::EndsWith(const String& string)   const { return Slice(Length() - string.Length(), string.Length()) == string; }
+Boolean String::StartsWith(StringView string) const { return AsView().StartsWith(string); }
+Boolean String::EndsWith(StringView string)   const { return AsView().EndsWith(string);   }
 
 String String::TrimStart() const
 {
@@ -148,34 +189,99 @@ String String::TrimEnd() const
 
 String String::Trim() const { return TrimStart().TrimEnd(); }
 
+Size String::GetUTF8Length() const { return Encoding::WideToUTF8((const wchar_t*)GetAddress(), Length().ToRawValue(), nullptr).GetCount(); }
+
 void String::CopyTo(char* cString) const
 {
-	for(Size i = 0U; i < Length(); i++)
-		cString[i.ToRawValue()] = (char)m_chars[i].m_value;
-
-	cString[Length().ToRawValue()] = '\0';
+	EncodingResult result = Encoding::WideToUTF8((const wchar_t*)GetAddress(), Length().ToRawValue(), cString);
+	cString[result.GetCount().ToRawValue()] = '\0';
 }
 
 void String::CopyTo(wchar_t* wcString) const
 {
-	for(Size i = 0U; i < Length(); i++)
-		wcString[i.ToRawValue()] = m_chars[i].m_value;
-
+	memcpy(wcString, GetAddress(), Length().ToRawValue() * sizeof(wchar_t));
 	wcString[Length().ToRawValue()] = '\0';
 }
 
+static_assert(std::is_trivially_copyable_v<StringView>);
+
+Nullable<Size> StringView::IndexOf(StringView string, Size offset) const
+{
+	if(offset > Length())
+		return nullptr;
+
+	Nullable<Size> result = StringSearch::IndexOf(m_address + offset.ToRawValue(), Length() - offset, string.m_address, string.Length());
+	if(result == nullptr)
+		return nullptr;
+
+	return result.GetValue() + offset;
+}
+
+Boolean StringView::StartsWith(StringView string) const { return string.m_length <= m_length && Slice(0U                        , string.Length()) == string; }
+Boolean StringView::EndsWith(StringView string)   const { return string.m_length <= m_length && Slice(Length() - string.Length(), string.Length()) == string; }
+
+SInt32 StringView::CompareTo(StringView other) const
+{
+	size_t length = m_length < other.m_length ? m_length : other.m_length;
+
+	int result = wmemcmp((const wchar_t*)m_address, (const wchar_t*)other.m_address, length);
+	if(result != 0)
+		return result < 0 ? -1 : 1;
+
+	if(m_length == other.m_length)
+		return 0;
+
+	return m_length < other.m_length ? -1 : 1;
+}
+
+String StringView::ToString() const { return String(*this); }
+
+Boolean operator==(StringView left, StringView right)
+{
+	return left.m_length == right.m_length && wmemcmp((const wchar_t*)left.m_address, (const wchar_t*)right.m_address, left.m_length) == 0;
+}
+
 MutableString String::ToMutableString() const { return MutableString(*this); }
 
-String operator+(const String& left, const String& right)
+HashCode String::GetHashCode() const
 {
-	SharedArrayRef<Character> resultChars = HeapArray<Character>(left.Length() + right.Length());
-	left.m_chars.CopyTo(resultChars.AsSpan().Slice(0U, left.Length()));
-	right.m_chars.CopyTo(resultChars.AsSpan(left.Length(), right.Length()));
-	return String(resultChars);
+	size_t* slot = m_chars.GetHashSlot();
+	if(!slot)
+		return AsView().GetHashCode();
+
+	// FromBytes never returns zero, so zero always means the slot is empty and every hash gets cached.
+	size_t cached = LoadHash(slot);
+	if(cached != 0U)
+		return HashCode(cached);
+
+	HashCode hash = AsView().GetHashCode();
+	StoreHash(slot, hash.GetValue());
+
+	return hash;
+}
+
+Boolean operator==(const String& left, const String& right)
+{
+	if(left.Length() != right.Length())
+		return false;
+
+	if(left.GetAddress() == right.GetAddress())
+		return true;
+
+	size_t*  leftSlot =  left.m_chars.GetHashSlot();
+	size_t* rightSlot = right.m_chars.GetHashSlot();
+	if(leftSlot && rightSlot)
+	{
+		size_t  leftHash = LoadHash( leftSlot);
+		size_t rightHash = LoadHash(rightSlot);
+		if(leftHash != 0U && rightHash != 0U && leftHash != rightHash)
+			return false;
+	}
+
+	return wmemcmp((const wchar_t*)left.GetAddress(), (const wchar_t*)right.GetAddress(), left.Length().ToRawValue()) == 0;
 }
 
-Boolean operator==(const String& left, const String& right) { return left.m_chars == right.m_chars; }
-Boolean operator!=(const String& left, const String& right) { return left.m_chars != right.m_chars; }
+Boolean operator!=(const String& left, const String& right) { return !(left == right); }
 
 MutableString operator+(const MutableString& left, const MutableString& right)
 {
@@ -213,6 +319,20 @@ const Character& MutableString::operator[](Size index) const { return m_chars[in
 
 void MutableString::TrimEnd(Size length) { m_length -= length; }
 
+Character* MutableString::Extend(Size count)
+{
+	if(m_length + count > m_chars.Count())
+	{
+		SharedArrayRef<Character> newChars(m_chars.Count() * 2U + count);
+		memcpy(newChars.ToUnsafePointer(), m_chars.ToUnsafePointer(), m_length.ToRawValue() * sizeof(Character));
+		m_chars = newChars;
+	}
+
+	Character* result = m_chars.ToUnsafePointer() + m_length.ToRawValue();
+	m_length += count;
+	return result;
+}
+
 MutableString& MutableString::Append(const MutableString& other)
 {
 	if(m_length + other.Length() >= m_chars.Count())
@@ -226,3 +346,101 @@ MutableString& MutableString::Append(const MutableString& other)
 	m_length += other.Length();
 	return *this;
 }
+
+
+Boolean StringSplitter::FindSeparator(Size offset, Size& index, Size& length) const
+{
+	const Character* start = m_string.GetAddress() + offset.ToRawValue();
+	Size remaining = m_string.Length() - offset;
+
+	Nullable<Size> result = nullptr;
+	switch(m_kind)
+	{
+		case SeparatorKind::Character:
+			result = StringSearch::IndexOf(start, remaining, m_separatorCharacter);
+			length = 1U;
+			break;
+		case SeparatorKind::String:
+			if(m_separator.Length() == 0U)
+				return false;
+
+			result = StringSearch::IndexOf(start, remaining, m_separator.GetAddress(), m_separator.Length());
+			length = m_separator.Length();
+			break;
+		case SeparatorKind::WhiteSpace:
+			result = StringSearch::IndexOfWhiteSpace(start, remaining);
+			length = 1U;
+			break;
+	}
+
+	if(result == nullptr)
+		return false;
+
+	index = offset + result.GetValue();
+
+	if(m_kind == SeparatorKind::WhiteSpace)
+	{
+		while(index + length < m_string.Length() && m_string[index + length].IsWhiteSpace())
+			length++;
+	}
+
+	return true;
+}
+
+void StringSplitter::Iterator::Advance()
+{
+	const StringSplitter& splitter = *m_splitter;
+	Size length = splitter.m_string.Length();
+
+	while(true)
+	{
+		if(m_position > length)
+		{
+			m_finished = true;
+			return;
+		}
+
+		Size separatorIndex;
+		Size separatorLength;
+
+		m_start = m_position;
+		if(splitter.FindSeparator(m_position, separatorIndex, separatorLength))
+		{
+			m_end      = separatorIndex;
+			m_position = separatorIndex + separatorLength;
+		}
+		else
+		{
+			m_end      = length;
+			m_position = length + 1U;
+		}
+
+		if(m_end > m_start || splitter.m_options != SplitOptions::RemoveEmptyEntries)
+			return;
+	}
+}
+
+StringSplitter::Iterator StringSplitter::begin() const
+{
+	Iterator result(this, false);
+	result.Advance();
+	return result;
+}
+
+Size StringSplitter::Count() const
+{
+	Size count = 0U;
+	for(Iterator it = begin(); it != end(); ++it)
+		count++;
+
+	return count;
+}
+
+Size StringSplitter::SplitInto(ArraySpan<String> destination) const
+{
+	Size count = 0U;
+	for(Iterator it = begin(); it != end() && count < destination.Count(); ++it)
+		destination[count++] = *it;
+
+	return count;
+}
\ No newline at end of file
@@ -3,9 +3,13 @@
 #include "Data/Memory/Refs.hpp"
 #include "Data/Memory/Array.hpp"
 
+#include "Encoding.hpp"
 #include "Nullable.hpp"
+#include "NumberFormat.hpp"
 
-#include <string>
+#include <cstring>
+#include <cwchar>
+#include <type_traits>
 
 class Character
 {
@@ -14,6 +18,8 @@ private:
 public:
 	Character(wchar_t value = '\0') : m_value(value) {}
 
+	wchar_t ToRawValue() const { return m_value; }
+
 	Boolean IsLetter() const { return (m_value >= 'A' && m_value <= 'Z') || (m_value >= 'a' && m_value <= 'z'); }
 	Boolean IsNumber() const { return (m_value >= '0' && m_value <= '9');                                       }
 
@@ -31,16 +37,109 @@ public:
 
 class MutableString;
 
+class StringSplitter;
+
+class StringView;
+
+// What the StringView parameters of the search functions also take, through a String made for the call: narrow
+// literals, concatenations and anything else that converts to a String but cannot be viewed directly.
+template<typename T>
+concept StringArgument = ConvertibleTo<const T&, String> && !ConvertibleTo<const T&, StringView>;
+
+// A non-owning view of characters: a pointer and a length, with no reference count. The viewed storage must outlive
+// the view.
+class StringView
+{
+private:
+	const Character* m_address;
+	size_t           m_length;
+public:
+	StringView() : m_address(nullptr), m_length(0U) {}
+
+	StringView(const Character* address, Size length) : m_address(address), m_length(length.ToRawValue()) {}
+
+	StringView(const wchar_t* wcString) : m_address((const Character*)wcString), m_length(wcslen(wcString)) {}
+
+	Size Length() const { return m_length; }
+
+	const Character& operator[](Size index) const { return m_address[index.ToRawValue()]; }
+
+	const Character* ToUnsafePointer() const { return m_address; }
+
+	StringView Slice(Size index)              const { return StringView(m_address + index.ToRawValue(), m_length - index.ToRawValue()); }
+	StringView Slice(Size index, Size length) const { return StringView(m_address + index.ToRawValue(), length); }
+
+	Nullable<Size> IndexOf(StringView string, Size offset = 0U) const;
+
+	Boolean Contains(StringView string) const { return IndexOf(string) != nullptr; }
+
+	Boolean StartsWith(StringView string) const;
+	Boolean   EndsWith(StringView string) const;
+
+	template<StringArgument T>
+	Nullable<Size> IndexOf(const T& string, Size offset = 0U) const;
+
+	template<StringArgument T>
+	Boolean Contains(const T& string) const;
+
+	template<StringArgument T>
+	Boolean StartsWith(const T& string) const;
+
+	template<StringArgument T>
+	Boolean EndsWith(const T& string) const;
+
+	SInt32 CompareTo(StringView other) const;
+
+	HashCode GetHashCode() const { return HashCode::FromBytes(m_address, m_length * sizeof(Character)); }
+
+	String ToString() const;
+
+	friend Boolean operator==(StringView left, StringView right);
+	friend Boolean operator!=(StringView left, StringView right) { return !(left == right); }
+
+	friend Boolean operator< (StringView left, StringView right) { return left.CompareTo(right) <  0; }
+	friend Boolean operator> (StringView left, StringView right) { return left.CompareTo(right) >  0; }
+	friend Boolean operator<=(StringView left, StringView right) { return left.CompareTo(right) <= 0; }
+	friend Boolean operator>=(StringView left, StringView right) { return left.CompareTo(right) >= 0; }
+};
+
+// Compile-time storage for a literal used with operator""_s. Narrow literals are decoded like String(const char*).
+template<size_t N>
+struct StringLiteral
+{
+	size_t  Length;
+	wchar_t characters[N];
+
+	consteval StringLiteral(const char (&string)[N]) : Length(0U), characters()
+	{
+		Length = Encoding::NarrowToWide(string, N - 1U, characters);
+	}
+
+	consteval StringLiteral(const wchar_t (&string)[N]) : Length(N - 1U), characters()
+	{
+		for(size_t i = 0U; i < N; i++)
+			characters[i] = string[i];
+	}
+};
+
+enum class SplitOptions
+{
+	None,
+	RemoveEmptyEntries,
+};
+
 class String
 {
 private:
-	const SharedArraySpan<Character> m_chars;
+	SharedArraySpan<Character> m_chars;
 
 	static SharedArrayRef<Character> FromCString(const char* cString);
 	static SharedArrayRef<Character> FromWCString(const wchar_t* wcString);
 	static SharedArrayRef<Character> FromChar(Character character, Size length);
+
+	const Character* GetAddress() const { return m_chars.ToUnsafePointer(); }
 public:
-	String() : String('\0', 0U) {}
+	String() : m_chars(SharedArrayRef<Character>::FromStatic(nullptr, 0U)) {}
 
 	String(const char*     cString);
 	String(const wchar_t* wcString);
@@ -49,28 +148,59 @@ public:
 	
 	explicit String(const SharedArraySpan<Character>& chars);
 
+	explicit String(StringView view);
+
 	String(const String& other);
 
+	String& operator=(const String& other);
+
 	Size Length() const { return m_chars.Count(); }
 
 	const Character& operator[](Size index) const;
 
 	SharedArrayRef<Character> ToCharacterArray() const;
 
-	Nullable<Size>     IndexOf(const String& string, Size offset = 0U) const;
-	Nullable<Size> LastIndexOf(const String& string, Size offset = 0U) const;
+	Nullable<Size>     IndexOf(StringView string, Size offset = 0U) const;
+	Nullable<Size> LastIndexOf(StringView string, Size offset = 0U) const;
+
+	Nullable<Size> IndexOfAny(const ArraySpan<String>& strings, Size offset = 0U) const;
+
+	Size CountOccurrences(StringView string) const;
 
 	String Slice(Size index)              const;
 	String Slice(Size index, Size length) const;
 
-	//SharedArrayRef<String> Split(const String& splitter) const;
+	StringSplitter Split(Character separator, SplitOptions options = SplitOptions::None) const;
+	StringSplitter Split(const String& separator, SplitOptions options = SplitOptions::None) const;
+	StringSplitter Split() const;
 
-	String Replace(const String& oldString, const String& newString) const;
+	String Replace(StringView oldString, StringView newString) const;
 
-	Boolean Contains(const String& string) const;
+	Boolean Contains(StringView string) const;
 
-	Boolean StartsWith(const String& string) const;
-	Boolean   EndsWith(const String& string) const;
+	Boolean StartsWith(StringView string) const;
+	Boolean   EndsWith(StringView string) const;
+
+	template<StringArgument T>
+	Nullable<Size> IndexOf(const T& string, Size offset = 0U) const { return IndexOf(String(string).AsView(), offset); }
+
+	template<StringArgument T>
+	Nullable<Size> LastIndexOf(const T& string, Size offset = 0U) const { return LastIndexOf(String(string).AsView(), offset); }
+
+	template<StringArgument T>
+	Size CountOccurrences(const T& string) const { return CountOccurrences(String(string).AsView()); }
+
+	template<typename Old, typename New> requires (StringArgument<Old> || StringArgument<New>)
+	String Replace(const Old& oldString, const New& newString) const { return Replace(String(oldString).AsView(), String(newString).AsView()); }
+
+	template<StringArgument T>
+	Boolean Contains(const T& string) const { return Contains(String(string).AsView()); }
+
+	template<StringArgument T>
+	Boolean StartsWith(const T& string) const { return StartsWith(String(string).AsView()); }
+
+	template<StringArgument T>
+	Boolean EndsWith(const T& string) const { return EndsWith(String(string).AsView()); }
 
 	String TrimStart() const;
 	String TrimEnd()   const;
@@ -78,46 +208,227 @@ public:
 
 	const SharedArraySpan<Character> AsSpan() const { return m_chars; }
 
+	StringView AsView() const { return StringView(GetAddress(), Length()); }
+
+	operator StringView() const { return AsView(); }
+
+	// Number of bytes CopyTo(char*) writes, not counting the terminator.
+	Size GetUTF8Length() const;
+
+	// Writes UTF-8. The buffer must hold GetUTF8Length() + 1 bytes.
 	void CopyTo(char*     cString) const;
 	void CopyTo(wchar_t* wcString) const;
 
-	friend String operator+(const String& left, const String& right);
+	// Ordinal comparison of the characters: negative, zero or positive.
+	SInt32 CompareTo(StringView other) const { return AsView().CompareTo(other); }
 
-	template<Printable T>
-	friend String operator+(const String& left, const T& right);
-	template<Printable T>
-	friend String operator+(const T& left, const String& right);
+	// Computed once per storage block and cached there, so copies of a string share the result.
+	HashCode GetHashCode() const;
 
 	friend Boolean operator==(const String& left, const String& right);
 	friend Boolean operator!=(const String& left, const String& right);
 
+	friend Boolean operator< (const String& left, const String& right) { return left.CompareTo(right) <  0; }
+	friend Boolean operator> (const String& left, const String& right) { return left.CompareTo(right) >  0; }
+	friend Boolean operator<=(const String& left, const String& right) { return left.CompareTo(right) <= 0; }
+	friend Boolean operator>=(const String& left, const String& right) { return left.CompareTo(right) >= 0; }
+
 	String ToString() const { return *this; }
 
 	MutableString ToMutableString() const;
 
 	friend class MutableString;
+	friend class StringSplitter;
+};
+
+template<StringArgument T>
+Nullable<Size> StringView::IndexOf(const T& string, Size offset) const { return IndexOf(String(string).AsView(), offset); }
+
+template<StringArgument T>
+Boolean StringView::Contains(const T& string) const { return Contains(String(string).AsView()); }
+
+template<StringArgument T>
+Boolean StringView::StartsWith(const T& string) const { return StartsWith(String(string).AsView()); }
+
+template<StringArgument T>
+Boolean StringView::EndsWith(const T& string) const { return EndsWith(String(string).AsView()); }
+
+// A lazy view of the pieces of a string between separators. Every piece is a slice sharing the storage of the
+// split string, and nothing is materialized until it is iterated or copied out with SplitInto.
+class StringSplitter
+{
+private:
+	enum class SeparatorKind
+	{
+		Character,
+		String,
+		WhiteSpace,
+	};
+
+	String        m_string;
+	String        m_separator;
+	Character     m_separatorCharacter;
+	SeparatorKind m_kind;
+	SplitOptions  m_options;
+
+	StringSplitter(const String& string, const String& separator, Character separatorCharacter, SeparatorKind kind, SplitOptions options) :
+		m_string(string), m_separator(separator), m_separatorCharacter(separatorCharacter), m_kind(kind), m_options(options) {}
+
+	Boolean FindSeparator(Size offset, Size& index, Size& length) const;
+public:
+	class Iterator
+	{
+	private:
+		const StringSplitter* m_splitter;
+
+		Size    m_position;
+		Size    m_start;
+		Size    m_end;
+		Boolean m_finished;
+
+		Iterator(const StringSplitter* splitter, Boolean finished) : 
+			m_splitter(splitter), m_position(0U), m_start(0U), m_end(0U), m_finished(finished) {}
+
+		void Advance();
+	public:
+		String operator*() const { return m_splitter->m_string.Slice(m_start, m_end - m_start); }
+
+		Iterator& operator++()
+		{
+			Advance();
+			return *this;
+		}
+
+		friend Boolean operator==(const Iterator& left, const Iterator& right)
+		{
+			if(left.m_finished || right.m_finished)
+				return left.m_finished == right.m_finished;
+
+			return left.m_position == right.m_position;
+		}
+
+		friend Boolean operator!=(const Iterator& left, const Iterator& right) { return !(left == right); }
+
+		friend class StringSplitter;
+	};
+
+	Iterator begin() const;
+	Iterator end()   const { return Iterator(this, true); }
+
+	Size Count() const;
+
+	Size SplitInto(ArraySpan<String> destination) const;
+
+	friend class String;
 };
 
-template<Printable T>
-inline String operator+(const String& left, const T& right) { return left + right.ToString(); }
+// A String over static storage built at compile time, e.g. "True"_s. It never allocates.
+template<StringLiteral Literal>
+String operator""_s() { return String(SharedArrayRef<Character>::FromStatic((const Character*)Literal.characters, Literal.Length)); }
 
-template<Printable T>
-inline String operator+(const T& left, const String& right) { return left.ToString() + right; }
+template<std::unsigned_integral T>
+String UnsignedInteger<T>::ToString() const
+{
+	SharedArrayRef<Character> chars = HeapArray<Character>(NumberFormat::GetLength(uint64_t(m_value)));
+	NumberFormat::Format(uint64_t(m_value), (wchar_t*)chars.ToUnsafePointer());
+	return String(chars);
+}
+
+template<std::signed_integral T>
+String SignedInteger<T>::ToString() const
+{
+	SharedArrayRef<Character> chars = HeapArray<Character>(NumberFormat::GetLength(int64_t(m_value)));
+	NumberFormat::Format(int64_t(m_value), (wchar_t*)chars.ToUnsafePointer());
+	return String(chars);
+}
+
+template<std::floating_point T>
+String Float<T>::ToString() const
+{
+	wchar_t buffer[NumberFormat::MaximumFloatLength];
+	size_t count = NumberFormat::Format(m_value, buffer);
+
+	SharedArrayRef<Character> chars = HeapArray<Character>(count);
+	memcpy(chars.ToUnsafePointer(), buffer, count * sizeof(wchar_t));
+	return String(chars);
+}
+
+// Float32's shortest form has more digits than the 16-bit value holds, so this looks for the fewest that read back the
+// same and writes those the way Float32 would write them.
+template<size_t ExponentBits>
+String HalfFloat<ExponentBits>::ToString() const
+{
+	wchar_t buffer[NumberFormat::MaximumFloatLength];
+	float   value = Decode(m_bits);
+
+	for(size_t digits = 1U; digits <= MaximumDigits && !IsNaN() && !IsInfinity(); digits++)
+	{
+		double parsed;
+		if(NumberFormat::Parse(buffer, NumberFormat::Format(value, digits, buffer), parsed) && HalfFloat<ExponentBits>(parsed).m_bits == m_bits)
+		{
+			value = float(parsed);
+			break;
+		}
+	}
+
+	size_t count = NumberFormat::Format(value, buffer);
+
+	SharedArrayRef<Character> chars = HeapArray<Character>(count);
+	memcpy(chars.ToUnsafePointer(), buffer, count * sizeof(wchar_t));
+	return String(chars);
+}
 
 template<std::unsigned_integral T>
-String UnsignedInteger<T>::ToString() const { return std::to_string(m_value).c_str(); }
+Boolean UnsignedInteger<T>::TryParse(const String& string, UnsignedInteger<T>& result)
+{
+	uint64_t value;
+	if(!NumberFormat::Parse((const wchar_t*)string.AsSpan().ToUnsafePointer(), string.Length().ToRawValue(), uint64_t(std::numeric_limits<T>::max()), value))
+		return false;
+
+	result = UnsignedInteger<T>(T(value));
+	return true;
+}
 
 template<std::signed_integral T>
-String SignedInteger<T>::ToString() const { return std::to_string(m_value).c_str(); }
+Boolean SignedInteger<T>::TryParse(const String& string, SignedInteger<T>& result)
+{
+	int64_t value;
+	if(!NumberFormat::Parse((const wchar_t*)string.AsSpan().ToUnsafePointer(), string.Length().ToRawValue(), int64_t(std::numeric_limits<T>::min()), int64_t(std::numeric_limits<T>::max()), value))
+		return false;
+
+	result = SignedInteger<T>(T(value));
+	return true;
+}
 
 template<std::floating_point T>
-String Float<T>::ToString() const { return std::to_string(m_value).c_str(); }
+Boolean Float<T>::TryParse(const String& string, Float<T>& result)
+{
+	T value;
+	if(!NumberFormat::Parse((const wchar_t*)string.AsSpan().ToUnsafePointer(), string.Length().ToRawValue(), value))
+		return false;
+
+	result = Float<T>(value);
+	return true;
+}
+
+template<size_t ExponentBits>
+Boolean HalfFloat<ExponentBits>::TryParse(const String& string, HalfFloat<ExponentBits>& result)
+{
+	double value;
+	if(!NumberFormat::Parse((const wchar_t*)string.AsSpan().ToUnsafePointer(), string.Length().ToRawValue(), value))
+		return false;
+
+	result = HalfFloat<ExponentBits>(value);
+	return true;
+}
 
 class MutableString
 {
 private:
 	SharedArrayRef<Character> m_chars;
 	Size                      m_length;
+
+	Character* Extend(Size count);
 public:
 	MutableString() : m_chars(HeapArray<Character>::Empty), m_length(0U) {}
 
@@ -144,6 +455,28 @@ public:
 
 	MutableString& Append(const MutableString& other);
 
+	template<std::unsigned_integral T>
+	MutableString& Append(UnsignedInteger<T> value)
+	{
+		NumberFormat::Format(uint64_t(value.ToRawValue()), (wchar_t*)Extend(NumberFormat::GetLength(uint64_t(value.ToRawValue()))));
+		return *this;
+	}
+
+	template<std::signed_integral T>
+	MutableString& Append(SignedInteger<T> value)
+	{
+		NumberFormat::Format(int64_t(value.ToRawValue()), (wchar_t*)Extend(NumberFormat::GetLength(int64_t(value.ToRawValue()))));
+		return *this;
+	}
+
+	template<std::floating_point T>
+	MutableString& Append(Float<T> value)
+	{
+		size_t count = NumberFormat::Format(value.ToRawValue(), (wchar_t*)Extend(NumberFormat::MaximumFloatLength));
+		TrimEnd(NumberFormat::MaximumFloatLength - count);
+		return *this;
+	}
+
 	MutableString& operator+=(const MutableString& other) { return Append(other); }
 
 	friend MutableString operator+(const MutableString& left, const MutableString& right);
@@ -184,39 +517,4 @@ public:
 //	return result.ToString();
 //}
 
-template<typename T>
-String SharedRef<T>::ToString() const requires Printable<T>
-{
-	return "Reference -> { " + m_address->ToString() + " }";
-}
-
-template<typename T>
-String NullableRef<T>::ToString() const requires Printable<T>
-{
-	if(m_address)
-		return "Reference -> { " + m_address->ToString() + " }";
-
-	return "<Null Reference>";
-}
-
-template<typename T>
-String WeakRef<T>::ToString() const requires Printable<T>
-{
-	if(m_refCount->m_useCount == 0U)
-		return "Reference -> Deleted";
-
-	return "Reference -> { " + m_address->ToString() + " }";
-}
-
-template<typename T>
-String NullableWeakRef<T>::ToString() const requires Printable<T>
-{
-	if(!m_address)
-		return "<Null Reference>";
-
-	if(m_refCount->m_useCount == 0U)
-		return "Reference -> Deleted";
-
-	return "Reference -> { " + m_address->ToString() + " }";
-}
-
+#include "Format.hpp"
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "StringBuilder.hpp"
+
+StringBuilder::StringBuilder(StringBuilder&& other) noexcept : m_first(other.m_first), m_last(other.m_last), m_length(other.m_length)
+{
+	other.m_first  = nullptr;
+	other.m_last   = nullptr;
+	other.m_length = 0U;
+}
+
+wchar_t* StringBuilder::Reserve(size_t count)
+{
+	if(!m_last || m_last->count + count > ChunkCapacity)
+	{
+		Chunk* chunk = (Chunk*)malloc(sizeof(Chunk));
+		chunk->next  = nullptr;
+		chunk->count = 0U;
+
+		if(m_last)
+			m_last->next = chunk;
+		else
+			m_first = chunk;
+
+		m_last = chunk;
+	}
+
+	return m_last->characters + m_last->count;
+}
+
+void StringBuilder::Commit(size_t count)
+{
+	m_last->count += count;
+	m_length      += count;
+}
+
+void StringBuilder::AppendCharacters(const wchar_t* characters, size_t count)
+{
+	while(count > 0U)
+	{
+		size_t available = m_last ? ChunkCapacity - m_last->count : 0U;
+		if(available == 0U)
+		{
+			Reserve(ChunkCapacity);
+			available = ChunkCapacity;
+		}
+
+		size_t copied = count < available ? count : available;
+		memcpy(m_last->characters + m_last->count, characters, copied * sizeof(wchar_t));
+		Commit(copied);
+
+		characters += copied;
+		count      -= copied;
+	}
+}
+
+StringBuilder& StringBuilder::AppendUnsigned(uint64_t value)
+{
+	size_t count = NumberFormat::GetLength(value);
+	NumberFormat::Format(value, Reserve(count));
+	Commit(count);
+	return *this;
+}
+
+StringBuilder& StringBuilder::AppendSigned(int64_t value)
+{
+	size_t count = NumberFormat::GetLength(value);
+	NumberFormat::Format(value, Reserve(count));
+	Commit(count);
+	return *this;
+}
+
+StringBuilder& StringBuilder::AppendFloat(double value, Boolean singlePrecision)
+{
+	wchar_t* dest = Reserve(NumberFormat::MaximumFloatLength);
+	Commit(singlePrecision ? NumberFormat::Format(float(value), dest) : NumberFormat::Format(value, dest));
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(const String& value)
+{
+	AppendCharacters((const wchar_t*)value.AsSpan().ToUnsafePointer(), value.Length().ToRawValue());
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(StringView value)
+{
+	AppendCharacters((const wchar_t*)value.ToUnsafePointer(), value.Length().ToRawValue());
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(const char* cString) { return Append(cString, strlen(cString)); }
+
+StringBuilder& StringBuilder::Append(const char* characters, Size length)
+{
+	// Decoded like String(const char*), which needs the whole run at once.
+	wchar_t  buffer[ChunkCapacity];
+	size_t   count = Encoding::NarrowToWide(characters, length.ToRawValue(), nullptr);
+	wchar_t* wide  = count <= ChunkCapacity ? buffer : (wchar_t*)malloc(count * sizeof(wchar_t));
+
+	Encoding::NarrowToWide(characters, length.ToRawValue(), wide);
+	AppendCharacters(wide, count);
+
+	if(wide != buffer)
+		free(wide);
+
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(const wchar_t* wcString)
+{
+	AppendCharacters(wcString, wcslen(wcString));
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(Character value)
+{
+	*Reserve(1U) = *(const wchar_t*)&value;
+	Commit(1U);
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(Character value, Size count)
+{
+	for(size_t remaining = count.ToRawValue(); remaining > 0U;)
+	{
+		wchar_t* dest = Reserve(1U);
+
+		size_t available = ChunkCapacity - m_last->count;
+		size_t filled = remaining < available ? remaining : available;
+		wmemset(dest, *(const wchar_t*)&value, filled);
+
+		Commit(filled);
+		remaining -= filled;
+	}
+
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(Boolean value) { return Append(value ? "True" : "False"); }
+
+void StringBuilder::Clear()
+{
+	while(m_first)
+	{
+		Chunk* next = m_first->next;
+		free(m_first);
+		m_first = next;
+	}
+
+	m_last   = nullptr;
+	m_length = 0U;
+}
+
+String StringBuilder::ToString() const
+{
+	SharedArrayRef<Character> result = HeapArray<Character>(m_length);
+
+	Character* dest = result.ToUnsafePointer();
+	for(const Chunk* chunk = m_first; chunk; chunk = chunk->next)
+	{
+		memcpy(dest, chunk->characters, chunk->count * sizeof(wchar_t));
+		dest += chunk->count;
+	}
+
+	return String(result);
+}
\ No newline at end of file
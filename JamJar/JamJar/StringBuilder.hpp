@@ -0,0 +1,70 @@
+#pragma once
+
+#include "String.hpp"
+
+// Accumulates text in a list of fixed-size chunks. Appending never moves characters that were already written,
+// and ToString copies everything exactly once into a String of the final length.
+class StringBuilder
+{
+private:
+	static const size_t ChunkCapacity = 512U;
+
+	struct Chunk
+	{
+		Chunk*  next;
+		size_t  count;
+		wchar_t characters[ChunkCapacity];
+	};
+
+	Chunk* m_first;
+	Chunk* m_last;
+	Size   m_length;
+
+	wchar_t* Reserve(size_t count);
+	void     Commit(size_t count);
+
+	void AppendCharacters(const wchar_t* characters, size_t count);
+
+	StringBuilder& AppendUnsigned(uint64_t value);
+	StringBuilder& AppendSigned(int64_t value);
+	StringBuilder& AppendFloat(double value, Boolean singlePrecision);
+public:
+	StringBuilder() : m_first(nullptr), m_last(nullptr), m_length(0U) {}
+
+	StringBuilder(const StringBuilder& other) = delete;
+	StringBuilder(StringBuilder&& other) noexcept;
+
+	~StringBuilder() { Clear(); }
+
+	StringBuilder& operator=(const StringBuilder& other) = delete;
+
+	Size Length() const { return m_length; }
+
+	StringBuilder& Append(const String& value);
+	StringBuilder& Append(StringView value);
+	StringBuilder& Append(const char* cString);
+	StringBuilder& Append(const char* characters, Size length);
+	StringBuilder& Append(const wchar_t* wcString);
+	StringBuilder& Append(Character value);
+	StringBuilder& Append(Character value, Size count);
+	StringBuilder& Append(Boolean value);
+
+	template<std::unsigned_integral T>
+	StringBuilder& Append(UnsignedInteger<T> value) { return AppendUnsigned(value.ToRawValue()); }
+
+	template<std::signed_integral T>
+	StringBuilder& Append(SignedInteger<T> value) { return AppendSigned(value.ToRawValue()); }
+
+	template<std::floating_point T>
+	StringBuilder& Append(Float<T> value) { return AppendFloat(value.ToRawValue(), sizeof(T) == sizeof(float)); }
+
+	template<Printable T>
+	StringBuilder& Append(const T& value) { return Append(value.ToString()); }
+
+	template<typename T>
+	StringBuilder& operator+=(const T& value) { return Append(value); }
+
+	void Clear();
+
+	String ToString() const;
+};
\ No newline at end of file
@@ -0,0 +1,329 @@
+#include "StringSearch.hpp"
+
+#include <bit>
+
+#if defined(__AVX2__)
+#define STRING_SEARCH_VECTORIZED
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_SEARCH_VECTORIZED
+#include <emmintrin.h>
+#endif
+
+static_assert(sizeof(Character) == sizeof(wchar_t));
+
+static const size_t NotFound = size_t(-1);
+
+#if !defined(STRING_SEARCH_VECTORIZED)
+static const size_t LongNeedleLength = 32U;
+#endif
+
+static Boolean MatchesAt(const wchar_t* haystack, const wchar_t* needle, size_t needleLength)
+{
+	return wmemcmp(haystack, needle, needleLength) == 0;
+}
+
+static Boolean IsWhiteSpace(wchar_t value) { return value == L' ' || value == L'\t' || value == L'\n' || value == L'\r'; }
+
+#if defined(__AVX2__)
+static const size_t VectorBytes = 32U;
+
+using VectorRegister = __m256i;
+
+static VectorRegister Load(const wchar_t* address) { return _mm256_loadu_si256((const __m256i*)address); }
+
+static VectorRegister Broadcast(wchar_t value)
+{
+	if constexpr(sizeof(wchar_t) == 2U)
+		return _mm256_set1_epi16((short)value);
+	else
+		return _mm256_set1_epi32((int)value);
+}
+
+static VectorRegister CompareEqual(VectorRegister left, VectorRegister right)
+{
+	if constexpr(sizeof(wchar_t) == 2U)
+		return _mm256_cmpeq_epi16(left, right);
+	else
+		return _mm256_cmpeq_epi32(left, right);
+}
+
+static VectorRegister And(VectorRegister left, VectorRegister right) { return _mm256_and_si256(left, right); }
+static VectorRegister Or (VectorRegister left, VectorRegister right) { return _mm256_or_si256 (left, right); }
+
+static uint32_t MoveMask(VectorRegister value) { return (uint32_t)_mm256_movemask_epi8(value); }
+#elif defined(STRING_SEARCH_VECTORIZED)
+static const size_t VectorBytes = 16U;
+
+using VectorRegister = __m128i;
+
+static VectorRegister Load(const wchar_t* address) { return _mm_loadu_si128((const __m128i*)address); }
+
+static VectorRegister Broadcast(wchar_t value)
+{
+	if constexpr(sizeof(wchar_t) == 2U)
+		return _mm_set1_epi16((short)value);
+	else
+		return _mm_set1_epi32((int)value);
+}
+
+static VectorRegister CompareEqual(VectorRegister left, VectorRegister right)
+{
+	if constexpr(sizeof(wchar_t) == 2U)
+		return _mm_cmpeq_epi16(left, right);
+	else
+		return _mm_cmpeq_epi32(left, right);
+}
+
+static VectorRegister And(VectorRegister left, VectorRegister right) { return _mm_and_si128(left, right); }
+static VectorRegister Or (VectorRegister left, VectorRegister right) { return _mm_or_si128 (left, right); }
+
+static uint32_t MoveMask(VectorRegister value) { return (uint32_t)_mm_movemask_epi8(value); }
+#endif
+
+static size_t FindCharacter(const wchar_t* haystack, size_t haystackLength, wchar_t character)
+{
+	size_t i = 0U;
+
+#if defined(STRING_SEARCH_VECTORIZED)
+	const size_t lanes = VectorBytes / sizeof(wchar_t);
+
+	VectorRegister target = Broadcast(character);
+	for(; i + lanes <= haystackLength; i += lanes)
+	{
+		uint32_t mask = MoveMask(CompareEqual(Load(haystack + i), target));
+		if(mask != 0U)
+			return i + (size_t)std::countr_zero(mask) / sizeof(wchar_t);
+	}
+#endif
+
+	for(; i < haystackLength; i++)
+	{
+		if(haystack[i] == character)
+			return i;
+	}
+
+	return NotFound;
+}
+
+static size_t FindWhiteSpace(const wchar_t* haystack, size_t haystackLength)
+{
+	size_t i = 0U;
+
+#if defined(STRING_SEARCH_VECTORIZED)
+	const size_t lanes = VectorBytes / sizeof(wchar_t);
+
+	VectorRegister space          = Broadcast(L' ');
+	VectorRegister tab            = Broadcast(L'\t');
+	VectorRegister newLine        = Broadcast(L'\n');
+	VectorRegister carriageReturn = Broadcast(L'\r');
+
+	for(; i + lanes <= haystackLength; i += lanes)
+	{
+		VectorRegister block = Load(haystack + i);
+		VectorRegister match = Or(Or(CompareEqual(block, space), CompareEqual(block, tab)), Or(CompareEqual(block, newLine), CompareEqual(block, carriageReturn)));
+
+		uint32_t mask = MoveMask(match);
+		if(mask != 0U)
+			return i + (size_t)std::countr_zero(mask) / sizeof(wchar_t);
+	}
+#endif
+
+	for(; i < haystackLength; i++)
+	{
+		if(IsWhiteSpace(haystack[i]))
+			return i;
+	}
+
+	return NotFound;
+}
+
+static size_t FindByEnds(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+{
+	size_t i = 0U;
+
+#if defined(STRING_SEARCH_VECTORIZED)
+	const size_t lanes = VectorBytes / sizeof(wchar_t);
+	const uint32_t laneBits = (1U << sizeof(wchar_t)) - 1U;
+
+	VectorRegister first = Broadcast(needle[0]);
+	VectorRegister last  = Broadcast(needle[needleLength - 1U]);
+
+	for(; i + needleLength - 1U + lanes <= haystackLength; i += lanes)
+	{
+		uint32_t mask = MoveMask(And(CompareEqual(first, Load(haystack + i)), CompareEqual(last, Load(haystack + i + needleLength - 1U))));
+
+		while(mask != 0U)
+		{
+			unsigned bit = (unsigned)std::countr_zero(mask);
+			size_t position = i + bit / sizeof(wchar_t);
+
+			if(needleLength <= 2U || MatchesAt(haystack + position + 1U, needle + 1U, needleLength - 2U))
+				return position;
+
+			mask &= ~(laneBits << bit);
+		}
+	}
+#endif
+
+	for(; i + needleLength <= haystackLength; i++)
+	{
+		if(haystack[i] == needle[0] && MatchesAt(haystack + i, needle, needleLength))
+			return i;
+	}
+
+	return NotFound;
+}
+
+#if !defined(STRING_SEARCH_VECTORIZED)
+static size_t FindLong(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+{
+	size_t shifts[256];
+	for(size_t& shift : shifts)
+		shift = needleLength;
+
+	for(size_t i = 0U; i < needleLength - 1U; i++)
+		shifts[needle[i] & 0xFF] = needleLength - 1U - i;
+
+	wchar_t lastCharacter = needle[needleLength - 1U];
+
+	size_t i = 0U;
+	while(i + needleLength <= haystackLength)
+	{
+		wchar_t current = haystack[i + needleLength - 1U];
+		if(current == lastCharacter && MatchesAt(haystack + i, needle, needleLength - 1U))
+			return i;
+
+		i += shifts[current & 0xFF];
+	}
+
+	return NotFound;
+}
+#endif
+
+static size_t Find(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+{
+	if(needleLength == 0U)
+		return 0U;
+
+	if(needleLength > haystackLength)
+		return NotFound;
+
+	if(needleLength == 1U)
+		return FindCharacter(haystack, haystackLength, needle[0]);
+
+#if defined(STRING_SEARCH_VECTORIZED)
+	// A register of positions per step outruns Boyer-Moore-Horspool even for long needles: on ordinary text most of
+	// their characters occur in the needle, so its shifts stay short.
+	return FindByEnds(haystack, haystackLength, needle, needleLength);
+#else
+	if(needleLength < LongNeedleLength)
+		return FindByEnds(haystack, haystackLength, needle, needleLength);
+
+	return FindLong(haystack, haystackLength, needle, needleLength);
+#endif
+}
+
+Nullable<Size> StringSearch::IndexOf(const Character* haystack, Size haystackLength, const Character* needle, Size needleLength)
+{
+	size_t result = Find((const wchar_t*)haystack, haystackLength.ToRawValue(), (const wchar_t*)needle, needleLength.ToRawValue());
+	if(result == NotFound)
+		return nullptr;
+
+	return Size(result);
+}
+
+Nullable<Size> StringSearch::IndexOf(const Character* haystack, Size haystackLength, Character character)
+{
+	size_t result = FindCharacter((const wchar_t*)haystack, haystackLength.ToRawValue(), *(const wchar_t*)&character);
+	if(result == NotFound)
+		return nullptr;
+
+	return Size(result);
+}
+
+Nullable<Size> StringSearch::IndexOfWhiteSpace(const Character* haystack, Size haystackLength)
+{
+	size_t result = FindWhiteSpace((const wchar_t*)haystack, haystackLength.ToRawValue());
+	if(result == NotFound)
+		return nullptr;
+
+	return Size(result);
+}
+
+Nullable<Size> StringSearch::LastIndexOf(const Character* haystack, Size haystackLength, const Character* needle, Size needleLength)
+{
+	const wchar_t* wideHaystack = (const wchar_t*)haystack;
+	const wchar_t* wideNeedle   = (const wchar_t*)needle;
+
+	size_t length     = haystackLength.ToRawValue();
+	size_t searchSize = needleLength.ToRawValue();
+
+	if(searchSize > length)
+		return nullptr;
+
+	if(searchSize == 0U)
+		return haystackLength;
+
+	for(size_t i = length - searchSize + 1U; i-- > 0U;)
+	{
+		if(wideHaystack[i] == wideNeedle[0] && MatchesAt(wideHaystack + i, wideNeedle, searchSize))
+			return Size(i);
+	}
+
+	return nullptr;
+}
+
+Nullable<Size> StringSearch::IndexOfAny(const Character* haystack, Size haystackLength, const ArraySpan<String>& needles)
+{
+	const wchar_t* wideHaystack = (const wchar_t*)haystack;
+
+	size_t best = NotFound;
+	for(Size i = 0U; i < needles.Count(); i++)
+	{
+		const String& needle = needles[i];
+		size_t needleLength = needle.Length().ToRawValue();
+
+		size_t searchLength = haystackLength.ToRawValue();
+		if(best != NotFound)
+			searchLength = best + needleLength - 1U < searchLength ? best + needleLength - 1U : searchLength;
+
+		size_t result = Find(wideHaystack, searchLength, (const wchar_t*)needle.AsSpan().ToUnsafePointer(), needleLength);
+		if(result < best)
+			best = result;
+
+		if(best == 0U)
+			break;
+	}
+
+	if(best == NotFound)
+		return nullptr;
+
+	return Size(best);
+}
+
+Size StringSearch::CountOccurrences(const Character* haystack, Size haystackLength, const Character* needle, Size needleLength)
+{
+	const wchar_t* wideHaystack = (const wchar_t*)haystack;
+	const wchar_t* wideNeedle   = (const wchar_t*)needle;
+
+	size_t length     = haystackLength.ToRawValue();
+	size_t searchSize = needleLength.ToRawValue();
+
+	if(searchSize == 0U)
+		return 0U;
+
+	size_t count = 0U;
+	size_t offset = 0U;
+	while(true)
+	{
+		size_t result = Find(wideHaystack + offset, length - offset, wideNeedle, searchSize);
+		if(result == NotFound)
+			break;
+
+		count++;
+		offset += result + searchSize;
+	}
+
+	return count;
+}
\ No newline at end of file
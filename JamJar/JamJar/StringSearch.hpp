@@ -0,0 +1,21 @@
+#pragma once
+
+#include "String.hpp"
+
+// Allocation-free substring search over raw character storage. Needles are located with a vectorized first/last
+// character filter; without vector registers, long needles fall back to Boyer-Moore-Horspool.
+class StringSearch
+{
+public:
+	static Nullable<Size> IndexOf(const Character* haystack, Size haystackLength, const Character* needle, Size needleLength);
+
+	static Nullable<Size> IndexOf(const Character* haystack, Size haystackLength, Character character);
+
+	static Nullable<Size> IndexOfWhiteSpace(const Character* haystack, Size haystackLength);
+
+	static Nullable<Size> LastIndexOf(const Character* haystack, Size haystackLength, const Character* needle, Size needleLength);
+
+	static Nullable<Size> IndexOfAny(const Character* haystack, Size haystackLength, const ArraySpan<String>& needles);
+
+	static Size CountOccurrences(const Character* haystack, Size haystackLength, const Character* needle, Size needleLength);
+};
\ No newline at end of file
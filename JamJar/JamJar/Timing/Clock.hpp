@@ -80,7 +80,7 @@ public:
 
 	String ToString() const 
 	{
-		MutableString weekDay;
+		const char* weekDay = "";
 		switch(GetWeekDay())
 		{
 			case Day::Monday:
@@ -106,7 +106,7 @@ public:
 				break;
 		}
 
-		MutableString daySuffix;
+		const char* daySuffix;
 		UInt32 day = GetDay();
 		if(day == 1U)
 			daySuffix = "st";
@@ -117,7 +117,7 @@ public:
 		else
 			daySuffix = "th";
 
-		MutableString month;
+		const char* month = "";
 		switch(GetMonth())
 		{
 			case Month::January:
@@ -158,19 +158,11 @@ public:
 				break;
 		}
 
-		UInt32 hour   = GetHour();
-		UInt32 minute = GetMinute();
-		UInt32 second = GetSecond();
+		const char*   hourPadding =   GetHour() > 0U ? "" : "0";
+		const char* minutePadding = GetMinute() > 0U ? "" : "0";
+		const char* secondPadding = GetSecond() > 0U ? "" : "0";
 
-		String   hourStr =   GetHour() > 0U ?   hour.ToString() : "0" +   hour.ToString();
-		String minuteStr = GetMinute() > 0U ? minute.ToString() : "0" + minute.ToString();
-		String secondStr = GetSecond() > 0U ? second.ToString() : "0" + second.ToString();
-
-		String date = "Date: " + day + daySuffix + " " + month + " " + GetYear();
-
-		String time = "Time: " + hourStr + ":" + minuteStr + ":" + secondStr;
-
-		return date + ", " + time;
+		return Format("Date: {}{} {} {}, Time: {}{}:{}{}:{}{}", day, daySuffix, month, GetYear(), hourPadding, GetHour(), minutePadding, GetMinute(), secondPadding, GetSecond());
 	}
 };
 
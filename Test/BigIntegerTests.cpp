@@ -0,0 +1,209 @@
+#include "Tests.hpp"
+
+#include <JamJar/Math/BigInteger.hpp>
+#include <JamJar/Math/Random.hpp>
+
+#include <cmath>
+
+// Limb counts for the identity checks, either side of the inline storage, Karatsuba and Newton division thresholds.
+static const size_t IdentityLimbs[] = { 1U, 2U, 3U, 4U, 31U, 32U, 33U, 100U, 700U, 2100U, 5000U };
+
+// The benchmark sizes in bits, each four times the last, and how much work each timed round does at least.
+static const size_t SmallestBits    = 64U;
+static const size_t LargestBits     = 1U << 20U;
+static const size_t RoundLimbWork   = 1U << 14U;
+
+// Values computed with Python's integers.
+static const char* const Factorial25  = "15511210043330985984000000";
+static const char* const Factorial100 = "93326215443944152681699238856266700490715968264381621468592963895217599993229915608941463976156518286253697920827223758251185210916864000000000000000000000000";
+static const char* const Mersenne521  = "6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151";
+static const char* const Power3To200  = "265613988875874769338781322035779626829233452653394495974574961739092490901302182994384699044001";
+
+static BigInteger RandomBigInteger(Xoshiro256& generator, size_t limbs)
+{
+	BigInteger value;
+	for(size_t i = 0U; i < limbs; i++)
+		value = (value << 64) | BigInteger(generator.Next().ToRawValue());
+
+	return value;
+}
+
+static BigInteger Factorial(uint64_t count)
+{
+	BigInteger result = BigInteger::One;
+	for(uint64_t i = 2U; i <= count; i++)
+		result *= BigInteger(i);
+
+	return result;
+}
+
+static void TestKnownValues()
+{
+	Check((BigInteger::One << 64).ToString() == "18446744073709551616"_s && (BigInteger::One << 64) - BigInteger::One == BigInteger(UINT64_MAX), "2^64 is right"_s);
+	Check(Factorial(25U).ToString() == String(Factorial25) && Factorial(100U) == BigInteger::Parse(String(Factorial100)), "Factorials are right"_s);
+	Check(((BigInteger::One << 521) - BigInteger::One).ToString() == String(Mersenne521) && BigInteger(3).IPow(200U).ToString() == String(Power3To200), "Powers are right"_s);
+
+	BigInteger dividend = BigInteger(10).IPow(100U) + BigInteger(7);
+	BigInteger divisor  = BigInteger(10).IPow(50U) + BigInteger(3);
+	BigInteger remainder;
+	Check(dividend.Divide(divisor, remainder) == BigInteger::Parse("99999999999999999999999999999999999999999999999997"_s) && remainder == BigInteger(16), "Division is right"_s);
+	Check((BigInteger(2) * BigInteger(10).IPow(100U)).Sqrt() == BigInteger::Parse("141421356237309504880168872420969807856967187537694"_s), "Sqrt is right"_s);
+
+	// Division truncates and shifts floor, as for the built-in types.
+	BigInteger negative = BigInteger(12345) - (BigInteger::One << 200);
+	Check(negative >> 70 == BigInteger::Parse("-1361129467683753853853498429727072845824"_s) && negative / (BigInteger::One << 70) == BigInteger::Parse("-1361129467683753853853498429727072845823"_s), "Negative values shift down and divide toward zero"_s);
+	Check(BigInteger(-7) / BigInteger(2) == BigInteger(-3) && BigInteger(-7) % BigInteger(2) == BigInteger(-1) && BigInteger(7) % BigInteger(-2) == BigInteger(1), "Remainders take the sign of the dividend"_s);
+	Check((BigInteger(-1) >> 1) == BigInteger(-1) && (BigInteger(-1) & negative) == negative && ~BigInteger::Zero == BigInteger(-1) && (BigInteger(-6) | BigInteger(3)) == BigInteger(-5), "Bitwise operators act on two's complement"_s);
+
+	// Runs of zeros inside a number are where splitting at powers of ten goes wrong.
+	String ones = "1"_s + String(Character(L'0'), 2000U) + "1"_s;
+	Check((BigInteger(10).IPow(2001U) + BigInteger::One).ToString() == ones && BigInteger::Parse(String(Character(L'9'), 3000U)) + BigInteger::One == BigInteger(10).IPow(3000U), "Long runs of zeros and nines survive ToString and Parse"_s);
+
+	BigInteger parsed;
+	Check(BigInteger::Parse("-0"_s) == BigInteger::Zero && !BigInteger::Parse("-0"_s).IsNegative() && BigInteger::Parse("+42"_s) == BigInteger(42), "Signs parse"_s);
+	Check(!BigInteger::TryParse(""_s, parsed) && !BigInteger::TryParse("-"_s, parsed) && !BigInteger::TryParse("12a"_s, parsed) && !BigInteger::TryParse("1 2"_s, parsed), "Malformed text does not parse"_s);
+
+	Check(double(Float64((BigInteger::One << 53) + BigInteger::One).ToRawValue()) == 9007199254740992.0 && std::isinf(double(Float64(BigInteger::One << 1024).ToRawValue())) && UInt64(BigInteger(-1)) == UInt64(UINT64_MAX), "Conversions round and wrap like the built-in ones"_s);
+}
+
+// Values move between the inline limbs and the heap as they grow and shrink.
+static void TestStorage()
+{
+	Xoshiro256 generator(4800U);
+
+	Boolean intact = true;
+	for(size_t limbs = 1U; limbs <= 6U; limbs++)
+	{
+		BigInteger value = RandomBigInteger(generator, limbs);
+		String     text  = value.ToString();
+
+		BigInteger copy  = value;
+		BigInteger moved = BigInteger(value);
+		BigInteger small = BigInteger(5);
+		BigInteger large = RandomBigInteger(generator, 8U);
+		small = value;
+		large = value;
+		copy  = copy;
+
+		BigInteger shrunk = (value << 512) >> 512;
+		intact = intact && copy.ToString() == text && moved == value && small == value && large == value && shrunk == value && value.GetHashCode() == shrunk.GetHashCode();
+		intact = intact && value.BitLength() <= Size(limbs * 64U) && value.BitLength() > Size(limbs * 64U - 64U);
+	}
+
+	Check(intact, "Values survive copies, moves and changes of storage"_s);
+}
+
+static void TestIdentities()
+{
+	Xoshiro256 generator(4801U);
+
+	Boolean divides      = true;
+	Boolean distributes  = true;
+	Boolean roundTrips   = true;
+	Boolean roots        = true;
+	for(size_t leftLimbs : IdentityLimbs)
+	{
+		for(size_t rightLimbs : IdentityLimbs)
+		{
+			// The slowest pair is left to the benchmark.
+			if(leftLimbs * rightLimbs > 2100U * 5000U)
+				continue;
+
+			BigInteger left  = RandomBigInteger(generator, leftLimbs);
+			BigInteger right = RandomBigInteger(generator, rightLimbs) | BigInteger::One;
+			BigInteger rest  = RandomBigInteger(generator, rightLimbs) % right;
+			if((leftLimbs + rightLimbs) % 2U != 0U)
+				left = -left;
+
+			// (left * right + rest) / right gives back left and rest, with rest taking the sign of the dividend.
+			BigInteger product = left * right;
+			BigInteger remainder;
+			if(left.IsNegative())
+				rest = -rest;
+
+			divides = divides && (product + rest).Divide(right, remainder) == left && remainder == rest;
+
+			// The same product from halves of different lengths takes other paths through the multiplication.
+			size_t     split = leftLimbs * 32U;
+			BigInteger high  = left.Abs() >> split;
+			BigInteger low   = left.Abs() - (high << split);
+			BigInteger other = ((high * right) << split) + low * right;
+			distributes = distributes && (left.IsNegative() ? -other : other) == product;
+
+			if(leftLimbs == 1U || leftLimbs == 33U || leftLimbs == 2100U)
+			{
+				roundTrips = roundTrips && BigInteger::Parse(product.ToString()) == product;
+
+				BigInteger magnitude = product.Abs();
+				BigInteger root      = magnitude.Sqrt();
+				roots = roots && root * root <= magnitude && (root + BigInteger::One) * (root + BigInteger::One) > magnitude;
+			}
+		}
+	}
+
+	Check(divides, "Division undoes multiplication at every size"_s);
+	Check(distributes, "Products agree however the factors are split"_s);
+	Check(roundTrips, "Parse reads back ToString at every size"_s);
+	Check(roots, "Sqrt rounds down at every size"_s);
+}
+
+// Nanoseconds per operation on numbers of the given size: an n by n bit product, a 2n by n bit division, and ToString
+// and Parse of n bits.
+static void TimeOperations(size_t bits, double& multiply, double& divide, double& format, double& parse)
+{
+	Xoshiro256 generator(4802U);
+
+	size_t     limbs    = bits / 64U;
+	BigInteger left     = RandomBigInteger(generator, limbs);
+	BigInteger right    = RandomBigInteger(generator, limbs);
+	BigInteger dividend = RandomBigInteger(generator, 2U * limbs);
+	String     text     = left.ToString();
+
+	// Small numbers are timed over enough repetitions to be measurable, large ones over a few rounds.
+	size_t repetitions = RoundLimbWork / limbs > 1U ? RoundLimbWork / limbs : 1U;
+	size_t rounds      = bits >= LargestBits / 4U ? 2U : 5U;
+
+	BigInteger result;
+	String     string;
+	multiply = BestTime([&]() { for(size_t i = 0U; i < repetitions; i++) result = left * right; }, rounds) / double(repetitions);
+	divide   = BestTime([&]() { for(size_t i = 0U; i < repetitions; i++) result = dividend / right; }, rounds) / double(repetitions);
+	format   = BestTime([&]() { for(size_t i = 0U; i < repetitions; i++) string = left.ToString(); }, rounds) / double(repetitions);
+	parse    = BestTime([&]() { for(size_t i = 0U; i < repetitions; i++) result = BigInteger::Parse(text); }, rounds) / double(repetitions);
+}
+
+static void BenchmarkBigInteger()
+{
+	double smallerMultiply = 0.0;
+	double largestMultiply = 0.0;
+	for(size_t bits = SmallestBits; bits <= LargestBits; bits *= 4U)
+	{
+		double multiply, divide, format, parse;
+		TimeOperations(bits, multiply, divide, format, parse);
+
+		Console::PrintLine(Format("BigInteger {} bits: multiply {} ns, divide {} ns, ToString {} ns, Parse {} ns",
+			UInt64(bits), Float64(multiply), Float64(divide), Float64(format), Float64(parse)));
+
+		if(bits == LargestBits / 16U)
+			smallerMultiply = multiply;
+
+		largestMultiply = multiply;
+	}
+
+	// Sixteen times the bits costs 256 times as much with schoolbook multiplication and 81 with Karatsuba; the two steps
+	// together are steadier than the last one alone.
+#if defined(NDEBUG)
+	Check(largestMultiply / smallerMultiply < 150.0, "BigInteger multiplication grows quadratically up to 1M bits"_s);
+#endif
+}
+
+UInt32 RunBigIntegerTests()
+{
+	s_failures = 0U;
+
+	TestKnownValues();
+	TestStorage();
+	TestIdentities();
+	BenchmarkBigInteger();
+
+	return s_failures;
+}
@@ -0,0 +1,194 @@
+#include "Tests.hpp"
+
+#include <JamJar/IO/File.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Console is timed in lines per second against what PrintLine did before it had a buffer: a wide copy written through
+// std::wcout and flushed by std::endl, one write per line. Both write to the null device, so the test measures the
+// library and not the terminal.
+static const size_t BenchmarkLines = 200000U;
+
+// Lines each thread prints while the others print theirs, to check that none is split or mixed with another.
+static const size_t ThreadCount = 4U;
+static const size_t ThreadLines = 5000U;
+
+#if defined(_WIN32)
+static const char* const NullDevice = "NUL";
+#else
+static const char* const NullDevice = "/dev/null";
+#endif
+
+static const char* const CapturePath = "ConsoleTests.txt";
+
+// Points standard output at a file while it lives, so what Console writes can be read back or thrown away.
+class OutputRedirect
+{
+private:
+	int m_previous;
+public:
+	OutputRedirect(const char* path)
+	{
+		Console::Flush();
+		std::wcout.flush();
+
+#if defined(_WIN32)
+		m_previous = _dup(1);
+
+		int file = _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+		_dup2(file, 1);
+		_close(file);
+#else
+		m_previous = dup(1);
+
+		int file = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		dup2(file, 1);
+		close(file);
+#endif
+	}
+
+	OutputRedirect(const OutputRedirect& other) = delete;
+
+	~OutputRedirect()
+	{
+		Console::Flush();
+		std::wcout.flush();
+
+#if defined(_WIN32)
+		_dup2(m_previous, 1);
+		_close(m_previous);
+#else
+		dup2(m_previous, 1);
+		close(m_previous);
+#endif
+	}
+};
+
+static void ReferencePrintLine(const String& value)
+{
+	wchar_t* chars = new wchar_t[value.Length().ToRawValue() + 1U];
+	value.CopyTo(chars);
+	std::wcout << chars << std::endl;
+	delete[] chars;
+}
+
+static void PrintLines(const String& line)
+{
+	for(size_t i = 0U; i < BenchmarkLines; i++)
+		Console::PrintLine(line);
+
+	Console::Flush();
+}
+
+static void PrintReferenceLines(const String& line)
+{
+	for(size_t i = 0U; i < BenchmarkLines; i++)
+		ReferencePrintLine(line);
+}
+
+static void PrintNumbers()
+{
+	for(size_t i = 0U; i < BenchmarkLines; i++)
+		Console::PrintLine(uint64_t(i));
+
+	Console::Flush();
+}
+
+static void BenchmarkConsole()
+{
+	String line = "Frame 1200 took 16.25 ms, 3 draw calls skipped"_s;
+
+	double console;
+	double numbers;
+	double reference;
+	{
+		OutputRedirect redirect(NullDevice);
+
+		console   = BestTime([&]() { Opaque(PrintLines)(line); }, 3U);
+		numbers   = BestTime([&]() { Opaque(PrintNumbers)(); }, 3U);
+		reference = BestTime([&]() { Opaque(PrintReferenceLines)(line); }, 3U);
+	}
+
+	double consoleRate   = double(BenchmarkLines) * 1e9 / console;
+	double numberRate    = double(BenchmarkLines) * 1e9 / numbers;
+	double referenceRate = double(BenchmarkLines) * 1e9 / reference;
+
+	Console::PrintLine(Format("Console: {} lines/s, {} number lines/s, std::wcout with std::endl {} lines/s",
+		Float64(consoleRate), Float64(numberRate), Float64(referenceRate)));
+
+#if defined(NDEBUG)
+	Check(consoleRate >= referenceRate, "Console is slower than std::wcout"_s);
+#endif
+}
+
+// Each thread prints its lines in two calls, so a write-out between them would show up as a split line.
+static void TestLinesStayWhole()
+{
+	{
+		OutputRedirect redirect(CapturePath);
+
+		std::thread threads[ThreadCount];
+		for(size_t i = 0U; i < ThreadCount; i++)
+		{
+			threads[i] = std::thread([i]()
+			{
+				for(size_t j = 0U; j < ThreadLines; j++)
+				{
+					Console::Print(Format("thread {} line ", UInt64(i)));
+					Console::PrintLine(uint64_t(j));
+				}
+			});
+		}
+
+		for(std::thread& thread : threads)
+			thread.join();
+	}
+
+	size_t  next[ThreadCount] = {};
+	Boolean whole             = true;
+	{
+		FileLineReader reader = FileLineReader(String(CapturePath));
+
+		String line;
+		while(reader.TryReadLine(line))
+		{
+			Boolean matched = false;
+			for(size_t i = 0U; i < ThreadCount && !matched; i++)
+			{
+				if(line == Format("thread {} line {}", UInt64(i), UInt64(next[i])))
+				{
+					next[i]++;
+					matched = true;
+				}
+			}
+
+			whole = whole && matched;
+		}
+	}
+
+	for(size_t i = 0U; i < ThreadCount; i++)
+		whole = whole && next[i] == ThreadLines;
+
+	Check(whole, "Console keeps every line whole and in order"_s);
+
+	std::remove(CapturePath);
+}
+
+UInt32 RunConsoleTests()
+{
+	s_failures = 0U;
+
+	TestLinesStayWhole();
+	BenchmarkConsole();
+
+	return s_failures;
+}
@@ -0,0 +1,257 @@
+#include "Tests.hpp"
+
+#include <JamJar/Math/Fixed.hpp>
+#include <JamJar/Math/Random.hpp>
+
+#include <cmath>
+
+// Random operands per arithmetic check. Each result is compared with one worked out separately with plain integers.
+static const size_t SampleCount = 100000U;
+
+// Bodies moved per benchmark step, and steps per round.
+static const size_t BodyCount = 1U << 12U;
+static const size_t StepCount = 64U;
+
+using WrappingFixed32 = Fixed<16U, 16U, FixedMode::Wrap>;
+
+// Halfway cases away from zero, as Fixed rounds.
+static int64_t RoundedShift(int64_t value, size_t shift)
+{
+	uint64_t magnitude = value < 0 ? 0U - uint64_t(value) : uint64_t(value);
+	magnitude = (magnitude + (uint64_t(1) << (shift - 1U))) >> shift;
+	return value < 0 ? -int64_t(magnitude) : int64_t(magnitude);
+}
+
+static int64_t Saturated(int64_t value)
+{
+	return value < INT32_MIN ? INT32_MIN : value > INT32_MAX ? INT32_MAX : value;
+}
+
+static void TestUInt128()
+{
+	UInt128 largest = UInt128::Multiply(UINT64_MAX, UINT64_MAX);
+	Check(largest == UInt128(0xFFFFFFFFFFFFFFFEULL, 1U), "UInt128 multiplies the largest 64-bit values"_s);
+
+	uint64_t remainder;
+	Check(largest.Divide(UINT64_MAX, remainder) == UInt128(UINT64_MAX) && remainder == 0U, "UInt128 divides a square by its root"_s);
+	Check((UInt128(1U) << 127U) == UInt128(uint64_t(1) << 63U, 0U) && ((UInt128(1U) << 127U) >> 127U) == UInt128(1U), "UInt128 shifts across the halves"_s);
+	Check(UInt128(0U) - UInt128(1U) == UInt128(UINT64_MAX, UINT64_MAX) && UInt128(UINT64_MAX) + UInt128(1U) == UInt128(1U, 0U), "UInt128 carries and borrows"_s);
+
+	// a * b + c divided by b gives back a and c for any c below b.
+	Xoshiro256 generator(44U);
+	Boolean    exact = true;
+	for(size_t i = 0U; i < SampleCount; i++)
+	{
+		uint64_t a = generator.Next().ToRawValue();
+		uint64_t b = generator.Next().ToRawValue() >> (i % 64U);
+		if(b == 0U)
+			continue;
+
+		uint64_t c = generator.Next().ToRawValue() % b;
+
+		UInt128 quotient = (UInt128::Multiply(a, b) + UInt128(c)).Divide(b, remainder);
+		exact = exact && quotient == UInt128(a) && remainder == c;
+	}
+
+	Check(exact, "UInt128 division undoes multiplication"_s);
+}
+
+static void TestArithmetic()
+{
+	Check(Fixed32::Maximum + Fixed32::One == Fixed32::Maximum && Fixed32::Minimum - Fixed32::One == Fixed32::Minimum, "Fixed32 addition saturates"_s);
+	Check(WrappingFixed32::Maximum + WrappingFixed32::Epsilon == WrappingFixed32::Minimum, "Wrapping addition wraps"_s);
+	Check(Fixed32(200) * Fixed32(-200) == Fixed32::Minimum && WrappingFixed32(256) * WrappingFixed32(256) == WrappingFixed32::Zero, "Fixed32 products saturate or wrap"_s);
+	Check(Fixed32(-1) / Fixed32::Zero == Fixed32::Minimum && Fixed32::Zero / Fixed32::Zero == Fixed32::Zero && Fixed32(5) % Fixed32::Zero == Fixed32::Zero, "Division by zero gives the documented values"_s);
+
+	// The product of the raw values needs more than 64 bits here, so these go through UInt128.
+	Check(Fixed64(46000.5) * Fixed64(46000.25) == Fixed64(2116034500.125) && Fixed64(2116034500.125) / Fixed64(46000.25) == Fixed64(46000.5), "Fixed64 multiplies and divides through 128 bits"_s);
+	Check(Fixed64::FromRawValue(3) * Fixed64::FromRawValue(int64_t(1) << 31U) == Fixed64::FromRawValue(2) && Fixed64::FromRawValue(-3) * Fixed64::FromRawValue(int64_t(1) << 31U) == Fixed64::FromRawValue(-2), "Fixed64 products round halfway cases away from zero"_s);
+	Check(Fixed64(3037000499.0) * Fixed64(-3037000499.0) == Fixed64::Minimum && Fixed64::Minimum / Fixed64(0.5) == Fixed64::Minimum, "Fixed64 saturates past 64 bits"_s);
+
+	Xoshiro256 generator(4400U);
+	Boolean    products  = true;
+	Boolean    quotients = true;
+	for(size_t i = 0U; i < SampleCount; i++)
+	{
+		int32_t left  = int32_t(generator.Next().ToRawValue()) >> (i % 16U);
+		int32_t right = int32_t(generator.Next().ToRawValue()) >> (i % 31U);
+
+		Fixed32 product = Fixed32::FromRawValue(left) * Fixed32::FromRawValue(right);
+		products = products && product.ToRawValue() == Saturated(RoundedShift(int64_t(left) * int64_t(right), 16U));
+
+		if(right == 0)
+			continue;
+
+		// The quotient rounded to nearest is (2 * left * 2^16 / right + 1) / 2 in magnitude.
+		uint64_t numerator = uint64_t(std::abs(int64_t(left))) << 17U;
+		uint64_t divisor   = uint64_t(std::abs(int64_t(right)));
+		int64_t  quotient  = int64_t((numerator / divisor + 1U) / 2U);
+		if((left < 0) != (right < 0))
+			quotient = -quotient;
+
+		quotients = quotients && (Fixed32::FromRawValue(left) / Fixed32::FromRawValue(right)).ToRawValue() == Saturated(quotient);
+	}
+
+	Check(products, "Fixed32 products are rounded and saturated"_s);
+	Check(quotients, "Fixed32 quotients are rounded and saturated"_s);
+}
+
+static void TestFunctions()
+{
+	// root is the rounded square root of value exactly when (2 * root - 1)^2 <= 4 * value < (2 * root + 1)^2.
+	Xoshiro256 generator(4401U);
+	Boolean    roots = true;
+	for(size_t i = 0U; i < SampleCount; i++)
+	{
+		uint64_t raw32 = generator.Next().ToRawValue() >> (33U + i % 31U);
+		uint64_t root  = uint64_t(Fixed32::FromRawValue(int32_t(raw32)).Sqrt().ToRawValue());
+		uint64_t value = raw32 << 18U;
+		roots = roots && (root == 0U || (2U * root - 1U) * (2U * root - 1U) <= value) && value < (2U * root + 1U) * (2U * root + 1U);
+
+		uint64_t raw64    = generator.Next().ToRawValue() >> (1U + i % 63U);
+		uint64_t root64   = uint64_t(Fixed64::FromRawValue(int64_t(raw64)).Sqrt().ToRawValue());
+		UInt128  value64  = UInt128(raw64) << 34U;
+		roots = roots && (root64 == 0U || UInt128::Multiply(2U * root64 - 1U, 2U * root64 - 1U) <= value64) && value64 < UInt128::Multiply(2U * root64 + 1U, 2U * root64 + 1U);
+	}
+
+	Check(roots, "Sqrt rounds to nearest"_s);
+
+	// CORDIC is good to an eighth of the last place, and the result is rounded to the format after that.
+	double worst32 = 0.0;
+	double worst64 = 0.0;
+	for(size_t i = 0U; i < SampleCount; i++)
+	{
+		Fixed32 angle32 = Fixed32::FromRawValue(int32_t(generator.Next().ToRawValue()) >> 8U);
+		double  exact32 = double(Float64(angle32).ToRawValue());
+		worst32 = std::fmax(worst32, std::fabs(double(angle32.Sin().ToRawValue()) - std::sin(exact32) * 65536.0));
+		worst32 = std::fmax(worst32, std::fabs(double(angle32.Cos().ToRawValue()) - std::cos(exact32) * 65536.0));
+
+		// Angles below 2^20, where a double still holds the Fixed64 value exactly and its sine to well under a raw unit.
+		Fixed64 angle64 = Fixed64::FromRawValue(int64_t(generator.Next().ToRawValue()) >> 11U);
+		double  exact64 = double(Float64(angle64).ToRawValue());
+		worst64 = std::fmax(worst64, std::fabs(double(angle64.Sin().ToRawValue()) - std::sin(exact64) * 4294967296.0));
+		worst64 = std::fmax(worst64, std::fabs(double(angle64.Cos().ToRawValue()) - std::cos(exact64) * 4294967296.0));
+	}
+
+	Check(worst32 <= 0.625 && worst64 <= 0.7, "Sin and Cos are within five eighths of the last place"_s);
+}
+
+static void TestText()
+{
+	Check(Fixed32(1.5).ToString() == "1.5"_s && Fixed32(-0.25).ToString() == "-0.25"_s && Fixed32::Epsilon.ToString() == "0.00002"_s, "Fixed32 prints the shortest decimal"_s);
+	Check(Fixed64::Minimum.ToString() == "-2147483648"_s && Fixed32::Parse("-32768"_s) == Fixed32::Minimum, "Fixed prints and parses its limits"_s);
+
+	Fixed32 parsed;
+	Check(!Fixed32::TryParse("32768"_s, parsed) && !Fixed32::TryParse("1."_s, parsed) && !Fixed32::TryParse("1.2x"_s, parsed) && !Fixed32::TryParse(""_s, parsed), "Fixed32 rejects text out of range or malformed"_s);
+	Check(Fixed64::Parse("0.1"_s) == Fixed64::FromRawValue(429496730) && Fixed64::Parse("-0.1"_s) == Fixed64::FromRawValue(-429496730), "Fixed64 parses to the nearest value"_s);
+
+	Xoshiro256 generator(4402U);
+	Boolean    roundTrips = true;
+	for(size_t i = 0U; i < SampleCount / 10U; i++)
+	{
+		Fixed32 value32 = Fixed32::FromRawValue(int32_t(generator.Next().ToRawValue()));
+		Fixed64 value64 = Fixed64::FromRawValue(int64_t(generator.Next().ToRawValue()));
+		roundTrips = roundTrips && Fixed32::Parse(value32.ToString()) == value32 && Fixed64::Parse(value64.ToString()) == value64;
+	}
+
+	Check(roundTrips, "Fixed reads back what it prints"_s);
+}
+
+// A lockstep simulation must end up in the same state on every machine, so this checks a fixed sequence of steps
+// against the state it reached when the test was written.
+static void TestDeterminism()
+{
+	Fixed32 position = Fixed32(0.0);
+	Fixed32 velocity = Fixed32(10.0);
+	Fixed32 step     = Fixed32(1.0 / 60.0);
+	Fixed32 gravity  = Fixed32(-9.81);
+
+	uint64_t hash = 0U;
+	for(size_t i = 0U; i < 1000U; i++)
+	{
+		velocity += gravity * step;
+		position += velocity * step + (position * step).Sin() / Fixed32(8);
+		if(position < Fixed32::Zero)
+		{
+			position = -position;
+			velocity = -velocity * Fixed32(0.9) + (velocity * velocity).Sqrt() / Fixed32(100);
+		}
+
+		hash = hash * 31U + uint64_t(uint32_t(position.ToRawValue()));
+	}
+
+	Check(hash == 1595586904049781270ULL, "Fixed32 simulation reaches the recorded state"_s);
+}
+
+template<typename T>
+static void Integrate(T* positions, T* velocities, size_t count, T step, T drag)
+{
+	for(size_t i = 0U; i < count; i++)
+	{
+		velocities[i] = velocities[i] - velocities[i] * drag * step;
+		positions[i]  = positions[i] + velocities[i] * step;
+	}
+}
+
+template<typename T>
+static void Normalize(T* values, size_t count)
+{
+	for(size_t i = 0U; i < count; i++)
+		values[i] = values[i] / (values[i] * values[i] + T(1)).Sqrt();
+}
+
+template<typename T>
+static void Rotate(T* values, size_t count)
+{
+	for(size_t i = 0U; i < count; i++)
+		values[i] = values[i].Sin();
+}
+
+// Nanoseconds per body and step for each kernel.
+template<typename T>
+static void TimeKernels(double& integrate, double& normalize, double& rotate)
+{
+	HeapArray<T> positions(BodyCount);
+	HeapArray<T> velocities(BodyCount);
+	for(size_t i = 0U; i < BodyCount; i++)
+	{
+		positions[i]  = T(double(i) / 64.0);
+		velocities[i] = T(double(i % 17U) - 8.0);
+	}
+
+	T step = T(1.0 / 60.0);
+	T drag = T(0.25);
+
+	double scale = double(BodyCount * StepCount);
+	integrate = BestTime([&]() { for(size_t j = 0U; j < StepCount; j++) Opaque(Integrate<T>)(&positions[0U], &velocities[0U], BodyCount, step, drag); }) / scale;
+	normalize = BestTime([&]() { for(size_t j = 0U; j < StepCount; j++) Opaque(Normalize<T>)(&positions[0U], BodyCount); }) / scale;
+	rotate    = BestTime([&]() { for(size_t j = 0U; j < StepCount; j++) Opaque(Rotate<T>)(&positions[0U], BodyCount); }) / scale;
+}
+
+static void BenchmarkFixed()
+{
+	double float32[3];
+	double fixed32[3];
+	double fixed64[3];
+	TimeKernels<Float32>(float32[0], float32[1], float32[2]);
+	TimeKernels<Fixed32>(fixed32[0], fixed32[1], fixed32[2]);
+	TimeKernels<Fixed64>(fixed64[0], fixed64[1], fixed64[2]);
+
+	Console::PrintLine(Format("Fixed integrate: Float32 {} ns, Fixed32 {} ns, Fixed64 {} ns per body", Float64(float32[0]), Float64(fixed32[0]), Float64(fixed64[0])));
+	Console::PrintLine(Format("Fixed normalize: Float32 {} ns, Fixed32 {} ns, Fixed64 {} ns per body", Float64(float32[1]), Float64(fixed32[1]), Float64(fixed64[1])));
+	Console::PrintLine(Format("Fixed sine: Float32 {} ns, Fixed32 {} ns, Fixed64 {} ns per body", Float64(float32[2]), Float64(fixed32[2]), Float64(fixed64[2])));
+}
+
+UInt32 RunFixedTests()
+{
+	s_failures = 0U;
+
+	TestUInt128();
+	TestArithmetic();
+	TestFunctions();
+	TestText();
+	TestDeterminism();
+	BenchmarkFixed();
+
+	return s_failures;
+}
@@ -0,0 +1,260 @@
+#include "Tests.hpp"
+
+#include <JamJar/Math/Math.hpp>
+#include <JamJar/Math/Random.hpp>
+
+#include <bit>
+#include <cmath>
+
+// Every 16-bit pattern is checked. Conversions from Float32 are checked on these many random patterns besides the
+// edge cases below.
+static const size_t PatternCount = 1U << 16U;
+static const size_t SampleCount  = 1U << 20U;
+
+// The bandwidth benchmark works on 64 MB of Float32, well past any cache, in blocks converted on the stack.
+static const size_t StreamCount = 1U << 24U;
+static const size_t BlockLength = 1024U;
+
+static Boolean SameBits(float left, float right) { return std::bit_cast<uint32_t>(left) == std::bit_cast<uint32_t>(right); }
+
+template<size_t ExponentBits>
+static uint16_t Narrow(float value) { return HalfFloat<ExponentBits>(value).ToRawValue(); }
+
+template<size_t ExponentBits>
+static float Widen(uint16_t bits) { return Float32(HalfFloat<ExponentBits>::FromRawValue(bits)).ToRawValue(); }
+
+static void TestRounding()
+{
+	// Halfway cases go to the even neighbour, including the one between the largest value and infinity.
+	Check(Narrow<5U>(1.0f + 0x1.0p-11f) == 0x3C00U && Narrow<5U>(1.0f + 0x3.0p-11f) == 0x3C02U && Narrow<5U>(1.0f + 0x1.02p-11f) == 0x3C01U, "Float16 rounds ties to even"_s);
+	Check(Narrow<5U>(65519.0f) == 0x7BFFU && Narrow<5U>(65520.0f) == 0x7C00U && Narrow<5U>(-65520.0f) == 0xFC00U, "Float16 overflows to infinity past the last halfway point"_s);
+	Check(Narrow<8U>(1.0f + 0x1.0p-8f) == 0x3F80U && Narrow<8U>(1.0f + 0x3.0p-8f) == 0x3F82U && Narrow<8U>(FLT_MAX) == 0x7F80U, "BFloat16 rounds ties to even"_s);
+
+	// Subnormals are rounded in units of the smallest one, which is 2^-24.
+	Check(Narrow<5U>(0x1.0p-24f) == 0x0001U && Narrow<5U>(0x1.0p-25f) == 0x0000U && Narrow<5U>(0x1.0002p-25f) == 0x0001U && Narrow<5U>(0x3.0p-25f) == 0x0002U, "Float16 rounds subnormals to even"_s);
+	Check(Narrow<5U>(0x1.FFCp-15f) == 0x0400U && Narrow<5U>(0x1.FF8p-15f) == 0x03FFU && Narrow<5U>(-0x1.0p-26f) == 0x8000U && Widen<5U>(0x03FFU) == 0x0.FFCp-14f, "Float16 subnormals border the normal range"_s);
+	Check(Narrow<8U>(0x1.0p-133f) == 0x0001U && Narrow<8U>(0x1.0p-134f) == 0x0000U && Widen<8U>(0x0001U) == 0x1.0p-133f, "BFloat16 keeps Float32 subnormals"_s);
+
+	Check(Float16(double(0x1.0p-25) * (1.0 + 0x1.0p-40)).ToRawValue() == 0x0001U && Float16(1.0 + 0x1.0p-11 + 0x1.0p-40).ToRawValue() == 0x3C01U, "Float16 rounds from Float64 once"_s);
+}
+
+static void TestSpecialValues()
+{
+	Check(Float16(NAN).IsNaN() && BFloat16(-NAN).IsNaN() && Float16::NaN != Float16::NaN && !(Float16::NaN < Float16::One), "NaN stays NaN and compares unequal"_s);
+	Check(Float16(INFINITY).IsPositiveInfinity() && BFloat16(-INFINITY).IsNegativeInfinity() && (Float16::Maximum + Float16::Maximum).IsPositiveInfinity(), "Infinities convert and arithmetic overflows to them"_s);
+	Check(Float16(-0.0f) == Float16::Zero && Float16(-0.0f).ToRawValue() == 0x8000U && (-Float16::Zero).ToRawValue() == 0x8000U, "Negative zero equals zero but keeps its sign"_s);
+	Check(Float16::Maximum == Float16(65504.0f) && BFloat16::Maximum == BFloat16(0x1.FEp127f) && Float16::Epsilon == Float16(0x1.0p-14f), "The limits are the IEEE ones"_s);
+
+	// A signalling NaN comes out quiet, and a payload only in the low bits does not turn it into infinity.
+	Check(Narrow<5U>(std::bit_cast<float>(0x7F800001U)) == 0x7E00U && Narrow<8U>(std::bit_cast<float>(0xFF800001U)) == 0xFFC0U, "NaN payloads are made quiet"_s);
+}
+
+// Every pattern widens exactly, narrows back to itself, and the span conversions agree with the scalar ones bit for bit.
+template<size_t ExponentBits>
+static Boolean CheckAllPatterns()
+{
+	using Half = HalfFloat<ExponentBits>;
+
+	HeapArray<Half>    patterns(PatternCount);
+	HeapArray<Float32> widened(PatternCount);
+	HeapArray<Half>    narrowed(PatternCount);
+	for(size_t i = 0U; i < PatternCount; i++)
+		patterns[i] = Half::FromRawValue(uint16_t(i));
+
+	Math::Convert(patterns.AsSpan(), widened.AsSpan());
+	Math::Convert(widened.AsSpan(), narrowed.AsSpan());
+
+	Boolean matches = true;
+	for(size_t i = 0U; i < PatternCount; i++)
+	{
+		float scalar = Widen<ExponentBits>(uint16_t(i));
+		matches = matches && SameBits(widened[i].ToRawValue(), scalar) && narrowed[i].ToRawValue() == Narrow<ExponentBits>(scalar);
+
+		// Quieting a NaN is the only change a round trip may make.
+		if(!patterns[i].IsNaN())
+			matches = matches && narrowed[i].ToRawValue() == uint16_t(i);
+	}
+
+	return matches;
+}
+
+template<size_t ExponentBits>
+static Boolean CheckRandomNarrowing()
+{
+	using Half = HalfFloat<ExponentBits>;
+
+	HeapArray<Float32> values(SampleCount);
+	HeapArray<Half>    narrowed(SampleCount);
+
+	// Raw patterns cover NaNs and subnormals; the rest are spread around the Float16 range, where the rounding is.
+	Xoshiro256 generator(45U);
+	for(size_t i = 0U; i < SampleCount; i++)
+	{
+		uint64_t bits = generator.Next().ToRawValue();
+		if(i % 2U == 0U)
+			values[i] = std::bit_cast<float>(uint32_t(bits));
+		else
+			values[i] = std::ldexp(float(uint32_t(bits) >> 8U) * 0x1.0p-24f, int(bits >> 58U) - 30) * ((bits >> 40U) % 2U == 0U ? 1.0f : -1.0f);
+	}
+
+	Math::Convert(values.AsSpan(), narrowed.AsSpan());
+
+	Boolean matches = true;
+	for(size_t i = 0U; i < SampleCount; i++)
+		matches = matches && narrowed[i].ToRawValue() == Narrow<ExponentBits>(values[i].ToRawValue());
+
+	return matches;
+}
+
+static void TestConversions()
+{
+	Check(CheckAllPatterns<5U>(), "Float16 span conversions match the scalar ones on every value"_s);
+	Check(CheckAllPatterns<8U>(), "BFloat16 span conversions match the scalar ones on every value"_s);
+	Check(CheckRandomNarrowing<5U>() && CheckRandomNarrowing<8U>(), "Span narrowing matches the scalar constructors"_s);
+
+	// The tails shorter than a register are converted the same way.
+	HeapArray<Float32> values(19U);
+	for(size_t i = 0U; i < 19U; i++)
+		values[i] = Float32(1.0f + float(i) * 0x1.0p-11f);
+
+	Boolean matches = true;
+	for(Size length = 1U; length <= 19U; length++)
+	{
+		HeapArray<Float16> part(length);
+		Math::Convert(values.AsSpan(0U, length), part.AsSpan());
+		for(Size i = 0U; i < length; i++)
+			matches = matches && part[i].ToRawValue() == Narrow<5U>(values[i].ToRawValue());
+	}
+
+	Check(matches, "Span conversions handle every length"_s);
+}
+
+// Float32 holds every half precision sum, difference and product exactly and rounds quotients and roots finely enough
+// that rounding again to 16 bits is the same as rounding once, which Float64 shows.
+template<size_t ExponentBits>
+static Boolean CheckArithmetic()
+{
+	using Half = HalfFloat<ExponentBits>;
+
+	Xoshiro256 generator(4500U);
+	Boolean    exact = true;
+	for(size_t i = 0U; i < SampleCount; i++)
+	{
+		uint64_t bits  = generator.Next().ToRawValue();
+		Half     left  = Half::FromRawValue(uint16_t(bits));
+		Half     right = Half::FromRawValue(uint16_t(bits >> 16U));
+		if(left.IsNaN() || right.IsNaN())
+			continue;
+
+		double a = double(Widen<ExponentBits>(left.ToRawValue()));
+		double b = double(Widen<ExponentBits>(right.ToRawValue()));
+
+		exact = exact && (left + right).ToRawValue() == Half(a + b).ToRawValue() && (left * right).ToRawValue() == Half(a * b).ToRawValue();
+		if(b != 0.0)
+			exact = exact && (left / right).ToRawValue() == Half(a / b).ToRawValue();
+		if(a > 0.0)
+			exact = exact && left.Sqrt().ToRawValue() == Half(std::sqrt(a)).ToRawValue();
+	}
+
+	return exact;
+}
+
+static void TestArithmetic()
+{
+	Check(CheckArithmetic<5U>() && CheckArithmetic<8U>(), "Half precision arithmetic is correctly rounded"_s);
+	Check(Float16::Parse(Float16::PI.ToString()) == Float16::PI && BFloat16::Parse(BFloat16::PI.ToString()) == BFloat16::PI, "Half precision values read back what they print"_s);
+}
+
+// Eight running sums, so the additions are not chained one after another and the loop is bound by memory.
+static float SumFloat32(const Float32* values, size_t count)
+{
+	float sums[8] = {};
+	for(size_t i = 0U; i < count; i += 8U)
+	{
+		for(size_t j = 0U; j < 8U; j++)
+			sums[j] += values[i + j].ToRawValue();
+	}
+
+	return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+}
+
+// The same sum over half the bytes, widened a block at a time.
+template<typename Half>
+static float SumHalf(const HeapArray<Half>& values)
+{
+	StackArray<Float32, BlockLength> block;
+
+	float sum = 0.0f;
+	for(size_t i = 0U; i < StreamCount; i += BlockLength)
+	{
+		Math::Convert(values.AsSpan(i, BlockLength), block.AsSpan());
+		sum += SumFloat32(&block[0U], BlockLength);
+	}
+
+	return sum;
+}
+
+static void ScaleFloat32(Float32* values, size_t count, float factor)
+{
+	for(size_t i = 0U; i < count; i++)
+		values[i] = values[i].ToRawValue() * factor;
+}
+
+template<typename Half>
+static void ScaleHalf(HeapArray<Half>& values, float factor)
+{
+	StackArray<Float32, BlockLength> block;
+	for(size_t i = 0U; i < StreamCount; i += BlockLength)
+	{
+		Math::Convert(values.AsSpan(i, BlockLength), block.AsSpan());
+		ScaleFloat32(&block[0U], BlockLength, factor);
+		Math::Convert(block.AsSpan(), values.AsSpan(i, BlockLength));
+	}
+}
+
+static void BenchmarkBandwidth()
+{
+	HeapArray<Float32>  singles(StreamCount);
+	HeapArray<Float16>  halves(StreamCount);
+	HeapArray<BFloat16> brains(StreamCount);
+	for(size_t i = 0U; i < StreamCount; i++)
+		singles[i] = Float32(float(i % 1000U) * 0.001f);
+
+	Math::Convert(singles.AsSpan(), halves.AsSpan());
+	Math::Convert(singles.AsSpan(), brains.AsSpan());
+
+	volatile float sink;
+	double sum32 = BestTime([&]() { sink = Opaque(SumFloat32)(&singles[0U], StreamCount); });
+	double sum16 = BestTime([&]() { sink = Opaque(SumHalf<Float16>)(halves); });
+	double sumB  = BestTime([&]() { sink = Opaque(SumHalf<BFloat16>)(brains); });
+
+	// Scaling by one leaves the values as they are, so every round does the same work.
+	double scale32 = BestTime([&]() { Opaque(ScaleFloat32)(&singles[0U], StreamCount, 1.0f); });
+	double scale16 = BestTime([&]() { Opaque(ScaleHalf<Float16>)(halves, 1.0f); });
+	double scaleB  = BestTime([&]() { Opaque(ScaleHalf<BFloat16>)(brains, 1.0f); });
+
+	Console::PrintLine(Format("HalfFloat sum: Float32 {} ms, Float16 {} ms ({}x), BFloat16 {} ms ({}x)",
+		Float64(sum32 * 1e-6), Float64(sum16 * 1e-6), Float64(sum32 / sum16), Float64(sumB * 1e-6), Float64(sum32 / sumB)));
+	Console::PrintLine(Format("HalfFloat scale: Float32 {} ms, Float16 {} ms ({}x), BFloat16 {} ms ({}x)",
+		Float64(scale32 * 1e-6), Float64(scale16 * 1e-6), Float64(scale32 / scale16), Float64(scaleB * 1e-6), Float64(scale32 / scaleB)));
+
+	// Scaling reads and writes every value, so moving half the bytes shows most clearly there. The sums also depend
+	// on how fast the machine widens, which is close to the memory time on some. Without F16C, Float16 is converted
+	// with integer operations and is slower than Float32 either way.
+#if defined(NDEBUG) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+	Check(scale16 * 1.5 <= scale32, "Scaling Float16 is not 1.5 times as fast as Float32"_s);
+#endif
+}
+
+UInt32 RunHalfFloatTests()
+{
+	s_failures = 0U;
+
+	TestRounding();
+	TestSpecialValues();
+	TestConversions();
+	TestArithmetic();
+	BenchmarkBandwidth();
+
+	return s_failures;
+}
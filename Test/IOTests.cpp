@@ -0,0 +1,506 @@
+#include "Tests.hpp"
+
+#include <JamJar/IO/File.hpp>
+#include <JamJar/IO/AsyncFile.hpp>
+#include <JamJar/IO/MappedFile.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <cstdio>
+
+static const char* const TestPath = "IOTests.bin";
+
+// Larger than the default buffers, so reads and lines cross block boundaries.
+static const size_t LargeLineCount = 100000U;
+
+// AsyncFile is timed on random 4 KB reads from a file in the system cache, at each queue depth from 1 to 256, so the
+// numbers show what keeping more requests in flight saves over waiting on each one.
+static const size_t AsyncFileLength = 64U << 20U;
+static const size_t AsyncBlock      = 4096U;
+static const size_t AsyncReads      = 32768U;
+
+// MappedTextReader is timed in GB/s on a file of short lines, alone, across threads and against FileLineReader, which
+// copies each line into a String.
+static const size_t MappedLineCount = 2U << 20U;
+static const size_t MappedThreads   = 4U;
+
+static BufferSpan<UInt8> MakeBuffer(Size count)
+{
+	Buffer<UInt8> buffer(count);
+	return SharedBufferRef<UInt8>(buffer);
+}
+
+// A byte that depends on its position, so a read from the wrong offset shows.
+static uint8_t PatternByte(uint64_t position) { return uint8_t(position * 131U + (position >> 8U)); }
+
+static Boolean MatchesPattern(BufferSpan<UInt8> data, uint64_t position, Size count)
+{
+	const UInt8* bytes = data.ToUnsafePointer();
+	for(size_t i = 0U; i < count.ToRawValue(); i++)
+	{
+		if(bytes[i].ToRawValue() != PatternByte(position + i))
+			return false;
+	}
+
+	return true;
+}
+
+static void TestFileReadWrite()
+{
+	String path = String(TestPath);
+
+	// Small writes go through the buffer, a large one around it, and a zero buffer size still takes text.
+	BufferSpan<UInt8> data = MakeBuffer(3U << 20U);
+	UInt8* bytes = data.ToUnsafePointer();
+	for(size_t i = 0U; i < (3U << 20U); i++)
+		bytes[i] = PatternByte(i);
+
+	{
+		FileWriter writer(path, FileWriteMode::Create, 4096U);
+		writer.Write(data.Slice(0U, 100U));
+		writer.Write(data.Slice(100U, 4000U));
+		writer.Write(data.Slice(4100U, (3U << 20U) - 4100U));
+		Check(writer.GetPosition() == UInt64(3U << 20U), "FileWriter counts what it wrote"_s);
+		writer.Close();
+	}
+
+	{
+		FileReader reader(path, FileAccess::Sequential, false, 8192U);
+		Check(reader.GetLength() == UInt64(3U << 20U), "FileReader sees the whole file"_s);
+
+		BufferSpan<UInt8> small = MakeBuffer(1000U);
+		BufferSpan<UInt8> large = MakeBuffer(1U << 20U);
+
+		Check(reader.Read(small) == Size(1000U) && MatchesPattern(small, 0U, 1000U), "FileReader reads through its buffer"_s);
+		Check(reader.Read(large) == Size(1U << 20U) && MatchesPattern(large, 1000U, 1U << 20U), "FileReader reads around its buffer"_s);
+
+		reader.Seek(UInt64(2U << 20U));
+		Check(reader.Read(small) == Size(1000U) && MatchesPattern(small, 2U << 20U, 1000U), "FileReader seeks"_s);
+
+		Check(reader.ReadAt(12345U, small) == Size(1000U) && MatchesPattern(small, 12345U, 1000U), "FileReader reads at a position"_s);
+		Check(reader.GetPosition() == UInt64((2U << 20U) + 1000U), "ReadAt leaves the position alone"_s);
+
+		reader.Seek(UInt64((3U << 20U) - 10U));
+		Check(reader.Read(small) == Size(10U), "FileReader stops at the end"_s);
+	}
+
+	{
+		FileReader reader(path, FileAccess::Sequential, true);
+
+		BufferSpan<UInt8> large = MakeBuffer(1U << 20U);
+		Boolean matches = true;
+		for(uint64_t position = 0U; position < (3U << 20U); position += 1U << 20U)
+			matches = matches && reader.Read(large) == Size(1U << 20U) && MatchesPattern(large, position, 1U << 20U);
+
+		Check(matches, "FileReader reads around the system cache"_s);
+	}
+
+	{
+		FileWriter writer(path, FileWriteMode::Create, 0U);
+		writer.Write(String("caf\xC3\xA9 \xF0\x9F\x98\x80\n"));
+		writer.Close();
+
+		FileReader reader(path);
+		BufferSpan<UInt8> text = MakeBuffer(16U);
+		Check(reader.Read(text) == Size(11U) && memcmp(text.ToUnsafePointer(), "caf\xC3\xA9 \xF0\x9F\x98\x80\n", 11U) == 0, "FileWriter writes text as UTF-8"_s);
+	}
+
+	std::remove(TestPath);
+}
+
+static void TestFileAppend()
+{
+	String path = String(TestPath);
+
+	{
+		FileWriter writer(path);
+		writer.Write("first\n"_s);
+	}
+
+	// Two writers on the same file each add to its end, whichever flushes first.
+	{
+		FileWriter first(path, FileWriteMode::Append);
+		FileWriter second(path, FileWriteMode::Append);
+
+		first.Write("second\n"_s);
+		first.Flush();
+		second.Write("third\n"_s);
+		second.Flush();
+		first.Write("fourth\n"_s);
+	}
+
+	FileReader reader(path);
+	BufferSpan<UInt8> text = MakeBuffer(64U);
+	Check(reader.Read(text) == Size(26U) && memcmp(text.ToUnsafePointer(), "first\nsecond\nthird\nfourth\n", 26U) == 0, "Appending writers add to the end"_s);
+
+	std::remove(TestPath);
+}
+
+static void TestFileLines()
+{
+	String path = String(TestPath);
+
+	{
+		FileWriter writer(path);
+		writer.Write("one\r\ntwo\n\nfour"_s);
+	}
+
+	{
+		FileLineReader reader = FileLineReader(path);
+
+		String one, two, three, four, end;
+		Boolean read = reader.TryReadLine(one) && reader.TryReadLine(two) && reader.TryReadLine(three) && reader.TryReadLine(four);
+		Check(read && one == "one"_s && two == "two"_s && three == ""_s && four == "four"_s, "FileLineReader splits on either line ending"_s);
+		Check(!reader.TryReadLine(end), "FileLineReader stops at the end"_s);
+	}
+
+	{
+		FileWriter writer(path);
+		for(size_t i = 0U; i < LargeLineCount; i++)
+			writer.Write(Format("line {} of the file \xC3\xA9\n", UInt64(i)));
+	}
+
+	{
+		FileLineReader reader = FileLineReader(path);
+
+		String  line;
+		size_t  count   = 0U;
+		Boolean matches = true;
+		while(reader.TryReadLine(line))
+		{
+			matches = matches && line == Format("line {} of the file \xC3\xA9", UInt64(count));
+			count++;
+		}
+
+		Check(matches && count == LargeLineCount, "FileLineReader reads lines across blocks"_s);
+	}
+
+	std::remove(TestPath);
+}
+
+static void CountCompletion(AsyncRequest& request) { ((std::atomic<size_t>*)request.GetContext())->fetch_add(1U, std::memory_order_relaxed); }
+
+static void TestAsyncFile()
+{
+	String path = String(TestPath);
+
+	BufferSpan<UInt8> data = MakeBuffer(1U << 20U);
+	UInt8* bytes = data.ToUnsafePointer();
+	for(size_t i = 0U; i < (1U << 20U); i++)
+		bytes[i] = PatternByte(i);
+
+	std::atomic<size_t> completed = 0U;
+	{
+		AsyncFile file(path, AsyncFileMode::Create);
+
+		// Written as sixteen requests in one batch, out of order.
+		AsyncRequest requests[16];
+		for(size_t i = 0U; i < 16U; i++)
+		{
+			size_t block = (i * 7U) % 16U;
+			file.Write(UInt64(block << 16U), data.Slice(block << 16U, 1U << 16U), requests[i]);
+		}
+
+		AsyncFile::Submit();
+
+		Size written = 0U;
+		for(AsyncRequest& request : requests)
+			written += request.Wait();
+
+		Check(written == Size(1U << 20U) && file.GetLength() == UInt64(1U << 20U), "AsyncFile writes every request"_s);
+	}
+
+	{
+		AsyncFile file(path);
+
+		BufferSpan<UInt8> small = MakeBuffer(1000U);
+		BufferSpan<UInt8> tail  = MakeBuffer(4096U);
+
+		AsyncRequest request(CountCompletion, &completed);
+		file.Read(12345U, small, request);
+		Check(request.Wait() == Size(1000U) && MatchesPattern(small, 12345U, 1000U), "AsyncFile reads at a position"_s);
+
+		// A finished request can be used again, and a read past the end comes back short.
+		file.Read(UInt64((1U << 20U) - 100U), tail, request);
+		Check(request.Wait() == Size(100U) && MatchesPattern(tail, (1U << 20U) - 100U, 100U), "AsyncFile stops at the end"_s);
+		Check(request.IsCompleted() && request.GetResult() == SInt64(100), "AsyncFile keeps the result"_s);
+		Check(completed.load() == 2U, "AsyncFile calls back once per request"_s);
+
+		// More requests than the ring holds are submitted as the queue fills.
+		BufferSpan<UInt8> blocks   = MakeBuffer(1U << 20U);
+		AsyncRequest*     pending  = new AsyncRequest[512U];
+		Boolean           matches  = true;
+		for(size_t i = 0U; i < 512U; i++)
+			file.Read(UInt64(i * 2048U), blocks.Slice(i * 2048U, 2048U), pending[i]);
+
+		for(size_t i = 0U; i < 512U; i++)
+			matches = matches && pending[i].Wait() == Size(2048U);
+
+		delete[] pending;
+
+		Check(matches && MatchesPattern(blocks, 0U, 1U << 20U), "AsyncFile handles more requests than the queue holds"_s);
+	}
+
+	std::remove(TestPath);
+}
+
+// Keeps depth reads in flight until count have finished, each at a scattered block of the file.
+static size_t ReadAtDepth(const AsyncFile& file, BufferSpan<UInt8> buffers, AsyncRequest* requests, size_t depth)
+{
+	size_t blocks = AsyncFileLength / AsyncBlock;
+	size_t total  = 0U;
+	for(size_t i = 0U; i < AsyncReads; i++)
+	{
+		size_t slot = i % depth;
+		if(i >= depth)
+			total += requests[slot].Wait().ToRawValue();
+
+		size_t block = (i * 2654435761U) % blocks;
+		file.Read(UInt64(block * AsyncBlock), buffers.Slice(slot * AsyncBlock, AsyncBlock), requests[slot]);
+	}
+
+	for(size_t i = 0U; i < depth; i++)
+		total += requests[i].Wait().ToRawValue();
+
+	return total;
+}
+
+static void BenchmarkAsyncFile()
+{
+	String path = String(TestPath);
+	{
+		BufferSpan<UInt8> chunk = MakeBuffer(1U << 20U);
+		memset(chunk.ToUnsafePointer(), 0x5A, 1U << 20U);
+
+		FileWriter writer(path);
+		for(size_t i = 0U; i < (AsyncFileLength >> 20U); i++)
+			writer.Write(chunk);
+	}
+
+	BufferSpan<UInt8> buffers  = MakeBuffer(256U * AsyncBlock);
+	AsyncRequest*     requests = new AsyncRequest[256U];
+
+	StackArray<BufferSpan<UInt8>, 1> registered(buffers);
+	AsyncFile::RegisterBuffers(registered.AsSpan());
+
+	double rates[9];
+	{
+		AsyncFile file(path);
+
+		size_t index = 0U;
+		for(size_t depth = 1U; depth <= 256U; depth *= 2U, index++)
+		{
+			size_t total = 0U;
+			double time  = BestTime([&]() { total = ReadAtDepth(file, buffers, requests, depth); }, 3U);
+
+			Check(total == AsyncReads * AsyncBlock, "AsyncFile reads every block"_s);
+			rates[index] = double(AsyncReads) * 1e9 / time;
+		}
+	}
+
+	delete[] requests;
+
+	Console::PrintLine(Format("AsyncFile ({}): 4 KB reads/s at depth 1 {}, 2 {}, 4 {}, 8 {}, 16 {}, 32 {}, 64 {}, 128 {}, 256 {}",
+		AsyncFile::GetBackend() == AsyncBackend::IOUring ? "io_uring" : "thread pool",
+		Float64(rates[0]), Float64(rates[1]), Float64(rates[2]), Float64(rates[3]), Float64(rates[4]), Float64(rates[5]), Float64(rates[6]), Float64(rates[7]), Float64(rates[8])));
+
+	// Only the ring batches its system calls; the pool's threads cannot beat one read at a time on a cached file.
+#if defined(NDEBUG)
+	if(AsyncFile::GetBackend() == AsyncBackend::IOUring)
+		Check(rates[6] >= rates[0], "AsyncFile is slower at depth 64 than at depth 1"_s);
+#endif
+
+	std::remove(TestPath);
+}
+
+static void CountLines(TextChunk& chunk, Size index, void* context)
+{
+	TextLine line;
+	size_t   count = 0U;
+	while(chunk.TryReadLine(line))
+		count++;
+
+	((size_t*)context)[index.ToRawValue()] = count;
+}
+
+static void CountLinesOrThrow(TextChunk& chunk, Size index, void* context)
+{
+	CountLines(chunk, index, context);
+	if(index == Size(2U))
+		throw std::runtime_error("chunk 2");
+}
+
+static void TestMappedFile()
+{
+	String path = String(TestPath);
+
+	{
+		FileWriter writer(path);
+		writer.Write("first\r\n\nx\xFFy\ncaf\xC3\xA9\nlast", 22U);
+	}
+
+	{
+		MappedTextReader reader(path);
+		Check(reader.Count() == Size(22U), "MappedTextReader maps the whole file"_s);
+
+		TextLine first, empty, invalid;
+		Boolean  read = reader.TryReadLine(first) && reader.TryReadLine(empty) && reader.TryReadLine(invalid);
+		Check(read && first.Count() == Size(5U) && first.StartsWith("first") && empty.IsEmpty(), "MappedTextReader drops either line ending"_s);
+
+		String decoded = invalid.ToString();
+		Check(decoded.Length() == Size(3U) && decoded[1U] == Character(L'\uFFFD'), "TextLine replaces invalid UTF-8"_s);
+
+		String text, last, end;
+		read = reader.TryReadLine(text) && reader.TryReadLine(last);
+		Check(read && text == String("caf\xC3\xA9") && last == "last"_s, "MappedTextReader decodes lines"_s);
+		Check(!reader.TryReadLine(end), "MappedTextReader stops at the end"_s);
+	}
+
+	{
+		FileWriter writer(path);
+		for(size_t i = 0U; i < 10000U; i++)
+			writer.Write(Format("line {}\n", UInt64(i)));
+	}
+
+	{
+		MappedTextReader reader(path);
+
+		// The chunks cover the file in order, without gaps, and each but the last ends a line.
+		HeapArray<TextChunk> chunks   = reader.Split(7U);
+		const char*          next     = (const char*)nullptr;
+		Size                 total    = 0U;
+		Boolean              adjacent = true;
+		for(Size i = 0U; i < chunks.Count(); i++)
+		{
+			const TextChunk& chunk = chunks[i];
+			adjacent = adjacent && (next == nullptr || chunk.ToUnsafePointer() == next);
+			adjacent = adjacent && (chunk.Count() == Size(0U) || chunk.ToUnsafePointer()[chunk.Count().ToRawValue() - 1U] == '\n');
+
+			next   = chunk.ToUnsafePointer() + chunk.Count().ToRawValue();
+			total += chunk.Count();
+		}
+
+		Check(chunks.Count() == Size(7U) && adjacent && total == reader.Count(), "MappedTextReader splits on line boundaries"_s);
+
+		size_t counts[MappedThreads] = {};
+		reader.ReadParallel(CountLines, counts, MappedThreads);
+		Check(counts[0] + counts[1] + counts[2] + counts[3] == 10000U, "ReadParallel reads every line once"_s);
+
+		// The worker's exception reaches the caller only after the other chunks are done.
+		size_t  partial[MappedThreads] = {};
+		Boolean caught                 = false;
+		try
+		{
+			reader.ReadParallel(CountLinesOrThrow, partial, MappedThreads);
+		}
+		catch(const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		Check(caught && partial[0] + partial[1] + partial[2] + partial[3] == 10000U, "ReadParallel passes on a worker's exception"_s);
+	}
+
+	{
+		FileWriter writer(path);
+	}
+
+	{
+		MappedTextReader reader(path);
+
+		TextLine line;
+		Check(reader.Count() == Size(0U) && !reader.TryReadLine(line), "MappedTextReader reads an empty file"_s);
+	}
+
+	std::remove(TestPath);
+}
+
+static size_t CountMappedLines(const String& path)
+{
+	MappedTextReader reader(path);
+
+	TextLine line;
+	size_t   count = 0U;
+	while(reader.TryReadLine(line))
+		count++;
+
+	return count;
+}
+
+static size_t CountMappedLinesParallel(const String& path)
+{
+	MappedTextReader reader(path);
+
+	size_t counts[MappedThreads] = {};
+	reader.ReadParallel(CountLines, counts, MappedThreads);
+
+	size_t count = 0U;
+	for(size_t chunk : counts)
+		count += chunk;
+
+	return count;
+}
+
+static size_t CountFileLines(const String& path)
+{
+	FileLineReader reader = FileLineReader(path);
+
+	String line;
+	size_t count = 0U;
+	while(reader.TryReadLine(line))
+		count++;
+
+	return count;
+}
+
+static void BenchmarkMappedFile()
+{
+	String path = String(TestPath);
+	{
+		FileWriter writer(path);
+		for(size_t i = 0U; i < MappedLineCount; i++)
+			writer.Write(Format("2024-05-01 12:00:00,{},sensor,{}\n", UInt64(i), UInt64(i * 7U % 1000U)));
+	}
+
+	size_t length;
+	{
+		MappedFile file(path);
+		length = file.Count().ToRawValue();
+	}
+
+	size_t mappedLines   = 0U;
+	size_t parallelLines = 0U;
+	size_t fileLines     = 0U;
+
+	double mapped   = BestTime([&]() { mappedLines   = Opaque(CountMappedLines)(path); }, 3U);
+	double parallel = BestTime([&]() { parallelLines = Opaque(CountMappedLinesParallel)(path); }, 3U);
+	double file     = BestTime([&]() { fileLines     = Opaque(CountFileLines)(path); }, 3U);
+
+	Check(mappedLines == MappedLineCount && parallelLines == MappedLineCount && fileLines == MappedLineCount, "Line readers count every line"_s);
+
+	Console::PrintLine(Format("MappedTextReader: {} GB/s, {} GB/s on {} threads, FileLineReader {} GB/s",
+		Float64(double(length) / mapped), Float64(double(length) / parallel), UInt64(MappedThreads), Float64(double(length) / file)));
+
+#if defined(NDEBUG)
+	Check(mapped <= file, "MappedTextReader is slower than FileLineReader"_s);
+#endif
+
+	std::remove(TestPath);
+}
+
+UInt32 RunIOTests()
+{
+	s_failures = 0U;
+
+	TestFileReadWrite();
+	TestFileAppend();
+	TestFileLines();
+	TestAsyncFile();
+	BenchmarkAsyncFile();
+	TestMappedFile();
+	BenchmarkMappedFile();
+
+	return s_failures;
+}
@@ -0,0 +1,106 @@
+#include "Tests.hpp"
+
+#include <JamJar/Logging/Logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// The producer's side of a log call must stay cheap enough for hot paths: the request puts the 99th percentile of a
+// call with two numeric arguments under 100 ns. Each call is timed on its own and the cost of reading the clock, taken
+// the same way, is subtracted.
+static const size_t LatencyCalls   = 100000U;
+static const double AllowedLatency = 100.0;
+
+// Keeps what the background thread writes, so the test can look at it.
+class CaptureLogSink : public LogSink
+{
+private:
+	StringBuilder m_text;
+public:
+	virtual void Write(const String& text) override { m_text.Append(text); }
+
+	String GetText() { return m_text.ToString(); }
+};
+
+// The given percentile of the samples, which it sorts.
+static uint64_t Percentile(uint64_t* samples, size_t count, double percentile)
+{
+	std::sort(samples, samples + count);
+	return samples[size_t(double(count - 1U) * percentile)];
+}
+
+static void MeasureLatency()
+{
+	uint64_t* clock = (uint64_t*)malloc(LatencyCalls * sizeof(uint64_t));
+	uint64_t* calls = (uint64_t*)malloc(LatencyCalls * sizeof(uint64_t));
+
+	for(size_t i = 0U; i < LatencyCalls; i++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point end   = std::chrono::steady_clock::now();
+		clock[i] = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	UInt64 dropped = Logger::GetDroppedCount();
+
+	for(size_t i = 0U; i < LatencyCalls; i++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Logger::Debug("Frame {} took {} ms", UInt64(i), Float64(double(i) * 0.25));
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		calls[i] = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	// A dropped record costs less than a written one, so the numbers only count if nothing was dropped.
+	Check(Logger::GetDroppedCount() == dropped, "Logger latency run dropped records"_s);
+
+	double overhead = double(Percentile(clock, LatencyCalls, 0.5));
+	double median   = double(Percentile(calls, LatencyCalls, 0.5))  - overhead;
+	double p99      = double(Percentile(calls, LatencyCalls, 0.99)) - overhead;
+
+	Console::PrintLine(Format("Logger: median {} ns, p99 {} ns per call", Float64(median), Float64(p99)));
+
+	// On a single core the background thread's time slices land inside the timed calls, so the bound cannot hold there.
+#if defined(NDEBUG)
+	if(std::thread::hardware_concurrency() > 1U)
+		Check(p99 < AllowedLatency, "Logger p99 latency"_s);
+#endif
+
+	free(clock);
+	free(calls);
+}
+
+UInt32 RunLoggerTests()
+{
+	s_failures = 0U;
+
+	SharedRef<CaptureLogSink> sink;
+	Logger::AddSink(SharedRef<LogSink>(sink));
+
+	Logger::Information("Loaded {} of {} assets ({})", UInt32(3U), UInt32(4U), "textures");
+	Logger::Warning("{{escaped}} {}", Float64(0.5));
+	Logger::Flush();
+
+	String text = sink->GetText();
+	Check(text.Contains("[Information] Loaded 3 of 4 assets (textures)\n"_s), "Logger formats arguments"_s);
+	Check(text.Contains("[Warning] {escaped} 0.5\n"_s), "Logger escapes braces"_s);
+
+	// Below the run-time level nothing reaches the sinks.
+	Logger::SetLevel(LogLevel::Error);
+	Logger::Information("Hidden");
+	Logger::Flush();
+	Check(!sink->GetText().Contains("Hidden"_s), "Logger level filter"_s);
+	Logger::SetLevel(LogLevel::Trace);
+
+	// On a thread of its own, so its ring can hold every record of the run without waiting for the writer.
+	Size capacity = Logger::GetRingCapacity();
+	Logger::SetRingCapacity(Size(16U * 1024U * 1024U));
+	std::thread([]() { MeasureLatency(); }).join();
+	Logger::SetRingCapacity(capacity);
+
+	Logger::Flush();
+	Check(sink->GetText().Contains("Frame 99999 took 24999.75 ms"_s), "Logger writes every record"_s);
+
+	return s_failures;
+}
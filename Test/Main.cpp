@@ -4,6 +4,8 @@
 
 #include <JamJar/Dynamic.hpp>
 
+#include "Tests.hpp"
+
 ExitStatus Start()
 {
 	const TypeInfo& stringType = Reflect::GetType<MutableString>();
@@ -22,5 +24,9 @@ ExitStatus Start()
 
 	//Console::PrintLine(array);
 
+	UInt32 failures = RunNumberFormatTests() + RunNumericsTests() + RunLoggerTests() + RunStringTests() + RunConsoleTests() + RunIOTests() + RunSerializationTests() + RunMathTests() + RunFixedTests() + RunHalfFloatTests() + RunRandomTests() + RunBigIntegerTests() + RunVectorTests() + RunVectorStreamTests();
+	if(failures != 0U)
+		return ExitStatus::ERROR;
+
 	return ExitStatus::OK;
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "Tests.hpp"
+
+#include <JamJar/Math/Math.hpp>
+
+#include <cmath>
+
+// The batch functions are timed on spans of this many values against a loop of the C library's scalar function, and
+// their errors are measured on the same values against a double precision reference.
+static const size_t BatchCount = 1U << 14U;
+
+// The table in Math.hpp, for Float32 over the ranges the inputs below are drawn from.
+static const double SinCosUlps     = 0.5;
+static const double FastSinCosUlps = 1.5;
+static const double ExpUlps        = 0.5;
+static const double FastExpUlps    = 1.3;
+static const double LogUlps        = 0.5;
+static const double FastLogUlps    = 1.0;
+static const double PowUlps        = 0.5;
+static const double FastPowUlps    = 120.0;
+
+// Rounding the reference to Float32 can leave it just past the documented bound, so this much is allowed on top.
+static const double ReferenceUlps = 0.01;
+
+template<typename T>
+using BatchFunction = void (*)(const ArraySpan<Float<T>>&, ArraySpan<Float<T>>);
+
+template<typename T>
+using BatchPowFunction = void (*)(const ArraySpan<Float<T>>&, const ArraySpan<Float<T>>&, ArraySpan<Float<T>>);
+
+template<typename T>
+using ScalarFunction = void (*)(const Float<T>*, Float<T>*, size_t);
+
+// The distance from value to exact in units in the last place of Float32 at exact.
+static double UlpError(float value, double exact)
+{
+	float  magnitude = std::fabs(float(exact));
+	double ulp       = double(std::nextafter(magnitude, INFINITY)) - double(magnitude);
+	return std::fabs(double(value) - exact) / ulp;
+}
+
+// Evenly spread over [minimum, maximum], so every part of the range is covered the same way on every run.
+template<typename T>
+static HeapArray<Float<T>> Spread(T minimum, T maximum)
+{
+	HeapArray<Float<T>> values(BatchCount);
+	for(size_t i = 0U; i < BatchCount; i++)
+		values[i] = Float<T>(minimum + (maximum - minimum) * T(i) / T(BatchCount - 1U));
+
+	return values;
+}
+
+template<typename T> static void ScalarSin (const Float<T>* input, Float<T>* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = Float<T>(std::sin (input[i].ToRawValue())); }
+template<typename T> static void ScalarCos (const Float<T>* input, Float<T>* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = Float<T>(std::cos (input[i].ToRawValue())); }
+template<typename T> static void ScalarExp (const Float<T>* input, Float<T>* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = Float<T>(std::exp (input[i].ToRawValue())); }
+template<typename T> static void ScalarLog (const Float<T>* input, Float<T>* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = Float<T>(std::log (input[i].ToRawValue())); }
+template<typename T> static void ScalarSqrt(const Float<T>* input, Float<T>* output, size_t count) { for(size_t i = 0U; i < count; i++) output[i] = Float<T>(std::sqrt(input[i].ToRawValue())); }
+
+template<typename T>
+static void ScalarPow(const Float<T>* base, const Float<T>* exponent, Float<T>* output, size_t count)
+{
+	for(size_t i = 0U; i < count; i++)
+		output[i] = Float<T>(std::pow(base[i].ToRawValue(), exponent[i].ToRawValue()));
+}
+
+// The largest error of a Float32 batch function over the inputs.
+template<typename Function, typename Reference>
+static double MaximumUlps(Function function, Reference reference, const HeapArray<Float32>& input)
+{
+	HeapArray<Float32> output(BatchCount);
+	function(input.AsSpan(), output.AsSpan());
+
+	double worst = 0.0;
+	for(size_t i = 0U; i < BatchCount; i++)
+	{
+		double error = UlpError(output[i].ToRawValue(), reference(double(input[i].ToRawValue())));
+		if(error > worst)
+			worst = error;
+	}
+
+	return worst;
+}
+
+static void TestBatchAccuracy()
+{
+	HeapArray<Float32> angles      = Spread(-100.0f, 100.0f);
+	HeapArray<Float32> smallAngles = Spread(-3.14159f, 3.14159f);
+	HeapArray<Float32> exponents   = Spread(-80.0f, 80.0f);
+	HeapArray<Float32> positives   = Spread(1e-3f, 1e6f);
+
+	double (*sine)  (double) = std::sin;
+	double (*cosine)(double) = std::cos;
+	double (*exp)   (double) = std::exp;
+	double (*log)   (double) = std::log;
+
+	BatchFunction<float> sin32     = Math::Sin;
+	BatchFunction<float> fastSin32 = Math::FastSin;
+	BatchFunction<float> cos32     = Math::Cos;
+	BatchFunction<float> fastCos32 = Math::FastCos;
+	BatchFunction<float> exp32     = Math::Exp;
+	BatchFunction<float> fastExp32 = Math::FastExp;
+	BatchFunction<float> log32     = Math::Log;
+	BatchFunction<float> fastLog32 = Math::FastLog;
+
+	Check(MaximumUlps(sin32, sine, angles) <= SinCosUlps + ReferenceUlps && MaximumUlps(cos32, cosine, angles) <= SinCosUlps + ReferenceUlps, "Sin and Cos are within their ULP bound"_s);
+	Check(MaximumUlps(fastSin32, sine, smallAngles) <= FastSinCosUlps + ReferenceUlps && MaximumUlps(fastCos32, cosine, smallAngles) <= FastSinCosUlps + ReferenceUlps, "FastSin and FastCos are within their ULP bound"_s);
+	Check(MaximumUlps(exp32, exp, exponents) <= ExpUlps + ReferenceUlps && MaximumUlps(fastExp32, exp, exponents) <= FastExpUlps + ReferenceUlps, "Exp is within its ULP bounds"_s);
+	Check(MaximumUlps(log32, log, positives) <= LogUlps + ReferenceUlps && MaximumUlps(fastLog32, log, positives) <= FastLogUlps + ReferenceUlps, "Log is within its ULP bounds"_s);
+
+	// Powers between 1e-10 and 1e10, well inside the range the fast bound is given for.
+	HeapArray<Float32> bases       = Spread(0.1f, 10.0f);
+	HeapArray<Float32> powers      = Spread(-10.0f, 10.0f);
+	HeapArray<Float32> accurate(BatchCount);
+	HeapArray<Float32> fast(BatchCount);
+	Math::Pow(bases.AsSpan(), powers.AsSpan(), accurate.AsSpan());
+	Math::FastPow(bases.AsSpan(), powers.AsSpan(), fast.AsSpan());
+
+	double accurateWorst = 0.0;
+	double fastWorst     = 0.0;
+	for(size_t i = 0U; i < BatchCount; i++)
+	{
+		double exact = std::pow(double(bases[i].ToRawValue()), double(powers[i].ToRawValue()));
+		accurateWorst = std::fmax(accurateWorst, UlpError(accurate[i].ToRawValue(), exact));
+		fastWorst     = std::fmax(fastWorst,     UlpError(fast[i].ToRawValue(),     exact));
+	}
+
+	Check(accurateWorst <= PowUlps + ReferenceUlps && fastWorst <= FastPowUlps, "Pow is within its ULP bounds"_s);
+
+	// Sqrt is correctly rounded, so it matches the C library exactly.
+	HeapArray<Float32> roots(BatchCount);
+	HeapArray<Float32> scalarRoots(BatchCount);
+	Math::Sqrt(positives.AsSpan(), roots.AsSpan());
+	ScalarSqrt(&positives[0U], &scalarRoots[0U], BatchCount);
+	Check(memcmp(&roots[0U], &scalarRoots[0U], BatchCount * sizeof(Float32)) == 0, "Sqrt is correctly rounded"_s);
+
+	// Every lane of a register and the scalar tail are handled alike, whatever the length of the span.
+	HeapArray<Float32> whole(BatchCount);
+	Math::Sin(angles.AsSpan(), whole.AsSpan());
+
+	Boolean matches = true;
+	for(Size length = 1U; length <= 17U; length++)
+	{
+		HeapArray<Float32> part(length);
+		Math::Sin(angles.AsSpan(3U, length), part.AsSpan());
+		matches = matches && memcmp(&part[0U], &whole[3U], (length * sizeof(Float32)).ToRawValue()) == 0;
+	}
+
+	Check(matches, "Batch functions give the same values for any span length"_s);
+}
+
+// The speedups of the accurate and fast variants over a loop of the C library's function, printed and returned.
+template<typename T>
+static void CompareBatch(const String& name, BatchFunction<T> accurate, BatchFunction<T> fast, ScalarFunction<T> scalar, const HeapArray<Float<T>>& input, double& accurateSpeedup, double& fastSpeedup)
+{
+	HeapArray<Float<T>> output(BatchCount);
+
+	double library   = BestTime([&]() { Opaque(scalar)(&input[0U], &output[0U], BatchCount); });
+	double batch     = BestTime([&]() { Opaque(accurate)(input.AsSpan(), output.AsSpan()); });
+	double batchFast = BestTime([&]() { Opaque(fast)(input.AsSpan(), output.AsSpan()); });
+
+	accurateSpeedup = library / batch;
+	fastSpeedup     = library / batchFast;
+
+	Console::PrintLine(Format("Math {}: C library {} ns, batch {} ns ({}x), fast {} ns ({}x) per value", name,
+		Float64(library / double(BatchCount)), Float64(batch / double(BatchCount)), Float64(accurateSpeedup), Float64(batchFast / double(BatchCount)), Float64(fastSpeedup)));
+}
+
+template<typename T>
+static void BenchmarkBatch(const String& type)
+{
+	HeapArray<Float<T>> angles    = Spread(T(-3.14159), T(3.14159));
+	HeapArray<Float<T>> exponents = Spread(T(-20), T(20));
+	HeapArray<Float<T>> positives = Spread(T(1e-3), T(1e6));
+
+	double accurate[4];
+	double fast[4];
+	CompareBatch<T>(type + " Sin"_s, Math::Sin, Math::FastSin, ScalarSin<T>, angles,    accurate[0], fast[0]);
+	CompareBatch<T>(type + " Cos"_s, Math::Cos, Math::FastCos, ScalarCos<T>, angles,    accurate[1], fast[1]);
+	CompareBatch<T>(type + " Exp"_s, Math::Exp, Math::FastExp, ScalarExp<T>, exponents, accurate[2], fast[2]);
+	CompareBatch<T>(type + " Log"_s, Math::Log, Math::FastLog, ScalarLog<T>, positives, accurate[3], fast[3]);
+
+	HeapArray<Float<T>> output(BatchCount);
+	HeapArray<Float<T>> bases = Spread(T(0.1), T(10));
+
+	BatchPowFunction<T> pow     = Math::Pow;
+	BatchPowFunction<T> fastPow = Math::FastPow;
+	BatchFunction<T>    sqrt    = Math::Sqrt;
+
+	double libraryPow  = BestTime([&]() { Opaque(ScalarPow<T>)(&bases[0U], &exponents[0U], &output[0U], BatchCount); });
+	double batchPow    = BestTime([&]() { Opaque(pow)(bases.AsSpan(), exponents.AsSpan(), output.AsSpan()); });
+	double batchFastPow = BestTime([&]() { Opaque(fastPow)(bases.AsSpan(), exponents.AsSpan(), output.AsSpan()); });
+
+	double librarySqrt = BestTime([&]() { Opaque(ScalarSqrt<T>)(&positives[0U], &output[0U], BatchCount); });
+	double batchSqrt   = BestTime([&]() { Opaque(sqrt)(positives.AsSpan(), output.AsSpan()); });
+
+	Console::PrintLine(Format("Math {} Pow: C library {} ns, batch {}x, fast {}x; Sqrt: C library {} ns, batch {}x", type,
+		Float64(libraryPow / double(BatchCount)), Float64(libraryPow / batchPow), Float64(libraryPow / batchFastPow), Float64(librarySqrt / double(BatchCount)), Float64(librarySqrt / batchSqrt)));
+
+	// The fast variants are the point of the batch functions and must beat the scalar loop everywhere. With only SSE2
+	// they work on four floats at a time, which is about as fast as the best C libraries' own Log and Pow.
+#if defined(NDEBUG) && defined(__AVX2__)
+	Boolean faster = batchFastPow < libraryPow;
+	for(size_t i = 0U; i < 4U; i++)
+		faster = faster && fast[i] > 1.0;
+
+	Check(faster, "Fast batch "_s + type + " functions are slower than the C library"_s);
+#endif
+}
+
+UInt32 RunMathTests()
+{
+	s_failures = 0U;
+
+	TestBatchAccuracy();
+	BenchmarkBatch<float>("Float32"_s);
+	BenchmarkBatch<double>("Float64"_s);
+
+	return s_failures;
+}
@@ -0,0 +1,204 @@
+#include "Tests.hpp"
+
+#include <charconv>
+
+// Formatting and parsing are timed against std::to_chars and std::from_chars over the same values. NumberFormat writes
+// wide characters straight into a String's storage, which the standard functions cannot, so they are the baseline it
+// has to stay close to.
+static const size_t FormatCount        = 1U << 16U;
+static const double AllowedFormatRatio = 1.5;
+
+template<typename T>
+static void CheckParses(const String& string, T expected)
+{
+	T result;
+	Check(T::TryParse(string, result) && result == expected, string);
+}
+
+template<typename T>
+static void CheckRejects(const String& string)
+{
+	T result;
+	Check(!T::TryParse(string, result), string);
+}
+
+// Spread over every digit count, so branch prediction does not see one length over and over.
+static uint64_t FormatValue(size_t index)
+{
+	uint64_t value = uint64_t(index) * 0x9E3779B97F4A7C15ULL;
+	return value >> (index % 64U);
+}
+
+static Boolean ParseNumber(const wchar_t* characters, size_t length, uint64_t& result) { return NumberFormat::Parse(characters, length, UINT64_MAX, result); }
+static Boolean ParseNumber(const wchar_t* characters, size_t length, double&   result) { return NumberFormat::Parse(characters, length, result); }
+
+// Each writes every value followed by a space, which neither parser takes, and returns the length.
+template<typename T>
+static size_t FormatAll(const T* values, wchar_t* destination)
+{
+	size_t count = 0U;
+	for(size_t i = 0U; i < FormatCount; i++)
+	{
+		count += NumberFormat::Format(values[i], destination + count);
+		destination[count++] = L' ';
+	}
+
+	return count;
+}
+
+template<typename T>
+static size_t ToCharsAll(const T* values, char* destination)
+{
+	char* end = destination;
+	for(size_t i = 0U; i < FormatCount; i++)
+	{
+		end = std::to_chars(end, end + NumberFormat::MaximumFloatLength, values[i]).ptr;
+		*end++ = ' ';
+	}
+
+	return size_t(end - destination);
+}
+
+// Each reads the numbers back into the array and returns whether all of them parsed.
+template<typename T>
+static Boolean ParseAll(const wchar_t* characters, size_t length, T* values)
+{
+	Boolean valid = true;
+	for(size_t start = 0U, end = 0U; start < length; start = end + 1U)
+	{
+		for(end = start; characters[end] != L' '; end++) {}
+
+		valid = valid && ParseNumber(characters + start, end - start, *values++);
+	}
+
+	return valid;
+}
+
+template<typename T>
+static Boolean FromCharsAll(const char* characters, size_t length, T* values)
+{
+	Boolean valid = true;
+	for(size_t start = 0U, end = 0U; start < length; start = end + 1U)
+	{
+		for(end = start; characters[end] != ' '; end++) {}
+
+		valid = valid && std::from_chars(characters + start, characters + end, *values++).ec == std::errc();
+	}
+
+	return valid;
+}
+
+// Both in nanoseconds for every number.
+static void CompareFormat(const String& name, double standard, double format)
+{
+	standard /= double(FormatCount);
+	format   /= double(FormatCount);
+
+	Console::PrintLine(Format("{}: standard {} ns, NumberFormat {} ns per number", name, Float64(standard), Float64(format)));
+
+#if defined(NDEBUG)
+	Check(format <= standard * AllowedFormatRatio, name + " is slower than the standard library"_s);
+#endif
+}
+
+// Writes the values with both, checks that they agree character for character and that NumberFormat reads its own
+// output back exactly, then times the two.
+template<typename T>
+static void CompareWithStandard(const String& name, const T* values)
+{
+	size_t   capacity = FormatCount * (NumberFormat::MaximumFloatLength + 1U);
+	wchar_t* wide     = (wchar_t*)malloc(capacity * sizeof(wchar_t));
+	char*    narrow   = (char*)malloc(capacity);
+	T*       parsed   = (T*)malloc(FormatCount * sizeof(T));
+
+	size_t wideLength   = FormatAll(values, wide);
+	size_t narrowLength = ToCharsAll(values, narrow);
+
+	Boolean same = wideLength == narrowLength;
+	for(size_t i = 0U; same && i < wideLength; i++)
+		same = wide[i] == wchar_t(narrow[i]);
+
+	Check(same, name + " format as std::to_chars does"_s);
+	Check(ParseAll(wide, wideLength, parsed) && memcmp(parsed, values, FormatCount * sizeof(T)) == 0, name + " read back"_s);
+
+	// The sink keeps the results alive, so the loops cannot be left out.
+	volatile size_t sink = 0U;
+
+	CompareFormat("Format "_s + name,
+		BestTime([&]() { sink = sink + Opaque(ToCharsAll<T>)(values, narrow); }),
+		BestTime([&]() { sink = sink + Opaque(FormatAll<T>)(values, wide); }));
+
+	CompareFormat("Parse "_s + name,
+		BestTime([&]() { sink = sink + Opaque(FromCharsAll<T>)(narrow, narrowLength, parsed); }),
+		BestTime([&]() { sink = sink + Opaque(ParseAll<T>)(wide, wideLength, parsed); }));
+
+	free(wide);
+	free(narrow);
+	free(parsed);
+}
+
+static void BenchmarkFormat()
+{
+	uint64_t* integers = (uint64_t*)malloc(FormatCount * sizeof(uint64_t));
+	double*   doubles  = (double*)malloc(FormatCount * sizeof(double));
+	for(size_t i = 0U; i < FormatCount; i++)
+	{
+		integers[i] = FormatValue(i);
+		doubles[i]  = double(int64_t(FormatValue(i) >> 11U) - (int64_t(1) << 52U)) * pow(10.0, double(int(i % 41U) - 20));
+	}
+
+	CompareWithStandard("integers"_s, integers);
+	CompareWithStandard("doubles"_s, doubles);
+
+	free(integers);
+	free(doubles);
+}
+
+UInt32 RunNumberFormatTests()
+{
+	s_failures = 0U;
+
+	// A chunk of eight digits above the maximum, with and without leading zeros.
+	CheckParses<UInt8>("255"_s, UInt8(255U));
+	CheckParses<UInt8>("00000255"_s, UInt8(255U));
+	CheckRejects<UInt8>("256"_s);
+	CheckRejects<UInt8>("00000300"_s);
+	CheckRejects<UInt8>("000000000300"_s);
+
+	CheckParses<UInt16>("65535"_s, UInt16(65535U));
+	CheckParses<UInt16>("+00065535"_s, UInt16(65535U));
+	CheckRejects<UInt16>("65536"_s);
+	CheckRejects<UInt16>("12345678"_s);
+
+	// A single digit above the maximum.
+	CheckParses<SInt8>("-128"_s, SInt8(-128));
+	CheckParses<SInt8>("127"_s, SInt8(127));
+	CheckParses<SInt8>("-00000128"_s, SInt8(-128));
+	CheckRejects<SInt8>("-129"_s);
+	CheckRejects<SInt8>("128"_s);
+	CheckRejects<SInt8>("-00001000"_s);
+
+	CheckParses<UInt64>("18446744073709551615"_s, UInt64(UINT64_MAX));
+	CheckParses<UInt64>("000000000000000018446744073709551615"_s, UInt64(UINT64_MAX));
+	CheckRejects<UInt64>("18446744073709551616"_s);
+	CheckRejects<UInt64>("99999999999999999999"_s);
+
+	CheckParses<SInt64>("-9223372036854775808"_s, SInt64(INT64_MIN));
+	CheckParses<SInt64>("9223372036854775807"_s, SInt64(INT64_MAX));
+	CheckRejects<SInt64>("-9223372036854775809"_s);
+	CheckRejects<SInt64>("9223372036854775808"_s);
+
+	// Signs, the same for integers and floats.
+	CheckParses<Float32>("+1.5"_s, Float32(1.5f));
+	CheckParses<Float32>("-1.5"_s, Float32(-1.5f));
+	CheckRejects<Float32>("+"_s);
+	CheckRejects<Float32>("+-1.5"_s);
+	CheckRejects<Float32>("++1.5"_s);
+	CheckParses<Float64>("+2.25"_s, Float64(2.25));
+	CheckRejects<UInt8>("+"_s);
+	CheckRejects<SInt8>("+-1"_s);
+
+	BenchmarkFormat();
+
+	return s_failures;
+}
@@ -0,0 +1,153 @@
+#include "Tests.hpp"
+
+#include <chrono>
+
+// The wrappers must cost nothing: each kernel is run over raw values and over wrapped ones, which must agree exactly
+// and, in optimized builds, take about as long. A wrapper that stops the compiler from vectorizing a loop shows up here
+// as a wrapped loop several times slower than the raw one.
+static const size_t ElementCount = 1U << 14U;
+static const size_t Repetitions  = 200U;
+static const size_t Rounds       = 15U;
+
+// How much slower the wrapped loop may be before it counts as a regression. Losing vectorization costs two to four
+// times; anything below this is timing noise.
+static const double AllowedRatio = 1.5;
+
+static int32_t SumRaw(const int32_t* values, size_t count)
+{
+	int32_t result = 0;
+	for(size_t i = 0U; i < count; i++)
+		result += values[i];
+
+	return result;
+}
+
+static SInt32 SumWrapped(const SInt32* values, Size count)
+{
+	SInt32 result = 0;
+	for(Size i = 0U; i < count; i++)
+		result += values[i.ToRawValue()];
+
+	return result;
+}
+
+static float DotRaw(const float* left, const float* right, size_t count)
+{
+	float result = 0.0f;
+	for(size_t i = 0U; i < count; i++)
+		result += left[i] * right[i];
+
+	return result;
+}
+
+static Float32 DotWrapped(const Float32* left, const Float32* right, Size count)
+{
+	Float32 result = 0.0f;
+	for(Size i = 0U; i < count; i++)
+		result += left[i.ToRawValue()] * right[i.ToRawValue()];
+
+	return result;
+}
+
+static void SaxpyRaw(float a, const float* x, float* y, size_t count)
+{
+	for(size_t i = 0U; i < count; i++)
+		y[i] = a * x[i] + y[i];
+}
+
+static void SaxpyWrapped(Float32 a, const Float32* x, Float32* y, Size count)
+{
+	for(Size i = 0U; i < count; i++)
+		y[i.ToRawValue()] = a * x[i.ToRawValue()] + y[i.ToRawValue()];
+}
+
+// One round of repetitions, in nanoseconds per element.
+template<typename Kernel>
+static double Measure(Kernel kernel)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(size_t i = 0U; i < Repetitions; i++)
+		kernel();
+
+	std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / double(Repetitions * ElementCount);
+}
+
+// Takes the best of several rounds of each, alternating between them so both see the same machine.
+template<typename RawKernel, typename WrappedKernel>
+static void Compare(const String& name, RawKernel raw, WrappedKernel wrapped)
+{
+	double rawTime     = Measure(raw);
+	double wrappedTime = Measure(wrapped);
+
+	for(size_t round = 1U; round < Rounds; round++)
+	{
+		double rawRound     = Measure(raw);
+		double wrappedRound = Measure(wrapped);
+
+		rawTime     = rawRound     < rawTime     ? rawRound     : rawTime;
+		wrappedTime = wrappedRound < wrappedTime ? wrappedRound : wrappedTime;
+	}
+
+	Console::PrintLine(Format("{}: raw {} ns, wrapped {} ns per element", name, Float64(rawTime), Float64(wrappedTime)));
+
+#if defined(NDEBUG)
+	Check(wrappedTime <= rawTime * AllowedRatio, name + " is slower wrapped"_s);
+#endif
+}
+
+UInt32 RunNumericsTests()
+{
+	s_failures = 0U;
+
+	int32_t* rawIntegers = (int32_t*)malloc(ElementCount * sizeof(int32_t));
+	float*   rawX        = (float*)malloc(ElementCount * sizeof(float));
+	float*   rawY        = (float*)malloc(ElementCount * sizeof(float));
+
+	SInt32*  integers = (SInt32*)malloc(ElementCount * sizeof(SInt32));
+	Float32* x        = (Float32*)malloc(ElementCount * sizeof(Float32));
+	Float32* y        = (Float32*)malloc(ElementCount * sizeof(Float32));
+
+	for(size_t i = 0U; i < ElementCount; i++)
+	{
+		rawIntegers[i] = int32_t(i * 7U % 1000U) - 500;
+		rawX[i]        = float(i % 17U) * 0.25f;
+		rawY[i]        = float(i % 5U) - 2.0f;
+
+		new(integers + i) SInt32(rawIntegers[i]);
+		new(x + i)        Float32(rawX[i]);
+		new(y + i)        Float32(rawY[i]);
+	}
+
+	Check(SumWrapped(integers, ElementCount).ToRawValue() == SumRaw(rawIntegers, ElementCount), "Sum"_s);
+	Check(DotWrapped(x, y, ElementCount).ToRawValue() == DotRaw(rawX, rawY, ElementCount), "Dot"_s);
+
+	SaxpyRaw(0.5f, rawX, rawY, ElementCount);
+	SaxpyWrapped(0.5f, x, y, ElementCount);
+	Check(memcmp(rawY, y, ElementCount * sizeof(float)) == 0, "Saxpy"_s);
+
+	// The sink keeps the results alive, so the loops cannot be left out.
+	volatile int32_t integerSink = 0;
+	volatile float   floatSink   = 0.0f;
+
+	Compare("Sum"_s,
+		[&]() { integerSink = integerSink + Opaque(SumRaw)(rawIntegers, ElementCount); },
+		[&]() { integerSink = integerSink + Opaque(SumWrapped)(integers, ElementCount).ToRawValue(); });
+
+	Compare("Dot"_s,
+		[&]() { floatSink = floatSink + Opaque(DotRaw)(rawX, rawY, ElementCount); },
+		[&]() { floatSink = floatSink + Opaque(DotWrapped)(x, y, ElementCount).ToRawValue(); });
+
+	Compare("Saxpy"_s,
+		[&]() { Opaque(SaxpyRaw)(0.5f, rawX, rawY, ElementCount); },
+		[&]() { Opaque(SaxpyWrapped)(0.5f, x, y, ElementCount); });
+
+	free(rawIntegers);
+	free(rawX);
+	free(rawY);
+	free(integers);
+	free(x);
+	free(y);
+
+	return s_failures;
+}
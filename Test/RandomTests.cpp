@@ -0,0 +1,289 @@
+#include "Tests.hpp"
+
+#include <JamJar/Math/Random.hpp>
+
+#include <random>
+
+// Draws per distribution check, and values per fill in the benchmark.
+static const size_t DrawCount = 600000U;
+static const size_t FillCount = 1U << 20U;
+
+// The first values of each engine from the authors' reference code.
+static const uint64_t SplitMix64Values[] = { 0xE220A8397B1DCDAFULL, 0x6E789E6AA1B965F4ULL, 0x06C45D188009454FULL, 0xF88BB8A8724C81ECULL, 0x1B39896A51A8749BULL };
+static const uint64_t Xoshiro256Values[] = { 0x99EC5F36CB75F2B4ULL, 0xBF6E1F784956452AULL, 0x1A5F849D4933E6E0ULL, 0x6AA594F1262D2D2CULL, 0xBBA5AD4A1F842E59ULL };
+static const uint64_t Pcg64Values[]      = { 0x86B1DA1D72062B68ULL, 0x1304AA46C9853D39ULL, 0xA3670E9E0DD50358ULL, 0xF9090E529A7DAE00ULL, 0xC85B9FD837996F2CULL, 0x606121F8E3919196ULL };
+
+template<typename Engine, size_t C>
+static Boolean Matches(Engine engine, const uint64_t (&values)[C])
+{
+	Boolean matches = true;
+	for(size_t i = 0U; i < C; i++)
+		matches = matches && engine.Next() == UInt64(values[i]);
+
+	return matches;
+}
+
+// The next few values of two engines, which agree only if their states do.
+template<typename Engine>
+static Boolean SameState(Engine left, Engine right)
+{
+	Boolean same = true;
+	for(size_t i = 0U; i < 8U; i++)
+		same = same && left.Next() == right.Next();
+
+	return same;
+}
+
+static void TestReferenceValues()
+{
+	Check(Matches(SplitMix64(0U), SplitMix64Values), "SplitMix64 gives the reference values"_s);
+	Check(Matches(Xoshiro256(0U), Xoshiro256Values), "Xoshiro256 gives the reference values"_s);
+	Check(Matches(Pcg64(42U, 54U), Pcg64Values), "Pcg64 gives the reference values"_s);
+}
+
+static void TestGenerate()
+{
+	// Short buffers are the values Next would give, in order.
+	Xoshiro256 engine(47U);
+	Xoshiro256 copy = engine;
+	uint64_t   values[64];
+	engine.Generate(values, 64U);
+
+	Boolean inOrder = true;
+	for(size_t i = 0U; i < 64U; i++)
+		inOrder = inOrder && copy.Next() == UInt64(values[i]);
+
+	SplitMix64 mixer(47U);
+	SplitMix64 mixerCopy = mixer;
+	mixer.Generate(values, 64U);
+	for(size_t i = 0U; i < 64U; i++)
+		inOrder = inOrder && mixerCopy.Next() == UInt64(values[i]);
+
+	Pcg64 pcg(47U);
+	Pcg64 pcgCopy = pcg;
+	pcg.Generate(values, 64U);
+	for(size_t i = 0U; i < 64U; i++)
+		inOrder = inOrder && pcgCopy.Next() == UInt64(values[i]);
+
+	Check(inOrder && SameState(engine, copy) && SameState(mixer, mixerCopy) && SameState(pcg, pcgCopy), "Generate gives the values of Next"_s);
+
+	// Longer ones interleave four engines split from this one, with or without AVX2, and leave it just past the splits.
+	const size_t count = 1003U;
+
+	HeapArray<UInt64> generated(count);
+	copy = engine;
+	engine.Generate((uint64_t*)&generated[0U], count);
+
+	Xoshiro256 lanes[4] = { copy.Split(), copy.Split(), copy.Split(), copy.Split() };
+
+	Boolean interleaved = true;
+	for(size_t i = 0U; i < count; i++)
+		interleaved = interleaved && generated[i] == lanes[i % 4U].Next();
+
+	Check(interleaved && SameState(engine, copy), "Long Generate interleaves four split engines"_s);
+}
+
+static void TestJumps()
+{
+	// A jump is a fixed number of steps, so it can be taken before or after a step.
+	Xoshiro256 early(4700U);
+	Xoshiro256 late = early;
+	early.Jump();
+	early.Next();
+	late.Next();
+	late.Jump();
+
+	Xoshiro256 longEarly(4700U);
+	Xoshiro256 longLate = longEarly;
+	longEarly.LongJump();
+	longEarly.Next();
+	longLate.Next();
+	longLate.LongJump();
+
+	Check(SameState(early, late) && SameState(longEarly, longLate) && !SameState(early, longEarly), "Xoshiro256 jumps commute with steps"_s);
+
+	Pcg64   stepped(4701U, 3U);
+	Pcg64   advanced = stepped;
+	Boolean matches  = true;
+	for(size_t steps : { 0U, 1U, 2U, 63U, 1000U, 12345U })
+	{
+		for(size_t i = 0U; i < steps; i++)
+			stepped.Next();
+
+		advanced.Advance(UInt64(uint64_t(steps)));
+		matches = matches && SameState(stepped, advanced);
+	}
+
+	Pcg64 once(4701U);
+	Pcg64 twice = once;
+	once.Advance(UInt64(0xC000000000000001ULL));
+	twice.Advance(UInt64(0x8000000000000000ULL));
+	twice.Advance(UInt64(0x4000000000000001ULL));
+
+	Check(matches && SameState(once, twice), "Pcg64 Advance is the same as that many steps"_s);
+}
+
+static void TestBounded()
+{
+	Random<> random(4702U);
+
+	Boolean inRange = random.NextUInt32(0U) == UInt32(0U) && random.NextUInt64(0U) == UInt64(0U) && random.NextUInt32(1U) == UInt32(0U);
+	for(size_t i = 0U; i < DrawCount / 10U; i++)
+	{
+		uint32_t bound = uint32_t(i * 2654435761U) | 1U;
+		uint64_t wide  = uint64_t(bound) << (i % 33U);
+		inRange = inRange && random.NextUInt32(bound) < UInt32(bound) && random.NextUInt64(wide) < UInt64(wide);
+	}
+
+	Check(inRange, "Bounded values are below the bound"_s);
+
+	// Six buckets, against the chi-squared value that a fair die exceeds one time in a thousand.
+	size_t buckets[6] = {};
+	for(size_t i = 0U; i < DrawCount; i++)
+		buckets[random.NextUInt32(6U).ToRawValue()]++;
+
+	double chiSquared = 0.0;
+	for(size_t bucket : buckets)
+	{
+		double difference = double(bucket) - double(DrawCount) / 6.0;
+		chiSquared += difference * difference / (double(DrawCount) / 6.0);
+	}
+
+	// Taking a 32-bit value modulo 3 * 2^30 would make the lowest third twice as likely as the others.
+	size_t lowest = 0U;
+	for(size_t i = 0U; i < DrawCount; i++)
+		lowest += random.NextUInt32(3U << 30U) < UInt32(1U << 30U) ? 1U : 0U;
+
+	Check(chiSquared < 20.5 && std::abs(double(lowest) / double(DrawCount) - 1.0 / 3.0) < 0.005, "Bounded values are uniform"_s);
+}
+
+static void TestRanges()
+{
+	Random<> random(4703U);
+
+	Boolean signedRange = random.NextSInt32(5, 5) == SInt32(5) && random.NextSInt32(5, -5) == SInt32(5);
+	Boolean ends[2]     = { false, false };
+	Boolean wideSigns[2] = { false, false };
+	for(size_t i = 0U; i < 1000U; i++)
+	{
+		SInt32 value = random.NextSInt32(-5, 5);
+		signedRange = signedRange && value >= SInt32(-5) && value < SInt32(5);
+		ends[0] = ends[0] || value == SInt32(-5);
+		ends[1] = ends[1] || value == SInt32(4);
+
+		SInt64 wide = random.NextSInt64(INT64_MIN, INT64_MAX);
+		wideSigns[wide < SInt64(0) ? 0 : 1] = true;
+	}
+
+	Check(signedRange && ends[0] && ends[1] && wideSigns[0] && wideSigns[1], "Signed ranges cover [minimum, maximum)"_s);
+
+	// A range one value wide can only give its minimum, though rounding would often carry to the maximum.
+	float   afterOne    = std::nextafter(1.0f, 2.0f);
+	Boolean floatRange  = random.NextFloat32(2.0f, 2.0f) == Float32(2.0f);
+	for(size_t i = 0U; i < 1000U; i++)
+	{
+		Float32 unit   = random.NextFloat32();
+		Float64 unit64 = random.NextFloat64();
+		floatRange = floatRange && unit >= Float32(0.0f) && unit < Float32(1.0f) && unit * Float32(16777216.0f) == Float32(std::floor(unit.ToRawValue() * 16777216.0f));
+		floatRange = floatRange && unit64 >= Float64(0.0) && unit64 < Float64(1.0);
+		floatRange = floatRange && random.NextFloat32(1.0f, afterOne) == Float32(1.0f) && random.NextFloat64(-1.0, 1.0) < Float64(1.0);
+	}
+
+	Check(floatRange, "Floating point values are in [minimum, maximum)"_s);
+}
+
+static void TestFill()
+{
+	// Each 64-bit value gives two 32-bit ones, low half first, and an odd last one comes from Next.
+	for(size_t count : { 9U, 513U })
+	{
+		Random<>   random(4704U);
+		Xoshiro256 engine(4704U);
+
+		HeapArray<UInt32> halves(count);
+		random.Fill(halves.AsSpan());
+
+		HeapArray<UInt64> reference(count / 2U);
+		engine.Generate((uint64_t*)&reference[0U], count / 2U);
+
+		Boolean matches = halves[count - 1U] == UInt32(uint32_t(engine.Next().ToRawValue()));
+		for(size_t i = 0U; i + 1U < count; i += 2U)
+			matches = matches && halves[i] == UInt32(uint32_t(reference[i / 2U].ToRawValue())) && halves[i + 1U] == UInt32(uint32_t(reference[i / 2U].ToRawValue() >> 32U));
+
+		Check(matches, Format("Filling {} UInt32 takes the low half first", UInt64(count)));
+	}
+
+	// The floating point fills are the integer ones converted.
+	Random<> integers(4705U);
+	Random<> floats(4705U);
+
+	HeapArray<UInt32>  bits32(FillCount / 16U + 3U);
+	HeapArray<Float32> values32(FillCount / 16U + 3U);
+	HeapArray<UInt64>  bits64(FillCount / 16U + 3U);
+	HeapArray<Float64> values64(FillCount / 16U + 3U);
+	integers.Fill(bits32.AsSpan());
+	floats.Fill(values32.AsSpan());
+	integers.Fill(bits64.AsSpan());
+	floats.Fill(values64.AsSpan());
+
+	Boolean converted = true;
+	for(size_t i = 0U; i < FillCount / 16U + 3U; i++)
+	{
+		converted = converted && values32[i] == Float32(float(bits32[i].ToRawValue() >> 8U) * 0x1.0p-24f);
+		converted = converted && values64[i] == Float64(double(bits64[i].ToRawValue() >> 11U) * 0x1.0p-53);
+	}
+
+	Check(converted, "Floating point fills convert the integer ones"_s);
+}
+
+static void FillRandom(Random<>& random, HeapArray<Float32>& values)
+{
+	random.Fill(values.AsSpan());
+}
+
+static void NextRandom(Random<>& random, HeapArray<Float32>& values)
+{
+	for(size_t i = 0U; i < FillCount; i++)
+		values[i] = random.NextFloat32();
+}
+
+static void NextMersenne(std::mt19937& engine, HeapArray<Float32>& values)
+{
+	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+	for(size_t i = 0U; i < FillCount; i++)
+		values[i] = distribution(engine);
+}
+
+// The particle case: a buffer of Float32 in [0, 1), against std::mt19937 with a standard distribution.
+static void BenchmarkRandom()
+{
+	Random<>           random(4706U);
+	std::mt19937       mersenne(4706U);
+	HeapArray<Float32> values(FillCount);
+
+	double fill = BestTime([&]() { Opaque(FillRandom)(random, values); });
+	double next = BestTime([&]() { Opaque(NextRandom)(random, values); });
+	double mt   = BestTime([&]() { Opaque(NextMersenne)(mersenne, values); });
+
+	Console::PrintLine(Format("Random Float32: Fill {} ns, NextFloat32 {} ns, std::mt19937 {} ns per value ({}x, {}x)",
+		Float64(fill / double(FillCount)), Float64(next / double(FillCount)), Float64(mt / double(FillCount)), Float64(mt / fill), Float64(mt / next)));
+
+#if defined(NDEBUG)
+	Check(fill < next && next < mt, "Random is slower than std::mt19937"_s);
+#endif
+}
+
+UInt32 RunRandomTests()
+{
+	s_failures = 0U;
+
+	TestReferenceValues();
+	TestGenerate();
+	TestJumps();
+	TestBounded();
+	TestRanges();
+	TestFill();
+	BenchmarkRandom();
+
+	return s_failures;
+}
@@ -0,0 +1,302 @@
+#include "Tests.hpp"
+
+#include <JamJar/Dynamic.hpp>
+#include <JamJar/NumberFormat.hpp>
+
+#include <cfloat>
+
+// One entity of a save file: an identifier, a signed counter and a position.
+struct SaveRecord
+{
+	UInt32  id;
+	SInt32  health;
+	Float64 x;
+	Float64 y;
+	Float64 z;
+};
+
+template<>
+struct Serialization<SaveRecord>
+{
+	static void Write(BinaryWriter& writer, const SaveRecord& value)
+	{
+		writer.Write(value.id);
+		writer.Write(value.health);
+		writer.Write(value.x);
+		writer.Write(value.y);
+		writer.Write(value.z);
+	}
+
+	static SaveRecord Read(BinaryReader& reader)
+	{
+		SaveRecord value;
+		value.id     = reader.Read<UInt32>();
+		value.health = reader.Read<SInt32>();
+		value.x      = reader.Read<Float64>();
+		value.y      = reader.Read<Float64>();
+		value.z      = reader.Read<Float64>();
+		return value;
+	}
+};
+
+// Loading is timed against the same records written as text, one per line with spaces between the fields, and read
+// back with NumberFormat. The binary form is meant to load about ten times faster.
+static const size_t RecordCount       = 1U << 16U;
+static const double RequiredLoadRatio = 10.0;
+
+static Boolean operator==(const SaveRecord& left, const SaveRecord& right)
+{
+	return left.id == right.id && left.health == right.health && left.x == right.x && left.y == right.y && left.z == right.z;
+}
+
+static void TestScalars()
+{
+	BinaryWriter writer;
+	writer.Write(UInt8(255U));
+	writer.Write(UInt16(65535U));
+	writer.Write(UInt64(UINT64_MAX));
+	writer.Write(SInt8(-128));
+	writer.Write(SInt64(INT64_MIN));
+	writer.Write(SInt64(INT64_MAX));
+	writer.Write(Float32(FLT_MIN));
+	writer.Write(Float64(-0.0));
+	writer.Write(Float64(DBL_MAX));
+	writer.Write(Boolean(true));
+	writer.Write(Boolean(false));
+	writer.Write(Character(L'é'));
+	writer.Write(String());
+	writer.Write(String("caf\xC3\xA9 \xE2\x82\xAC"));
+
+	BinaryReader reader(writer.ToUnsafePointer(), writer.Count());
+	Check(reader.Read<UInt8>() == UInt8(255U) && reader.Read<UInt16>() == UInt16(65535U) && reader.Read<UInt64>() == UInt64(UINT64_MAX), "Unsigned integers round-trip"_s);
+	Check(reader.Read<SInt8>() == SInt8(-128) && reader.Read<SInt64>() == SInt64(INT64_MIN) && reader.Read<SInt64>() == SInt64(INT64_MAX), "Signed integers round-trip"_s);
+
+	Float32 smallest = reader.Read<Float32>();
+	Float64 zero     = reader.Read<Float64>();
+	Float64 largest  = reader.Read<Float64>();
+	Check(smallest == Float32(FLT_MIN) && zero == Float64(0.0) && std::signbit(zero.ToRawValue()) && largest == Float64(DBL_MAX), "Floats round-trip bit for bit"_s);
+
+	Check(reader.Read<Boolean>() && !reader.Read<Boolean>() && reader.Read<Character>() == Character(L'é'), "Booleans and characters round-trip"_s);
+	Check(reader.Read<String>().Length() == Size(0U) && reader.Read<String>() == String("caf\xC3\xA9 \xE2\x82\xAC"), "Strings round-trip"_s);
+	Check(reader.IsAtEnd(), "Reading stops where writing did"_s);
+}
+
+static void TestVarInts()
+{
+	BinaryWriter writer;
+
+	writer.WriteVarUInt(127U);
+	Size one = writer.Count();
+	writer.WriteVarUInt(128U);
+	Size two = writer.Count() - one;
+	writer.WriteVarUInt(UINT64_MAX);
+	Size ten = writer.Count() - one - two;
+	Check(one == Size(1U) && two == Size(2U) && ten == Size(10U), "Unsigned integers take one byte per seven bits"_s);
+
+	// Zig-zag encoding keeps small negative numbers as short as small positive ones.
+	writer.Clear();
+	writer.WriteVarSInt(-1);
+	writer.WriteVarSInt(63);
+	writer.WriteVarSInt(-64);
+	Check(writer.Count() == Size(3U), "Small signed integers take one byte"_s);
+
+	BinaryReader reader(writer.ToUnsafePointer(), writer.Count());
+	Check(reader.ReadVarSInt() == SInt64(-1) && reader.ReadVarSInt() == SInt64(63) && reader.ReadVarSInt() == SInt64(-64), "Signed integers read back"_s);
+}
+
+static void TestArrays()
+{
+	HeapArray<Float64> values(1000U);
+	for(Size i = 0U; i < values.Count(); i++)
+		values[i] = Float64(double(i.ToRawValue()) * 0.5);
+
+	HeapArray<String> words("alpha"_s, ""_s, String("\xF0\x9F\x98\x80"));
+
+	BinaryWriter writer;
+	writer.Write(UInt8(1U));
+	writer.Write(values);
+	writer.Write(words);
+	writer.Write(values);
+
+	BinaryReader reader(writer.ToUnsafePointer(), writer.Count());
+	reader.Read<UInt8>();
+
+	HeapArray<Float64> copied = reader.Read<HeapArray<Float64>>();
+	Boolean            equal  = copied.Count() == values.Count();
+	for(Size i = 0U; equal && i < values.Count(); i++)
+		equal = copied[i] == values[i];
+
+	Check(equal, "Arrays of numbers round-trip"_s);
+
+	HeapArray<String> readWords = reader.Read<HeapArray<String>>();
+	Check(readWords.Count() == Size(3U) && readWords[0U] == "alpha"_s && readWords[1U] == ""_s && readWords[2U] == String("\xF0\x9F\x98\x80"), "Arrays of strings round-trip"_s);
+
+	// A block is read in place, aligned for its elements even though a single byte came before it.
+	const ArrayRef<Float64> view   = reader.ReadView<Float64>();
+	const unsigned char*    start  = (const unsigned char*)writer.ToUnsafePointer();
+	const unsigned char*    inside = (const unsigned char*)&view[0U];
+	Check(inside > start && inside < start + writer.Count().ToRawValue() && (uintptr_t)inside % alignof(Float64) == 0U, "Blocks are read without copying"_s);
+
+	equal = view.Count() == values.Count();
+	for(Size i = 0U; equal && i < values.Count(); i++)
+		equal = view[i] == values[i];
+
+	Check(equal && reader.IsAtEnd(), "Blocks read in place hold the values"_s);
+}
+
+static void TestDynamic()
+{
+	Reflect::Register<SaveRecord>("SaveRecord"_s);
+
+	SaveRecord record = { UInt32(7U), SInt32(-3), Float64(1.5), Float64(-2.25), Float64(1e300) };
+
+	BinaryWriter writer;
+	writer.Write(Dynamic(String("first")));
+	Size first = writer.Count();
+	writer.Write(Dynamic(String("again")));
+	Size second = writer.Count() - first;
+	writer.Write(Dynamic(SaveRecord(record)));
+	writer.Write(DynamicArray(HeapArray<UInt32>(UInt32(1U), UInt32(300U), UInt32(70000U))));
+	writer.Write(DynamicArray(HeapArray<String>("x"_s, "yz"_s)));
+
+	// The second value names its type by index instead of spelling it out again.
+	Check(second < first, "Types are written by name once"_s);
+
+	BinaryReader reader(writer.ToUnsafePointer(), writer.Count());
+
+	Dynamic firstValue  = reader.Read<Dynamic>();
+	Dynamic secondValue = reader.Read<Dynamic>();
+	Check(firstValue.GetType() == Reflect::GetType<String>() && firstValue.Cast<String>() == "first"_s && secondValue.Cast<String>() == "again"_s, "Dynamic strings round-trip"_s);
+
+	Dynamic recordValue = reader.Read<Dynamic>();
+	Check(recordValue.GetType() == Reflect::GetType<SaveRecord>() && recordValue.Cast<SaveRecord>() == record, "Dynamic values of registered types round-trip"_s);
+
+	DynamicArray numbers = reader.Read<DynamicArray>();
+	Check(numbers.GetElementType() == Reflect::GetType<UInt32>() && numbers.Count() == Size(3U) && numbers[2U].Cast<UInt32>() == UInt32(70000U), "Dynamic arrays of numbers round-trip"_s);
+
+	DynamicArray strings = reader.Read<DynamicArray>();
+	Check(strings.Count() == Size(2U) && strings[0U].Cast<String>() == "x"_s && strings[1U].Cast<String>() == "yz"_s, "Dynamic arrays of strings round-trip"_s);
+	Check(reader.IsAtEnd(), "Dynamic values read to the end"_s);
+}
+
+// Positions are thirds, so most take the full seventeen digits as text, as coordinates from a running game do.
+static SaveRecord MakeRecord(size_t index)
+{
+	double position = double(index) / 3.0;
+	return { UInt32(uint32_t(index * 2654435761U)), SInt32(int32_t(index % 200U) - 100), Float64(position), Float64(-position), Float64(position * 3.0) };
+}
+
+// Both loaders fill the same array, so the time is spent reading and not on fresh pages for the result.
+static Boolean LoadBinary(const BinaryWriter& writer, HeapArray<SaveRecord>& records)
+{
+	BinaryReader reader(writer.ToUnsafePointer(), writer.Count());
+	if(reader.ReadVarUInt() != UInt64(RecordCount))
+		return false;
+
+	for(size_t i = 0U; i < RecordCount; i++)
+		records[i] = reader.Read<SaveRecord>();
+
+	return reader.IsAtEnd();
+}
+
+static Boolean ParseField(const wchar_t*& text, uint64_t& result)
+{
+	size_t length = 0U;
+	while(text[length] != L' ' && text[length] != L'\n')
+		length++;
+
+	Boolean parsed = NumberFormat::Parse(text, length, UINT32_MAX, result);
+	text += length + 1U;
+	return parsed;
+}
+
+static Boolean ParseField(const wchar_t*& text, int64_t& result)
+{
+	size_t length = 0U;
+	while(text[length] != L' ' && text[length] != L'\n')
+		length++;
+
+	Boolean parsed = NumberFormat::Parse(text, length, INT32_MIN, INT32_MAX, result);
+	text += length + 1U;
+	return parsed;
+}
+
+static Boolean ParseField(const wchar_t*& text, double& result)
+{
+	size_t length = 0U;
+	while(text[length] != L' ' && text[length] != L'\n')
+		length++;
+
+	Boolean parsed = NumberFormat::Parse(text, length, result);
+	text += length + 1U;
+	return parsed;
+}
+
+static Boolean LoadText(const wchar_t* text, HeapArray<SaveRecord>& records)
+{
+	for(size_t i = 0U; i < RecordCount; i++)
+	{
+		uint64_t id;
+		int64_t  health;
+		double   x, y, z;
+		if(!ParseField(text, id) || !ParseField(text, health) || !ParseField(text, x) || !ParseField(text, y) || !ParseField(text, z))
+			return false;
+
+		records[i] = { UInt32(uint32_t(id)), SInt32(int32_t(health)), Float64(x), Float64(y), Float64(z) };
+	}
+
+	return true;
+}
+
+static void BenchmarkLoading()
+{
+	HeapArray<SaveRecord> records(RecordCount);
+	for(size_t i = 0U; i < RecordCount; i++)
+		records[i] = MakeRecord(i);
+
+	BinaryWriter writer;
+	writer.Write(records);
+
+	StringBuilder builder;
+	for(size_t i = 0U; i < RecordCount; i++)
+		builder.Append(Format("{} {} {} {} {}\n", records[i].id, records[i].health, records[i].x, records[i].y, records[i].z));
+
+	String   text  = builder.ToString();
+	wchar_t* chars = (wchar_t*)malloc((text.Length().ToRawValue() + 1U) * sizeof(wchar_t));
+	text.CopyTo(chars);
+
+	HeapArray<SaveRecord> fromBinary(RecordCount);
+	HeapArray<SaveRecord> fromText(RecordCount);
+
+	Boolean loaded = true;
+	double  binary = BestTime([&]() { loaded = Opaque(LoadBinary)(writer, fromBinary) && loaded; });
+	double  parsed = BestTime([&]() { loaded = Opaque(LoadText)(chars, fromText) && loaded; });
+
+	Boolean equal = loaded;
+	for(size_t i = 0U; equal && i < RecordCount; i++)
+		equal = fromBinary[i] == records[i] && fromText[i] == records[i];
+
+	Check(equal, "Binary and text loads give the saved records"_s);
+
+	Console::PrintLine(Format("Serialization: {} records load in {} ns from {} bytes, {} ns from {} characters of text ({}x)",
+		UInt64(RecordCount), Float64(binary), writer.Count(), Float64(parsed), text.Length(), Float64(parsed / binary)));
+
+#if defined(NDEBUG)
+	Check(binary * RequiredLoadRatio <= parsed, "Binary loading is not ten times faster than text"_s);
+#endif
+
+	free(chars);
+}
+
+UInt32 RunSerializationTests()
+{
+	s_failures = 0U;
+
+	TestScalars();
+	TestVarInts();
+	TestArrays();
+	TestDynamic();
+	BenchmarkLoading();
+
+	return s_failures;
+}
@@ -0,0 +1,352 @@
+#include "Tests.hpp"
+
+#include <JamJar/Atom.hpp>
+#include <JamJar/Encoding.hpp>
+#include <JamJar/StringSearch.hpp>
+
+#include <algorithm>
+#include <thread>
+
+// The search engine is timed against the plain loop it replaced, over haystacks from 1 KB to 100 MB of text the needle
+// is missing from, so every character is looked at. Once a haystack is past the cost of setting the engine up, the
+// engine must not lose to that loop.
+static const size_t HaystackBytes[]     = { 1U << 10U, 64U << 10U, 1U << 20U, 100U << 20U };
+static const size_t SearchRepetitions[] = { 4096U,     64U,        8U,        1U          };
+static const size_t MinimumSearchBytes  = 64U << 10U;
+
+static const wchar_t SearchText[] = L"the quick brown fox jumps over the lazy dog, then ";
+
+// What IndexOf did before the search engine: a compare at every position whose first character matches.
+static size_t ScalarIndexOf(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+{
+	for(size_t i = 0U; i + needleLength <= haystackLength; i++)
+	{
+		if(haystack[i] == needle[0] && wmemcmp(haystack + i, needle, needleLength) == 0)
+			return i;
+	}
+
+	return haystackLength;
+}
+
+static size_t EngineIndexOf(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+{
+	Nullable<Size> result = StringSearch::IndexOf((const Character*)haystack, haystackLength, (const Character*)needle, needleLength);
+	return result == nullptr ? haystackLength : result.GetValue().ToRawValue();
+}
+
+static void CompareSearch(const wchar_t* haystack, size_t length, size_t repetitions, const String& name, const wchar_t* needle)
+{
+	size_t needleLength = wcslen(needle);
+
+	// The sink keeps the results alive, so the searches cannot be left out.
+	volatile size_t sink = 0U;
+
+	double scalar = BestTime([&]()
+	{
+		for(size_t i = 0U; i < repetitions; i++)
+			sink = sink + Opaque(ScalarIndexOf)(haystack, length, needle, needleLength);
+	}, 3U);
+
+	double engine = BestTime([&]()
+	{
+		for(size_t i = 0U; i < repetitions; i++)
+			sink = sink + Opaque(EngineIndexOf)(haystack, length, needle, needleLength);
+	}, 3U);
+
+	size_t bytes = length * sizeof(wchar_t);
+	Console::PrintLine(Format("Search {} in {} KB: scalar {} GB/s, engine {} GB/s, {}x", name, UInt64(bytes >> 10U),
+		Float64(double(bytes * repetitions) / scalar), Float64(double(bytes * repetitions) / engine), Float64(scalar / engine)));
+
+#if defined(NDEBUG)
+	if(bytes >= MinimumSearchBytes)
+		Check(engine <= scalar, "Search "_s + name + " is slower than the scalar loop"_s);
+#endif
+}
+
+static void TestSearch()
+{
+	String text = "the quick brown fox jumps over the lazy dog"_s;
+
+	Check(text.IndexOf("quick").GetValue() == Size(4U), "IndexOf finds a word"_s);
+	Check(text.IndexOf("the", 1U).GetValue() == Size(31U), "IndexOf starts at the offset"_s);
+	Check(text.IndexOf("cat") == nullptr, "IndexOf misses an absent word"_s);
+	Check(text.LastIndexOf("the").GetValue() == Size(31U), "LastIndexOf finds the last match"_s);
+	Check(text.CountOccurrences("o") == Size(4U), "CountOccurrences counts characters"_s);
+	Check(text.Replace("the", "a") == "a quick brown fox jumps over a lazy dog"_s, "Replace swaps every match"_s);
+	Check(text.Contains("lazy dog") && !text.Contains("lazy cat"), "Contains"_s);
+	Check(text.StartsWith("the") && text.EndsWith("dog"), "StartsWith and EndsWith"_s);
+
+	// A needle long enough for the skip table, placed where the vector loop hands over to the scalar tail.
+	String longNeedle = "jumps over the lazy dog and runs away into the woods"_s;
+	String haystack   = String(L'x', 1000U) + longNeedle;
+	Check(haystack.IndexOf(longNeedle).GetValue() == Size(1000U), "IndexOf finds a long needle"_s);
+	Check(haystack.IndexOf("woods").GetValue() == haystack.Length() - 5U, "IndexOf finds a needle at the end"_s);
+	Check(haystack.IndexOf(longNeedle + "!") == nullptr, "IndexOf misses a needle past the end"_s);
+}
+
+static void BenchmarkSearch()
+{
+	size_t   textLength = wcslen(SearchText);
+	size_t   maximum    = HaystackBytes[3] / sizeof(wchar_t);
+	wchar_t* characters = (wchar_t*)malloc(maximum * sizeof(wchar_t));
+	for(size_t i = 0U; i < maximum; i++)
+		characters[i] = SearchText[i % textLength];
+
+	const wchar_t* shortNeedle = L"lazy cat";
+	const wchar_t* longNeedle  = L"the quick brown fox jumps over the lazy cat";
+	for(size_t i = 0U; i < 4U; i++)
+	{
+		size_t length = HaystackBytes[i] / sizeof(wchar_t);
+		Check(EngineIndexOf(characters, length, shortNeedle, wcslen(shortNeedle)) == length, "Search misses an absent needle"_s);
+
+		CompareSearch(characters, length, SearchRepetitions[i], "short needle"_s, shortNeedle);
+		CompareSearch(characters, length, SearchRepetitions[i], "long needle"_s, longNeedle);
+	}
+
+	free(characters);
+}
+
+// UTF-8 for "é", "€" and "😀", taking two, three and four bytes.
+static const char* const MultiByteCharacters[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+
+// Sequences every decoder must refuse: overlong, a surrogate, above U+10FFFF, cut short, and a stray continuation byte.
+static const char* const InvalidSequences[] = { "\xC0\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE2\x82", "\x80" };
+
+// Converts UTF-8 to UTF-16 and UTF-32, across and back, and checks that every path ends where it started.
+static Boolean RoundTrips(const char* text, size_t length)
+{
+	char16_t* utf16  = (char16_t*)malloc((length + 1U) * sizeof(char16_t));
+	char32_t* utf32  = (char32_t*)malloc((length + 1U) * sizeof(char32_t));
+	char16_t* back16 = (char16_t*)malloc((length + 1U) * sizeof(char16_t));
+	char*     back8  = (char*)malloc(length + 1U);
+
+	EncodingResult to16 = Encoding::UTF8ToUTF16(text, length, utf16);
+	EncodingResult to32 = Encoding::UTF8ToUTF32(text, length, utf32);
+
+	size_t count16 = to16.GetCount().ToRawValue();
+	size_t count32 = to32.GetCount().ToRawValue();
+
+	// Measuring must agree with converting.
+	Boolean valid = to16.IsValid() && to32.IsValid() && Encoding::UTF8ToUTF16(text, length, nullptr).GetCount() == to16.GetCount();
+
+	EncodingResult from16 = Encoding::UTF16ToUTF8(utf16, count16, back8);
+	valid = valid && from16.IsValid() && from16.GetCount() == Size(length) && memcmp(back8, text, length) == 0;
+
+	EncodingResult from32 = Encoding::UTF32ToUTF8(utf32, count32, back8);
+	valid = valid && from32.IsValid() && from32.GetCount() == Size(length) && memcmp(back8, text, length) == 0;
+
+	EncodingResult across = Encoding::UTF32ToUTF16(utf32, count32, back16);
+	valid = valid && across.IsValid() && across.GetCount() == Size(count16) && memcmp(back16, utf16, count16 * sizeof(char16_t)) == 0;
+
+	free(utf16);
+	free(utf32);
+	free(back16);
+	free(back8);
+	return valid;
+}
+
+static void TestEncoding()
+{
+	// Each multi-byte character at every offset in a run of ASCII longer than a vector, so the vector loop hands over to
+	// the scalar decoder at each possible point.
+	char text[160];
+	Boolean roundTrips = true;
+	Boolean rejects    = true;
+	for(const char* character : MultiByteCharacters)
+	{
+		size_t characterLength = strlen(character);
+		for(size_t offset = 0U; offset < 70U; offset++)
+		{
+			memset(text, 'a', sizeof(text));
+			memcpy(text + offset, character, characterLength);
+			roundTrips = roundTrips && RoundTrips(text, sizeof(text));
+		}
+	}
+
+	for(const char* sequence : InvalidSequences)
+	{
+		size_t sequenceLength = strlen(sequence);
+		for(size_t offset = 0U; offset < 70U; offset++)
+		{
+			memset(text, 'a', sizeof(text));
+			memcpy(text + offset, sequence, sequenceLength);
+
+			// The ASCII after a cut-short sequence is what makes it cut short.
+			EncodingResult result = Encoding::ValidateUTF8(text, sizeof(text));
+			rejects = rejects && !result.IsValid() && result.GetPosition() == Size(offset);
+		}
+	}
+
+	Check(roundTrips, "UTF-8, UTF-16 and UTF-32 round-trip"_s);
+	Check(rejects, "Invalid UTF-8 is rejected where it starts"_s);
+
+	// A lone surrogate has no UTF-8 form.
+	char16_t loneSurrogate[] = { u'a', char16_t(0xD800U), u'b' };
+	char     bytes[16];
+	EncodingResult result = Encoding::UTF16ToUTF8(loneSurrogate, 3U, bytes);
+	Check(!result.IsValid() && result.GetPosition() == Size(1U), "A lone surrogate is rejected"_s);
+
+	// Narrow text is UTF-8 when it is valid and Latin-1 otherwise.
+	Check(String("caf\xC3\xA9").Length() == Size(4U) && String("caf\xC3\xA9")[3U] == Character(L'\u00E9'), "Narrow text reads as UTF-8"_s);
+	Check(String("caf\xE9").Length() == Size(4U) && String("caf\xE9")[3U] == Character(L'\u00E9'), "Invalid UTF-8 reads as Latin-1"_s);
+	Check("caf\xC3\xA9"_s == String("caf\xC3\xA9"), "Literals decode as run-time text does"_s);
+
+	String emoji = String(MultiByteCharacters[2]);
+	Check(emoji.GetUTF8Length() == Size(4U), "A character outside the BMP takes four bytes"_s);
+}
+
+static void TestOrdering()
+{
+	Check("apple"_s.CompareTo("banana"_s) == -1 && "banana"_s.CompareTo("apple"_s) == 1, "CompareTo orders by the first difference"_s);
+	Check("app"_s.CompareTo("apple"_s) == -1 && "apple"_s.CompareTo("app"_s) == 1, "CompareTo puts a prefix first"_s);
+	Check("apple"_s.CompareTo(String("apple")) == 0, "CompareTo finds equal strings equal"_s);
+	Check("Zebra"_s < "apple"_s && "z"_s < String("\xC3\xA9"), "Strings order by code unit"_s);
+	Check("a"_s <= "a"_s && "b"_s >= "a"_s && !("a"_s > "a"_s), "Ordering operators"_s);
+
+	String words[] = { "pear"_s, "apple"_s, "fig"_s, "applesauce"_s, "Peach"_s, ""_s };
+	std::sort(words, words + 6);
+	Check(words[0] == ""_s && words[1] == "Peach"_s && words[2] == "apple"_s && words[3] == "applesauce"_s && words[4] == "fig"_s && words[5] == "pear"_s, "Strings sort"_s);
+}
+
+static void TestHashing()
+{
+	String   text  = "the quick brown fox"_s;
+	String   copy  = text;
+	String   built = String("the quick ") + "brown fox";
+	HashCode hash  = text.GetHashCode();
+
+	Check(hash.GetValue() != 0U, "A hash is never zero"_s);
+	Check(copy.GetHashCode() == hash && text.GetHashCode() == hash, "A cached hash is the one computed"_s);
+	Check(built.GetHashCode() == hash, "Equal strings in separate storage hash alike"_s);
+	Check(text.AsView().GetHashCode() == hash, "A string hashes as its view does"_s);
+	Check(built.Slice(4U, 5U).GetHashCode() == "quick"_s.GetHashCode(), "A slice hashes as its text"_s);
+	Check("abc"_s.GetHashCode() != "abd"_s.GetHashCode(), "Different strings hash apart"_s);
+	Check(""_s.GetHashCode().GetValue() != 0U, "The empty string has a hash"_s);
+
+	// Equality may stop at two cached hashes that differ, but must still compare when they agree.
+	String other = String("the quick brown cat");
+	other.GetHashCode();
+	Check(text != other && text == built, "Equality with cached hashes"_s);
+
+	// Several threads filling the same slot at once all see the one value.
+	String shared = String("shared between threads");
+	HashCode results[4];
+	{
+		std::thread threads[4];
+		for(size_t i = 0U; i < 4U; i++)
+			threads[i] = std::thread([&shared, &results, i]() { results[i] = String(shared).GetHashCode(); });
+
+		for(std::thread& thread : threads)
+			thread.join();
+	}
+
+	Boolean agree = true;
+	for(const HashCode& result : results)
+		agree = agree && result == shared.AsView().GetHashCode();
+
+	Check(agree, "Threads hashing one string agree"_s);
+}
+
+// Builds a concatenation and returns it unconverted, so its operands have to outlive the expression that made them.
+static auto PendingGreeting(const String& name)
+{
+	return "Hello, "_s + name + "! You are " + UInt32(42U) + " today.";
+}
+
+static void TestFormat()
+{
+	Check(Format("{} + {} = {}", SInt32(-2), UInt64(5U), Float64(3.0)) == "-2 + 5 = 3"_s, "Format fills placeholders in order"_s);
+	Check(Format("{{{}}} {{}}", "x") == "{x} {}"_s, "Format escapes braces"_s);
+	Check(Format("{}{}{}", Boolean(true), Character(L'!'), L"wide") == "True!wide"_s, "Format takes booleans, characters and wide text"_s);
+	Check(Format("no placeholders") == "no placeholders"_s, "Format without arguments"_s);
+	Check(Format("{}", "caf\xC3\xA9") == String("caf\xC3\xA9"), "Format decodes narrow arguments as UTF-8"_s);
+	Check(Format("{}", "x"_s.Replace("x", "{}")) == "{}"_s, "Format leaves braces in arguments alone"_s);
+
+	String name = "Ada"_s;
+	Check(String("a"_s + "b" + L"c" + Character(L'd') + SInt32(-5) + Float32(0.5f)) == "abcd-50.5"_s, "Concatenation of mixed operands"_s);
+	Check(String("left"_s + ("middle"_s + "right"_s)) == "leftmiddleright"_s, "Concatenation nested to the right"_s);
+	Check(String(MutableString("mutable") + "!") == "mutable!"_s, "Concatenation of a MutableString"_s);
+
+	// A concatenation kept past its expression, copied and converted later, must not read dead operands.
+	auto pending = PendingGreeting("Grace"_s);
+	auto copy    = pending;
+	String first  = pending;
+	String second = std::move(copy);
+	Check(first == "Hello, Grace! You are 42 today."_s && second == first, "A kept concatenation converts later"_s);
+
+	// The operands are copied when the node is built, not read when it is converted.
+	auto early = name + " Lovelace";
+	name = "Bob"_s;
+	Check(String(early) == "Ada Lovelace"_s, "A concatenation holds its operands by value"_s);
+
+	Check("ab"_s + "c" == "abc"_s, "A concatenation compares as a string"_s);
+	Check("xabx"_s.Contains("a"_s + "b") && !"xabx"_s.Contains("b"_s + "a"), "A concatenation is searched for as a string"_s);
+	Check(Format("[{}]", "a"_s + "b") == "[ab]"_s, "Format takes a concatenation"_s);
+}
+
+static void TestAtoms()
+{
+	AtomStatistics before = Atom::GetStatistics();
+
+	Atom first  = Atom("interned in StringTests"_s);
+	Atom second = Atom(String("interned in ") + "StringTests");
+	Atom other  = Atom("something else in StringTests"_s);
+
+	Check(first == second && first.GetHashCode() == second.GetHashCode(), "Equal strings intern to one atom"_s);
+	Check(first != other, "Different strings intern apart"_s);
+	Check(first.ToString() == "interned in StringTests"_s && first.Length() == Size(23U), "An atom keeps its text"_s);
+	Check(Atom(""_s) == Atom() && Atom() != first, "The empty string is the empty atom"_s);
+
+	Atom found;
+	Check(Atom::TryFind("interned in StringTests"_s, found) && found == first, "TryFind finds an interned string"_s);
+	Check(!Atom::TryFind("never interned in StringTests"_s, found), "TryFind does not intern"_s);
+
+	StackArray<String, 3> words("alpha in StringTests"_s, "beta in StringTests"_s, "alpha in StringTests"_s);
+	Atom::InternAll(words.AsSpan());
+	Check(Atom::TryFind("beta in StringTests"_s, found) && found == Atom("beta in StringTests"_s), "InternAll interns every string"_s);
+
+	AtomStatistics after = Atom::GetStatistics();
+	Check(after.GetAtomCount() - before.GetAtomCount() == Size(4U), "Each distinct string is stored once"_s);
+	Check(after.GetRequestedBytes() - before.GetRequestedBytes() > after.GetStoredBytes() - before.GetStoredBytes(), "Repeated strings save memory"_s);
+
+	// Threads interning the same strings at once must all end up at the same entries.
+	Atom results[4][16];
+	{
+		std::thread threads[4];
+		for(size_t i = 0U; i < 4U; i++)
+		{
+			threads[i] = std::thread([&results, i]()
+			{
+				for(size_t j = 0U; j < 16U; j++)
+					results[i][j] = Atom(Format("thread atom {} in StringTests", UInt64(j)));
+			});
+		}
+
+		for(std::thread& thread : threads)
+			thread.join();
+	}
+
+	Boolean agree = true;
+	for(size_t i = 1U; i < 4U; i++)
+	{
+		for(size_t j = 0U; j < 16U; j++)
+			agree = agree && results[i][j] == results[0][j] && results[i][j] != results[i][(j + 1U) % 16U];
+	}
+
+	Check(agree, "Threads interning the same strings agree"_s);
+}
+
+UInt32 RunStringTests()
+{
+	s_failures = 0U;
+
+	TestSearch();
+	BenchmarkSearch();
+	TestEncoding();
+	TestOrdering();
+	TestHashing();
+	TestFormat();
+	TestAtoms();
+
+	return s_failures;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <JamJar/Core.hpp>
+
+#include <chrono>
+
+// The failed checks of the tests running now. Each Run function resets it first and returns it at the end.
+inline UInt32 s_failures = 0U;
+
+// Prints the name of a check that did not hold and counts it.
+inline void Check(Boolean condition, const String& name)
+{
+	if(condition)
+		return;
+
+	Console::PrintLine("FAILED: "_s + name);
+	s_failures++;
+}
+
+// Hides which function is called, so a kernel is timed as compiled on its own. Inlined into the timing loop, the kernels
+// being compared are open to different optimizations across repetitions.
+template<typename Function>
+Function* Opaque(Function* function)
+{
+	Function* volatile result = function;
+	return result;
+}
+
+// The fastest of several rounds of the kernel, in nanoseconds. The first round also pays for faulting in memory and
+// filling caches, which the minimum leaves out.
+template<typename Kernel>
+double BestTime(Kernel kernel, size_t rounds = 5U)
+{
+	double best = 0.0;
+	for(size_t round = 0U; round < rounds; round++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		kernel();
+
+		std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+		double time = double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+		if(round == 0U || time < best)
+			best = time;
+	}
+
+	return best;
+}
+
+// Each returns the number of checks that failed, after printing them.
+UInt32 RunNumberFormatTests();
+UInt32 RunNumericsTests();
+UInt32 RunLoggerTests();
+UInt32 RunStringTests();
+UInt32 RunConsoleTests();
+UInt32 RunIOTests();
+UInt32 RunSerializationTests();
+UInt32 RunMathTests();
+UInt32 RunFixedTests();
+UInt32 RunHalfFloatTests();
+UInt32 RunRandomTests();
+UInt32 RunBigIntegerTests();
+UInt32 RunVectorTests();
+UInt32 RunVectorStreamTests();
@@ -0,0 +1,258 @@
+#include "Tests.hpp"
+
+#include <JamJar/Math/VectorStream.hpp>
+#include <JamJar/Math/Random.hpp>
+
+#include <cmath>
+
+// Not a whole number of blocks, so the padding at the end of each component is in play.
+static const size_t VectorCount = 1003U;
+
+// Enough vectors for four chunks of the threaded mode, and points per round of the benchmark, 12 MB of each array.
+static const size_t ThreadedCount = 4U * VectorStream3F32::MinimumChunk + 5U;
+static const size_t PointCount    = 1U << 20U;
+
+template<typename T, size_t D>
+static HeapArray<typename VectorStream<T, D>::Element> RandomVectors(Random<>& random, size_t count)
+{
+	HeapArray<typename VectorStream<T, D>::Element> vectors(count);
+	for(size_t i = 0U; i < count; i++)
+	{
+		for(size_t j = 0U; j < D; j++)
+			vectors[i][j] = T(random.NextFloat64(-100.0, 100.0).ToRawValue());
+	}
+
+	return vectors;
+}
+
+template<typename T>
+static Matrix4x4<T> RandomMatrix(Random<>& random)
+{
+	Matrix4x4<T> matrix;
+	for(size_t row = 0U; row < 4U; row++)
+	{
+		for(size_t column = 0U; column < 4U; column++)
+			matrix[row][column] = T(random.NextFloat64(-2.0, 2.0).ToRawValue());
+	}
+
+	return matrix;
+}
+
+static Boolean Close(double value, double expected, double tolerance)
+{
+	return std::abs(value - expected) <= tolerance * (std::abs(expected) > 1.0 ? std::abs(expected) : 1.0);
+}
+
+template<typename T, size_t D>
+static void TestConversion(Random<>& random)
+{
+	using Stream = VectorStream<T, D>;
+
+	HeapArray<typename Stream::Element> vectors = RandomVectors<T, D>(random, VectorCount);
+	Stream stream(vectors);
+
+	Boolean matches = stream.Count() == Size(VectorCount);
+	HeapArray<typename Stream::Element> back = stream.ToArray();
+	for(size_t i = 0U; i < VectorCount; i++)
+		matches = matches && back[i] == vectors[i] && stream.Get(i) == vectors[i] && stream.ToUnsafePointer(D - 1U)[i] == vectors[i][D - 1U];
+
+	for(size_t j = 0U; j < D; j++)
+		matches = matches && uintptr_t(stream.ToUnsafePointer(j)) % Stream::Alignment == 0U;
+
+	// Copies are separate, moves take the storage, and new streams start at zero.
+	Stream copy  = stream;
+	Stream moved = Stream(stream);
+	copy.Set(0U, vectors[1U]);
+	moved = copy;
+	matches = matches && stream.Get(0U) == vectors[0U] && copy.Get(0U) == vectors[1U] && moved.Get(0U) == vectors[1U];
+
+	Stream zeros(VectorCount);
+	matches = matches && zeros.Get(VectorCount - 1U) == typename Stream::Element(T::Zero) && Stream().Count() == Size(0U);
+
+	Check(matches, Format("VectorStream<{}> converts to and from arrays", UInt64(D)));
+}
+
+// Each lane does the arithmetic of Vector in the same order, so most results are exact against it; Transform may fuse
+// its multiplies and adds, and the reciprocal square root estimate is only close.
+template<typename T, size_t D>
+static void TestOperations(Random<>& random)
+{
+	using Stream = VectorStream<T, D>;
+
+	double tolerance = SameAs<T, Float32> ? 0x1.0p-20 : 0x1.0p-48;
+
+	HeapArray<typename Stream::Element> leftVectors  = RandomVectors<T, D>(random, VectorCount);
+	HeapArray<typename Stream::Element> rightVectors = RandomVectors<T, D>(random, VectorCount);
+	Stream left(leftVectors), right(rightVectors);
+	T      factor = T(random.NextFloat64(-3.0, 3.0).ToRawValue());
+
+	Stream sum(VectorCount), scaled(VectorCount), normalized(VectorCount), fast(VectorCount);
+	Stream::Add(left, right, sum);
+	Stream::Scale(left, factor, scaled);
+	Stream::Normalize(left, normalized);
+	Stream::FastNormalize(left, fast);
+
+	HeapArray<T> dots(VectorCount);
+	Stream::Dot(left, right, dots.AsSpan());
+
+	Boolean exact = true;
+	Boolean close = true;
+	for(size_t i = 0U; i < VectorCount; i++)
+	{
+		exact = exact && sum.Get(i) == leftVectors[i] + rightVectors[i] && scaled.Get(i) == leftVectors[i] * factor;
+		exact = exact && normalized.Get(i) == leftVectors[i].Normalize() && dots[i] == leftVectors[i].Dot(rightVectors[i]);
+
+		for(size_t j = 0U; j < D; j++)
+			close = close && Close(fast.Get(i)[j].ToRawValue(), normalized.Get(i)[j].ToRawValue(), tolerance);
+	}
+
+	if constexpr(D == 3U)
+	{
+		Stream crossed(VectorCount);
+		Stream::Cross(left, right, crossed);
+		for(size_t i = 0U; i < VectorCount; i++)
+			exact = exact && crossed.Get(i) == leftVectors[i].Cross(rightVectors[i]);
+	}
+
+	if constexpr(D >= 3U)
+	{
+		Matrix4x4<T> matrix = RandomMatrix<T>(random);
+		Stream transformed(VectorCount);
+		Stream::Transform(matrix, left, transformed);
+
+		// Three components are a point with a w of one. Fusing changes the rounding, by little against the terms summed.
+		for(size_t i = 0U; i < VectorCount; i++)
+		{
+			for(size_t row = 0U; row < D; row++)
+			{
+				T expected  = matrix[row][3U];
+				T magnitude = matrix[row][3U].Abs();
+				if constexpr(D == 4U)
+				{
+					expected  = expected * leftVectors[i][3U];
+					magnitude = expected.Abs();
+				}
+
+				for(size_t column = 0U; column < 3U; column++)
+				{
+					expected  = expected + matrix[row][column] * leftVectors[i][column];
+					magnitude = magnitude + (matrix[row][column] * leftVectors[i][column]).Abs();
+				}
+
+				close = close && std::abs((transformed.Get(i)[row] - expected).ToRawValue()) <= tolerance * magnitude.ToRawValue();
+			}
+		}
+	}
+
+	// The output may be one of the inputs.
+	Stream inPlace = left;
+	Stream::Normalize(inPlace, inPlace);
+	Stream::Add(inPlace, right, inPlace);
+	for(size_t i = 0U; i < VectorCount; i++)
+		exact = exact && inPlace.Get(i) == leftVectors[i].Normalize() + rightVectors[i];
+
+	Check(exact, Format("VectorStream<{}> matches Vector exactly", UInt64(D)));
+	Check(close, Format("VectorStream<{}> transforms and fast normalizes close to Vector", UInt64(D)));
+}
+
+// Chunks are whole blocks of the same stream, so any number of threads gives the same results as one.
+static void TestThreads()
+{
+	Random<> random(5002U);
+
+	HeapArray<Vector3F32> leftVectors  = RandomVectors<Float32, 3U>(random, ThreadedCount);
+	HeapArray<Vector3F32> rightVectors = RandomVectors<Float32, 3U>(random, ThreadedCount);
+	VectorStream3F32 left(leftVectors), right(rightVectors);
+	Matrix4x4F32     matrix = RandomMatrix<Float32>(random);
+
+	Boolean same = true;
+	VectorStream3F32  single(ThreadedCount), threaded(ThreadedCount);
+	HeapArray<Float32> singleDots(ThreadedCount), threadedDots(ThreadedCount);
+	for(size_t threads : { 4U, 3U, 0U })
+	{
+		VectorStream3F32::Transform(matrix, left, single);
+		VectorStream3F32::Transform(matrix, left, threaded, threads);
+		VectorStream3F32::Cross(single, right, single);
+		VectorStream3F32::Cross(threaded, right, threaded, threads);
+		VectorStream3F32::Dot(single, right, singleDots.AsSpan());
+		VectorStream3F32::Dot(threaded, right, threadedDots.AsSpan(), threads);
+
+		for(size_t j = 0U; j < 3U; j++)
+			same = same && memcmp(single.ToUnsafePointer(j), threaded.ToUnsafePointer(j), ThreadedCount * sizeof(Float32)) == 0;
+
+		same = same && memcmp(&singleDots[0U], &threadedDots[0U], ThreadedCount * sizeof(Float32)) == 0;
+	}
+
+	Check(same, "Threaded streams give the same results as one thread"_s);
+}
+
+// The batch case: every point through a matrix and normalized, on an array of Vector3F32 a vector at a
+// time, and on a stream a block at a time, with one thread and with one per processor.
+static void TransformArray(const HeapArray<Vector3F32>& input, HeapArray<Vector3F32>& output, const Vector3F32 (&columns)[4])
+{
+	for(size_t i = 0U; i < PointCount; i++)
+	{
+		const Vector3F32& point = input[i];
+		output[i] = (columns[0] * point.GetX() + columns[1] * point.GetY() + columns[2] * point.GetZ() + columns[3]).Normalize();
+	}
+}
+
+static void TransformStream(const Matrix4x4F32& matrix, const VectorStream3F32& input, VectorStream3F32& output, Size threads)
+{
+	VectorStream3F32::Transform(matrix, input, output, threads);
+	VectorStream3F32::Normalize(output, output, threads);
+}
+
+static void BenchmarkVectorStream()
+{
+	Random<> random(5003U);
+
+	Matrix4x4F32 matrix = RandomMatrix<Float32>(random);
+	Vector3F32   columns[4];
+	for(size_t column = 0U; column < 4U; column++)
+		columns[column] = Vector3F32(matrix[0U][column], matrix[1U][column], matrix[2U][column]);
+
+	HeapArray<Vector3F32> points = RandomVectors<Float32, 3U>(random, PointCount);
+	HeapArray<Vector3F32> output(PointCount);
+	VectorStream3F32      stream(points), streamOutput(PointCount);
+
+	double array    = BestTime([&]() { Opaque(TransformArray)(points, output, columns); });
+	double single   = BestTime([&]() { Opaque(TransformStream)(matrix, stream, streamOutput, 1U); });
+	double threaded = BestTime([&]() { Opaque(TransformStream)(matrix, stream, streamOutput, 0U); });
+
+	Boolean agrees = true;
+	for(size_t i = 0U; i < PointCount; i += 97U)
+	{
+		for(size_t j = 0U; j < 3U; j++)
+			agrees = agrees && Close(streamOutput.Get(i)[j].ToRawValue(), output[i][j].ToRawValue(), 1e-5);
+	}
+
+	Check(agrees, "The stream and array transforms agree"_s);
+
+	Console::PrintLine(Format("VectorStream transform and normalize: array {} ns, stream {} ns ({}x), threaded {} ns per point",
+		Float64(array / double(PointCount)), Float64(single / double(PointCount)), Float64(array / single), Float64(threaded / double(PointCount))));
+
+#if defined(NDEBUG)
+	Check(single < array, "VectorStream is slower than an array of Vector3F32"_s);
+#endif
+}
+
+UInt32 RunVectorStreamTests()
+{
+	s_failures = 0U;
+
+	Random<> random(5001U);
+	TestConversion<Float32, 2U>(random);
+	TestConversion<Float32, 3U>(random);
+	TestConversion<Float64, 4U>(random);
+	TestOperations<Float32, 2U>(random);
+	TestOperations<Float32, 3U>(random);
+	TestOperations<Float32, 4U>(random);
+	TestOperations<Float64, 2U>(random);
+	TestOperations<Float64, 3U>(random);
+	TestOperations<Float64, 4U>(random);
+	TestThreads();
+	BenchmarkVectorStream();
+
+	return s_failures;
+}
@@ -0,0 +1,241 @@
+#include "Tests.hpp"
+
+#include <JamJar/Math/Vector.hpp>
+#include <JamJar/Math/Random.hpp>
+
+#include <cmath>
+
+// Random vectors per arithmetic check, and points per round of the benchmark, a few MB of them.
+static const size_t SampleCount = 4096U;
+static const size_t PointCount  = 1U << 18U;
+
+// The plain structure Vector3F32 used to be: a loop over the components for everything, one at a time.
+struct ScalarVector3
+{
+	float x, y, z;
+};
+
+template<typename T>
+static T RandomComponent(Random<>& random)
+{
+	return T(random.NextFloat64(-100.0, 100.0).ToRawValue());
+}
+
+template<typename T, size_t D>
+static Vector<T, D> RandomVector(Random<>& random)
+{
+	Vector<T, D> result;
+	for(size_t i = 0U; i < D; i++)
+		result[i] = RandomComponent<T>(random);
+
+	return result;
+}
+
+// Vector sums the lanes in pairs, (x + y) + (z + w), and each lane is the same IEEE operation as on its own, so the
+// results are exact against the components worked one at a time in that order.
+template<typename T, size_t D>
+static Boolean MatchesComponents(Random<>& random)
+{
+	Boolean matches = true;
+	for(size_t sample = 0U; sample < SampleCount; sample++)
+	{
+		Vector<T, D> left   = RandomVector<T, D>(random);
+		Vector<T, D> right  = RandomVector<T, D>(random);
+		T            scalar = RandomComponent<T>(random);
+
+		Vector<T, D> sum        = left + right;
+		Vector<T, D> difference = left - right;
+		Vector<T, D> product    = left * right;
+		Vector<T, D> quotient   = left / right;
+		Vector<T, D> scaled     = left * scalar;
+		Vector<T, D> divided    = scalar / right;
+		Vector<T, D> negated    = -left;
+		Vector<T, D> compound   = left;
+		compound += right;
+		compound *= scalar;
+
+		for(size_t i = 0U; i < D; i++)
+		{
+			matches = matches && sum[i] == left[i] + right[i] && difference[i] == left[i] - right[i] && product[i] == left[i] * right[i] && quotient[i] == left[i] / right[i];
+			matches = matches && scaled[i] == left[i] * scalar && divided[i] == scalar / right[i] && negated[i] == -left[i] && compound[i] == (left[i] + right[i]) * scalar;
+		}
+
+		T dot = left[0U] * right[0U] + left[1U] * right[1U];
+		if constexpr(D == 3U)
+			dot = dot + left[2U] * right[2U];
+		else
+			dot = dot + (left[2U] * right[2U] + left[3U] * right[3U]);
+
+		T            length     = left.Dot(left).Sqrt();
+		Vector<T, D> normalized = left.Normalize();
+		Vector<T, D> fast       = left.FastNormalize();
+		matches = matches && left.Dot(right) == dot && left.Length() == length && left.LengthSquared() == left.Dot(left);
+
+		for(size_t i = 0U; i < D; i++)
+		{
+			double error = std::abs((fast[i] - normalized[i]).ToRawValue());
+			matches = matches && normalized[i] == left[i] / length && error <= (SameAs<T, Float32> ? 0x1.0p-21 : 0x1.0p-52);
+		}
+
+		Vector<T, D> changed = left;
+		changed[D - 1U] = changed[D - 1U] + T::One;
+		matches = matches && left == Vector<T, D>(left) && left != changed && !(left == changed);
+	}
+
+	return matches;
+}
+
+static void TestArithmetic()
+{
+	Random<> random(4900U);
+
+	Check(MatchesComponents<Float32, 3U>(random) && MatchesComponents<Float32, 4U>(random), "Float32 vectors match their components worked one at a time"_s);
+	Check(MatchesComponents<Float64, 3U>(random) && MatchesComponents<Float64, 4U>(random), "Float64 vectors match their components worked one at a time"_s);
+
+	// Integers and two components keep the loop.
+	Vector3SI integers = Vector3SI(7, -3, 2) * SInt32(3) - Vector3SI(1);
+	Vector2F32 pair    = Vector2F32(3.0f, 4.0f);
+	Check(integers == Vector3SI(20, -10, 5) && integers.Dot(Vector3SI(1, 1, 1)) == SInt32(15) && pair.Length() == Float32(5.0f) && pair.Normalize() == Vector2F32(0.6f, 0.8f), "Vectors without registers work as before"_s);
+}
+
+// Three components are written as two parts, so a vector never spills into the one after it in an array.
+template<typename T>
+static Boolean KeepsNeighbours()
+{
+	HeapArray<Vector3<T>> vectors(3U);
+	vectors[0U] = Vector3<T>(T(1.0f), T(2.0f), T(3.0f));
+	vectors[1U] = Vector3<T>(T(4.0f), T(5.0f), T(6.0f));
+	vectors[2U] = Vector3<T>(T(7.0f), T(8.0f), T(9.0f));
+
+	vectors[1U] = (vectors[1U] * T(2.0f)).Normalize() * vectors[1U].Length();
+	vectors[0U] += T(1.0f);
+
+	const T* components = (const T*)&vectors[0U];
+	return components[2U] == T(4.0f) && components[3U] == vectors[1U].GetX() && components[6U] == T(7.0f) && components[8U] == T(9.0f);
+}
+
+static void TestLayout()
+{
+	Check(KeepsNeighbours<Float32>() && KeepsNeighbours<Float64>(), "Vector3 stores touch only their own components"_s);
+
+	Vector4F32 vector(1.0f, 2.0f, 3.0f, 4.0f);
+	Vector4F64 wide(1.0, 2.0, 3.0, 4.0);
+	Check(vector.GetZXY() == Vector3F32(3.0f, 1.0f, 2.0f) && vector.GetWZ() == Vector2F32(4.0f, 3.0f) && vector.GetYWX() == Vector3F32(2.0f, 4.0f, 1.0f), "Float32 swizzles pick the right components"_s);
+	Check(wide.GetZXY() == Vector3F64(3.0, 1.0, 2.0) && wide.GetWZ() == Vector2F64(4.0, 3.0) && wide.GetXYZ().GetZY() == Vector2F64(3.0, 2.0), "Float64 swizzles pick the right components"_s);
+
+	Vector3F32 x(1.0f, 0.0f, 0.0f), y(0.0f, 1.0f, 0.0f), z(0.0f, 0.0f, 1.0f);
+	Vector3F32 rotated = x.Rotate(z, 90.0f);
+	Check(x.Cross(y) == z && y.Cross(x) == -z && Vector3F64(2.0, 3.0, 4.0).Cross(Vector3F64(5.0, 6.0, 7.0)) == Vector3F64(-3.0, 6.0, -3.0), "Cross follows the right-hand rule"_s);
+	Check((rotated - y).Length() < Float32(1e-6f), "Rotate turns about the axis"_s);
+}
+
+// The transform-heavy loop of a vertex shader: each point through a projection given by the columns of the matrix and
+// divided by its w, and its normal through the upper three by three of it, normalized, and crossed with an axis to give
+// a tangent. The same point stands in for the normal.
+static void TransformScalar(const HeapArray<ScalarVector3>& input, HeapArray<ScalarVector3>& positions, HeapArray<ScalarVector3>& tangents, const float (&matrix)[4][4])
+{
+	for(size_t i = 0U; i < PointCount; i++)
+	{
+		const ScalarVector3& point = input[i];
+
+		float x = matrix[0][0] * point.x + matrix[1][0] * point.y + matrix[2][0] * point.z + matrix[3][0];
+		float y = matrix[0][1] * point.x + matrix[1][1] * point.y + matrix[2][1] * point.z + matrix[3][1];
+		float z = matrix[0][2] * point.x + matrix[1][2] * point.y + matrix[2][2] * point.z + matrix[3][2];
+		float w = matrix[0][3] * point.x + matrix[1][3] * point.y + matrix[2][3] * point.z + matrix[3][3];
+		positions[i] = { x / w, y / w, z / w };
+
+		float nx = matrix[0][0] * point.x + matrix[1][0] * point.y + matrix[2][0] * point.z;
+		float ny = matrix[0][1] * point.x + matrix[1][1] * point.y + matrix[2][1] * point.z;
+		float nz = matrix[0][2] * point.x + matrix[1][2] * point.y + matrix[2][2] * point.z;
+
+		float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+		nx /= length;
+		ny /= length;
+		nz /= length;
+
+		tangents[i] = { ny * 0.5f - nz * 0.25f, nz * 1.0f - nx * 0.5f, nx * 0.25f - ny * 1.0f };
+	}
+}
+
+template<typename T>
+static void TransformVector(const HeapArray<Vector3<T>>& input, HeapArray<Vector3<T>>& positions, HeapArray<Vector3<T>>& tangents, const Vector4<T> (&columns)[4])
+{
+	Vector3<T> axis(T(1.0f), T(0.25f), T(0.5f));
+	for(size_t i = 0U; i < PointCount; i++)
+	{
+		const Vector3<T>& point = input[i];
+
+		Vector4<T> normal = columns[0] * point.GetX() + columns[1] * point.GetY() + columns[2] * point.GetZ();
+		Vector4<T> clip   = normal + columns[3];
+		positions[i] = clip.GetXYZ() / clip.GetW();
+
+		tangents[i] = normal.GetXYZ().Normalize().Cross(axis);
+	}
+}
+
+// The same loop on Vector3F32, on Vector3F64, and on the scalar structure above.
+static void BenchmarkVector()
+{
+	Random<> random(4901U);
+
+	// A w between about 15 and 45 over the points, so the division is well away from zero.
+	float      matrix[4][4];
+	Vector4F32 columns[4];
+	Vector4F64 wideColumns[4];
+	for(size_t column = 0U; column < 4U; column++)
+	{
+		for(size_t row = 0U; row < 4U; row++)
+			matrix[column][row] = random.NextFloat32(-2.0f, 2.0f).ToRawValue();
+
+		matrix[column][3] = column == 3U ? 30.0f : random.NextFloat32(-0.5f, 0.5f).ToRawValue();
+
+		columns[column]     = Vector4F32(matrix[column][0], matrix[column][1], matrix[column][2], matrix[column][3]);
+		wideColumns[column] = Vector4F64(matrix[column][0], matrix[column][1], matrix[column][2], matrix[column][3]);
+	}
+
+	HeapArray<ScalarVector3> scalarPoints(PointCount), scalarPositions(PointCount), scalarTangents(PointCount);
+	HeapArray<Vector3F32>    points(PointCount), positions(PointCount), tangents(PointCount);
+	HeapArray<Vector3F64>    widePoints(PointCount), widePositions(PointCount), wideTangents(PointCount);
+	for(size_t i = 0U; i < PointCount; i++)
+	{
+		scalarPoints[i] = { random.NextFloat32(-10.0f, 10.0f).ToRawValue(), random.NextFloat32(-10.0f, 10.0f).ToRawValue(), random.NextFloat32(-10.0f, 10.0f).ToRawValue() };
+		points[i]       = Vector3F32(scalarPoints[i].x, scalarPoints[i].y, scalarPoints[i].z);
+		widePoints[i]   = Vector3F64(scalarPoints[i].x, scalarPoints[i].y, scalarPoints[i].z);
+	}
+
+	double scalar = BestTime([&]() { Opaque(TransformScalar)(scalarPoints, scalarPositions, scalarTangents, matrix); });
+	double single = BestTime([&]() { Opaque(TransformVector<Float32>)(points, positions, tangents, columns); });
+	double wide   = BestTime([&]() { Opaque(TransformVector<Float64>)(widePoints, widePositions, wideTangents, wideColumns); });
+
+	// The cross product with (1, 0.25, 0.5) is written out by hand in the scalar loop, so the two agree closely.
+	Boolean agrees = true;
+	for(size_t i = 0U; i < PointCount; i += 97U)
+	{
+		for(size_t j = 0U; j < 3U; j++)
+		{
+			float position = j == 0U ? scalarPositions[i].x : j == 1U ? scalarPositions[i].y : scalarPositions[i].z;
+			float tangent  = j == 0U ? scalarTangents[i].x  : j == 1U ? scalarTangents[i].y  : scalarTangents[i].z;
+			agrees = agrees && std::abs(positions[i][j].ToRawValue() - position) < 1e-5f && std::abs(tangents[i][j].ToRawValue() - tangent) < 1e-5f;
+		}
+	}
+
+	Check(agrees, "The vector and scalar transforms agree"_s);
+
+	Console::PrintLine(Format("Vector transform: scalar {} ns, Vector3F32 {} ns ({}x), Vector3F64 {} ns per point",
+		Float64(scalar / double(PointCount)), Float64(single / double(PointCount)), Float64(scalar / single), Float64(wide / double(PointCount))));
+
+#if defined(NDEBUG)
+	Check(single < scalar, "Vector3F32 is slower than the scalar structure"_s);
+#endif
+}
+
+UInt32 RunVectorTests()
+{
+	s_failures = 0U;
+
+	TestArithmetic();
+	TestLayout();
+	BenchmarkVector();
+
+	return s_failures;
+}